@@ -8,6 +8,7 @@ git submodule update --init depends/picosha2
 echo "SHA256 parsing library downloaded."
 
 BUILD_COVERAGE_REPORT='BUILD_COVERAGE_REPORT=OFF'
+USE_IO_URING='USE_IO_URING=OFF'
 
 while [ ! $# -eq 0 ]
 do
@@ -26,6 +27,14 @@ do
 			BUILD_COVERAGE_REPORT='BUILD_COVERAGE_REPORT=ON'
 			echo "coverage report to be generated."
 			;;
+		--uring | -u | -U )
+			USE_IO_URING='USE_IO_URING=ON'
+			echo "io_uring socket backend to be built."
+			;;
+		--bench | --benchmark | -b | -B )
+			BUILD_BENCHMARK='BUILD_BENCHMARK=ON'
+			echo "socket benchmark to be built."
+			;;
 		--docs | --doc | -d | -D )
 			BUILD_DOCS='BUILD_DOCS=ON'
 			rm  ./doc/html/*.*
@@ -51,7 +60,7 @@ echo "JSON message templates loaded for doxygen."
 rm -rf ./build
 mkdir build
 cd ./build
-cmake .. -D${BUILD_COVERAGE_REPORT}
+cmake .. -D${BUILD_COVERAGE_REPORT} -D${USE_IO_URING}
 make
 cd ./../
 
@@ -66,6 +75,17 @@ then
 	echo "- - -"
 fi
 
+if [ ${BUILD_BENCHMARK} ]
+then
+	  cd ./build
+    cmake .. -D${BUILD_BENCHMARK}
+    make
+    cd ./../
+	echo "Benchmark built."
+	echo "From build/ run '$ ./utils/socket_benchmark/telematics-api-benchmark > /dev/null' for benchmark."
+	echo "- - -"
+fi
+
 if [ ${BUILD_TESTS} ]
 then
     cd ./build
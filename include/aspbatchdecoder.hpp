@@ -0,0 +1,113 @@
+/*! \license
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * \copyright 2021 Dan Fernández
+ *
+ *
+ * \file Header for \p AspBatchDecoder class.
+ *
+ * \author fdaniel, trice2
+ */
+
+#if !defined( ASPBATCHDECODER_HPP )
+#define ASPBATCHDECODER_HPP
+
+#include "signalhandler.hpp"
+
+#include <cstddef>
+#include <cstdint>
+
+constexpr size_t ASP_BATCH_THREAD_PACKETS = 16384;  // fewest packets worth a thread
+constexpr uint8_t ASP_THREAT_DISTANCE_NONE = 19;    // distance when no ObjSegment arrived
+
+/*!
+ * ASPM_LM signals copied into an \p AspSnapshot; each field has the name of
+ * its ASPM_LM::ID and ASP type.
+ */
+#define ASP_SNAPSHOT_LM_FIELDS( X ) \
+    X( InfoMsg ) \
+    X( ActiveAutonomousFeature ) \
+    X( ActiveParkingType ) \
+    X( ActiveParkingMode ) \
+    X( ManeuverStatus ) \
+    X( NoFeatureAvailableMsg ) \
+    X( CancelMsg ) \
+    X( PauseMsg1 ) \
+    X( PauseMsg2 ) \
+    X( InstructMsg ) \
+    X( ExploreModeAvailability ) \
+    X( RemoteDriveAvailability ) \
+    X( ManeuverSideAvailability ) \
+    X( DirectionChangeAvailability ) \
+    X( ActiveManeuverSide ) \
+    X( ActiveManeuverOrientation ) \
+    X( ParkTypeChangeAvailability ) \
+    X( ManeuverDirectionAvailability ) \
+    X( ManeuverAlignmentAvailability ) \
+    X( ConfirmAvailability ) \
+    X( ResumeAvailability ) \
+    X( ReturnToStartAvailability ) \
+    X( LongitudinalAdjustAvailability ) \
+    X( LongitudinalAdjustLength ) \
+    X( ManeuverProgressBar ) \
+    X( MobileChallengeSend )
+
+
+/*!
+ * \brief Decodes recorded ASPM packets into snapshots, many at a time.
+ *
+ * Unlike \p SignalHandler::decodeASPMSignalData( ) nothing is kept between
+ * packets: each snapshot comes from its own packet alone, so a batch can be
+ * split across threads.  Only the ASPM_LM signals in an \p AspSnapshot are
+ * extracted, and the ObjSegment bytes are split into types and distances 16
+ * at a time where SSE2 is available.
+ */
+class AspBatchDecoder
+{
+
+public:
+
+    /*!
+     * Decode one ASPM packet.  PDUs are found by header as the live decoder
+     * finds them; fields of a PDU that is missing or has the wrong length
+     * stay as a new \p SignalHandler has them, None or zero, and distance
+     * ASP_THREAT_DISTANCE_NONE.
+     *
+     * \param packet  ASPM_TOTAL_PACKET_SIZE bytes as received
+     * \param out  snapshot to fill
+     */
+    static void decode( const uint8_t* packet, AspSnapshot& out );
+
+    /*!
+     * Decode \p n packets stored back to back, on up to \p threads threads
+     * when there are at least ASP_BATCH_THREAD_PACKETS per thread.
+     *
+     * \param packets  n * ASPM_TOTAL_PACKET_SIZE bytes
+     * \param n  number of packets
+     * \param out  n snapshots to fill, out[ i ] from packet i
+     * \param threads  most threads to use; 0 for one per core
+     */
+    static void decodeBatch( const uint8_t* packets, size_t n, AspSnapshot* out, unsigned threads = 0 );
+
+};
+
+#endif //ASPBATCHDECODER_HPP
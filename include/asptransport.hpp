@@ -0,0 +1,532 @@
+/*! \license
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * \copyright 2021 Dan Fernández
+ *
+ *
+ * \file Header for \p AspTransport classes.
+ *
+ * \author fdaniel, trice2
+ */
+
+#if !defined( ASPTRANSPORT_HPP )
+#define ASPTRANSPORT_HPP
+
+#include <memory>
+#include <atomic>
+#include <string>
+
+#include "sockethandler.hpp"
+#include "latencyhistogram.hpp"
+
+#include <sys/un.h>
+
+constexpr auto ASP_UNIX_NAME = "telematics-asp";    // abstract socket, ASP side
+constexpr auto TCM_UNIX_NAME = "telematics-tcm";    // abstract socket, TCM side
+constexpr auto ASP_SHM_NAME = "/telematics-asp";    // POSIX shared memory object
+constexpr auto ASP_SHM_SLOT_SIZE = 1024;            // bytes, per buffered packet
+constexpr auto ASP_SHM_WAIT_MS = 100;               // ms, between closed checks
+
+
+/*!
+ * Link used between the TCM and the ASP (or its simulator).
+ */
+enum class AspTransportType : uint8_t
+{
+    Udp = 0,            //!< UDP to UDP_ADDR:UDP_PORT; the vehicle link
+    UnixDgram = 1,      //!< AF_UNIX datagrams; same host, no IP stack
+    SharedMemory = 2    //!< shared memory double buffer; same host, no syscalls
+};
+
+
+/*!
+ * \brief Packet transport between the TCM and the ASP.
+ *
+ * Carries one encoded PDU set per send( ) and hands back one per receive( ).
+ * Both ends must use the same transport type.  \p SignalHandler opens the TCM
+ * end and \p ASPM the ASP end.
+ *
+ */
+class AspTransport
+{
+
+public:
+
+    AspTransport( ) : superseded_( 0 ), lastReceiveTime_( 0 ), port_( UDP_PORT ) { }
+
+    virtual ~AspTransport( ) { }
+
+    /*!
+     * Construct a transport of the requested type.
+     *
+     * \param type  transport to construct
+     *
+     * \return std::unique_ptr<AspTransport>  unopened transport
+     */
+    static std::unique_ptr<AspTransport> create( const AspTransportType& type );
+
+    /*!
+     * Parse a transport name: "udp", "unix" or "shm".
+     *
+     * \param type  transport name
+     *
+     * \return AspTransportType  parsed type; Udp if the name is unknown
+     */
+    static AspTransportType parseType( const std::string& type );
+
+    /*!
+     * Select the channel, so several vehicles can share one host; call
+     * before open( ).  UDP uses it as the port on UDP_ADDR, the co-located
+     * transports append it to their names unless it is UDP_PORT.
+     *
+     * \param port  channel; UDP_PORT by default
+     */
+    void setPort( const uint16_t& port );
+
+    /*!
+     * \return uint16_t  channel selected by setPort( )
+     */
+    uint16_t getPort( ) const;
+
+    /*!
+     * Open this end of the link.
+     *
+     * \param isTCM  true for the TCM end, false for the ASP end
+     *
+     * \return bool  true on success
+     */
+    virtual bool open( const bool& isTCM ) = 0;
+
+    /*!
+     * Block until a packet arrives or close( ) is called.
+     *
+     * \param buffer  destination for the packet
+     * \param bufSize  size of \p buffer
+     *
+     * \return ssize_t  packet size; 0 once closed; -1 on error
+     */
+    virtual ssize_t receive( void* buffer, const uint16_t& bufSize ) = 0;
+
+    /*!
+     * Like receive( ), but anything else already queued is drained and only
+     * the newest valid packet is returned; older valid packets are counted
+     * as superseded.  A packet of another size is returned only if nothing
+     * valid arrived.  The default, for links that keep only the newest
+     * packet, returns receive( ) unchecked.
+     *
+     * \param buffer  destination for the packet
+     * \param bufSize  size of \p buffer
+     * \param validSize  size of a valid packet; 0 accepts any size
+     *
+     * \return ssize_t  packet size; 0 once closed; -1 on error
+     */
+    virtual ssize_t receiveLatest(
+            void* buffer,
+            const uint16_t& bufSize,
+            const uint16_t& validSize );
+
+    /*!
+     * \return uint64_t  valid packets skipped for a newer one
+     */
+    /*!
+     * Like receiveLatest( ), but return at once when nothing has arrived.
+     *
+     * \param buffer  destination for the packet
+     * \param bufSize  size of \p buffer
+     * \param validSize  size of a valid packet; 0 accepts any size
+     *
+     * \return ssize_t  packet size, or -1 with errno EAGAIN when empty
+     */
+    virtual ssize_t pollLatest(
+            void* buffer,
+            const uint16_t& bufSize,
+            const uint16_t& validSize ) = 0;
+
+    /*!
+     * Descriptor that becomes readable when a packet arrives, for callers
+     * that wait on many links with one epoll.
+     *
+     * \return int  descriptor, or -1 if the link has none and must be
+     * polled with pollLatest( )
+     */
+    virtual int getEventSocket( );
+
+    virtual uint64_t getSupersededCount( );
+
+    /*!
+     * Arrival time of the packet last returned by a receive; a kernel stamp
+     * where the link provides one, otherwise the time the receive returned.
+     *
+     * \return uint64_t  CLOCK_REALTIME nanoseconds; 0 if unknown
+     */
+    virtual uint64_t getLastReceiveTime( );
+
+    /*!
+     * Send a packet to the other end.
+     *
+     * \param buffer  packet to send
+     * \param bufSize  size of packet
+     *
+     * \return int32_t  bytes sent, or -1 on error
+     */
+    virtual int32_t send( const void* buffer, const uint16_t& bufSize ) = 0;
+
+    /*!
+     * Send a packet and wait for the reply, as the TCM does once per cycle.
+     *
+     * \param bufferOut  packet to send
+     * \param sizeOut  size of packet to send
+     * \param bufferIn  destination for the reply
+     * \param sizeIn  size of \p bufferIn
+     * \param validSize  size of a valid reply; 0 accepts any size
+     *
+     * \return ssize_t  reply size; 0 once closed; -1 on error
+     *
+     * \sa receiveLatest( )
+     */
+    virtual ssize_t exchange(
+            const void* bufferOut,
+            const uint16_t& sizeOut,
+            void* bufferIn,
+            const uint16_t& sizeIn,
+            const uint16_t& validSize = 0 );
+
+    /*!
+     * Close the link; a receive( ) blocked on another thread returns.
+     */
+    virtual void close( ) = 0;
+
+protected:
+
+    /*!
+     * valid packets skipped for a newer one.
+     */
+    std::atomic<uint64_t> superseded_;
+
+    /*!
+     * arrival time of the last packet returned, in nanoseconds.
+     */
+    std::atomic<uint64_t> lastReceiveTime_;
+
+    /*!
+     * channel selected by setPort( ).
+     */
+    uint16_t port_;
+
+    /*!
+     * \param name  default name of a co-located link endpoint
+     *
+     * \return std::string  \p name, suffixed with the channel if it is not
+     * UDP_PORT
+     */
+    std::string channelName_( const char* name ) const;
+
+};
+
+
+/*!
+ * \brief UDP transport through \p SocketHandler; today's vehicle link.
+ */
+class UdpTransport : public AspTransport
+{
+
+public:
+
+    virtual bool open( const bool& isTCM );
+
+    virtual ssize_t receive( void* buffer, const uint16_t& bufSize );
+
+    /*!
+     * Drains the socket with recvmmsg( ).
+     */
+    virtual ssize_t receiveLatest(
+            void* buffer,
+            const uint16_t& bufSize,
+            const uint16_t& validSize );
+
+    virtual ssize_t pollLatest(
+            void* buffer,
+            const uint16_t& bufSize,
+            const uint16_t& validSize );
+
+    virtual int getEventSocket( );
+
+    virtual uint64_t getSupersededCount( );
+
+    /*!
+     * SO_TIMESTAMPNS stamp taken by the kernel.
+     */
+    virtual uint64_t getLastReceiveTime( );
+
+    virtual int32_t send( const void* buffer, const uint16_t& bufSize );
+
+    /*!
+     * Uses SocketHandler::exchangeUDP( ), a single syscall with io_uring.
+     */
+    virtual ssize_t exchange(
+            const void* bufferOut,
+            const uint16_t& sizeOut,
+            void* bufferIn,
+            const uint16_t& sizeIn,
+            const uint16_t& validSize = 0 );
+
+    virtual void close( );
+
+private:
+
+    /*!
+     * SocketHandler object for handling all socket communications.
+     */
+    SocketHandler socketHandler_;
+
+};
+
+
+/*!
+ * \brief AF_UNIX datagram transport for a co-located ASP or simulator.
+ *
+ * Each end binds an abstract socket name, so nothing is left behind in the
+ * filesystem.  The ASP end replies to whichever TCM last sent to it.
+ */
+class UnixDgramTransport : public AspTransport
+{
+
+public:
+
+    UnixDgramTransport( );
+
+    ~UnixDgramTransport( );
+
+    virtual bool open( const bool& isTCM );
+
+    virtual ssize_t receive( void* buffer, const uint16_t& bufSize );
+
+    /*!
+     * Drains the socket with non-blocking reads after the first packet.
+     */
+    virtual ssize_t receiveLatest(
+            void* buffer,
+            const uint16_t& bufSize,
+            const uint16_t& validSize );
+
+    virtual ssize_t pollLatest(
+            void* buffer,
+            const uint16_t& bufSize,
+            const uint16_t& validSize );
+
+    virtual int getEventSocket( );
+
+    virtual int32_t send( const void* buffer, const uint16_t& bufSize );
+
+    virtual void close( );
+
+private:
+
+    /*!
+     * Receive one packet, learning the peer on the ASP end.
+     *
+     * \param buffer  destination for the packet
+     * \param bufSize  size of \p buffer
+     * \param flags  recvfrom( ) flags
+     *
+     * \return ssize_t  packet size, or -1 on error
+     */
+    ssize_t receive_( void* buffer, const uint16_t& bufSize, const int& flags );
+
+    /*!
+     * Read everything else already queued, keeping the newest valid packet.
+     *
+     * \param buffer  destination; holds the packet already received
+     * \param bufSize  size of \p buffer
+     * \param validSize  size of a valid packet; 0 accepts any size
+     * \param current  size of the packet already in \p buffer
+     *
+     * \return ssize_t  size of the packet in \p buffer
+     */
+    ssize_t drain_(
+            void* buffer,
+            const uint16_t& bufSize,
+            const uint16_t& validSize,
+            const ssize_t& current );
+
+    /*!
+     * Fill in an abstract socket address.
+     *
+     * \param address  address to fill
+     * \param name  abstract socket name, without the leading NUL
+     *
+     * \return socklen_t  length of the address
+     */
+    static socklen_t setAddress_( struct sockaddr_un& address, const char* name );
+
+    /*!
+     * datagram socket.
+     */
+    int socket_;
+
+    /*!
+     * address of the other end; learned from the first packet on the ASP end.
+     */
+    struct sockaddr_un peer_;
+
+    /*!
+     * length of peer_, 0 while unknown.
+     */
+    socklen_t peerSize_;
+
+};
+
+
+/*!
+ * \brief One direction of the shared memory link.
+ *
+ * Two packet slots alternate: the writer fills the slot that is not
+ * published and then bumps \p sequence, so a reader always has a complete
+ * packet to copy.  Each slot has its own version, odd while the writer
+ * refills it; a reader retries if the version was odd or moved during its
+ * copy, or if the slot no longer holds the packet it was after.  Only the
+ * newest packet is kept.
+ */
+struct AspShmChannel
+{
+
+    /*!
+     * packets published so far; the newest is in slot[ sequence & 1 ].
+     */
+    std::atomic<uint32_t> sequence;
+
+    /*!
+     * write count per slot; odd while the slot is being written.
+     */
+    std::atomic<uint32_t> version[ 2 ];
+
+    /*!
+     * sequence of the packet held per slot.
+     */
+    uint32_t packet[ 2 ];
+
+    /*!
+     * packet length per slot.
+     */
+    uint32_t length[ 2 ];
+
+    /*!
+     * packet data per slot.
+     */
+    uint8_t slot[ 2 ][ ASP_SHM_SLOT_SIZE ];
+
+};
+
+
+/*!
+ * \brief Layout of the shared memory object.
+ */
+struct AspShmRegion
+{
+
+    AspShmChannel toASP;    //!< written by the TCM
+    AspShmChannel toTCM;    //!< written by the ASP
+
+};
+
+
+/*!
+ * \brief Lock-free shared memory transport for a co-located ASP or simulator.
+ *
+ * Packets are copied into a double buffer in a POSIX shared memory object
+ * and the reader is woken through a futex on the sequence word, so neither
+ * side takes a lock and the IP stack is skipped entirely.  Like the vehicle
+ * signals it carries, a packet is superseded by a newer one if the reader
+ * falls behind.
+ */
+class SharedMemoryTransport : public AspTransport
+{
+
+public:
+
+    SharedMemoryTransport( );
+
+    ~SharedMemoryTransport( );
+
+    virtual bool open( const bool& isTCM );
+
+    /*!
+     * Always returns the newest packet; packets overwritten before they
+     * were read count as superseded.
+     */
+    virtual ssize_t receive( void* buffer, const uint16_t& bufSize );
+
+    /*!
+     * The size is not checked: only the newest packet is kept, so there is
+     * never an older valid one to return instead.
+     */
+    virtual ssize_t pollLatest(
+            void* buffer,
+            const uint16_t& bufSize,
+            const uint16_t& validSize );
+
+    virtual int32_t send( const void* buffer, const uint16_t& bufSize );
+
+    virtual void close( );
+
+private:
+
+    /*!
+     * Copy out the newest packet.
+     *
+     * \param buffer  destination for the packet
+     * \param bufSize  size of \p buffer
+     * \param wait  true to sleep until a packet arrives or close( )
+     *
+     * \return ssize_t  packet size; 0 once closed; -1 with errno EAGAIN
+     * if \p wait is false and nothing new was published
+     */
+    ssize_t receive_( void* buffer, const uint16_t& bufSize, const bool& wait );
+
+    /*!
+     * mapped shared memory object.
+     */
+    AspShmRegion* region_;
+
+    /*!
+     * channel written by this end.
+     */
+    AspShmChannel* tx_;
+
+    /*!
+     * channel read by this end.
+     */
+    AspShmChannel* rx_;
+
+    /*!
+     * sequence of the last packet received.
+     */
+    uint32_t lastSequence_;
+
+    /*!
+     * set by close( ) to release a blocked receive( ).
+     */
+    std::atomic<bool> closing_;
+
+};
+
+#endif //ASPTRANSPORT_HPP
@@ -0,0 +1,109 @@
+/*! \license
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * \copyright 2021 Dan Fernández
+ *
+ *
+ * \file Header for \p BodyCodec class.
+ *
+ * \author fdaniel, trice2
+ */
+
+#if !defined( BODYCODEC_HPP )
+#define BODYCODEC_HPP
+
+#include <string>
+
+#include "json.hpp"
+
+constexpr auto BODY_ENCODING_COUNT = 3;
+
+
+/*!
+ * Encoding of mobile message bodies.  Headers are always JSON text.
+ */
+enum class BodyEncoding : uint8_t
+{
+    Json = 0,           //!< JSON text; the default for every connection
+    Cbor = 1,           //!< RFC 8949 CBOR
+    MsgPack = 2         //!< MessagePack
+};
+
+
+/*!
+ * \brief Serializes and parses message bodies in a negotiated encoding.
+ *
+ * A client picks an encoding with a set_body_encoding message; from then on
+ * bodies in both directions use it, and every outbound header names a binary
+ * encoding in its "encoding" field.
+ */
+class BodyCodec
+{
+
+public:
+
+    /*!
+     * Parse an encoding name: "json", "cbor" or "msgpack".
+     *
+     * \param name  encoding name
+     * \param encoding  parsed encoding; unchanged if the name is unknown
+     *
+     * \return bool  true if the name is known
+     */
+    static bool parseEncoding( const std::string& name, BodyEncoding& encoding );
+
+    /*!
+     * \param encoding  encoding to name
+     *
+     * \return const char*  name accepted by parseEncoding( )
+     */
+    static const char* getEncodingName( const BodyEncoding& encoding );
+
+    /*!
+     * Serialize a body.
+     *
+     * \param body  body to serialize
+     * \param encoding  output encoding
+     *
+     * \return std::string  serialized body; binary for CBOR and MessagePack
+     */
+    static std::string encode( const nlohmann::json& body, const BodyEncoding& encoding );
+
+    /*!
+     * Parse a body without throwing.
+     *
+     * \param raw  start of the serialized body
+     * \param size  length of the serialized body
+     * \param encoding  encoding of the serialized body
+     * \param body  parsed body
+     *
+     * \return bool  false if the body is malformed
+     */
+    static bool decode(
+            const char* raw,
+            const size_t& size,
+            const BodyEncoding& encoding,
+            nlohmann::json& body );
+
+};
+
+#endif //BODYCODEC_HPP
@@ -0,0 +1,167 @@
+/*! \license
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * \copyright 2021 Dan Fernández
+ *
+ *
+ * \file Header for \p CommandQueue class.
+ *
+ * \author fdaniel, trice2
+ */
+
+#if !defined( COMMANDQUEUE_HPP )
+#define COMMANDQUEUE_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+
+/*!
+ * \brief Bounded, ordered queue from any number of producers to one consumer.
+ *
+ * Each slot carries a sequence number telling whether it is free for the
+ * producer whose turn it is or filled for the consumer, so producers claim a
+ * slot with a single compare-and-swap and never lock or wait on the consumer.
+ * Items come out in the order their slots were claimed.  The consumer may
+ * look at the next item before deciding to take it.
+ *
+ * \tparam T  item type, copied into its slot
+ * \tparam N  capacity; a power of two
+ */
+template <typename T, size_t N>
+class CommandQueue
+{
+
+    static_assert( N >= 2 && ( N & ( N - 1 ) ) == 0, "CommandQueue capacity must be a power of two" );
+
+public:
+
+    /*!
+     * constructor
+     */
+    CommandQueue( )
+            :
+            tail_( 0 ),
+            head_( 0 )
+    {
+        for( size_t i = 0; i < N; ++i )
+        {
+            slots_[ i ].sequence.store( i, std::memory_order_relaxed );
+        }
+    }
+
+    /*!
+     * Append an item; safe from any thread.
+     *
+     * \param item  item to append
+     *
+     * \return bool  false if the queue is full; the item is dropped
+     */
+    bool push( const T& item )
+    {
+        size_t position( tail_.load( std::memory_order_relaxed ) );
+
+        while( true )
+        {
+            Slot& slot( slots_[ position & ( N - 1 ) ] );
+            size_t sequence( slot.sequence.load( std::memory_order_acquire ) );
+            intptr_t lag( (intptr_t)sequence - (intptr_t)position );
+
+            if( lag == 0 )
+            {
+                if( tail_.compare_exchange_weak( position, position + 1, std::memory_order_relaxed ) )
+                {
+                    slot.item = item;
+                    slot.sequence.store( position + 1, std::memory_order_release );
+
+                    return true;
+                }
+            }
+            else if( lag < 0 )
+            {
+                return false;
+            }
+            else
+            {
+                position = tail_.load( std::memory_order_relaxed );
+            }
+        }
+    }
+
+    /*!
+     * Next item without taking it; consumer thread only.
+     *
+     * \return const T*  next item, or nullptr if none is ready
+     */
+    const T* front( ) const
+    {
+        const Slot& slot( slots_[ head_ & ( N - 1 ) ] );
+
+        if( slot.sequence.load( std::memory_order_acquire ) != head_ + 1 )
+        {
+            return nullptr;
+        }
+
+        return &slot.item;
+    }
+
+    /*!
+     * Take the item returned by front( ); consumer thread only.
+     */
+    void pop( )
+    {
+        slots_[ head_ & ( N - 1 ) ].sequence.store( head_ + N, std::memory_order_release );
+        ++head_;
+    }
+
+
+private:
+
+    /*!
+     * one queued item and the turn it belongs to.
+     */
+    struct Slot
+    {
+        std::atomic<size_t> sequence;   //!< position + 1 once filled; position + N once taken
+        T item;                         //!< the queued item
+    };
+
+    /*!
+     * ring of slots.
+     */
+    Slot slots_[ N ];
+
+    /*!
+     * position the next producer claims.
+     */
+    std::atomic<size_t> tail_;
+
+    /*!
+     * position of the next item to take; owned by the consumer.
+     */
+    size_t head_;
+
+};
+
+
+#endif //COMMANDQUEUE_HPP
@@ -46,6 +46,8 @@ constexpr auto MAX_REFRESH_RATE = 10000000;                 // μs,
 constexpr auto DMH_TIMEOUT_RATE = 3 * ASP_REFRESH_RATE;     // μs,
 constexpr auto TCM_TIMEOUT_RATE = 60000000;                 // μs,
 constexpr auto BUTTON_TIMEOUT_RATE = 240000;                // μs,
+constexpr auto DEFERRED_REPLY_TIMEOUT = 2000000;            // μs, longest wait on ASP / DCM state
+constexpr auto MANEUVER_INIT_TIMEOUT = 5 * ASP_REFRESH_RATE;    // μs,
 
 // list of supported maneuvers as enum for reference in the codebase
 typedef enum
@@ -0,0 +1,98 @@
+/*! \license
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * \copyright 2021 Dan Fernández
+ *
+ *
+ * \file Header for \p DmhFrame class.
+ *
+ * \author fdaniel, trice2
+ */
+
+#if !defined( DMHFRAME_HPP )
+#define DMHFRAME_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+constexpr auto DMH_FRAME_SIZE = 10;                 // bytes, binary frame body
+constexpr auto DMH_FRAME_TYPE = 0x01;               // first body byte
+constexpr auto DMH_FLAG_ENABLE_MOTION = 0x01;       // flags bit 0
+
+
+/*!
+ * One deadmans_handle sample, already in the ranges \p SignalHandler takes.
+ */
+struct DmhSample
+{
+    bool gesture;           //!< enable_vehicle_motion
+    uint8_t percent;        //!< dmh_gesture_progress
+    uint16_t x;             //!< dmh_horizontal_touch
+    uint16_t y;             //!< dmh_vertical_touch
+    uint16_t crc;           //!< crc_value
+};
+
+
+/*!
+ * \brief Encodes and decodes the fixed-layout binary deadmans_handle frame.
+ *
+ * A client that negotiated "binary_dmh" with set_body_encoding may send each
+ * DMH sample as a frame with an empty header and a DMH_FRAME_SIZE body, laid
+ * out big-endian as:
+ *
+ *      0       frame type, DMH_FRAME_TYPE
+ *      1       flags, DMH_FLAG_ENABLE_MOTION
+ *      2       gesture progress
+ *      3       reserved, zero
+ *      4-5     horizontal touch
+ *      6-7     vertical touch
+ *      8-9     CRC value
+ *
+ * JSON headers are never empty, so the two kinds of frames cannot be confused.
+ */
+class DmhFrame
+{
+
+public:
+
+    /*!
+     * Decode a frame body.
+     *
+     * \param raw  start of the frame body
+     * \param size  length of the frame body
+     * \param sample  decoded sample; unchanged if the body is rejected
+     *
+     * \return bool  false if the size, frame type or reserved bits are wrong
+     */
+    static bool decode( const char* raw, const size_t& size, DmhSample& sample );
+
+    /*!
+     * Encode a frame body.
+     *
+     * \param sample  sample to encode
+     * \param out  DMH_FRAME_SIZE bytes to fill
+     */
+    static void encode( const DmhSample& sample, char* out );
+
+};
+
+#endif //DMHFRAME_HPP
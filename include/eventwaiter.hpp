@@ -0,0 +1,115 @@
+/*! \license
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * \copyright 2021 Dan Fernández
+ *
+ *
+ * \file Header for \p EventWaiter class.
+ *
+ * \author fdaniel, trice2
+ */
+
+#if !defined( EVENTWAITER_HPP )
+#define EVENTWAITER_HPP
+
+#include <atomic>
+
+#include <stdint.h>
+#include <errno.h>
+#include <poll.h>
+#include <unistd.h>
+#include <sys/eventfd.h>
+
+
+/*!
+ * \brief Interruptible sleep for event loop threads.
+ *
+ * Loops sleep in waitFor( ) instead of usleep( ); notify( ) writes an
+ * eventfd that every waiting thread polls, so all of them return at once
+ * rather than at the end of their period.  Once notified, waitFor( )
+ * returns immediately until reset( ).
+ */
+class EventWaiter
+{
+
+public:
+
+    /*!
+     * Constructor.
+     */
+    EventWaiter( );
+
+    /*!
+     * Destructor.
+     */
+    ~EventWaiter( );
+
+    /*!
+     * Sleep for the given time, or until notify( ).
+     *
+     * \param micros  time to sleep, in microseconds
+     *
+     * \return bool  true if the full time elapsed, false if notified
+     */
+    bool waitFor( const uint32_t& micros );
+
+    /*!
+     * Sleep until notify( ), however long that takes.
+     */
+    void wait( );
+
+    /*!
+     * Wake every thread in waitFor( ), now and until reset( ).
+     */
+    void notify( );
+
+    /*!
+     * Clear a notify( ) so waitFor( ) sleeps again.
+     */
+    void reset( );
+
+    /*!
+     * \return bool  true between notify( ) and reset( )
+     */
+    bool isNotified( ) const;
+
+    /*!
+     * \return int  eventfd readable between notify( ) and reset( ), for
+     * loops that wait in poll( ) or epoll on other descriptors too
+     */
+    int getEventSocket( ) const;
+
+private:
+
+    /*!
+     * eventfd written by notify( ).
+     */
+    int eventSocket_;
+
+    /*!
+     * set by notify( ), cleared by reset( ).
+     */
+    std::atomic<bool> notified_;
+
+};
+
+#endif //EVENTWAITER_HPP
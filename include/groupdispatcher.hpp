@@ -0,0 +1,212 @@
+/*! \license
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * \copyright 2021 Dan Fernández
+ *
+ *
+ * \file Header for \p GroupDispatcher class.
+ *
+ * \author fdaniel, trice2
+ */
+
+#if !defined( GROUPDISPATCHER_HPP )
+#define GROUPDISPATCHER_HPP
+
+#include <array>
+#include <string>
+#include <functional>
+
+#include "requestparser.hpp"
+#include "templatehandler.hpp"
+
+constexpr auto DISPATCH_TABLE_SIZE = 64;            // slots; a power of two
+constexpr uint32_t DISPATCH_HASH_SEED = 2166136287u; // FNV-1a basis + 26
+
+
+/*!
+ * Handler for the body of one message group.
+ */
+typedef std::function< void( const RequestBody& ) > GroupHandler;
+
+
+/*!
+ * \brief Maps message groups to their handlers in constant time.
+ *
+ * Every group name in \p RD hashes to its own slot, which is checked at
+ * compile time, so a lookup is one hash and one string compare whether the
+ * group is known or not.  A new group needs its \p RD constant, an entry in
+ * the static_assert below, and an add( ) call with the schema of its body.
+ */
+class GroupDispatcher
+{
+
+public:
+
+    /*!
+     * Seeded FNV-1a hash of a group name.
+     *
+     * \param group  NUL-terminated group name
+     * \param hash  hash of the characters before \p group
+     *
+     * \return uint32_t  hash of the name
+     */
+    static constexpr uint32_t hash(
+            const char* group,
+            const uint32_t hash = DISPATCH_HASH_SEED )
+    {
+        return ( *group == '\0' )
+                ? hash
+                : GroupDispatcher::hash( group + 1, ( hash ^ (uint8_t)*group ) * 16777619u );
+    }
+
+    /*!
+     * \param group  NUL-terminated group name
+     *
+     * \return size_t  table slot of the group
+     */
+    static constexpr size_t slot( const char* group )
+    {
+        return hash( group ) & ( DISPATCH_TABLE_SIZE - 1 );
+    }
+
+    /*!
+     * Register the handler of a group, replacing any earlier one.
+     *
+     * \param group  one of the \p RD group names
+     * \param handler  called with the message body
+     * \param schema  fields of the message body; must outlive the dispatcher
+     *
+     * \return bool  false if the group shares its slot with another name
+     * and cannot be registered
+     */
+    bool add(
+            const char* group,
+            const GroupHandler& handler,
+            const RequestSchema& schema = NO_FIELDS );
+
+    /*!
+     * \param group  group name from the message header, not NUL-terminated
+     * \param length  length of \p group
+     *
+     * \return RequestSchema*  schema of the group's body; nullptr if no
+     * handler is registered for it
+     */
+    const RequestSchema* getSchema( const char* group, const size_t& length ) const;
+
+    /*!
+     * Call the handler of a group.
+     *
+     * \param group  group name from the message header, not NUL-terminated
+     * \param length  length of \p group
+     * \param body  message body, passed to the handler
+     *
+     * \return bool  false if no handler is registered for the group
+     */
+    bool dispatch( const char* group, const size_t& length, const RequestBody& body ) const;
+
+    /*!
+     * Fields of a body nobody reads.
+     */
+    static const RequestSchema NO_FIELDS;
+
+private:
+
+    /*!
+     * A registered group.
+     */
+    struct Entry
+    {
+        const char* group = nullptr;
+        const RequestSchema* schema = nullptr;
+        GroupHandler handler;
+    };
+
+    /*!
+     * \return Entry*  registered entry of the group; nullptr if none
+     */
+    const Entry* find_( const char* group, const size_t& length ) const;
+
+    /*!
+     * registered groups, indexed by slot( ).
+     */
+    std::array<Entry, DISPATCH_TABLE_SIZE> table_;
+
+};
+
+
+/*!
+ * \return bool  true if no value after \p slot equals it
+ */
+constexpr bool isSlotUnique( const size_t )
+{
+    return true;
+}
+
+template< typename... Slots >
+constexpr bool isSlotUnique( const size_t slot, const size_t first, const Slots... rest )
+{
+    return slot != first && isSlotUnique( slot, rest... );
+}
+
+/*!
+ * \return bool  true if all slots differ
+ */
+constexpr bool areSlotsUnique( )
+{
+    return true;
+}
+
+template< typename... Slots >
+constexpr bool areSlotsUnique( const size_t first, const Slots... rest )
+{
+    return isSlotUnique( first, rest... ) && areSlotsUnique( rest... );
+}
+
+// A clash means a new RD group needs another DISPATCH_HASH_SEED.
+static_assert( areSlotsUnique(
+        GroupDispatcher::slot( RD::GET_API_VERSION ),
+        GroupDispatcher::slot( RD::SEND_PIN ),
+        GroupDispatcher::slot( RD::MOBILE_INIT ),
+        GroupDispatcher::slot( RD::GET_THREAT_DATA ),
+        GroupDispatcher::slot( RD::LIST_MANEUVERS ),
+        GroupDispatcher::slot( RD::MANEUVER_INIT ),
+        GroupDispatcher::slot( RD::DEADMANS_HANDLE ),
+        GroupDispatcher::slot( RD::CANCEL_DRIVE_ON ),
+        GroupDispatcher::slot( RD::CANCEL_MANEUVER ),
+        GroupDispatcher::slot( RD::GET_CABIN_STATUS ),
+        GroupDispatcher::slot( RD::CABIN_COMMANDS ),
+        GroupDispatcher::slot( RD::MOBILE_RESPONSE ),
+        GroupDispatcher::slot( RD::HEARTBEAT ),
+        GroupDispatcher::slot( RD::SET_BODY_ENCODING ),
+        GroupDispatcher::slot( RD::VEHICLE_API_VERSION ),
+        GroupDispatcher::slot( RD::VEHICLE_STATUS ),
+        GroupDispatcher::slot( RD::VEHICLE_INIT ),
+        GroupDispatcher::slot( RD::THREAT_DATA ),
+        GroupDispatcher::slot( RD::AVAILABLE_MANEUVERS ),
+        GroupDispatcher::slot( RD::MANEUVER_STATUS ),
+        GroupDispatcher::slot( RD::MOBILE_CHALLENGE ),
+        GroupDispatcher::slot( RD::CABIN_STATUS ),
+        GroupDispatcher::slot( RD::BODY_ENCODING ),
+        GroupDispatcher::slot( RD::DEBUG ) ),
+        "RD group names collide in the dispatch table" );
+
+#endif //GROUPDISPATCHER_HPP
@@ -0,0 +1,138 @@
+/*! \license
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * \copyright 2021 Dan Fernández
+ *
+ *
+ * \file Header for \p LatencyHistogram class.
+ *
+ * \author fdaniel, trice2
+ */
+
+#if !defined( LATENCYHISTOGRAM_HPP )
+#define LATENCYHISTOGRAM_HPP
+
+#include <atomic>
+#include <string>
+#include <iostream>
+
+#include <time.h>
+#include <stdint.h>
+
+constexpr auto LATENCY_BUCKETS = 32;                // log2 buckets, microseconds
+
+
+/*!
+ * Lock-free latency histogram with power-of-two microsecond buckets.
+ *
+ * Bucket 0 counts samples below 1 us; bucket n counts samples in
+ * [ 2^(n-1), 2^n ) us.  record( ) may be called from any thread.
+ */
+class LatencyHistogram
+{
+
+public:
+
+    /*!
+     * Constructor.
+     */
+    LatencyHistogram( );
+
+    /*!
+     * \return uint64_t  CLOCK_REALTIME in nanoseconds, the clock used by
+     * SO_TIMESTAMPNS
+     */
+    static uint64_t now( );
+
+    /*!
+     * Add one sample.  Samples from a later start than end are dropped.
+     *
+     * \param startNs  start of the interval, from now( ) or a kernel stamp
+     * \param endNs  end of the interval
+     */
+    void record( const uint64_t& startNs, const uint64_t& endNs );
+
+    /*!
+     * \return uint64_t  samples recorded since the last reset( )
+     */
+    uint64_t getCount( ) const;
+
+    /*!
+     * \return uint64_t  largest sample, in microseconds
+     */
+    uint64_t getMax( ) const;
+
+    /*!
+     * Upper bound of the bucket holding the given percentile.
+     *
+     * \param percentile  0 to 100
+     *
+     * \return uint64_t  microseconds; 0 when empty
+     */
+    uint64_t getPercentile( const double& percentile ) const;
+
+    /*!
+     * \param bucket  bucket index, below LATENCY_BUCKETS
+     *
+     * \return uint64_t  samples in the bucket
+     */
+    uint64_t getBucket( const int& bucket ) const;
+
+    /*!
+     * Add every sample of another histogram to this one.
+     *
+     * \param other  histogram to add
+     */
+    void merge( const LatencyHistogram& other );
+
+    /*!
+     * Clear all samples.
+     */
+    void reset( );
+
+    /*!
+     * Print count, p50, p99 and max under the given name.
+     *
+     * \param name  label for the report
+     */
+    void print( const std::string& name ) const;
+
+private:
+
+    /*!
+     * sample counts per bucket.
+     */
+    std::atomic<uint64_t> buckets_[ LATENCY_BUCKETS ];
+
+    /*!
+     * total samples.
+     */
+    std::atomic<uint64_t> count_;
+
+    /*!
+     * largest sample in microseconds.
+     */
+    std::atomic<uint64_t> max_;
+
+};
+
+#endif //LATENCYHISTOGRAM_HPP
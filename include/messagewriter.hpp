@@ -0,0 +1,408 @@
+/*! \license
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * \copyright 2021 Dan Fernández
+ *
+ *
+ * \file Header for \p MessageWriter class.
+ *
+ * \author fdaniel, trice2
+ */
+
+#if !defined( MESSAGEWRITER_HPP )
+#define MESSAGEWRITER_HPP
+
+#include <string>
+
+#include "constants.h"
+
+constexpr auto VEHICLE_STATUS_COUNT = 9;
+constexpr auto AVAILABLE_MANEUVER_COUNT = 15;
+constexpr auto THREAT_SEGMENT_COUNT = 32;
+
+
+/*!
+ * Text sent for each status signal value, indexed by the value of the signal.
+ */
+constexpr const char* MANEUVER_STATUS_TEXT[] =
+{
+    "NotActive",
+    "Scanning",
+    "Selecting",
+    "Confirming",
+    "Manoeuvring",
+    "Interrupted",
+    "Finishing",
+    "Ended",
+    "RCStartStop",
+    "Holding",
+    "Cancelled",
+    "RESERVED4",
+    "RESERVED3",
+    "RESERVED2",
+    "RESERVED1",
+    "RESERVED"
+};
+
+constexpr const char* NO_FEATURE_AVAILABLE_MSG_TEXT[] =
+{
+    "None",
+    "NotAvailableSystemFault",
+    "NotAvailableSensorBlocked",
+    "NotAvailableVehicleNotStarted",
+    "NotAvailableTiltTooStrong",
+    "NotAvailableTrailerConnected",
+    "NotAvailableRideHeight",
+    "NotAvailableSpeedToohigh",
+    "NotAvailableATPC",
+    "NotAvailableTowAssistOn",
+    "NotAvailableWadeAssistOn",
+    "NotAvailableACCOn",
+    "NotAvailableTJPOn",
+    "NotAvailableVehicleOnMotorway",
+    "Reserved2",
+    "Reserved1"
+};
+
+constexpr const char* CANCEL_MSG_TEXT[] =
+{
+    "None",
+    "CancelledFromLossOfTraction",
+    "CancelledMaxNumMovesReached",
+    "CancelledPausedForTooLong",
+    "CancelledInternalSystemFailure",
+    "CancelledTrailerConnected",
+    "ManoeuvreCancelledDriverRequest",
+    "ManoeuvreCancelledVehicleDrivenOn",
+    "CancelledSpeedTooHigh",
+    "CancelledVehicleInMotorway",
+    "Reserved6",
+    "Reserved5",
+    "Reserved4",
+    "Reserved3",
+    "Reserved2",
+    "Reserved1"
+};
+
+constexpr const char* PAUSE_MSG_1_TEXT[] =
+{
+    "None",
+    "PausedDriverReq",
+    "PausedSteeringIntervention",
+    "PausedManualGearChange",
+    "PausedDriverBraked",
+    "PausedParkBrake",
+    "PausedAcceleratorPressed",
+    "PausedEngineStalled",
+    "PausedDoorOpen",
+    "PausedBootOpen",
+    "PausedBonnetOpen",
+    "PausedObstacleDetected",
+    "PauseRideHeightChanged",
+    "PausedSensorPerformance",
+    "RemoteCommunicationLost",
+    "PausedPowerLow"
+};
+
+constexpr const char* PAUSE_MSG_2_TEXT[] =
+{
+    "None",
+    "ActivityKeyInVehicle",
+    "ActivityKeyOutsideLegalDistance",
+    "ActivityKeyDistanceIndeterminate",
+    "ActivityKeyMissing",
+    "MaximumDistanceReached",
+    "MaximumDurationForOperationReached",
+    "ApplicationCRCFailure",
+    "ChallengeResponseMismatch",
+    "DMHInvalid",
+    "TemporarySystemFailure"
+};
+
+constexpr const char* INFO_MSG_TEXT[] =
+{
+    "None",
+    "SearchingForSpaces",
+    "SlowDownSearchForSpaces",
+    "SlowDownViewSpaces",
+    "DriveForwardSpaceSearch",
+    "MoveSuspensionToNormalHeight",
+    "SpaceTooSmall",
+    "NarrowSpaceAvailableThroughRemoteOnly",
+    "SpaceOccupied",
+    "CantManeuverIntoSpace",
+    "BringVehicleToRestAndApplyBrake",
+    "ConfirmAndReleaseBrakeToStart",
+    "ReleaseBrakeToStart",
+    "MoveIndicatorToChangeSelectionSide",
+    "NoAvailableParkOut",
+    "NotEnoughSpaceToParkOut",
+    "SelectParkOutManeuver",
+    "RemoteDeviceConnectedAndReady",
+    "RemoteDeviceBatteryTooLow",
+    "RemoteManeuverReady",
+    "DriverMustBeOutsideOfVehicle",
+    "PowerReservesLow",
+    "MindOtherRoadUsersDisclaimer",
+    "EngageReverseToStartManeuver",
+    "ApproachingLegalDistanceLimit",
+    "ApproachingMaximumDistance",
+    "ApproachingMaximumDistanceForOperation"
+};
+
+constexpr const char* INSTRUCT_MSG_TEXT[] =
+{
+    "None",
+    "BringVehicleToRest",
+    "ReleaseBrakesToStart",
+    "SelectR",
+    "SelectD",
+    "SelectFirstGear",
+    "DeselctRtoDisplaySpaces",
+    "DriveForward",
+    "ContinueForward",
+    "DriveBackward",
+    "ContinueBackward",
+    "Stop",
+    "EngageParkBrake",
+    "MonitorManouevreInProgress",
+    "RemoteManouevreInProgress",
+    "VehicleStopping",
+    "VehicleStopped",
+    "SystemOperationRestrictedCapabilityReached",
+    "SystemOperationRestrictedOccupantMovement",
+    "PressAcceleratorToResume",
+    "PauseManuouevre",
+    "PowerReservesLow",
+    "MindOtherRoadUsersDisclaimer",
+    "EngageReverseToStartManeuver",
+    "ApproachingLegalDistanceLimit",
+    "ApproachingMaximumDistance",
+    "ApproachingMaximumDistanceForOperation"
+};
+
+constexpr const char* ACKNOWLEDGE_REMOTE_PIN_TEXT[] =
+{
+    "None",
+    "IncorrectPIN",
+    "IncorrectPIN3xLock60s",
+    "IncorrectPIN3xLock300s",
+    "IncorrectPIN3xLock3600s",
+    "IncorrectPIN3xLockIndefinite",
+    "ExpiredPIN",
+    "NotSetInDCM",
+    "CorrectPIN"
+};
+
+constexpr const char* ERROR_MSG_TEXT[] =
+{
+    "None",
+    "ElectricChargerConnected",
+    "StolenVehicleTrackingAlert",
+    "RemoteStartMaxAttemptsReached",
+    "VehicleCrashDetected",
+    "LowFuelWarning",
+    "ErrorFromCCM",
+    "MultipleKeyFobsDetected",
+    "LowBatteryWarning",
+    "RemoteSessionExpirationWarning",
+    "Reserved9",
+    "Reserved8",
+    "Reserved7",
+    "Reserved6",
+    "Reserved5",
+    "Reserved4",
+    "Reserved3",
+    "Reserved2",
+    "Reserved1",
+    "Reserved0",
+    "WiFiAdvertisingTimeoutIn30sec",
+    "WiFiAdvertisingTimeoutIn1min",
+    "WiFiAdvertisingTimeoutIn2min",
+    "WiFiAdvertisingTimeoutIn3min",
+    "WiFiAdvertisingTimeoutIn4min",
+    "WiFiAdvertisingTimeoutIn5min"
+};
+
+/*!
+ * Maneuvers offered in an available_maneuvers message, in the order their
+ * keys are serialized.
+ */
+enum class AvailableManeuver : uint8_t
+{
+    InLftFwd = 0,
+    InLftRvs = 1,
+    InRgtFwd = 2,
+    InRgtRvs = 3,
+    NdgFwd = 4,
+    NdgRvs = 5,
+    OutLftFwd = 6,
+    OutLftPrl = 7,
+    OutLftRvs = 8,
+    OutRgtFwd = 9,
+    OutRgtPrl = 10,
+    OutRgtRvs = 11,
+    RtnToOgn = 12,
+    StrFwd = 13,
+    StrRvs = 14
+};
+
+constexpr const char* AVAILABLE_MANEUVER_NAMES[] =
+{
+    "InLftFwd",
+    "InLftRvs",
+    "InRgtFwd",
+    "InRgtRvs",
+    "NdgFwd",
+    "NdgRvs",
+    "OutLftFwd",
+    "OutLftPrl",
+    "OutLftRvs",
+    "OutRgtFwd",
+    "OutRgtPrl",
+    "OutRgtRvs",
+    "RtnToOgn",
+    "StrFwd",
+    "StrRvs"
+};
+
+
+/*!
+ * One status_Nxx entry of a vehicle_status message.
+ */
+struct StatusEntry
+{
+    int code;               //!< status prefix plus signal value
+    const char* text;       //!< text of the signal value
+};
+
+
+/*!
+ * \brief Serializes fixed-schema outbound message bodies without a DOM.
+ *
+ * Each writer appends the compact JSON text of one message type to a caller
+ * owned buffer, byte for byte what nlohmann::json::dump( ) produces for the
+ * matching template: keys in sorted order, no whitespace.  Reusing the buffer
+ * keeps the steady state free of allocations.
+ */
+class MessageWriter
+{
+
+public:
+
+    /*!
+     * \param prefix  status group of the signal
+     * \param value  integer value of the signal
+     *
+     * \return const char*  text of the value; "InvalidSig" if out of range
+     */
+    static const char* getStatusText( const VehicleStatusPrefix& prefix, const int& value );
+
+    /*!
+     * Append a message header, {"group":...}.
+     *
+     * \param group  message group
+     * \param out  buffer to append to
+     */
+    static void writeHeader( const std::string& group, std::string& out );
+
+    /*!
+     * Append a vehicle_status body.
+     *
+     * \param status  status_1xx through status_9xx
+     * \param out  buffer to append to
+     */
+    static void writeVehicleStatus(
+            const StatusEntry ( &status )[ VEHICLE_STATUS_COUNT ],
+            std::string& out );
+
+    /*!
+     * Append a maneuver_status body.
+     *
+     * \param maneuver  maneuver name
+     * \param progress  maneuver progress
+     * \param status  prefixed maneuver status code
+     * \param out  buffer to append to
+     */
+    static void writeManeuverStatus(
+            const std::string& maneuver,
+            const int& progress,
+            const int& status,
+            std::string& out );
+
+    /*!
+     * Append a cabin_status body.  Door states are not reported by the
+     * vehicle and are always false.
+     *
+     * \param engineOff  power_status
+     * \param doorsLocked  lock_status
+     * \param out  buffer to append to
+     */
+    static void writeCabinStatus(
+            const bool& engineOff,
+            const bool& doorsLocked,
+            std::string& out );
+
+    /*!
+     * Append an available_maneuvers body.
+     *
+     * \param defaultManeuver  default maneuver name
+     * \param continueExploring  continue_exploring flag
+     * \param offered  offered flags, indexed by \p AvailableManeuver
+     * \param out  buffer to append to
+     */
+    static void writeAvailableManeuvers(
+            const std::string& defaultManeuver,
+            const bool& continueExploring,
+            const bool ( &offered )[ AVAILABLE_MANEUVER_COUNT ],
+            std::string& out );
+
+    /*!
+     * Append a threat_data body.
+     *
+     * \param threats  distance per segment, clockwise from the driver door
+     * \param out  buffer to append to
+     */
+    static void writeThreatData(
+            const uint8_t ( &threats )[ THREAT_SEGMENT_COUNT ],
+            std::string& out );
+
+private:
+
+    /*!
+     * Append a quoted, escaped string.
+     */
+    static void writeString_( const char* value, std::string& out );
+
+    /*!
+     * Append a decimal integer.
+     */
+    static void writeInt_( const int& value, std::string& out );
+
+    /*!
+     * Append true or false.
+     */
+    static void writeBool_( const bool& value, std::string& out );
+
+};
+
+#endif //MESSAGEWRITER_HPP
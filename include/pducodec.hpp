@@ -0,0 +1,247 @@
+/*! \license
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * \copyright 2021 Dan Fernández
+ *
+ *
+ * \file Header for \p PduCodec class.
+ *
+ * \author fdaniel, trice2
+ */
+
+#if !defined( PDUCODEC_HPP )
+#define PDUCODEC_HPP
+
+#include <cstdint>
+#include <cstring>
+
+
+/*!
+ * One signal of a PDU payload, as listed in its lm_signal_t table.
+ *
+ * \tparam ID    signal ID from constants.h; negative IDs mark unused bits
+ * \tparam BITS  width of the signal in the bitstream
+ */
+template <int ID, unsigned BITS>
+struct PduSignal
+{
+    static_assert( BITS > 0 && BITS <= 64, "PDU signals are 1 to 64 bits wide" );
+
+    static constexpr int id = ID;           //!< index into the value array
+    static constexpr unsigned bits = BITS;  //!< width in bits
+};
+
+template <int ID, unsigned BITS>
+constexpr int PduSignal<ID, BITS>::id;
+
+template <int ID, unsigned BITS>
+constexpr unsigned PduSignal<ID, BITS>::bits;
+
+/*!
+ * Closes the signal list given to \p PduCodec.
+ */
+struct PduEnd
+{
+
+};
+
+
+namespace pdu_detail
+{
+
+/*!
+ * Low \p bits bits set.
+ */
+constexpr uint64_t mask( unsigned bits )
+{
+    return ( bits >= 64 ) ? ~(uint64_t)0 : ( ( (uint64_t)1 << bits ) - 1 );
+}
+
+/*!
+ * Moves a value right by SHIFT bits, or left when SHIFT is negative.
+ */
+template <int SHIFT, bool RIGHT = ( SHIFT >= 0 )>
+struct Shift
+{
+    static uint64_t right( uint64_t value ) { return value >> SHIFT; }
+    static uint64_t left( uint64_t value ) { return value << SHIFT; }
+};
+
+template <int SHIFT>
+struct Shift<SHIFT, false>
+{
+    static uint64_t right( uint64_t value ) { return value << -SHIFT; }
+    static uint64_t left( uint64_t value ) { return value >> -SHIFT; }
+};
+
+/*!
+ * Payload bytes BYTE..LAST of a signal whose last bit is bit END - 1 of the
+ * payload.  Bits run MSB first, so in byte BYTE the signal is shifted by
+ * END - 8 * BYTE - 8.
+ */
+template <unsigned END, unsigned BYTE, unsigned LAST, bool DONE = ( BYTE > LAST )>
+struct Bytes
+{
+    typedef Shift<(int)END - 8 * (int)BYTE - 8> At;
+
+    static void put( uint64_t value, uint8_t* payload )
+    {
+        payload[ BYTE ] |= (uint8_t)At::right( value );
+        Bytes<END, BYTE + 1, LAST>::put( value, payload );
+    }
+
+    static uint64_t get( const uint8_t* payload )
+    {
+        return At::left( payload[ BYTE ] ) | Bytes<END, BYTE + 1, LAST>::get( payload );
+    }
+};
+
+template <unsigned END, unsigned BYTE, unsigned LAST>
+struct Bytes<END, BYTE, LAST, true>
+{
+    static void put( uint64_t, uint8_t* ) { }
+    static uint64_t get( const uint8_t* ) { return 0; }
+};
+
+/*!
+ * One signal starting OFFSET bits into the payload.
+ */
+template <unsigned OFFSET, typename SIGNAL, bool UNUSED = ( SIGNAL::id < 0 )>
+struct Field
+{
+    static constexpr unsigned END = OFFSET + SIGNAL::bits;
+
+    typedef Bytes<END, OFFSET / 8, ( END - 1 ) / 8> Span;
+
+    static void put( const uint64_t* values, uint8_t* payload )
+    {
+        Span::put( values[ SIGNAL::id ] & mask( SIGNAL::bits ), payload );
+    }
+
+    static void get( const uint8_t* payload, uint64_t* values )
+    {
+        values[ SIGNAL::id ] = Span::get( payload ) & mask( SIGNAL::bits );
+    }
+};
+
+template <unsigned OFFSET, typename SIGNAL>
+struct Field<OFFSET, SIGNAL, true>
+{
+    static void put( const uint64_t*, uint8_t* ) { }
+    static void get( const uint8_t*, uint64_t* ) { }
+};
+
+/*!
+ * Signals from OFFSET bits into the payload up to \p PduEnd.
+ */
+template <unsigned OFFSET, typename SIGNAL, typename... REST>
+struct Fields
+{
+    typedef Field<OFFSET, SIGNAL> Head;
+    typedef Fields<OFFSET + SIGNAL::bits, REST...> Tail;
+
+    static constexpr unsigned END = Tail::END;
+
+    static void put( const uint64_t* values, uint8_t* payload )
+    {
+        Head::put( values, payload );
+        Tail::put( values, payload );
+    }
+
+    static void get( const uint8_t* payload, uint64_t* values )
+    {
+        Head::get( payload, values );
+        Tail::get( payload, values );
+    }
+};
+
+template <unsigned OFFSET>
+struct Fields<OFFSET, PduEnd>
+{
+    static constexpr unsigned END = OFFSET;
+
+    static void put( const uint64_t*, uint8_t* ) { }
+    static void get( const uint8_t*, uint64_t* ) { }
+};
+
+}
+
+
+/*!
+ * \brief Packs and unpacks one PDU payload with a layout fixed at compile time.
+ *
+ * The signal list gives the order and width of each signal in the payload, so
+ * every bit offset, shift and mask is a constant and encode( ) / decode( )
+ * compile to straight-line loads, shifts and stores with no per-signal loop or
+ * switch.  Values are exchanged through an array indexed by signal ID, so
+ * callers fill and read it with the enums in constants.h.  Values wider than
+ * their signal are masked to fit.
+ *
+ * \tparam SIGNALS  \p PduSignal types in payload order, ending with \p PduEnd
+ */
+template <typename... SIGNALS>
+class PduCodec
+{
+
+    typedef pdu_detail::Fields<0, SIGNALS...> Layout;
+
+public:
+
+    static constexpr unsigned BITS = Layout::END;   //!< payload length in bits
+    static constexpr unsigned BYTES = BITS / 8;     //!< payload length in bytes
+
+    static_assert( BITS % 8 == 0, "PDU payload must end on a byte boundary" );
+
+    /*!
+     * Write every signal into the payload.
+     *
+     * \param values   signal values indexed by signal ID
+     * \param payload  BYTES bytes, overwritten
+     */
+    static void encode( const uint64_t* values, uint8_t* payload )
+    {
+        memset( payload, 0, BYTES );
+        Layout::put( values, payload );
+    }
+
+    /*!
+     * Read every signal out of the payload.  Entries of unused bits and of IDs
+     * not in the PDU are left untouched.
+     *
+     * \param payload  BYTES bytes
+     * \param values   signal values indexed by signal ID
+     */
+    static void decode( const uint8_t* payload, uint64_t* values )
+    {
+        Layout::get( payload, values );
+    }
+
+};
+
+template <typename... SIGNALS>
+constexpr unsigned PduCodec<SIGNALS...>::BITS;
+
+template <typename... SIGNALS>
+constexpr unsigned PduCodec<SIGNALS...>::BYTES;
+
+
+#endif //PDUCODEC_HPP
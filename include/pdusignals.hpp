@@ -0,0 +1,380 @@
+/*! \license
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * \copyright 2021 Dan Fernández
+ *
+ *
+ * \file Signal layout of each PDU exchanged with the ASPM.
+ *
+ * \author fdaniel, trice2
+ */
+
+#if !defined( PDUSIGNALS_HPP )
+#define PDUSIGNALS_HPP
+
+#include "constants.h"
+#include "pducodec.hpp"
+
+
+/*
+ * Each list below names the signals of one PDU in the order they are packed,
+ * as X( namespace, signal, bits ).  SignalHandler builds its lm_signal_t
+ * tables from these lists and the PduCodec typedefs at the bottom are built
+ * from the same lists, so the two cannot drift apart.
+ */
+
+/*!
+ * Signals of the TCM_LM PDU, in payload order.
+ */
+#define TCM_LM_SIGNALS( X ) \
+    X( TCM_LM, AppCalcCheck, 16 ) \
+    X( TCM_LM, LMDviceAliveCntRMT, 4 ) \
+    X( TCM_LM, ManeuverEnableInput, 2 ) \
+    X( TCM_LM, ManeuverGearSelect, 2 ) \
+    X( TCM_LM, NudgeSelect, 2 ) \
+    X( TCM_LM, RCDOvrrdReqRMT, 2 ) \
+    X( TCM_LM, AppSliderPosY, 12 ) \
+    X( TCM_LM, AppSliderPosX, 11 ) \
+    X( TCM_LM, RCDSpeedChngReqRMT, 6 ) \
+    X( TCM_LM, RCDSteWhlChngReqRMT, 10 ) \
+    X( TCM_LM, ConnectionApproval, 2 ) \
+    X( TCM_LM, ManeuverButtonPress, 3 ) \
+    X( TCM_LM, DeviceControlMode, 4 ) \
+    X( TCM_LM, ManeuverTypeSelect, 2 ) \
+    X( TCM_LM, ManeuverDirectionSelect, 2 ) \
+    X( TCM_LM, ExploreModeSelect, 1 ) \
+    X( TCM_LM, RemoteDeviceBatteryLevel, 7 ) \
+    X( TCM_LM, PairedWKeyId, 8 ) \
+    X( TCM_LM, ManeuverSideSelect, 2 ) \
+    X( TCM_LM, LMDviceRngeDistRMT, 10 ) \
+    X( TCM_LM, TTTTTTTTTT, 4 ) \
+    X( TCM_LM, LMRemoteChallengeVDC, 64 ) \
+    X( TCM_LM, MobileChallengeReply, 64 )
+
+/*!
+ * Signals of the TCM_LM_Session PDU, in payload order.
+ */
+#define TCM_LM_SESSION_SIGNALS( X ) \
+    X( TCM_LM_Session, LMEncrptSessionCntVDC_1, 64 ) \
+    X( TCM_LM_Session, LMEncrptSessionCntVDC_2, 64 ) \
+    X( TCM_LM_Session, LMEncryptSessionIDVDC_1, 64 ) \
+    X( TCM_LM_Session, LMEncryptSessionIDVDC_2, 64 ) \
+    X( TCM_LM_Session, LMTruncMACVDC, 64 ) \
+    X( TCM_LM_Session, LMTruncSessionCntVDC, 8 ) \
+    X( TCM_LM_Session, LMSessionControlVDC, 3 ) \
+    X( TCM_LM_Session, LMSessionControlVDCExt, 5 )
+
+/*!
+ * Signals of the TCM_RemoteControl PDU, in payload order.
+ */
+#define TCM_REMOTECONTROL_SIGNALS( X ) \
+    X( TCM_RemoteControl, TCMRemoteControl, 64 )
+
+/*!
+ * Signals of the TCM_TransportKey PDU, in payload order.
+ */
+#define TCM_TRANSPORTKEY_SIGNALS( X ) \
+    X( TCM_TransportKey, LMSessionKeyIDVDC, 16 ) \
+    X( TCM_TransportKey, LMHashEnTrnsportKeyVDC, 16 ) \
+    X( TCM_TransportKey, LMEncTransportKeyVDC_1, 64 ) \
+    X( TCM_TransportKey, LMEncTransportKeyVDC_2, 64 )
+
+/*!
+ * Signals of the TCM_LM_App PDU, in payload order.
+ */
+#define TCM_LM_APP_SIGNALS( X ) \
+    X( TCM_LM_App, LMAppTimeStampRMT, 64 ) \
+    X( TCM_LM_App, AppAccelerationX, 64 ) \
+    X( TCM_LM_App, AppAccelerationY, 64 ) \
+    X( TCM_LM_App, AppAccelerationZ, 64 )
+
+/*!
+ * Signals of the TCM_LM_KeyID PDU, in payload order.
+ */
+#define TCM_LM_KEYID_SIGNALS( X ) \
+    X( TCM_LM_KeyID, NOT_USED_ONE_BIT, 1 ) \
+    X( TCM_LM_KeyID, LMRotKeyChkACKVDC, 3 ) \
+    X( TCM_LM_KeyID, LMSessionKeyIDVDCExt, 4 )
+
+/*!
+ * Signals of the TCM_LM_KeyAlpha PDU, in payload order.
+ */
+#define TCM_LM_KEYALPHA_SIGNALS( X ) \
+    X( TCM_LM_KeyAlpha, LMHashEnRotKeyAlphaVDC, 16 ) \
+    X( TCM_LM_KeyAlpha, LMEncRotKeyAlphaVDC_1, 64 ) \
+    X( TCM_LM_KeyAlpha, LMEncRotKeyAlphaVDC_2, 64 )
+
+/*!
+ * Signals of the TCM_LM_KeyBeta PDU, in payload order.
+ */
+#define TCM_LM_KEYBETA_SIGNALS( X ) \
+    X( TCM_LM_KeyBeta, LMHashEncRotKeyBetaVDC, 16 ) \
+    X( TCM_LM_KeyBeta, LMEncRotKeyBetaVDC_1, 64 ) \
+    X( TCM_LM_KeyBeta, LMEncRotKeyBetaVDC_2, 64 )
+
+/*!
+ * Signals of the TCM_LM_KeyGamma PDU, in payload order.
+ */
+#define TCM_LM_KEYGAMMA_SIGNALS( X ) \
+    X( TCM_LM_KeyGamma, LMHashEncRotKeyGamaVDC, 16 ) \
+    X( TCM_LM_KeyGamma, LMEncRotKeyGammaVDC_1, 64 ) \
+    X( TCM_LM_KeyGamma, LMEncRotKeyGammaVDC_2, 64 )
+
+/*!
+ * Signals of the ASPM_LM PDU, in payload order.
+ */
+#define ASPM_LM_SIGNALS( X ) \
+    X( ASPM_LM, LMAppConsChkASPM, 16 ) \
+    X( ASPM_LM, ActiveAutonomousFeature, 4 ) \
+    X( ASPM_LM, CancelAvailability, 2 ) \
+    X( ASPM_LM, ConfirmAvailability, 2 ) \
+    X( ASPM_LM, LongitudinalAdjustAvailability, 2 ) \
+    X( ASPM_LM, ManeuverDirectionAvailability, 2 ) \
+    X( ASPM_LM, ManeuverSideAvailability, 2 ) \
+    X( ASPM_LM, ActiveManeuverOrientation, 2 ) \
+    X( ASPM_LM, ActiveParkingMode, 2 ) \
+    X( ASPM_LM, DirectionChangeAvailability, 2 ) \
+    X( ASPM_LM, ParkTypeChangeAvailability, 2 ) \
+    X( ASPM_LM, ExploreModeAvailability, 2 ) \
+    X( ASPM_LM, ActiveManeuverSide, 2 ) \
+    X( ASPM_LM, ManeuverStatus, 4 ) \
+    X( ASPM_LM, RemoteDriveOverrideState, 2 ) \
+    X( ASPM_LM, ActiveParkingType, 3 ) \
+    X( ASPM_LM, ResumeAvailability, 2 ) \
+    X( ASPM_LM, ReturnToStartAvailability, 2 ) \
+    X( ASPM_LM, NNNNNNNNNN, 2 ) \
+    X( ASPM_LM, KeyFobRange, 3 ) \
+    X( ASPM_LM, LMDviceAliveCntAckRMT, 4 ) \
+    X( ASPM_LM, NoFeatureAvailableMsg, 4 ) \
+    X( ASPM_LM, LMFrwdCollSnsType1RMT, 1 ) \
+    X( ASPM_LM, LMFrwdCollSnsType2RMT, 1 ) \
+    X( ASPM_LM, LMFrwdCollSnsType3RMT, 1 ) \
+    X( ASPM_LM, LMFrwdCollSnsType4RMT, 1 ) \
+    X( ASPM_LM, LMFrwdCollSnsZone1RMT, 4 ) \
+    X( ASPM_LM, LMFrwdCollSnsZone2RMT, 4 ) \
+    X( ASPM_LM, LMFrwdCollSnsZone3RMT, 4 ) \
+    X( ASPM_LM, LMFrwdCollSnsZone4RMT, 4 ) \
+    X( ASPM_LM, InfoMsg, 6 ) \
+    X( ASPM_LM, InstructMsg, 5 ) \
+    X( ASPM_LM, LateralControlInfo, 3 ) \
+    X( ASPM_LM, LongitudinalAdjustLength, 10 ) \
+    X( ASPM_LM, LongitudinalControlInfo, 3 ) \
+    X( ASPM_LM, ManeuverAlignmentAvailability, 3 ) \
+    X( ASPM_LM, RemoteDriveAvailability, 2 ) \
+    X( ASPM_LM, PauseMsg2, 4 ) \
+    X( ASPM_LM, PauseMsg1, 4 ) \
+    X( ASPM_LM, LMRearCollSnsType1RMT, 1 ) \
+    X( ASPM_LM, LMRearCollSnsType2RMT, 1 ) \
+    X( ASPM_LM, LMRearCollSnsType3RMT, 1 ) \
+    X( ASPM_LM, LMRearCollSnsType4RMT, 1 ) \
+    X( ASPM_LM, LMRearCollSnsZone1RMT, 4 ) \
+    X( ASPM_LM, LMRearCollSnsZone2RMT, 4 ) \
+    X( ASPM_LM, LMRearCollSnsZone3RMT, 4 ) \
+    X( ASPM_LM, LMRearCollSnsZone4RMT, 4 ) \
+    X( ASPM_LM, LMRemoteFeatrReadyRMT, 2 ) \
+    X( ASPM_LM, CancelMsg, 4 ) \
+    X( ASPM_LM, LMVehMaxRmteVLimRMT, 6 ) \
+    X( ASPM_LM, ManueverPopupDisplay, 1 ) \
+    X( ASPM_LM, ManeuverProgressBar, 7 ) \
+    X( ASPM_LM, MobileChallengeSend, 64 ) \
+    X( ASPM_LM, LMRemoteResponseASPM, 64 )
+
+/*!
+ * Signals of the ASPM_LM_ObjSegment PDU, in payload order.
+ */
+#define ASPM_LM_OBJSEGMENT_SIGNALS( X ) \
+    X( ASPM_LM_ObjSegment, ASPMXXXXX, 1 ) \
+    X( ASPM_LM_ObjSegment, ASPMFrontSegType1RMT, 2 ) \
+    X( ASPM_LM_ObjSegment, ASPMFrontSegDist1RMT, 5 ) \
+    X( ASPM_LM_ObjSegment, ASPMXXXXX, 1 ) \
+    X( ASPM_LM_ObjSegment, ASPMFrontSegType2RMT, 2 ) \
+    X( ASPM_LM_ObjSegment, ASPMFrontSegDist2RMT, 5 ) \
+    X( ASPM_LM_ObjSegment, ASPMXXXXX, 1 ) \
+    X( ASPM_LM_ObjSegment, ASPMFrontSegType3RMT, 2 ) \
+    X( ASPM_LM_ObjSegment, ASPMFrontSegDist3RMT, 5 ) \
+    X( ASPM_LM_ObjSegment, ASPMXXXXX, 1 ) \
+    X( ASPM_LM_ObjSegment, ASPMFrontSegType4RMT, 2 ) \
+    X( ASPM_LM_ObjSegment, ASPMFrontSegDist4RMT, 5 ) \
+    X( ASPM_LM_ObjSegment, ASPMXXXXX, 1 ) \
+    X( ASPM_LM_ObjSegment, ASPMFrontSegType5RMT, 2 ) \
+    X( ASPM_LM_ObjSegment, ASPMFrontSegDist5RMT, 5 ) \
+    X( ASPM_LM_ObjSegment, ASPMXXXXX, 1 ) \
+    X( ASPM_LM_ObjSegment, ASPMFrontSegType6RMT, 2 ) \
+    X( ASPM_LM_ObjSegment, ASPMFrontSegDist6RMT, 5 ) \
+    X( ASPM_LM_ObjSegment, ASPMXXXXX, 1 ) \
+    X( ASPM_LM_ObjSegment, ASPMFrontSegType7RMT, 2 ) \
+    X( ASPM_LM_ObjSegment, ASPMFrontSegDist7RMT, 5 ) \
+    X( ASPM_LM_ObjSegment, ASPMXXXXX, 1 ) \
+    X( ASPM_LM_ObjSegment, ASPMFrontSegType8RMT, 2 ) \
+    X( ASPM_LM_ObjSegment, ASPMFrontSegDist8RMT, 5 ) \
+    X( ASPM_LM_ObjSegment, ASPMXXXXX, 1 ) \
+    X( ASPM_LM_ObjSegment, ASPMFrontSegType9RMT, 2 ) \
+    X( ASPM_LM_ObjSegment, ASPMFrontSegDist9RMT, 5 ) \
+    X( ASPM_LM_ObjSegment, ASPMXXXXX, 1 ) \
+    X( ASPM_LM_ObjSegment, ASPMFrontSegType10RMT, 2 ) \
+    X( ASPM_LM_ObjSegment, ASPMFrontSegDist10RMT, 5 ) \
+    X( ASPM_LM_ObjSegment, ASPMXXXXX, 1 ) \
+    X( ASPM_LM_ObjSegment, ASPMFrontSegType11RMT, 2 ) \
+    X( ASPM_LM_ObjSegment, ASPMFrontSegDist11RMT, 5 ) \
+    X( ASPM_LM_ObjSegment, ASPMXXXXX, 1 ) \
+    X( ASPM_LM_ObjSegment, ASPMFrontSegType12RMT, 2 ) \
+    X( ASPM_LM_ObjSegment, ASPMFrontSegDist12RMT, 5 ) \
+    X( ASPM_LM_ObjSegment, ASPMXXXXX, 1 ) \
+    X( ASPM_LM_ObjSegment, ASPMFrontSegType13RMT, 2 ) \
+    X( ASPM_LM_ObjSegment, ASPMFrontSegDist13RMT, 5 ) \
+    X( ASPM_LM_ObjSegment, ASPMXXXXX, 1 ) \
+    X( ASPM_LM_ObjSegment, ASPMFrontSegType14RMT, 2 ) \
+    X( ASPM_LM_ObjSegment, ASPMFrontSegDist14RMT, 5 ) \
+    X( ASPM_LM_ObjSegment, ASPMXXXXX, 1 ) \
+    X( ASPM_LM_ObjSegment, ASPMFrontSegType15RMT, 2 ) \
+    X( ASPM_LM_ObjSegment, ASPMFrontSegDist15RMT, 5 ) \
+    X( ASPM_LM_ObjSegment, ASPMXXXXX, 1 ) \
+    X( ASPM_LM_ObjSegment, ASPMFrontSegType16RMT, 2 ) \
+    X( ASPM_LM_ObjSegment, ASPMFrontSegDist16RMT, 5 ) \
+    X( ASPM_LM_ObjSegment, ASPMXXXXX, 1 ) \
+    X( ASPM_LM_ObjSegment, ASPMRearSegType1RMT, 2 ) \
+    X( ASPM_LM_ObjSegment, ASPMRearSegDist1RMT, 5 ) \
+    X( ASPM_LM_ObjSegment, ASPMXXXXX, 1 ) \
+    X( ASPM_LM_ObjSegment, ASPMRearSegType2RMT, 2 ) \
+    X( ASPM_LM_ObjSegment, ASPMRearSegDist2RMT, 5 ) \
+    X( ASPM_LM_ObjSegment, ASPMXXXXX, 1 ) \
+    X( ASPM_LM_ObjSegment, ASPMRearSegType3RMT, 2 ) \
+    X( ASPM_LM_ObjSegment, ASPMRearSegDist3RMT, 5 ) \
+    X( ASPM_LM_ObjSegment, ASPMXXXXX, 1 ) \
+    X( ASPM_LM_ObjSegment, ASPMRearSegType4RMT, 2 ) \
+    X( ASPM_LM_ObjSegment, ASPMRearSegDist4RMT, 5 ) \
+    X( ASPM_LM_ObjSegment, ASPMXXXXX, 1 ) \
+    X( ASPM_LM_ObjSegment, ASPMRearSegType5RMT, 2 ) \
+    X( ASPM_LM_ObjSegment, ASPMRearSegDist5RMT, 5 ) \
+    X( ASPM_LM_ObjSegment, ASPMXXXXX, 1 ) \
+    X( ASPM_LM_ObjSegment, ASPMRearSegType6RMT, 2 ) \
+    X( ASPM_LM_ObjSegment, ASPMRearSegDist6RMT, 5 ) \
+    X( ASPM_LM_ObjSegment, ASPMXXXXX, 1 ) \
+    X( ASPM_LM_ObjSegment, ASPMRearSegType7RMT, 2 ) \
+    X( ASPM_LM_ObjSegment, ASPMRearSegDist7RMT, 5 ) \
+    X( ASPM_LM_ObjSegment, ASPMXXXXX, 1 ) \
+    X( ASPM_LM_ObjSegment, ASPMRearSegType8RMT, 2 ) \
+    X( ASPM_LM_ObjSegment, ASPMRearSegDist8RMT, 5 ) \
+    X( ASPM_LM_ObjSegment, ASPMXXXXX, 1 ) \
+    X( ASPM_LM_ObjSegment, ASPMRearSegType9RMT, 2 ) \
+    X( ASPM_LM_ObjSegment, ASPMRearSegDist9RMT, 5 ) \
+    X( ASPM_LM_ObjSegment, ASPMXXXXX, 1 ) \
+    X( ASPM_LM_ObjSegment, ASPMRearSegType10RMT, 2 ) \
+    X( ASPM_LM_ObjSegment, ASPMRearSegDist10RMT, 5 ) \
+    X( ASPM_LM_ObjSegment, ASPMXXXXX, 1 ) \
+    X( ASPM_LM_ObjSegment, ASPMRearSegType11RMT, 2 ) \
+    X( ASPM_LM_ObjSegment, ASPMRearSegDist11RMT, 5 ) \
+    X( ASPM_LM_ObjSegment, ASPMXXXXX, 1 ) \
+    X( ASPM_LM_ObjSegment, ASPMRearSegType12RMT, 2 ) \
+    X( ASPM_LM_ObjSegment, ASPMRearSegDist12RMT, 5 ) \
+    X( ASPM_LM_ObjSegment, ASPMXXXXX, 1 ) \
+    X( ASPM_LM_ObjSegment, ASPMRearSegType13RMT, 2 ) \
+    X( ASPM_LM_ObjSegment, ASPMRearSegDist13RMT, 5 ) \
+    X( ASPM_LM_ObjSegment, ASPMXXXXX, 1 ) \
+    X( ASPM_LM_ObjSegment, ASPMRearSegType14RMT, 2 ) \
+    X( ASPM_LM_ObjSegment, ASPMRearSegDist14RMT, 5 ) \
+    X( ASPM_LM_ObjSegment, ASPMXXXXX, 1 ) \
+    X( ASPM_LM_ObjSegment, ASPMRearSegType15RMT, 2 ) \
+    X( ASPM_LM_ObjSegment, ASPMRearSegDist15RMT, 5 ) \
+    X( ASPM_LM_ObjSegment, ASPMXXXXX, 1 ) \
+    X( ASPM_LM_ObjSegment, ASPMRearSegType16RMT, 2 ) \
+    X( ASPM_LM_ObjSegment, ASPMRearSegDist16RMT, 5 )
+
+/*!
+ * Signals of the ASPM_RemoteTarget PDU, in payload order.
+ */
+#define ASPM_REMOTETARGET_SIGNALS( X ) \
+    X( ASPM_RemoteTarget, TCMRemoteTarget, 64 )
+
+/*!
+ * Signals of the ASPM_LM_Session PDU, in payload order.
+ */
+#define ASPM_LM_SESSION_SIGNALS( X ) \
+    X( ASPM_LM_Session, LMEncrptSessionCntASPM_1, 64 ) \
+    X( ASPM_LM_Session, LMEncrptSessionCntASPM_2, 64 ) \
+    X( ASPM_LM_Session, LMEncryptSessionIDASPM_1, 64 ) \
+    X( ASPM_LM_Session, LMEncryptSessionIDASPM_2, 64 ) \
+    X( ASPM_LM_Session, LMTruncMACASPM, 64 ) \
+    X( ASPM_LM_Session, LMTruncSessionCntASPM, 8 ) \
+    X( ASPM_LM_Session, LMSessionControlASPM, 3 ) \
+    X( ASPM_LM_Session, LMSessionControlASPMExt, 5 )
+
+/*!
+ * Signals of the ASPM_LM_Trunc PDU, in payload order.
+ */
+#define ASPM_LM_TRUNC_SIGNALS( X ) \
+    X( ASPM_LM_Trunc, LMTruncEnPsPrasRotASPM_1, 64 ) \
+    X( ASPM_LM_Trunc, LMTruncEnPsPrasRotASPM_2, 64 )
+
+/*!
+ * Expands one list entry into an lm_signal_t initializer.
+ */
+#define PDU_TABLE_SIGNAL( PDU, NAME, BITS ) { PDU::NAME, #NAME, 0, 0, BITS },
+
+/*!
+ * Expands one list entry into a PduSignal template argument.
+ */
+#define PDU_CODEC_SIGNAL( PDU, NAME, BITS ) PduSignal<PDU::NAME, BITS>,
+
+typedef PduCodec< TCM_LM_SIGNALS( PDU_CODEC_SIGNAL ) PduEnd > TcmLmCodec;
+typedef PduCodec< TCM_LM_SESSION_SIGNALS( PDU_CODEC_SIGNAL ) PduEnd > TcmLmSessionCodec;
+typedef PduCodec< TCM_REMOTECONTROL_SIGNALS( PDU_CODEC_SIGNAL ) PduEnd > TcmRemoteControlCodec;
+typedef PduCodec< TCM_TRANSPORTKEY_SIGNALS( PDU_CODEC_SIGNAL ) PduEnd > TcmTransportKeyCodec;
+typedef PduCodec< TCM_LM_APP_SIGNALS( PDU_CODEC_SIGNAL ) PduEnd > TcmLmAppCodec;
+typedef PduCodec< TCM_LM_KEYID_SIGNALS( PDU_CODEC_SIGNAL ) PduEnd > TcmLmKeyIdCodec;
+typedef PduCodec< TCM_LM_KEYALPHA_SIGNALS( PDU_CODEC_SIGNAL ) PduEnd > TcmLmKeyAlphaCodec;
+typedef PduCodec< TCM_LM_KEYBETA_SIGNALS( PDU_CODEC_SIGNAL ) PduEnd > TcmLmKeyBetaCodec;
+typedef PduCodec< TCM_LM_KEYGAMMA_SIGNALS( PDU_CODEC_SIGNAL ) PduEnd > TcmLmKeyGammaCodec;
+typedef PduCodec< ASPM_LM_SIGNALS( PDU_CODEC_SIGNAL ) PduEnd > AspmLmCodec;
+typedef PduCodec< ASPM_LM_OBJSEGMENT_SIGNALS( PDU_CODEC_SIGNAL ) PduEnd > AspmLmObjSegmentCodec;
+typedef PduCodec< ASPM_REMOTETARGET_SIGNALS( PDU_CODEC_SIGNAL ) PduEnd > AspmRemoteTargetCodec;
+typedef PduCodec< ASPM_LM_SESSION_SIGNALS( PDU_CODEC_SIGNAL ) PduEnd > AspmLmSessionCodec;
+typedef PduCodec< ASPM_LM_TRUNC_SIGNALS( PDU_CODEC_SIGNAL ) PduEnd > AspmLmTruncCodec;
+
+static_assert( TcmLmCodec::BYTES == LENGTH_OF_TCM_LM, "TCM_LM layout does not match LENGTH_OF_TCM_LM" );
+static_assert( TcmLmSessionCodec::BYTES == LENGTH_OF_TCM_LM_Session, "TCM_LM_Session layout does not match LENGTH_OF_TCM_LM_Session" );
+static_assert( TcmRemoteControlCodec::BYTES == LENGTH_OF_TCM_RemoteControl, "TCM_RemoteControl layout does not match LENGTH_OF_TCM_RemoteControl" );
+static_assert( TcmTransportKeyCodec::BYTES == LENGTH_OF_TCM_TransportKey, "TCM_TransportKey layout does not match LENGTH_OF_TCM_TransportKey" );
+static_assert( TcmLmAppCodec::BYTES == LENGTH_OF_TCM_LM_App, "TCM_LM_App layout does not match LENGTH_OF_TCM_LM_App" );
+static_assert( TcmLmKeyIdCodec::BYTES == LENGTH_OF_TCM_LM_KeyID, "TCM_LM_KeyID layout does not match LENGTH_OF_TCM_LM_KeyID" );
+static_assert( TcmLmKeyAlphaCodec::BYTES == LENGTH_OF_TCM_LM_KeyAlpha, "TCM_LM_KeyAlpha layout does not match LENGTH_OF_TCM_LM_KeyAlpha" );
+static_assert( TcmLmKeyBetaCodec::BYTES == LENGTH_OF_TCM_LM_KeyBeta, "TCM_LM_KeyBeta layout does not match LENGTH_OF_TCM_LM_KeyBeta" );
+static_assert( TcmLmKeyGammaCodec::BYTES == LENGTH_OF_TCM_LM_KeyGamma, "TCM_LM_KeyGamma layout does not match LENGTH_OF_TCM_LM_KeyGamma" );
+static_assert( AspmLmCodec::BYTES == LENGTH_OF_ASPM_LM, "ASPM_LM layout does not match LENGTH_OF_ASPM_LM" );
+static_assert( AspmLmObjSegmentCodec::BYTES == LENGTH_OF_ASPM_LM_ObjSegment, "ASPM_LM_ObjSegment layout does not match LENGTH_OF_ASPM_LM_ObjSegment" );
+static_assert( AspmRemoteTargetCodec::BYTES == LENGTH_OF_ASPM_RemoteTarget, "ASPM_RemoteTarget layout does not match LENGTH_OF_ASPM_RemoteTarget" );
+static_assert( AspmLmSessionCodec::BYTES == LENGTH_OF_ASPM_LM_Session, "ASPM_LM_Session layout does not match LENGTH_OF_ASPM_LM_Session" );
+static_assert( AspmLmTruncCodec::BYTES == LENGTH_OF_ASPM_LM_Trunc, "ASPM_LM_Trunc layout does not match LENGTH_OF_ASPM_LM_Trunc" );
+
+static_assert( TcmLmCodec::BYTES + TcmLmSessionCodec::BYTES + TcmRemoteControlCodec::BYTES +
+               TcmTransportKeyCodec::BYTES + TcmLmAppCodec::BYTES + TcmLmKeyIdCodec::BYTES +
+               TcmLmKeyAlphaCodec::BYTES + TcmLmKeyBetaCodec::BYTES + TcmLmKeyGammaCodec::BYTES +
+               NUMBER_OF_TCM_PDU * 8 == TCM_TOTAL_PACKET_SIZE,
+               "TCM PDU layouts do not add up to TCM_TOTAL_PACKET_SIZE" );
+
+static_assert( AspmLmCodec::BYTES + AspmLmObjSegmentCodec::BYTES + AspmRemoteTargetCodec::BYTES +
+               AspmLmSessionCodec::BYTES + AspmLmTruncCodec::BYTES +
+               NUMBER_OF_ASPM_PDU * 8 == ASPM_TOTAL_PACKET_SIZE,
+               "ASPM PDU layouts do not add up to ASPM_TOTAL_PACKET_SIZE" );
+
+
+#endif //PDUSIGNALS_HPP
@@ -33,11 +33,22 @@
 #include "signalhandler.hpp"
 #include "sockethandler.hpp"
 #include "templatehandler.hpp"
+#include "bodycodec.hpp"
+#include "groupdispatcher.hpp"
+#include "responsecache.hpp"
+#include "messagewriter.hpp"
+#include "dmhframe.hpp"
 
 #include <sstream>
+#include <algorithm>
 #include <iostream>
 #include <fstream>
 #include <atomic>
+#include <mutex>
+#include <map>
+#include <set>
+#include <vector>
+#include <functional>
 
 
 /*!
@@ -55,8 +66,15 @@ public:
 
     /*!
      * constructor
+     *
+     * \param TCM  signal state of the vehicle served
+     * \param startThreads  false to start no threads of its own; the owner
+     * then calls pollEvents( ) when getEventSocket( ) is readable and
+     * updateStatus( ) every ASP_REFRESH_RATE
      */
-    RemoteDeviceHandler( std::shared_ptr <SignalHandler> TCM );
+    RemoteDeviceHandler(
+            std::shared_ptr <SignalHandler> TCM,
+            const bool& startThreads = true );
 
     /*!
      * destructor
@@ -64,8 +82,8 @@ public:
     ~RemoteDeviceHandler( );
 
     /*!
-     * main blocking call for waiting for a client to connect, then waiting for
-     * a received message from a connected client.
+     * main blocking call; runs the \p SocketHandler event loop, accepting
+     * mobile devices and dispatching their messages until stop( ) is called.
      */
     void spin( );
 
@@ -74,6 +92,43 @@ public:
      */
     void stop( );
 
+    /*!
+     * Listen for mobile devices; spin( ) does this on TCP_PORT.
+     *
+     * \param port  TCP port on TCP_ADDR
+     */
+    void bindServer( const uint16_t& port = TCP_PORT );
+
+    /*!
+     * Service mobile device sockets once, then send any deferred replies
+     * whose state has arrived or whose deadline has passed.
+     *
+     * \param timeoutMs  maximum time to wait for activity, in ms
+     *
+     * \return int  number of ready sockets serviced, or -1 on error
+     */
+    int pollEvents( const int& timeoutMs );
+
+    /*!
+     * \return int  epoll descriptor, readable when pollEvents( 0 ) has work
+     */
+    int getEventSocket( ) const;
+
+    /*!
+     * Close the server opened by bindServer( ) and all mobile devices.
+     */
+    void closeServer( );
+
+    /*!
+     * One pass of the status loop: push status changes to mobile devices.
+     */
+    void updateStatus( );
+
+    /*!
+     * \return ResponseCache&  serialized status responses, with their hit rate
+     */
+    ResponseCache& getResponseCache( );
+
 
 private:
 
@@ -86,12 +141,15 @@ private:
     bool checkMessageReadability_( const ssize_t& receiptVal );
 
     /*!
-     * Check if received message contains a client request for disconnecting.
+     * Check the sending connection for a socket error and a received text
+     * frame, header and body, for a client request for disconnecting.
      *
      * \return  boolean value for whether client is connected
-     * \param  msg message for parsing in string format
+     * \param  connection  id of the connection the message came from
+     * \param  msg message for parsing, not null-terminated
+     * \param  msgLen message length
      */
-    bool checkClientConnection_( const std::string& msg );
+    bool checkClientConnection_( const int& connection, const char* msg, const size_t& msgLen );
 
     /*!
      * Set compatible device connection status for method owned by
@@ -109,9 +167,40 @@ private:
     void setKeyFobRangingRate_( const DCM::FobRangeRequestRate& rangingRate );
 
     /*!
-     * Main message processing pipeline; all possible JSON scenarios are here
+     * Called by \p SocketHandler after a mobile device connects.
+     *
+     * \param connection  id of the new connection
+     */
+    void clientConnected_( const int& connection );
+
+    /*!
+     * Called by \p SocketHandler after a mobile device disconnects.
      *
-     * \param  msg message for parsing in string format
+     * \param connection  id of the closed connection
+     */
+    void clientDisconnected_( const int& connection );
+
+    /*!
+     * Called by \p SocketHandler for each complete frame received; checks the
+     * frame and passes it on to messageEvent_( ).
+     *
+     * \param connection  id of the sending connection
+     * \param receivedMsg  view of raw frame, header followed by body
+     * \param headerLen  message header length
+     * \param bodyLen  message body length
+     */
+    void frameEvent_(
+            const int& connection,
+            const char* receivedMsg,
+            const uint32_t& headerLen,
+            const uint32_t& bodyLen );
+
+    /*!
+     * Main message processing pipeline; parses the message and passes its
+     * body to the handler registered for its group
+     *
+     * \param  msg view of message for parsing, header followed by body; only
+     * valid for the duration of the call
      * \param  headerLen message header length
      * \param  msgLen message body length
      *
@@ -119,31 +208,243 @@ private:
      * Exception thrown parsing JSON message; check input format for template
      * mismatch
      *
-     * \sa setRemoteControlPIN_( )
-     * \sa loadMainMenu_( )
-     * \sa loadSpaceSelection_( )
-     * \sa pushPullSelected_( )
-     * \sa updateDMH_( )
-     * \sa SignalHandler::setManeuverButtonPress( )
-     * \sa SignalHandler::setCabinCommands( )
+     * \sa registerGroupHandlers_( )
+     * \sa GroupDispatcher::dispatch( )
      *
      */
     void messageEvent_(
-            const std::string& msg,
+            const char* msg,
             const uint32_t& headerLen,
             const uint32_t& msgLen );
 
+    /*!
+     * Register the handler of every inbound message group with groupHandlers_.
+     */
+    void registerGroupHandlers_( );
+
+    /*!
+     * Register a member function as the handler of a message group.
+     *
+     * \param  group one of the \p RD group names
+     * \param  handler called with the message body
+     * \param  schema fields of the message body
+     */
+    void addGroupHandler_(
+            const char* group,
+            void ( RemoteDeviceHandler::*handler )( const RequestBody& ),
+            const RequestSchema& schema = GroupDispatcher::NO_FIELDS );
+
+    /*!
+     * \brief Handle HEARTBEAT: opt the device in to liveness supervision and
+     * answer with a heartbeat.
+     *
+     * \param  msgInBody body of the inbound message
+     */
+    void handleHeartbeat_( const RequestBody& msgInBody );
+
+    /*!
+     * \brief Handle SEND_PIN: pass the PIN to the DCM and report the result
+     * in a vehicle status once the DCM acknowledges it.
+     *
+     * \param  msgInBody body of the inbound message
+     */
+    void handleSendPIN_( const RequestBody& msgInBody );
+
+    /*!
+     * \brief Handle MOBILE_INIT: approve an authenticated device that
+     * accepted the terms and answer with VEHICLE_INIT.
+     *
+     * \param  msgInBody body of the inbound message
+     */
+    void handleMobileInit_( const RequestBody& msgInBody );
+
+    /*!
+     * \brief Handle GET_THREAT_DATA once the ASP has finished scanning.
+     *
+     * \param  msgInBody body of the inbound message
+     */
+    void handleGetThreatData_( const RequestBody& msgInBody );
+
+    /*!
+     * \brief Handle LIST_MANEUVERS: load space selection if needed and answer
+     * with AVAILABLE_MANEUVERS.
+     *
+     * \param  msgInBody body of the inbound message
+     */
+    void handleListManeuvers_( const RequestBody& msgInBody );
+
+    /*!
+     * \brief Handle MANEUVER_INIT: select the requested maneuver at the ASP
+     * and answer with MANEUVER_STATUS.
+     *
+     * \param  msgInBody body of the inbound message
+     */
+    void handleManeuverInit_( const RequestBody& msgInBody );
+
+    /*!
+     * \brief Handle MOBILE_RESPONSE: pass the challenge response to the TCM.
+     *
+     * \param  msgInBody body of the inbound message
+     */
+    void handleMobileResponse_( const RequestBody& msgInBody );
+
+    /*!
+     * \brief Handle DEADMANS_HANDLE.
+     *
+     * \param  msgInBody body of the inbound message
+     *
+     * \sa updateDMH_( )
+     */
+    void handleDeadmansHandle_( const RequestBody& msgInBody );
+
+    /*!
+     * \brief Handle a binary DMH frame, the fixed-layout twin of DEADMANS_HANDLE.
+     *
+     * Ignored with a DEBUG reply unless the sending connection negotiated
+     * "binary_dmh" with set_body_encoding.
+     *
+     * \param  rawBody view of the frame body
+     * \param  bodyLen frame body length
+     *
+     * \sa DmhFrame::decode( ), updateDMH_( )
+     */
+    void dmhFrameEvent_( const char* rawBody, const uint32_t& bodyLen );
+
+    /*!
+     * \brief Handle CANCEL_DRIVE_ON: resume a paused maneuver.
+     *
+     * \param  msgInBody body of the inbound message
+     */
+    void handleCancelDriveOn_( const RequestBody& msgInBody );
+
+    /*!
+     * \brief Handle CANCEL_MANEUVER: press cancel until the ASP confirms,
+     * without blocking the connection meanwhile.
+     *
+     * \param  msgInBody body of the inbound message
+     */
+    void handleCancelManeuver_( const RequestBody& msgInBody );
+
+    /*!
+     * \brief Handle CABIN_COMMANDS and answer with CABIN_STATUS.
+     *
+     * \param  msgInBody body of the inbound message
+     */
+    void handleCabinCommands_( const RequestBody& msgInBody );
+
+    /*!
+     * Pass \p msgManeuver to the ASP and answer with MANEUVER_STATUS once the
+     * ASP offers it, or after MANEUVER_INIT_TIMEOUT.
+     *
+     * \param  msgManeuver name of the requested maneuver
+     */
+    void selectManeuver_( const std::string& msgManeuver );
+
+    /*!
+     * Answer the current frame's connection by \p reply once \p ready holds
+     * or \p timeout has passed, without blocking the connection meanwhile.
+     * Replies immediately if \p ready already holds.
+     *
+     * \param  ready checks the awaited ASP / DCM state
+     * \param  reply sends the reply; may be empty
+     * \param  timeout longest wait, in μs
+     * \param  retry repeats the request every ASP_REFRESH_RATE; may be empty
+     */
+    void deferReply_(
+            const std::function< bool( ) >& ready,
+            const std::function< void( ) >& reply,
+            const uint32_t& timeout,
+            const std::function< void( ) >& retry = nullptr );
+
+    /*!
+     * Send the deferred replies that are ready or expired and retry the
+     * rest; called from pollEvents( ).
+     */
+    void serviceDeferredReplies_( );
+
     /*!
      * Send JSON messages out via \p SocketHandler
      *
      * \param  msgOut json struct for sending
      * \param  msgGroup group name for populating outgoing header
+     * \param  version state version \p msgOut was built from, to cache it
+     * under; NO_STATE_VERSION to not cache it
      *
      * \sa TemplateHandler::getRawHeaderTemplate( )
      * \sa TemplateHandler::getRawVehicleStatusTemplate( )
      *
      */
-    void sendMsg_( const nlohmann::json& msgOut, const std::string& msgGroup );
+    void sendMsg_(
+            const nlohmann::json& msgOut,
+            const std::string& msgGroup,
+            const uint64_t& version = NO_STATE_VERSION );
+
+    /*!
+     * Send a body already serialized to JSON text by \p MessageWriter.  It
+     * goes out as is when every connection uses JSON bodies, and through
+     * sendMsg_( ) otherwise.
+     *
+     * \param  bodyOut serialized JSON body
+     * \param  msgGroup group name for populating outgoing header
+     * \param  version state version \p bodyOut was built from, to cache it
+     * under; NO_STATE_VERSION to not cache it
+     */
+    void sendBody_(
+            const std::string& bodyOut,
+            const std::string& msgGroup,
+            const uint64_t& version = NO_STATE_VERSION );
+
+    /*!
+     * \return bool  true if no connection negotiated a binary body encoding
+     */
+    bool isJsonOnly_( );
+
+    /*!
+     * Send the response to \p msgGroup cached at \p version, if there is one
+     * for every encoding it goes out in.
+     *
+     * \param  msgGroup group name of the response
+     * \param  version current state version
+     *
+     * \return bool  true if sent from the cache
+     */
+    bool sendCached_( const std::string& msgGroup, const uint64_t& version );
+
+    /*!
+     * \return std::vector<int>  connections a message goes to: the one being
+     * answered, or all of them for a push
+     */
+    std::vector<int> getTargets_( );
+
+    /*!
+     * \param  msgGroup group name of an outgoing message
+     *
+     * \return std::string  key under which an unsent older copy is
+     * superseded; empty unless \p msgGroup is a status push.  Records the
+     * latency of MANEUVER_STATUS.
+     */
+    std::string getSupersedeKey_( const std::string& msgGroup );
+
+    /*!
+     * \brief Switch the body encoding of the sending connection
+     *
+     * Replies with BODY_ENCODING, already in the selected encoding; an
+     * unknown encoding leaves the connection unchanged.  An optional
+     * "binary_dmh" field switches binary DMH frames on or off.
+     *
+     * \param  msgBody body of the set_body_encoding message
+     *
+     * \sa BodyCodec::parseEncoding( )
+     *
+     */
+    void setBodyEncoding_( const RequestBody& msgBody );
+
+    /*!
+     * \param  connection id of the connection
+     *
+     * \return BodyEncoding  encoding negotiated by the connection; Json if none
+     */
+    BodyEncoding getBodyEncoding_( const int& connection );
 
     /*!
      * \brief Format and send JSON message to return VEHICLE_API_VERSION
@@ -670,9 +971,10 @@ private:
     /*!
      * Check if exploratory maneuvers can be continued ( < 3 SF or SR )
      *
+     * \param asp  decoded ASP signals to check
      * \return bool  boolean value for whether explore can continue
      */
-    bool checkContinueExploratoryMode_( );
+    bool checkContinueExploratoryMode_( const AspSnapshot& asp );
 
     /*!
      * Helper method to check which of the vehicle_status signals has changed.
@@ -687,20 +989,10 @@ private:
      * <a href="./res/vehiclestatuscodes.md">\p vehiclestatuscodes.md</a>.
      *
      * \param prefix  type of status code to prefix
+     * \param asp  decoded ASP signals to read the status from
      * \return updated status code with prefix
      */
-    int prefixStatus_( const VehicleStatusPrefix& prefix );
-
-    /*!
-     * Map message text values to names for use in \p RemoteDeviceHandler
-     *
-     * \exception e
-     * Error populating signal text values
-     *
-     * \param sigText  map of signal text values
-     * \param data  raw text from CONSTANTS_H
-     */
-    void mapMsgText_( std::vector<std::string>& sigText, const char* data );
+    int prefixStatus_( const VehicleStatusPrefix& prefix, const AspSnapshot& asp );
 
     /*!
      * Event loop for tracking changes in ASP state and reporting back to mobile
@@ -725,59 +1017,6 @@ private:
      */
     SocketHandler socketHandler_;
 
-    /*!
-     * struct of signal text mapped to signal code.
-     */
-    struct signalText
-    {
-
-        /*!
-         * String vector for assigning ManeuverStatus signals to text values.
-         */
-        std::vector<std::string> ManeuverStatus;
-
-        /*!
-         * String vector for assigning NoFeatureAvailableMsg signals to text values.
-         */
-        std::vector<std::string> NoFeatureAvailableMsg;
-
-        /*!
-         * String vector for assigning CancelMsg signals to text values.
-         */
-        std::vector<std::string> CancelMsg;
-
-        /*!
-         * String vector for assigning PauseMsg1 signals to text values.
-         */
-        std::vector<std::string> PauseMsg1;
-
-        /*!
-         * String vector for assigning PauseMsg2 signals to text values.
-         */
-        std::vector<std::string> PauseMsg2;
-
-        /*!
-         * String vector for assigning InfoMsg signals to text values.
-         */
-        std::vector<std::string> InfoMsg;
-
-        /*!
-         * String vector for assigning InstructMsg signals to text values.
-         */
-        std::vector<std::string> InstructMsg;
-
-        /*!
-         * String vector for assigning InstructMsg signals to text values.
-         */
-        std::vector<std::string> AcknowledgeRemotePIN;
-
-        /*!
-         * String vector for assigning InstructMsg signals to text values.
-         */
-        std::vector<std::string> ErrorMsg;
-
-    } sigText_;
-
     /*!
      * holds all previous signal values to be checked on loop.
      */
@@ -835,11 +1074,79 @@ private:
 
     } prevSig_;
 
+    /*!
+     * connection whose frame is currently being processed; -1 outside of
+     * frameEvent_( ).
+     */
+    int activeConnection_;
+
+    /*!
+     * connection that completed mobile_init and holds remote control; its
+     * departure revokes approval even if other devices remain connected.
+     */
+    int controllingConnection_;
+
+    /*!
+     * connections that negotiated a binary body encoding; all others use JSON.
+     */
+    std::map<int, BodyEncoding> bodyEncodings_;
+
+    /*!
+     * connections that negotiated binary DMH frames; see dmhFrameEvent_( ).
+     */
+    std::set<int> binaryDmh_;
+
+    /*!
+     * handlers of the inbound message groups, keyed by group name.
+     */
+    GroupDispatcher groupHandlers_;
+
+    /*!
+     * guards bodyEncodings_ and binaryDmh_, read by every thread sending
+     * messages.
+     */
+    std::mutex encodingMtx_;
+
+    /*!
+     * reply waiting on ASP / DCM state; see deferReply_( ).
+     */
+    struct DeferredReply
+    {
+        int connection;                     //!< connection to answer
+        std::function< bool( ) > ready;     //!< awaited state has arrived
+        std::function< void( ) > reply;     //!< sends the reply
+        std::function< void( ) > retry;     //!< repeats the request
+        uint64_t deadline;                  //!< expiry, in ns
+        uint64_t nextRetry;                 //!< next retry, in ns
+    };
+
+    /*!
+     * replies waiting on ASP / DCM state; used by the pollEvents( ) thread only.
+     */
+    std::vector<DeferredReply> deferredReplies_;
+
+    /*!
+     * size of deferredReplies_, read by the ASP thread to wake pollEvents( ).
+     */
+    std::atomic<size_t> deferredCount_;
+
     /*!
      * indicates that the handler is currently "spinning"
      */
     std::atomic<bool> running_;
 
+    /*!
+     * status signal changes published by TCM_; wake the status loop, as
+     * does stop( ).
+     */
+    std::shared_ptr<SignalSubscriber> statusSignals_;
+
+    /*!
+     * serialized VEHICLE_STATUS, MANEUVER_STATUS, CABIN_STATUS and
+     * AVAILABLE_MANEUVERS responses.
+     */
+    ResponseCache responseCache_;
+
     /*!
      * loopHandler for MsgParser thread.
      */
@@ -847,15 +1154,4 @@ private:
 
 };
 
-// external handlers for status signal text
-extern const char * rawTextManeuverStatus;
-extern const char * rawTextNoFeatureAvailableMsg;
-extern const char * rawTextCancelMsg;
-extern const char * rawTextPauseMsg1;
-extern const char * rawTextPauseMsg2;
-extern const char * rawTextLMInfoRMT;
-extern const char * rawTextInstructMsg;
-extern const char * rawAcknowledgeRemotePIN;
-extern const char * rawErrorMsg;
-
 #endif //REMOTEDEVICEHANDLER_HPP
@@ -0,0 +1,273 @@
+/*! \license
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * \copyright 2021 Dan Fernández
+ *
+ *
+ * \file Header for \p RequestParser class.
+ *
+ * \author fdaniel, trice2
+ */
+
+#if !defined( REQUESTPARSER_HPP )
+#define REQUESTPARSER_HPP
+
+#include <string>
+
+#include "json.hpp"
+
+constexpr auto MAX_REQUEST_FIELDS = 8;
+constexpr auto MAX_REQUEST_DEPTH = 64;
+constexpr auto MAX_NUMBER_LENGTH = 64;
+
+
+/*!
+ * JSON type a request field must have.
+ */
+enum class FieldType : uint8_t
+{
+    Bool = 0,
+    Number = 1,
+    String = 2
+};
+
+
+/*!
+ * Result of parsing a request header or body.
+ */
+enum class ParseStatus : uint8_t
+{
+    Ok = 0,
+    Malformed = 1,          //!< not a well-formed JSON object
+    MissingField = 2,       //!< a required field is absent
+    TypeMismatch = 3,       //!< a field has the wrong type
+    Unsupported = 4         //!< needs the DOM, e.g. an escaped string field
+};
+
+
+/*!
+ * One field a request may carry.
+ */
+struct FieldSpec
+{
+    const char* name;
+    FieldType type;
+    bool required;
+};
+
+
+/*!
+ * The fields of one request; any others are skipped.
+ */
+struct RequestSchema
+{
+    const FieldSpec* fields;
+    size_t count;
+};
+
+/*!
+ * \return RequestSchema  schema of \p fields, checked to fit a \p RequestBody
+ */
+template <size_t N>
+constexpr RequestSchema makeSchema( const FieldSpec ( &fields )[ N ] )
+{
+    static_assert( N <= MAX_REQUEST_FIELDS, "schema has more than MAX_REQUEST_FIELDS fields" );
+    return RequestSchema{ fields, N };
+}
+
+
+/*!
+ * A parsed field.  Strings point into the buffer that was parsed, or into
+ * the DOM it came from, and live as long as it does.
+ */
+struct FieldValue
+{
+    bool present = false;
+    bool boolean = false;
+    double number = 0.0;
+    const char* string = nullptr;
+    size_t length = 0;
+
+    /*!
+     * \return std::string  copy of a string field
+     */
+    std::string str( ) const;
+
+    /*!
+     * \param text  NUL-terminated text
+     *
+     * \return bool  true if the field is a string equal to \p text
+     */
+    bool equals( const char* text ) const;
+};
+
+
+/*!
+ * \brief Fields of a request, laid out by its \p RequestSchema.
+ */
+class RequestBody
+{
+
+public:
+
+    /*!
+     * \param schema  fields the request may carry; must outlive the body
+     */
+    explicit RequestBody( const RequestSchema& schema );
+
+    /*!
+     * \param name  field name from the schema
+     *
+     * \return FieldValue&  the field; absent if it is not in the schema
+     */
+    const FieldValue& get( const char* name ) const;
+
+    /*!
+     * \return bool  true if the field was sent
+     */
+    bool has( const char* name ) const;
+
+    /*!
+     * \return bool  value of a Bool field; false if absent
+     */
+    bool getBool( const char* name ) const;
+
+    /*!
+     * \return double  value of a Number field; 0 if absent
+     */
+    double getNumber( const char* name ) const;
+
+    /*!
+     * \return std::string  copy of a String field; empty if absent
+     */
+    std::string getString( const char* name ) const;
+
+private:
+
+    friend class RequestParser;
+
+    /*!
+     * \return int  index of the field in the schema; -1 if not in it
+     */
+    int find_( const char* name, const size_t& length ) const;
+
+    /*!
+     * fields the request may carry.
+     */
+    const RequestSchema* schema_;
+
+    /*!
+     * parsed fields, indexed like schema_->fields.
+     */
+    FieldValue values_[ MAX_REQUEST_FIELDS ];
+
+};
+
+
+/*!
+ * \brief Parses request headers and bodies in place, without exceptions.
+ *
+ * JSON text is read straight from the receive buffer.  Only the fields of
+ * the schema are extracted, everything else is checked for well-formedness
+ * and skipped, so a request parses without a heap allocation.  A string
+ * field with escapes reports Unsupported; the caller then parses a DOM and
+ * extracts from it with parseDom( ), as it does for binary encodings.
+ */
+class RequestParser
+{
+
+public:
+
+    /*!
+     * Parse a JSON object.
+     *
+     * \param raw  start of the JSON text
+     * \param size  length of the JSON text
+     * \param body  parsed fields; its schema picks them
+     *
+     * \return ParseStatus  Ok, or why the request was refused
+     */
+    static ParseStatus parse( const char* raw, const size_t& size, RequestBody& body );
+
+    /*!
+     * Extract fields from an already parsed DOM.
+     *
+     * \param dom  parsed request; must outlive \p body
+     * \param body  parsed fields; its schema picks them
+     *
+     * \return ParseStatus  Ok, or why the request was refused
+     */
+    static ParseStatus parseDom( const nlohmann::json& dom, RequestBody& body );
+
+private:
+
+    /*!
+     * Check that every required field is present.
+     */
+    static ParseStatus checkRequired_( const RequestBody& body );
+
+    /*!
+     * Skip whitespace.
+     */
+    static void skipSpace_( const char*& ptr, const char* end );
+
+    /*!
+     * Scan a string at \p ptr, which must be its opening quote.
+     *
+     * \param start  first character of the string
+     * \param length  length of the raw string
+     * \param escaped  true if it contains escapes
+     */
+    static ParseStatus scanString_(
+            const char*& ptr,
+            const char* end,
+            const char*& start,
+            size_t& length,
+            bool& escaped );
+
+    /*!
+     * Scan a number and convert it.
+     */
+    static ParseStatus scanNumber_( const char*& ptr, const char* end, double& number );
+
+    /*!
+     * Scan true, false or null.
+     */
+    static bool scanLiteral_( const char*& ptr, const char* end, const char* literal );
+
+    /*!
+     * Skip any value, nested up to MAX_REQUEST_DEPTH deep.
+     */
+    static ParseStatus skipValue_( const char*& ptr, const char* end, const int& depth );
+
+    /*!
+     * Parse the value of a schema field.
+     */
+    static ParseStatus parseField_(
+            const char*& ptr,
+            const char* end,
+            const FieldType& type,
+            FieldValue& value );
+
+};
+
+#endif //REQUESTPARSER_HPP
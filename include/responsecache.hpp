@@ -0,0 +1,153 @@
+/*! \license
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * \copyright 2021 Dan Fernández
+ *
+ *
+ * \file Header for \p ResponseCache class.
+ *
+ * \author fdaniel, trice2
+ */
+
+#if !defined( RESPONSECACHE_HPP )
+#define RESPONSECACHE_HPP
+
+#include "bodycodec.hpp"
+
+#include <array>
+#include <atomic>
+#include <map>
+#include <mutex>
+#include <string>
+
+#include <stdint.h>
+
+
+/*!
+ * state version that is never cached; see SignalHandler::getStateVersion( ).
+ */
+constexpr uint64_t NO_STATE_VERSION = 0;
+
+
+/*!
+ * \brief Serialized responses, kept per message group and body encoding
+ * along with the signal state version they were built from.
+ *
+ * A lookup hits only while the state version is unchanged, so a group
+ * polled repeatedly between ASP changes is sent without any JSON work.
+ */
+class ResponseCache
+{
+
+public:
+
+    /*!
+     * Constructor.
+     */
+    ResponseCache( );
+
+    /*!
+     * Copy out the response to \p group cached at \p version.
+     *
+     * \param group  message group of the response
+     * \param encoding  body encoding of the response
+     * \param version  current state version
+     * \param header  set to the serialized header on a hit
+     * \param body  set to the serialized body on a hit
+     *
+     * \return bool  true on a hit
+     */
+    bool lookup(
+            const std::string& group,
+            const BodyEncoding& encoding,
+            const uint64_t& version,
+            std::string& header,
+            std::string& body );
+
+    /*!
+     * Cache a serialized response built at \p version, replacing any older
+     * one for the same group and encoding.
+     */
+    void store(
+            const std::string& group,
+            const BodyEncoding& encoding,
+            const uint64_t& version,
+            const std::string& header,
+            const std::string& body );
+
+    /*!
+     * \return uint64_t  lookups served from the cache
+     */
+    uint64_t getHits( ) const;
+
+    /*!
+     * \return uint64_t  lookups that had to build the response
+     */
+    uint64_t getMisses( ) const;
+
+    /*!
+     * \return double  hits per lookup, 0 before the first lookup
+     */
+    double getHitRate( ) const;
+
+    /*!
+     * Print hits, misses and hit rate under the given name.
+     *
+     * \param name  label for the report
+     */
+    void print( const std::string& name ) const;
+
+private:
+
+    /*!
+     * one cached response.
+     */
+    struct Entry
+    {
+        uint64_t version;       //!< state version, NO_STATE_VERSION if empty
+        std::string header;     //!< serialized header
+        std::string body;       //!< serialized body
+    };
+
+    /*!
+     * guards entries_.
+     */
+    std::mutex cacheMtx_;
+
+    /*!
+     * responses by group, one per body encoding.
+     */
+    std::map< std::string, std::array< Entry, BODY_ENCODING_COUNT > > entries_;
+
+    /*!
+     * lookups served from entries_.
+     */
+    std::atomic<uint64_t> hits_;
+
+    /*!
+     * lookups not served from entries_.
+     */
+    std::atomic<uint64_t> misses_;
+
+};
+
+#endif //RESPONSECACHE_HPP
@@ -0,0 +1,177 @@
+/*! \license
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * \copyright 2021 Dan Fernández
+ *
+ *
+ * \file Header for \p RingBuffer class.
+ *
+ * \author fdaniel, trice2
+ */
+
+#if !defined( RINGBUFFER_HPP )
+#define RINGBUFFER_HPP
+
+#include <vector>
+#include <cstddef>
+#include <string.h>
+
+
+/*!
+ * \brief Fixed-capacity receive buffer for a single stream connection.
+ *
+ * Bytes are received straight into the free tail, consumed from the head, and
+ * the unread region is always contiguous so complete frames can be handed out
+ * as non-owning pointers.  Rather than wrapping, the read and write positions
+ * rewind to the start once everything has been consumed, and any leftover
+ * partial frame is moved to the front only when the tail runs out of space.
+ * Storage is allocated once, so steady-state receipt performs no allocation.
+ *
+ */
+class RingBuffer
+{
+
+public:
+
+    /*!
+     * constructor
+     *
+     * \param capacity  number of bytes the buffer can hold
+     */
+    explicit RingBuffer( const size_t& capacity = 0 )
+            :
+            buffer_( capacity ),
+            head_( 0 ),
+            tail_( 0 )
+    {
+
+    }
+
+    /*!
+     * Resize storage and discard any buffered bytes.
+     *
+     * \param capacity  number of bytes the buffer can hold
+     */
+    void reset( const size_t& capacity )
+    {
+        buffer_.assign( capacity, 0 );
+        head_ = 0;
+        tail_ = 0;
+    }
+
+    /*!
+     * Start of the unread bytes.
+     */
+    const char* readPtr( ) const
+    {
+        return buffer_.data( ) + head_;
+    }
+
+    /*!
+     * Number of unread bytes.
+     */
+    size_t readable( ) const
+    {
+        return tail_ - head_;
+    }
+
+    /*!
+     * Mark bytes at the head as consumed.  Pointers returned by readPtr( )
+     * stay valid until the next call to writePtr( ).
+     *
+     * \param count  number of bytes consumed
+     */
+    void consume( const size_t& count )
+    {
+        head_ += ( count < readable( ) ) ? count : readable( );
+
+        if( head_ == tail_ )
+        {
+            head_ = 0;
+            tail_ = 0;
+        }
+    }
+
+    /*!
+     * Start of the free tail, moving unread bytes to the front first if the
+     * tail is full.
+     */
+    char* writePtr( )
+    {
+        if( tail_ == buffer_.size( ) && head_ > 0 )
+        {
+            memmove( buffer_.data( ), buffer_.data( ) + head_, readable( ) );
+            tail_ -= head_;
+            head_ = 0;
+        }
+
+        return buffer_.data( ) + tail_;
+    }
+
+    /*!
+     * Number of free bytes after writePtr( ).
+     */
+    size_t writable( ) const
+    {
+        return buffer_.size( ) - tail_;
+    }
+
+    /*!
+     * Mark bytes written at writePtr( ) as readable.
+     *
+     * \param count  number of bytes written
+     */
+    void commit( const size_t& count )
+    {
+        tail_ += ( count < writable( ) ) ? count : writable( );
+    }
+
+    /*!
+     * Total number of bytes the buffer can hold.
+     */
+    size_t capacity( ) const
+    {
+        return buffer_.size( );
+    }
+
+
+private:
+
+    /*!
+     * backing storage.
+     */
+    std::vector<char> buffer_;
+
+    /*!
+     * offset of the first unread byte.
+     */
+    size_t head_;
+
+    /*!
+     * offset one past the last unread byte.
+     */
+    size_t tail_;
+
+};
+
+
+#endif //RINGBUFFER_HPP
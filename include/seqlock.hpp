@@ -0,0 +1,181 @@
+/*! \license
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * \copyright 2021 Dan Fernández
+ *
+ *
+ * \file Header for \p Seqlock class.
+ *
+ * \author fdaniel, trice2
+ */
+
+#if !defined( SEQLOCK_HPP )
+#define SEQLOCK_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <string.h>
+
+
+/*!
+ * \brief Latest-value mailbox publishing a small POD value as one unit.
+ *
+ * The value is held in relaxed atomic words behind a sequence counter that is
+ * odd while a store is under way.  A reader copies the words and retries if
+ * the counter moved meanwhile, so it always gets one whole value and never
+ * makes a writer wait.  Concurrent writers queue on the counter among
+ * themselves; they take no lock a reader could hold.
+ *
+ * \tparam T  trivially copyable value type
+ */
+template <typename T>
+class Seqlock
+{
+
+    static_assert( std::is_trivially_copyable<T>::value, "Seqlock needs a trivially copyable type" );
+
+public:
+
+    /*!
+     * constructor
+     *
+     * \param initial  value returned until the first store( )
+     */
+    explicit Seqlock( const T& initial = T( ) )
+            :
+            sequence_( 0 )
+    {
+        uint64_t words[ WORDS ] = { 0 };
+        memcpy( words, &initial, sizeof( T ) );
+
+        for( size_t i = 0; i < WORDS; ++i )
+        {
+            words_[ i ].store( words[ i ], std::memory_order_relaxed );
+        }
+    }
+
+    /*!
+     * Publish a new value.
+     *
+     * \param value  value to publish
+     */
+    void store( const T& value )
+    {
+        uint64_t words[ WORDS ] = { 0 };
+        memcpy( words, &value, sizeof( T ) );
+
+        uint32_t sequence( sequence_.load( std::memory_order_relaxed ) );
+        while( ( sequence & 1 ) != 0
+               || sequence_.compare_exchange_weak(
+                        sequence,
+                        sequence + 1,
+                        std::memory_order_acquire,
+                        std::memory_order_relaxed ) == false )
+        {
+            sequence = sequence_.load( std::memory_order_relaxed );
+        }
+        std::atomic_thread_fence( std::memory_order_release );
+
+        for( size_t i = 0; i < WORDS; ++i )
+        {
+            words_[ i ].store( words[ i ], std::memory_order_relaxed );
+        }
+
+        sequence_.store( sequence + 2, std::memory_order_release );
+    }
+
+    /*!
+     * Copy the latest value.
+     *
+     * \param value  copy of the latest whole value
+     *
+     * \return uint32_t  its version, as getVersion( )
+     */
+    uint32_t load( T& value ) const
+    {
+        uint64_t words[ WORDS ];
+        uint32_t before;
+        uint32_t after;
+
+        do
+        {
+            before = sequence_.load( std::memory_order_acquire );
+
+            for( size_t i = 0; i < WORDS; ++i )
+            {
+                words[ i ] = words_[ i ].load( std::memory_order_relaxed );
+            }
+
+            std::atomic_thread_fence( std::memory_order_acquire );
+            after = sequence_.load( std::memory_order_relaxed );
+        }
+        while( ( before & 1 ) != 0 || before != after );
+
+        memcpy( &value, words, sizeof( T ) );
+
+        return before >> 1;
+    }
+
+    /*!
+     * \return T  copy of the latest whole value
+     */
+    T load( ) const
+    {
+        T value;
+        load( value );
+
+        return value;
+    }
+
+    /*!
+     * \return uint32_t  number of completed store( ) calls; cheap to poll
+     * before deciding to load( )
+     */
+    uint32_t getVersion( ) const
+    {
+        return sequence_.load( std::memory_order_acquire ) >> 1;
+    }
+
+
+private:
+
+    /*!
+     * number of 64-bit words holding a T.
+     */
+    static constexpr size_t WORDS = ( sizeof( T ) + sizeof( uint64_t ) - 1 ) / sizeof( uint64_t );
+
+    /*!
+     * twice the number of completed stores, plus one while a store is under way.
+     */
+    std::atomic<uint32_t> sequence_;
+
+    /*!
+     * the value, split into words each read and written atomically.
+     */
+    std::atomic<uint64_t> words_[ WORDS ];
+
+};
+
+
+#endif //SEQLOCK_HPP
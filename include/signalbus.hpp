@@ -0,0 +1,218 @@
+/*! \license
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * \copyright 2021 Dan Fernández
+ *
+ *
+ * \file Header for \p SignalBus class.
+ *
+ * \author fdaniel, trice2
+ */
+
+#if !defined( SIGNALBUS_HPP )
+#define SIGNALBUS_HPP
+
+#include "eventwaiter.hpp"
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <stdint.h>
+
+
+/*!
+ * Status signals whose changes SignalHandler publishes.
+ */
+enum class StatusSignal : uint8_t
+{
+    ManeuverStatus = 0,
+    NoFeatureAvailableMsg = 1,
+    CancelMsg = 2,
+    PauseMsg1 = 3,
+    PauseMsg2 = 4,
+    InfoMsg = 5,
+    InstructMsg = 6,
+    AcknowledgeRemotePIN = 7,
+    ErrorMsg = 8,
+    MobileChallengeSend = 9
+};
+
+/*!
+ * Set of StatusSignal, one bit per signal.
+ */
+typedef uint32_t SignalMask;
+
+/*!
+ * \return SignalMask  bit of \p signal
+ */
+constexpr SignalMask signalBit( const StatusSignal signal )
+{
+    return (SignalMask)1 << (uint8_t)signal;
+}
+
+// signal groups, by the message that reports them
+constexpr SignalMask MANEUVER_STATUS_SIGNALS = signalBit( StatusSignal::ManeuverStatus );
+constexpr SignalMask VEHICLE_STATUS_SIGNALS =
+        signalBit( StatusSignal::ManeuverStatus ) |
+        signalBit( StatusSignal::NoFeatureAvailableMsg ) |
+        signalBit( StatusSignal::CancelMsg ) |
+        signalBit( StatusSignal::PauseMsg1 ) |
+        signalBit( StatusSignal::PauseMsg2 ) |
+        signalBit( StatusSignal::InfoMsg ) |
+        signalBit( StatusSignal::InstructMsg ) |
+        signalBit( StatusSignal::AcknowledgeRemotePIN ) |
+        signalBit( StatusSignal::ErrorMsg );
+constexpr SignalMask MOBILE_CHALLENGE_SIGNALS = signalBit( StatusSignal::MobileChallengeSend );
+constexpr SignalMask ALL_STATUS_SIGNALS =
+        VEHICLE_STATUS_SIGNALS | MOBILE_CHALLENGE_SIGNALS;
+
+
+/*!
+ * \brief Receives the status signal changes of one subscriber.
+ *
+ * Changes accumulate as bits until takeChanges( ); each publish also wakes
+ * waitFor( ), so the subscriber reacts right after the decode that caused
+ * the change instead of at its next poll.
+ */
+class SignalSubscriber
+{
+
+public:
+
+    /*!
+     * Constructor.
+     *
+     * \param mask  signals to receive
+     */
+    explicit SignalSubscriber( const SignalMask& mask );
+
+    /*!
+     * Sleep for the given time, or until a subscribed signal changes or
+     * wake( ) is called.
+     *
+     * \param micros  time to sleep, in microseconds
+     *
+     * \return bool  true if the full time elapsed
+     */
+    bool waitFor( const uint32_t& micros );
+
+    /*!
+     * Sleep until a subscribed signal changes or wake( ) is called.
+     */
+    void wait( );
+
+    /*!
+     * \return SignalMask  signals changed since the last call; clears them
+     * and rearms waitFor( )
+     */
+    SignalMask takeChanges( );
+
+    /*!
+     * Wake waitFor( ) without a change, e.g. to stop the subscribing loop.
+     */
+    void wake( );
+
+    /*!
+     * \return SignalMask  signals this subscriber receives
+     */
+    SignalMask getMask( ) const;
+
+    /*!
+     * \return int  eventfd readable while changes are pending, for loops
+     * that wait in poll( ) or epoll
+     */
+    int getEventSocket( ) const;
+
+private:
+
+    friend class SignalBus;
+
+    /*!
+     * Record \p changed signals and wake the subscriber; called by SignalBus.
+     */
+    void post_( const SignalMask& changed );
+
+    /*!
+     * signals this subscriber receives.
+     */
+    const SignalMask mask_;
+
+    /*!
+     * changed signals not yet taken.
+     */
+    std::atomic<SignalMask> pending_;
+
+    /*!
+     * wakes waitFor( ).
+     */
+    EventWaiter waiter_;
+
+};
+
+
+/*!
+ * \brief Publishes status signal changes to the subscribers of each signal.
+ */
+class SignalBus
+{
+
+public:
+
+    /*!
+     * Constructor.
+     */
+    SignalBus( );
+
+    /*!
+     * \param mask  signals to receive
+     *
+     * \return std::shared_ptr<SignalSubscriber>  new subscriber
+     */
+    std::shared_ptr<SignalSubscriber> subscribe( const SignalMask& mask );
+
+    /*!
+     * Stop delivering changes to \p subscriber.
+     */
+    void unsubscribe( const std::shared_ptr<SignalSubscriber>& subscriber );
+
+    /*!
+     * Deliver the \p changed signals to their subscribers.
+     */
+    void publish( const SignalMask& changed );
+
+private:
+
+    /*!
+     * guards subscribers_.
+     */
+    std::mutex subscriberMtx_;
+
+    /*!
+     * current subscribers.
+     */
+    std::vector< std::shared_ptr<SignalSubscriber> > subscribers_;
+
+};
+
+#endif //SIGNALBUS_HPP
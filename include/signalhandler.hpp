@@ -32,7 +32,13 @@
 
 #include "constants.h"
 #include "sockethandler.hpp" // TO use ASPM_PORT
+#include "asptransport.hpp"
+#include "latencyhistogram.hpp"
+#include "eventwaiter.hpp"
+#include "signalbus.hpp"
 #include "udppacket.hpp"
+#include "seqlock.hpp"
+#include "commandqueue.hpp"
 
 #include <vector>
 #include <string>
@@ -48,6 +54,9 @@
 
 #define UDP_BUF_MAX    512
 
+constexpr size_t TCM_COMMAND_QUEUE_SIZE = 64;      // commands queued between UDP cycles
+constexpr size_t ASP_THREAT_SEGMENT_COUNT = 16;    // threat segments per end of the vehicle
+
 /*!
  * Base container for signals used in TCM <-> ASPM communications
  */
@@ -103,6 +112,96 @@ class LMSignalInfo
         lm_signal_t lm_signal;
 };
 
+/*!
+ * One deadmans_handle sample from the mobile device, published to the UDP
+ * encoder as a unit.
+ *
+ * \sa SignalHandler::setDmhInput( )
+ */
+struct DmhInput
+{
+    TCM::AppSliderPosX AppSliderPosX;               //!< x coordinate
+    TCM::AppSliderPosY AppSliderPosY;               //!< y coordinate
+    TCM::AppAccelerationZ AppAccelerationZ;         //!< gesture progress
+    TCM::ManeuverEnableInput ManeuverEnableInput;   //!< gesture validity
+    TCM::AppCalcCheck AppCalcCheck;                 //!< CRC over the sample
+};
+
+/*!
+ * Maneuver selection signals, which the ASP must see change together.
+ *
+ * \sa SignalHandler::setManeuverSelection( )
+ */
+struct ManeuverSelection
+{
+    TCM::ManeuverTypeSelect ManeuverTypeSelect;             //!< type of maneuver
+    TCM::ManeuverDirectionSelect ManeuverDirectionSelect;   //!< nose or rear first
+    TCM::ManeuverGearSelect ManeuverGearSelect;             //!< gear to move in
+    TCM::ManeuverSideSelect ManeuverSideSelect;             //!< side of the vehicle
+    TCM::ExploreModeSelect ExploreModeSelect;               //!< straight maneuver
+    TCM::NudgeSelect NudgeSelect;                           //!< nudge maneuver
+};
+
+/*!
+ * Discrete command from the mobile device, queued for the UDP encoder.
+ */
+struct TcmCommand
+{
+    /*!
+     * signal the command sets.
+     */
+    enum class Type : uint8_t
+    {
+        ConnectionApproval,
+        DeviceControlMode,
+        ManeuverButtonPress,
+        ManeuverSelection
+    } type;
+
+    uint8_t value;                  //!< new signal value, unless a selection
+    ManeuverSelection selection;    //!< new selection, for ManeuverSelection
+};
+
+/*!
+ * ASP signals read by \p RemoteDeviceHandler, all from one decoded packet.
+ *
+ * \sa SignalHandler::getAspSnapshot( )
+ */
+struct AspSnapshot
+{
+    ASP::InfoMsg InfoMsg;
+    ASP::ActiveAutonomousFeature ActiveAutonomousFeature;
+    ASP::ActiveParkingType ActiveParkingType;
+    ASP::ActiveParkingMode ActiveParkingMode;
+    ASP::ManeuverStatus ManeuverStatus;
+    ASP::NoFeatureAvailableMsg NoFeatureAvailableMsg;
+    ASP::CancelMsg CancelMsg;
+    ASP::PauseMsg1 PauseMsg1;
+    ASP::PauseMsg2 PauseMsg2;
+    ASP::InstructMsg InstructMsg;
+    ASP::ExploreModeAvailability ExploreModeAvailability;
+    ASP::RemoteDriveAvailability RemoteDriveAvailability;
+    ASP::ManeuverSideAvailability ManeuverSideAvailability;
+    ASP::DirectionChangeAvailability DirectionChangeAvailability;
+    ASP::ActiveManeuverSide ActiveManeuverSide;
+    ASP::ActiveManeuverOrientation ActiveManeuverOrientation;
+    ASP::ParkTypeChangeAvailability ParkTypeChangeAvailability;
+    ASP::ManeuverDirectionAvailability ManeuverDirectionAvailability;
+    ASP::ManeuverAlignmentAvailability ManeuverAlignmentAvailability;
+    ASP::ConfirmAvailability ConfirmAvailability;
+    ASP::ResumeAvailability ResumeAvailability;
+    ASP::ReturnToStartAvailability ReturnToStartAvailability;
+    ASP::LongitudinalAdjustAvailability LongitudinalAdjustAvailability;
+    ASP::LongitudinalAdjustLength LongitudinalAdjustLength;
+    ASP::ManeuverProgressBar ManeuverProgressBar;
+    ASP::MobileChallengeSend MobileChallengeSend;
+
+    uint8_t ASPMFrontSegDistRMT[ ASP_THREAT_SEGMENT_COUNT ];   //!< front threat distances
+    uint8_t ASPMRearSegDistRMT[ ASP_THREAT_SEGMENT_COUNT ];    //!< rear threat distances
+    uint8_t ASPMFrontSegTypeRMT[ ASP_THREAT_SEGMENT_COUNT ];   //!< front threat types
+    uint8_t ASPMRearSegTypeRMT[ ASP_THREAT_SEGMENT_COUNT ];    //!< rear threat types
+};
+
 /*!
  * \brief Handles all TCM <--> ASP signal values.
  *
@@ -137,6 +236,153 @@ public:
      */
     virtual void initiateEventLoops( );
 
+    /*!
+     * Like initiateEventLoops( ), but no threads are started; the owner
+     * drives the link with sendSignals( ) and receiveSignals( ), and calls
+     * updateTimers( ) every ASP_REFRESH_RATE.  Lets one process host many
+     * vehicles on shared threads.
+     */
+    void initiateTicks( );
+
+    /*!
+     * Encode the TCM signals and send them to the ASP, as once per cycle of
+     * the signal loop.  Does nothing while no device is connected.
+     */
+    void sendSignals( );
+
+    /*!
+     * Decode the newest ASP packet if one has arrived; never blocks.
+     *
+     * \return ssize_t  size of the packet decoded, or -1 if none was ready
+     */
+    ssize_t receiveSignals( );
+
+    /*!
+     * Run one pass of the ranging timer; button presses time out in
+     * sendSignals( ).
+     */
+    void updateTimers( );
+
+    /*!
+     * \return int  descriptor that becomes readable when an ASP packet
+     * arrives, or -1 if the link must be polled with receiveSignals( )
+     */
+    int getEventSocket( );
+
+    /*!
+     * Select the ASP channel; takes effect at initiateEventLoops( ).
+     *
+     * \param port  UDP port on UDP_ADDR, or suffix for the co-located links
+     *
+     * \sa AspTransport::setPort( )
+     */
+    void setAspPort( const uint16_t& port );
+
+    /*!
+     * \return uint16_t  ASP channel selected by setAspPort( )
+     */
+    uint16_t getAspPort( ) const;
+
+    /*!
+     * Select the link to the ASP; takes effect at initiateEventLoops( ).
+     *
+     * \param type  transport to use; UDP by default
+     */
+    void setTransport( const AspTransportType& type );
+
+    /*!
+     * \return AspTransportType  transport selected for the ASP link
+     */
+    AspTransportType getTransportType( ) const;
+
+    /*!
+     * \return uint64_t  ASP packets skipped because a newer one had
+     * already arrived
+     */
+    uint64_t getSupersededPacketCount( );
+
+    /*!
+     * \return uint64_t  arrival time of the last decoded ASP packet, in
+     * CLOCK_REALTIME nanoseconds
+     */
+    uint64_t getAspReceiveTime( );
+
+    /*!
+     * \return uint64_t  time the last ASP packet was decoded, in
+     * CLOCK_REALTIME nanoseconds
+     */
+    uint64_t getAspDecodeTime( );
+
+    /*!
+     * Register \p callback to run on the receiving thread after each ASP
+     * packet is decoded.  Set before the event loops or ticks start.
+     *
+     * \param callback  must not block; a wakeup is all it should do
+     */
+    void setStateCallback( const std::function< void( ) >& callback );
+
+    /*!
+     * \return SignalBus&  publishes changes of the status signals right
+     * after the ASP packet that carried them is decoded; signals written
+     * directly are not published
+     */
+    SignalBus& getSignalBus( );
+
+    /*!
+     * \return uint64_t  version of the signal state, increased whenever a
+     * decoded ASP packet differs from the last one or markStateChanged( )
+     * is called; responses built at one version may be reused until it
+     * changes
+     */
+    uint64_t getStateVersion( ) const;
+
+    /*!
+     * Increase the state version after changing signals other than by
+     * decoding an ASP packet.
+     */
+    void markStateChanged( );
+
+    /*!
+     * \brief Copy of the decoded ASP signals, never mixing two packets.
+     *
+     * Wait-free for the caller; retries only while a packet is being
+     * published.  Safe from any thread.
+     *
+     * \return AspSnapshot  signals as of the last publishAspSnapshot( )
+     */
+    AspSnapshot getAspSnapshot( ) const;
+
+    /*!
+     * Publish the ASP signal members as one snapshot, and their status
+     * changes on the signal bus.  Decoded packets publish themselves; call
+     * it after writing the members, or AcknowledgeRemotePIN and ErrorMsg,
+     * by other means.
+     */
+    void publishAspSnapshot( );
+
+    /*!
+     * Record decode-to-send latency for the ASP packet that last changed
+     * ManeuverStatus; called once its JSON is handed to the socket.  Only
+     * the first call after a change records a sample.
+     */
+    void recordManeuverStatusSent( );
+
+    /*!
+     * \return LatencyHistogram&  kernel arrival to decode of ASP packets
+     */
+    LatencyHistogram& getArrivalToDecodeLatency( );
+
+    /*!
+     * \return LatencyHistogram&  decode of a ManeuverStatus change to its
+     * JSON being sent
+     */
+    LatencyHistogram& getDecodeToSendLatency( );
+
+    /*!
+     * Print both latency histograms.
+     */
+    void printLatencyReport( );
+
     /*!
      *  \brief Used to parse a MANOUEVRE code from a std::string
      *
@@ -152,6 +398,13 @@ public:
      */
     void setInputManeuverSignals( const MANOUEVRE& maneuver );
 
+    /*!
+     * \brief Set all maneuver selection signals as one command.
+     *
+     * \param selection  desired signal values to tell to the ASP
+     */
+    void setManeuverSelection( const ManeuverSelection& selection );
+
     /*!
      * \brief Sets the 'DeviceControlMode_RD' ASP signal to certain mode.
      * Assigns corresponding signals according to sequence diagram logic.
@@ -181,12 +434,33 @@ public:
      * \param xCoord  current x coordinate from RemoteDeviceHandler
      * \param yCoord  current y coordinate from RemoteDeviceHandler
      * \param gesturePercent  current gesture progress from RemoteDeviceHandler
+     * \param validGesture  current validity of the gesture
+     * \param crc  CRC computed by the mobile device over the sample
+     *
+     * \sa setDmhInput( )
      */
     void setManeuverEnableInput(
             const uint16_t& xCoord,
             const uint16_t& yCoord,
             const int64_t& gesturePercent,
-            const bool& validGesture );
+            const bool& validGesture,
+            const TCM::AppCalcCheck& crc );
+
+    /*!
+     * \brief Publish a DMH sample without blocking.
+     *
+     * The UDP encoder picks up the latest sample at the start of its next
+     * cycle and copies it into the DMH signal members, so a packet never
+     * mixes coordinates or CRC from two samples.  Safe from any thread.
+     *
+     * \param input  sample to publish
+     */
+    void setDmhInput( const DmhInput& input );
+
+    /*!
+     * \return DmhInput  latest published DMH sample
+     */
+    DmhInput getDmhInput( ) const;
 
     /*!
      * \brief Sets the 'InControlRemotePin_RD' ASP signal to certain mode.
@@ -354,6 +628,15 @@ public:
     */
     std::string getManeuverFromASP( );
 
+    /*!
+     * \brief Same as getManeuverFromASP( ), from a snapshot.
+     *
+     * \param snapshot  decoded ASP signals to read
+     *
+     * \return std::string  maneuver currently active, or "" if none
+     */
+    static std::string getManeuverFromASP( const AspSnapshot& snapshot );
+
     /*!
      * Method for returning specific node value for ASPMFrontSegDistxxRMT
      *
@@ -486,6 +769,8 @@ public:
 
     /*
     *** WRITE SIGNALS TO ASP ***
+    *   Command signals hold the value last requested; the ASP receives them,
+    *   in order, only through their set*( ) methods.
     */
 
     /*!
@@ -524,7 +809,8 @@ public:
     TCM::ManeuverSideSelect ManeuverSideSelect;
 
     /*!
-     * Holds the current ASP signal value for reference; write to ASP
+     * Holds the DMH signal value last encoded; write to ASP through
+     * setDmhInput( ), which the UDP encoder copies from
      */
     TCM::ManeuverEnableInput ManeuverEnableInput;
 
@@ -539,14 +825,16 @@ public:
     TCM::NudgeSelect NudgeSelect;
 
     /*!
-     * Holds the current ASP signal value for reference; write to ASP
+     * Holds the DMH signal value last encoded; write to ASP through
+     * setDmhInput( ), which the UDP encoder copies from
      * X coordinate from mobile to be passed to DMH
      * PhysicalRange 0 - 2047 1 0
      */
     TCM::AppSliderPosX AppSliderPosX;
 
     /*!
-     * Holds the current ASP signal value for reference; write to ASP
+     * Holds the DMH signal value last encoded; write to ASP through
+     * setDmhInput( ), which the UDP encoder copies from
      * X coordinate from mobile to be passed to DMH
      * PhysicalRange 0 - 4095 1 0
      */
@@ -558,7 +846,8 @@ public:
     TCM::RemoteDeviceBatteryLevel RemoteDeviceBatteryLevel;
 
     /*!
-     * Holds the current ASP signal value for reference; write to ASP
+     * Holds the DMH signal value last encoded; write to ASP through
+     * setDmhInput( ), which the UDP encoder copies from
      */
     TCM::AppCalcCheck AppCalcCheck;
 
@@ -578,7 +867,8 @@ public:
     TCM::AppAccelerationY AppAccelerationY;
 
     /*!
-     * Holds the current ASP signal value for reference; write to ASP
+     * Holds the DMH signal value last encoded; write to ASP through
+     * setDmhInput( ), which the UDP encoder copies from
      */
     TCM::AppAccelerationZ AppAccelerationZ;
 
@@ -862,9 +1152,79 @@ private:
     void rangingRequestEventLoop_( );
 
     /*!
-     * Loop for checking if ManeuverButtonPress has expired IAW BUTTON_TIMEOUT_RATE
+     * One pass of rangingRequestEventLoop_( ).
+     */
+    void updateRanging_( );
+
+    /*!
+     * Decode an ASP packet and record its age, or report a bad length.
+     *
+     * \param buffer  packet received from the ASP
+     * \param bytes  result of the receive
+     */
+    void handleASPMPacket_( uint8_t* buffer, const ssize_t& bytes );
+
+    /*!
+     * Check \p pin and update AcknowledgeRemotePIN; see setInControlRemotePin( ).
+     *
+     * \param pin  PIN received from the mobile device
      */
-    void buttonPressEventLoop_( );
+    void checkRemotePin_( const std::string& pin );
+
+    /*!
+     * Set \p signal to \p value and mark it for publishing once the packet
+     * is decoded, if it changed.
+     *
+     * \param signal  member holding the status signal
+     * \param value  decoded value
+     * \param id  signal published to the bus
+     */
+    template <typename T>
+    void updateSignal_( T& signal, const T& value, const StatusSignal& id )
+    {
+        if( signal != value )
+        {
+            signal = value;
+            changedSignals_ |= signalBit( id );
+        }
+    }
+
+    /*!
+     * \return AspSnapshot  the ASP signal members as they are now
+     */
+    AspSnapshot captureAspSnapshot_( ) const;
+
+    /*!
+     * Queue a command for the UDP encoder without blocking, and record it as
+     * the latest of its type; on overflow the encoder instead resyncs once
+     * from those latest values.
+     *
+     * \param command  command to queue
+     */
+    void queueCommand_( const TcmCommand& command );
+
+    /*!
+     * Apply queued commands to commandSignals_ in order, on the UDP thread at
+     * the start of each packet.  Stops before a command that would overwrite
+     * a signal set earlier in the same pass, so every command goes out in at
+     * least one packet, and clears a button press BUTTON_TIMEOUT_RATE after
+     * it first went out.
+     */
+    void applyCommands_( );
+
+    /*!
+     * Copy a decoded ASPM_LM PDU into the ASP signal members.
+     *
+     * \param values  signal values indexed by ASPM_LM::ID
+     */
+    void applyAspmLm_( const uint64_t* values );
+
+    /*!
+     * Copy a decoded ASPM_LM_ObjSegment PDU into the threat data members.
+     *
+     * \param values  signal values indexed by ASPM_LM_ObjSegment::ID
+     */
+    void applyAspmObjSegment_( const uint64_t* values );
 
     /*
     *** Private Members ***
@@ -885,11 +1245,6 @@ private:
      */
     std::string pinStoredInVDC_;
 
-    /*!
-     * Holds the starting time to countdown maneuver button reset
-     */
-    timeval maneuverButtonPressTime_;
-
     /*!
      * Holds the time limit to countdown allowable PIN entries again
      */
@@ -906,9 +1261,45 @@ private:
     unsigned int pinLockoutLimit_;
 
     /*!
-     * SocketHandler object for handling all socket communications.
+     * transport selected for the ASP link.
+     */
+    AspTransportType transportType_;
+
+    /*!
+     * channel selected for the ASP link.
      */
-    SocketHandler socketHandler_;
+    uint16_t aspPort_;
+
+    /*!
+     * link to the ASP, opened by initiateEventLoops( ).
+     */
+    std::unique_ptr<AspTransport> transport_;
+
+    /*!
+     * arrival time of the last decoded ASP packet, in nanoseconds.
+     */
+    std::atomic<uint64_t> aspReceiveTime_;
+
+    /*!
+     * decode time of the last ASP packet, in nanoseconds.
+     */
+    std::atomic<uint64_t> aspDecodeTime_;
+
+    /*!
+     * decode time of the ASP packet that last changed ManeuverStatus; 0
+     * once recorded.
+     */
+    std::atomic<uint64_t> maneuverStatusChangeTime_;
+
+    /*!
+     * kernel arrival to decode of ASP packets.
+     */
+    LatencyHistogram arrivalToDecode_;
+
+    /*!
+     * decode of a ManeuverStatus change to its JSON being sent.
+     */
+    LatencyHistogram decodeToSend_;
 
     /*!
      * loopHandler for running signal update loop on separate thread.
@@ -921,14 +1312,92 @@ private:
     std::thread rangingLoopHandler_;
 
     /*!
-     * loopHandler for timing out the ManeuverButtonPress signal after 240ms.
+     * indicates that the event loops are currently "spinning"
      */
-    std::thread buttonPressLoopHandler_;
+    std::atomic<bool> running_;
 
     /*!
-     * indicates that the event loops are currently "spinning"
+     * sleep of the event loops, cut short by stop( ).
      */
-    std::atomic<bool> running_;
+    EventWaiter wakeup_;
+
+    /*!
+     * run after each decoded ASP packet; see setStateCallback( ).
+     */
+    std::function< void( ) > stateCallback_;
+
+    /*!
+     * publishes status signal changes; see getSignalBus( ).
+     */
+    SignalBus signalBus_;
+
+    /*!
+     * status signals changed by the ASP packet being decoded.
+     */
+    SignalMask changedSignals_;
+
+    /*!
+     * see getStateVersion( ).
+     */
+    std::atomic<uint64_t> stateVersion_;
+
+    /*!
+     * last decoded ASP packet, to tell whether the state changed.
+     */
+    uint8_t lastAspPacket_[ ASPM_TOTAL_PACKET_SIZE ];
+
+    /*!
+     * DMH samples from the mobile device; see setDmhInput( ).
+     */
+    Seqlock<DmhInput> dmhInput_;
+
+    /*!
+     * version of dmhInput_ last copied into the DMH signal members by the
+     * UDP encoder.
+     */
+    uint32_t dmhInputVersion_;
+
+    /*!
+     * decoded ASP signals for readers on other threads; see getAspSnapshot( ).
+     */
+    Seqlock<AspSnapshot> aspSnapshot_;
+
+    /*!
+     * commands from the mobile device, in the order given; see queueCommand_( ).
+     */
+    CommandQueue<TcmCommand, TCM_COMMAND_QUEUE_SIZE> commands_;
+
+    /*!
+     * a command was dropped because commands_ was full.
+     */
+    std::atomic<bool> commandOverflow_;
+
+    /*!
+     * latest value queued for each command, whether or not it fit in
+     * commands_; written by queueCommand_( ), read by the UDP encoder to
+     * resync after an overflow.
+     */
+    std::atomic<TCM::ConnectionApproval> latestConnectionApproval_;
+    std::atomic<TCM::DeviceControlMode> latestDeviceControlMode_;          //!< \sa latestConnectionApproval_
+    std::atomic<TCM::ManeuverButtonPress> latestManeuverButtonPress_;      //!< \sa latestConnectionApproval_
+    Seqlock<ManeuverSelection> latestSelection_;                           //!< \sa latestConnectionApproval_
+
+    /*!
+     * command signal values as encoded; owned by the UDP thread, which
+     * updates them from commands_ only.
+     */
+    struct
+    {
+        TCM::ConnectionApproval ConnectionApproval;
+        TCM::DeviceControlMode DeviceControlMode;
+        TCM::ManeuverButtonPress ManeuverButtonPress;
+        ManeuverSelection selection;
+    } commandSignals_;
+
+    /*!
+     * when commandSignals_.ManeuverButtonPress first went out, in ns.
+     */
+    uint64_t buttonPressSentTime_;
 
     /*!
      * temporary state variable to indicate engine state; TODO: obsolete this once CCM
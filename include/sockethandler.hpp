@@ -30,19 +30,37 @@
 #if !defined( SOCKETHANDLER_HPP )
 #define SOCKETHANDLER_HPP
 
+#include <map>
+#include <deque>
+#include <atomic>
+#include <mutex>
 #include <tuple>
 #include <string>
+#include <vector>
 #include <iostream>
+#include <functional>
+
+#include "ringbuffer.hpp"
+
+#if defined( USE_IO_URING )
+#include "uringqueue.hpp"
+#endif
 
 #include <time.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <errno.h>
+#include <fcntl.h>
 #include <unistd.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/timerfd.h>
+#include <sys/uio.h>
 #include <sys/types.h>
 #include <sys/socket.h>
 #include <netinet/in.h>
+#include <netinet/tcp.h>
 #include <arpa/inet.h>
 #include <netdb.h>
 
@@ -50,6 +68,51 @@ constexpr auto TCP_ADDR = "0.0.0.0";
 constexpr auto UDP_ADDR = "127.0.0.1";
 constexpr auto TCP_PORT = 8063;
 constexpr auto UDP_PORT = 8064;
+constexpr auto TCP_MAX_EVENTS = 16;
+constexpr auto TCP_TX_QUEUE_DEPTH = 64;            // frames, per connection
+constexpr auto TCP_TX_BATCH_MAX = 64;               // frames, per sendmsg
+constexpr auto TCP_MAX_FRAME_SIZE = 65536;          // bytes, header + body
+constexpr auto TCP_FRAME_PREFIX_SIZE = 8;           // bytes, two length words
+constexpr auto TCP_KEEPALIVE_IDLE = 1;              // s, idle before probing
+constexpr auto TCP_KEEPALIVE_INTERVAL = 1;          // s, between probes
+constexpr auto TCP_KEEPALIVE_COUNT = 3;             // probes before reset
+constexpr auto TCP_USER_TIMEOUT_MS = 3000;          // ms, unacknowledged data
+constexpr auto TCP_LIVENESS_PERIOD = 250;           // ms, liveness timer
+constexpr auto TCP_HEARTBEAT_TIMEOUT = 3000;        // ms, silence after heartbeat
+constexpr auto URING_QUEUE_DEPTH = 64;              // entries, per io_uring
+constexpr auto UDP_URING_BUF_SIZE = 1024;           // bytes, per registered buffer
+constexpr auto UDP_BATCH_MAX = 16;                  // datagrams, per recvmmsg / sendmmsg
+constexpr auto UDP_BATCH_BUF_SIZE = 1024;           // bytes, per batched datagram
+
+
+/*!
+ * Callback invoked once per complete frame received from a mobile connection.
+ * Arguments are the connection id, a pointer to the raw frame (header followed
+ * by body) inside the connection's receive buffer, the header length, and the
+ * body length.  The pointer is only valid for the duration of the call.
+ */
+typedef std::function< void(
+        const int&,
+        const char*,
+        const uint32_t&,
+        const uint32_t& ) > MessageCallback;
+
+/*!
+ * Action taken when a frame is sent to a connection whose outbound queue is
+ * already full.
+ */
+enum class BackpressurePolicy : uint8_t
+{
+    Disconnect = 0,     //!< close the connection; the peer has stalled
+    DropOldest = 1,     //!< discard the oldest unsent frame
+    DropNewest = 2      //!< discard the frame being sent
+};
+
+/*!
+ * Callback invoked when a mobile connection is accepted or closed.  Argument
+ * is the connection id.
+ */
+typedef std::function< void( const int& ) > ConnectionCallback;
 
 
 /*!
@@ -58,6 +121,25 @@ constexpr auto UDP_PORT = 8064;
  * Stores all address information, generates sockets, and sends/receives data
  * via TCP or UDP
  *
+ * For TCP, the listening socket and every accepted client socket are
+ * non-blocking and registered edge-triggered on a single epoll instance.
+ * pollEvents( ) accepts new clients, drains readable sockets, and hands each
+ * complete frame to the registered \p MessageCallback, so one thread can serve
+ * several mobile devices, diagnostic tools, and test rigs at once.
+ *
+ * Client sockets use TCP keepalive and TCP_USER_TIMEOUT, and a periodic
+ * timer closes any connection with a pending socket error or whose
+ * application heartbeat has lapsed, so a vanished peer is torn down within a
+ * bounded time rather than on the next blocking read.
+ *
+ * Outbound frames from any thread are placed on a bounded per-connection
+ * queue and only the pollEvents( ) thread writes to client sockets, so frames
+ * never interleave on the wire and a stalled peer never blocks a producer.
+ *
+ * Built with USE_IO_URING, queued frames for all clients are written with a
+ * single io_uring submission, and each ASP send / receive cycle is one linked
+ * submission from registered buffers; see exchangeUDP( ).
+ *
  * \warning
  * This class is constructed to be used in a bench test setup and may require
  * additional functionality once deployed to a vehicle VDC.
@@ -88,24 +170,91 @@ public:
             const bool& isTCM = false );
 
     /*!
-     * Public-accessible function to connect client socket to desired address.
+     * Register the callback invoked for each complete frame received.
+     *
+     * \param callback  handler for received frames
+     */
+    void setMessageCallback( const MessageCallback& callback );
+
+    /*!
+     * Register the callback invoked after a new client has been accepted.
+     *
+     * \param callback  handler for new connections
+     */
+    void setConnectCallback( const ConnectionCallback& callback );
+
+    /*!
+     * Register the callback invoked after a client has been closed.
+     *
+     * \param callback  handler for closed connections
+     */
+    void setDisconnectCallback( const ConnectionCallback& callback );
+
+    /*!
+     * Wait for activity on the listening socket and all client sockets, then
+     * service every ready socket.  Must be called from a single thread.
+     *
+     * \param timeoutMs  maximum time to wait for activity, in ms
+     *
+     * \return int  number of ready sockets serviced, or -1 on error
+     */
+    int pollEvents( const int& timeoutMs );
+
+    /*!
+     * Make a pending or the next pollEvents( ) return at once, e.g. so the
+     * polling thread notices a stop request.
      */
-    void connectClient( );
+    void wake( );
 
     /*!
-     * Receive a message from a client and pass it to the server for parsing.
+     * epoll descriptor serviced by pollEvents( ); readable whenever
+     * pollEvents( 0 ) has work, so it can be nested in another epoll.
      *
-     * \param readVal  Return value from message receipt
-     * \param receivedMsg  String value of received message
-     * \param headerLen  message header length
-     * \param msgLen  message body length
+     * \return int  descriptor, or -1 before a TCP connectServer( )
+     */
+    int getEventSocket( ) const;
+
+    /*!
+     * \return int  socket opened by connectServer( ), or -1
+     */
+    int getServerSocket( ) const;
+
+    /*!
+     * Set the largest accepted frame (header + body); clients sending larger
+     * frames are disconnected.  Applies to connections accepted afterwards.
+     *
+     * \param maxFrameSize  largest frame in bytes
+     */
+    void setMaxFrameSize( const uint32_t& maxFrameSize );
+
+    /*!
+     * Enable or disable per-tick coalescing.  When enabled, every frame queued
+     * for a connection by the end of a pollEvents( ) iteration is written with
+     * a single syscall; otherwise each frame gets its own.
+     *
+     * \param coalesce  true to batch queued frames per iteration
+     */
+    void setCoalescing( const bool& coalesce );
+
+    /*!
+     * Set the outbound queue depth and the action taken when it is exceeded.
      *
+     * \param policy  action on a full queue
+     * \param depth  maximum unsent frames per connection
      */
-    void receiveTCP(
-            ssize_t& readVal,
-            std::string& receivedMsg,
-            uint32_t& headerLen,
-            uint32_t& msgLen );
+    void setBackpressurePolicy(
+            const BackpressurePolicy& policy,
+            const size_t& depth = TCP_TX_QUEUE_DEPTH );
+
+    /*!
+     * Number of queued frames replaced by a newer frame with the same key.
+     */
+    uint64_t getSupersededFrameCount( );
+
+    /*!
+     * Number of frames discarded, or connections closed, by backpressure.
+     */
+    uint64_t getDroppedFrameCount( );
 
     /**
      * Receive a message from a ASPM and pass it to the server for parsing.
@@ -114,16 +263,88 @@ public:
      */
     ssize_t receiveUDP( void* buffer, const uint16_t& bufSize );
 
+    /*!
+     * Block for a datagram, then drain everything else already queued with
+     * recvmmsg( ) and keep only the newest valid one.  Older valid datagrams
+     * are counted as superseded, so after a stall the next cycle starts from
+     * current data instead of working through a backlog.
+     *
+     * \param buffer  destination for the newest valid datagram
+     * \param bufSize  size of \p buffer
+     * \param validSize  size of a valid datagram; 0 accepts any size
+     *
+     * \return ssize_t  size of the datagram in \p buffer; if none was valid,
+     * the newest invalid one is returned so the caller can report it
+     */
+    ssize_t receiveLatestUDP(
+            void* buffer,
+            const uint16_t& bufSize,
+            const uint16_t& validSize = 0 );
+
+    /*!
+     * Valid datagrams discarded by receiveLatestUDP( ) for a newer one.
+     *
+     * \return uint64_t  superseded datagram count
+     */
+    uint64_t getSupersededPacketCount( );
+
+    /*!
+     * Like receiveLatestUDP( ), but return at once when nothing is queued.
+     *
+     * \param buffer  destination for the newest valid datagram
+     * \param bufSize  size of \p buffer
+     * \param validSize  size of a valid datagram; 0 accepts any size
+     *
+     * \return ssize_t  size of the datagram in \p buffer, or -1 with errno
+     * EAGAIN when the socket is empty
+     */
+    ssize_t pollLatestUDP(
+            void* buffer,
+            const uint16_t& bufSize,
+            const uint16_t& validSize = 0 );
+
+    /*!
+     * Kernel arrival time of the datagram last returned by
+     * receiveLatestUDP( ) or exchangeUDP( ), from SO_TIMESTAMPNS.
+     *
+     * \return uint64_t  CLOCK_REALTIME nanoseconds; 0 if not stamped
+     */
+    uint64_t getLastReceiveTimestamp( );
+
     /*!
      * Public-accessible function to send desired message from server to client.
      *
+     * Frames sent while a received frame is being dispatched on the
+     * pollEvents( ) thread are returned to the connection that sent it; all
+     * other frames are broadcast to every connected client.  Frames are
+     * queued and written by the pollEvents( ) thread.
+     *
+     * \param msgHeader  String value of message header to be sent
+     * \param msgBody  String value of message body to be sent
+     * \param supersedeKey  if not empty, an unsent queued frame with the same
+     * key is replaced by this one (latest wins)
+     *
+     */
+    void sendTCP(
+            const std::string& msgHeader,
+            const std::string& msgBody,
+            const std::string& supersedeKey = "" );
+
+    /*!
+     * Send desired message from server to a single client.
+     *
+     * \param connection  id of the receiving connection
      * \param msgHeader  String value of message header to be sent
      * \param msgBody  String value of message body to be sent
+     * \param supersedeKey  if not empty, an unsent queued frame with the same
+     * key is replaced by this one (latest wins)
      *
      */
     void sendTCP(
+            const int& connection,
             const std::string& msgHeader,
-            const std::string& msgBody );
+            const std::string& msgBody,
+            const std::string& supersedeKey = "" );
 
     /*!
      * Public-accessible function to send desired message from server to client.
@@ -135,12 +356,97 @@ public:
     int32_t sendUDP( const void* buffer, const uint16_t& bufSize );
 
     /*!
-     * Public-accessible function to disconnect client socket from server.
+     * Send several datagrams with a single sendmmsg( ).
+     *
+     * \param packets  one entry per datagram
+     * \param count  number of datagrams, at most UDP_BATCH_MAX
+     * \param peers  destination per datagram; NULL sends all to the peer
+     * used by sendUDP( )
      *
-     * \param listen_for_new  true if server should begin listening for another client to connect
+     * \return int  number of datagrams sent, or -1 on error
+     */
+    int sendBatchUDP(
+            const struct iovec* packets,
+            const unsigned& count,
+            const struct sockaddr_in* peers = NULL );
+
+    /*!
+     * Send a UDP message and wait for the reply, as done once per ASP cycle.
+     *
+     * With the io_uring backend the write and the read are submitted
+     * together, linked, from registered buffers, so a cycle costs a single
+     * system call; otherwise this is sendUDP( ) followed by receiveUDP( ).
+     *
+     * \param bufferOut  message buffer to be sent
+     * \param sizeOut  size of message buffer to be sent
+     * \param bufferIn  buffer for the reply
+     * \param sizeIn  size of reply buffer
+     *
+     * \return ssize_t  size of the reply, or -1 with errno set
+     */
+    ssize_t exchangeUDP(
+            const void* bufferOut,
+            const uint16_t& sizeOut,
+            void* bufferIn,
+            const uint16_t& sizeIn,
+            const uint16_t& validSize = 0 );
+
+    /*!
+     * Select between the io_uring backend and plain socket calls at run time.
+     * Has no effect unless built with USE_IO_URING.
+     *
+     * \param enable  true to use io_uring where it is available
+     */
+    void setUringEnabled( const bool& enable );
+
+    /*!
+     * \return bool  true if transfers currently go through io_uring
+     */
+    bool isUringEnabled( ) const;
+
+    /*!
+     * Public-accessible function to disconnect all client sockets from server.
+     *
+     * \param listen_for_new  true if server should keep accepting new clients
      */
     void disconnectClient( bool listen_for_new = true );
 
+    /*!
+     * Disconnect a single client socket from server.
+     *
+     * \param connection  id of the connection to close
+     */
+    void disconnectClient( const int& connection );
+
+    /*!
+     * Number of clients currently connected.
+     *
+     * \return size_t  connected client count
+     */
+    size_t getClientCount( );
+
+    /*!
+     * \return std::vector<int>  ids of the connected clients
+     */
+    std::vector<int> getConnections( );
+
+    /*!
+     * \return int  id of the connection whose frame the calling thread is
+     * dispatching, or -1 outside a \p MessageCallback
+     */
+    int getDispatchConnection( ) const;
+
+    /*!
+     * Run \p send as if dispatching a frame from \p connection, so the frames
+     * it sends go to that connection only, then write them out.  Call from
+     * the pollEvents( ) thread, e.g. for replies completed after the frame
+     * that asked for them.
+     *
+     * \param connection  id of the receiving connection
+     * \param send  sends the reply
+     */
+    void dispatchAs( const int& connection, const std::function< void( ) >& send );
+
     /*!
      * Public-accessible function to disconnect server socket.
      */
@@ -149,42 +455,358 @@ public:
     /*!
      * Public-accessible function to check client / server socket connection.
      *
-     * \return int  Return value from socket check; "0" means good connection
+     * Sockets with a pending error are closed by the liveness timer, so this
+     * only looks for a connection that is not closing; it makes no system
+     * calls.
+     *
+     * \return int  "0" if at least one client is connected, else "-1"
      */
     int checkClientConnection( );
 
+    /*!
+     * Check a single client connection for a pending socket error.
+     *
+     * \param connection  id of the connection to check
+     *
+     * \return int  SO_ERROR of the socket, or -1 if it is not connected; "0"
+     * means good connection
+     */
+    int checkClientConnection( const int& connection );
+
+    /*!
+     * Require a connection to keep sending; once nothing has been received
+     * for longer than the timeout, the liveness timer closes it.
+     *
+     * \param connection  id of the connection
+     * \param timeoutMs  allowed silence in ms; 0 disables the check
+     */
+    void setLivenessTimeout( const int& connection, const uint32_t& timeoutMs );
+
     /*!
      * Public-accessible reference for if client is currently connected.
      */
-    bool isClientConnected;
+    std::atomic<bool> isClientConnected;
 
 
 private:
 
+    /*!
+     * \brief Framed message waiting in a connection's outbound queue.
+     */
+    struct OutboundFrame
+    {
+
+        /*!
+         * length words, header, and body, ready to write.
+         */
+        std::string bytes;
+
+        /*!
+         * latest-wins key; empty if the frame is never superseded.
+         */
+        std::string key;
+
+    };
+
+    /*!
+     * \brief Per-client connection state.
+     */
+    struct Connection
+    {
+
+        /*!
+         * client socket file descriptor; also used as the connection id.
+         */
+        int socket;
+
+        /*!
+         * struct to hold client socket information.
+         */
+        struct sockaddr_in address;
+
+        /*!
+         * bytes received but not yet dispatched as a complete frame.
+         */
+        RingBuffer rxBuffer;
+
+        /*!
+         * frames waiting to be written; front may be partially written.
+         */
+        std::deque<OutboundFrame> txQueue;
+
+        /*!
+         * bytes of the front frame already written.
+         */
+        size_t txOffset;
+
+        /*!
+         * true while the socket buffer is full and EPOLLOUT is awaited;
+         * atomic as senders on other threads read it without the lock.
+         */
+        std::atomic<bool> txBlocked;
+
+        /*!
+         * true while TCP_CORK is held because a frame is partially written.
+         */
+        bool corked;
+
+        /*!
+         * monotonic time of the last received bytes, in ms.
+         */
+        uint64_t lastReceived;
+
+        /*!
+         * allowed silence before the connection is closed, in ms; 0 if the
+         * peer has not opted in to heartbeats.
+         */
+        uint32_t livenessTimeout;
+
+        /*!
+         * true once the connection is due to be closed; set under
+         * connectionMtx_ by other threads and read without it by the poll
+         * thread.
+         */
+        std::atomic<bool> closing;
+
+    };
+
     /*!
      * Used to set server socket to listen for a new client.
      */
     void listenForNewClient_( );
 
+    /*!
+     * Accept every pending client on the listening socket.
+     */
+    void acceptClients_( );
+
+    /*!
+     * Drain a readable client socket and dispatch each complete frame.
+     *
+     * \param connection  connection to read from
+     */
+    void receiveTCP_( Connection& connection );
+
+    /*!
+     * Dispatch every complete frame held in a connection's receive buffer.
+     *
+     * \param connection  connection to parse
+     *
+     * \return bool  false if the connection sent an invalid frame
+     */
+    bool dispatchFrames_( Connection& connection );
+
+    /*!
+     * Place a frame on a connection's outbound queue, applying latest-wins
+     * replacement and the backpressure policy.  Requires connectionMtx_.
+     *
+     * \param connection  receiving connection
+     * \param frame  frame to queue
+     */
+    void enqueueFrame_( Connection& connection, const OutboundFrame& frame );
+
+    /*!
+     * Write as much of a connection's outbound queue as the socket accepts
+     * without blocking.  Requires connectionMtx_.
+     *
+     * \param connection  connection to write to
+     *
+     * \return bool  false if the socket failed
+     */
+    bool flushConnection_( Connection& connection );
+
+    /*!
+     * Point \p iov at the next frames of a connection's outbound queue, up
+     * to one frame unless coalescing.  Requires connectionMtx_.
+     *
+     * \param connection  connection to write to
+     * \param iov  array of at least TCP_TX_BATCH_MAX entries
+     *
+     * \return size_t  number of entries filled
+     */
+    size_t gatherFrames_( const Connection& connection, struct iovec* iov );
+
+    /*!
+     * Account for the result of a send: retire frames written in full, or
+     * block the connection until EPOLLOUT.  Requires connectionMtx_.
+     *
+     * \param connection  connection written to
+     * \param sent  bytes written, or -1 on failure
+     * \param error  errno of a failed send
+     *
+     * \return bool  false if the socket failed
+     */
+    bool completeSend_( Connection& connection, const ssize_t& sent, const int& error );
+
+#if defined( USE_IO_URING )
+    /*!
+     * Write every connection's outbound queue with one io_uring submission
+     * per round instead of one sendmsg( ) per connection.  Requires
+     * connectionMtx_.
+     */
+    void flushPendingUring_( );
+#endif
+
+    /*!
+     * Write out every connection's outbound queue; called once per
+     * pollEvents( ) iteration.
+     */
+    void flushPending_( );
+
+    /*!
+     * Wake pollEvents( ) so frames queued by another thread are written.
+     */
+    void wake_( );
+
+    /*!
+     * Read queued datagrams in batches until the socket is empty, keeping
+     * the newest valid one in \p buffer.
+     *
+     * \param buffer  destination; may already hold a datagram
+     * \param bufSize  size of \p buffer
+     * \param validSize  size of a valid datagram; 0 accepts any size
+     * \param flags  recvmmsg( ) flags for the first batch
+     * \param current  size of the datagram already in \p buffer, or -1
+     *
+     * \return ssize_t  size of the datagram in \p buffer, or -1 on error
+     */
+    ssize_t drainUDP_(
+            void* buffer,
+            const uint16_t& bufSize,
+            const uint16_t& validSize,
+            const int& flags,
+            const ssize_t& current );
+
+    /*!
+     * \param msg  received message with its control data
+     *
+     * \return uint64_t  SCM_TIMESTAMPNS stamp in nanoseconds, or 0
+     */
+    uint64_t readTimestamp_( struct msghdr* msg );
+
+    /*!
+     * Flag every connection with a pending socket error or a lapsed
+     * heartbeat for closing; run on each liveness timer tick.
+     */
+    void checkLiveness_( );
+
+    /*!
+     * Enable keepalive probing and a bounded retransmission time on a newly
+     * accepted client socket.
+     *
+     * \param socket  socket to configure
+     */
+    static void setKeepAlive_( const int& socket );
+
+    /*!
+     * Close a client socket and forget its connection state.
+     *
+     * \param connection  id of the connection to close
+     */
+    void closeClient_( const int& connection );
+
+    /*!
+     * Put a socket into non-blocking mode.
+     *
+     * \param socket  socket to configure
+     */
+    static void setNonBlocking_( const int& socket );
+
     /*!
      * int to hold server socket information.
      */
     int serverSocket_;
 
     /*!
-    * int to hold client socket information.
+     * epoll instance for the TCP server and its clients.
      */
-    int clientSocket_;
+    int epollSocket_;
 
     /*!
-    * struct to hold server socket information.
+     * eventfd used to wake pollEvents( ) from other threads.
      */
-    struct sockaddr_in serverAddress_;
+    int wakeSocket_;
+
+    /*!
+     * timerfd driving the periodic liveness check.
+     */
+    int timerSocket_;
 
     /*!
-    * struct to hold client socket information.
+     * per-client state keyed by client socket.
      */
-    struct sockaddr_in clientAddress_;
+    std::map< int, Connection > connections_;
+
+    /*!
+     * guards connections_ against concurrent senders and the poll thread.
+     */
+    std::mutex connectionMtx_;
+
+    /*!
+     * largest accepted frame (header + body), in bytes.
+     */
+    uint32_t maxFrameSize_;
+
+    /*!
+     * true if queued frames are written with one syscall per iteration.
+     */
+    bool coalesce_;
+
+    /*!
+     * action taken when an outbound queue is full.
+     */
+    BackpressurePolicy backpressurePolicy_;
+
+    /*!
+     * maximum unsent frames per connection.
+     */
+    size_t queueDepth_;
+
+    /*!
+     * frames replaced by a newer frame with the same key.
+     */
+    std::atomic<uint64_t> supersededFrames_;
+
+    /*!
+     * frames dropped, or connections closed, by backpressure.
+     */
+    std::atomic<uint64_t> droppedFrames_;
+
+    /*!
+     * valid datagrams skipped by receiveLatestUDP( ).
+     */
+    std::atomic<uint64_t> supersededPackets_;
+
+    /*!
+     * storage for batched datagrams, UDP_BATCH_MAX slots of
+     * UDP_BATCH_BUF_SIZE bytes; allocated on first use.
+     */
+    std::vector<uint8_t> udpBatch_;
+
+    /*!
+     * kernel arrival time of the last datagram returned, in nanoseconds.
+     */
+    std::atomic<uint64_t> lastReceiveTimestamp_;
+
+    /*!
+     * handler for received frames.
+     */
+    MessageCallback onMessage_;
+
+    /*!
+     * handler for new connections.
+     */
+    ConnectionCallback onConnect_;
+
+    /*!
+     * handler for closed connections.
+     */
+    ConnectionCallback onDisconnect_;
+
+    /*!
+    * struct to hold server socket information.
+     */
+    struct sockaddr_in serverAddress_;
 
     /*!
     * socklen_t to hold socket size information.
@@ -196,6 +818,38 @@ private:
      */
     time_t curTime_;
 
+    /*!
+     * true if transfers go through io_uring.
+     */
+    bool uringEnabled_;
+
+#if defined( USE_IO_URING )
+    /*!
+     * io_uring instance owned by the thread driving this socket.
+     */
+    UringQueue uring_;
+
+    /*!
+     * registered buffers for exchangeUDP( ); index 0 sends, index 1 receives.
+     */
+    uint8_t uringBuffers_[ 2 ][ UDP_URING_BUF_SIZE ];
+
+    /*!
+     * per-connection send state for one flushPendingUring_( ) round.
+     */
+    struct UringSend
+    {
+        Connection* connection;
+        struct msghdr msg;
+        struct iovec iov[ TCP_TX_BATCH_MAX ];
+    };
+
+    /*!
+     * reusable send state, sized to the queue depth.
+     */
+    std::vector<UringSend> uringSends_;
+#endif
+
 };
 
 
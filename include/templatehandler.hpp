@@ -99,6 +99,8 @@ public:
     static constexpr auto GET_CABIN_STATUS = "get_cabin_status";
     static constexpr auto CABIN_COMMANDS = "cabin_commands";
     static constexpr auto MOBILE_RESPONSE = "mobile_response";
+    static constexpr auto HEARTBEAT = "heartbeat";
+    static constexpr auto SET_BODY_ENCODING = "set_body_encoding";
     static constexpr auto VEHICLE_API_VERSION = "vehicle_api_version";
     static constexpr auto VEHICLE_STATUS = "vehicle_status";
     static constexpr auto VEHICLE_INIT = "vehicle_init";
@@ -107,6 +109,7 @@ public:
     static constexpr auto MANEUVER_STATUS = "maneuver_status";
     static constexpr auto MOBILE_CHALLENGE = "mobile_challenge";
     static constexpr auto CABIN_STATUS = "cabin_status";
+    static constexpr auto BODY_ENCODING = "body_encoding";
     static constexpr auto DEBUG = "debug";
 
 };
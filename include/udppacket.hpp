@@ -24,8 +24,16 @@
  *
  */
 
+#if !defined( UDPPACKET_HPP )
+#define UDPPACKET_HPP
+
 #include "constants.h"
 
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
+#include <arpa/inet.h>
+
 /*!
  * Describes the type of UDP packet to process
  */
@@ -54,6 +62,211 @@ typedef struct
     char payload[LENGTH_OF_ASPM_LARGEST_Size];  //!< Values of each signal in the PDU (bitwise translation)
 } pdu_packet_t;
 
+/*!
+ * PDU type of a header ID in a packet sent by the ASPM.
+ *
+ * \param headerID  header ID of the PDU
+ * \returns PDU type, or PDU_NONE if the ASPM sends no such PDU
+ */
+constexpr PDU_TYPE::ID aspmPduType( const uint32_t headerID )
+{
+    return headerID == HRD_ID_OF_ASPM_LM ? PDU_TYPE::PDU_ASPM_LM
+         : headerID == HRD_ID_OF_ASPM_RemoteTarget ? PDU_TYPE::PDU_ASPM_RemoteTarget
+         : headerID == HRD_ID_OF_ASPM_LM_Session ? PDU_TYPE::PDU_ASPM_LM_Session
+         : headerID == HRD_ID_OF_ASPM_LM_ObjSegment ? PDU_TYPE::PDU_ASPM_LM_ObjSegment
+         : headerID == HRD_ID_OF_ASPM_LM_Trunc ? PDU_TYPE::PDU_ASPM_LM_Trunc
+         : PDU_TYPE::PDU_NONE;
+}
+
+/*!
+ * PDU type of a header ID in a packet sent by the TCM.  Header IDs overlap
+ * between the two directions, so the sender decides the type.
+ *
+ * \param headerID  header ID of the PDU
+ * \returns PDU type, or PDU_NONE if the TCM sends no such PDU
+ */
+constexpr PDU_TYPE::ID tcmPduType( const uint32_t headerID )
+{
+    return headerID == HRD_ID_OF_TCM_LM ? PDU_TYPE::PDU_TCM_LM
+         : headerID == HRD_ID_OF_TCM_RemoteControl ? PDU_TYPE::PDU_TCM_RemoteControl
+         : headerID == HRD_ID_OF_TCM_LM_Session ? PDU_TYPE::PDU_TCM_LM_Session
+         : headerID == HRD_ID_OF_TCM_TransportKey ? PDU_TYPE::PDU_TCM_TransportKey
+         : headerID == HRD_ID_OF_TCM_LM_App ? PDU_TYPE::PDU_TCM_LM_App
+         : headerID == HRD_ID_OF_TCM_LM_KeyID ? PDU_TYPE::PDU_TCM_LM_KeyID
+         : headerID == HRD_ID_OF_TCM_LM_KeyAlpha ? PDU_TYPE::PDU_TCM_LM_KeyAlpha
+         : headerID == HRD_ID_OF_TCM_LM_KeyBeta ? PDU_TYPE::PDU_TCM_LM_KeyBeta
+         : headerID == HRD_ID_OF_TCM_LM_KeyGamma ? PDU_TYPE::PDU_TCM_LM_KeyGamma
+         : PDU_TYPE::PDU_NONE;
+}
+
+/*!
+ * Payload length of a PDU type.
+ *
+ * \param type  PDU type
+ * \returns payload length in bytes, or 0 for PDU_NONE
+ */
+constexpr uint32_t pduPayloadLength( const PDU_TYPE::ID type )
+{
+    return type == PDU_TYPE::PDU_ASPM_LM ? LENGTH_OF_ASPM_LM
+         : type == PDU_TYPE::PDU_ASPM_RemoteTarget ? LENGTH_OF_ASPM_RemoteTarget
+         : type == PDU_TYPE::PDU_ASPM_LM_Session ? LENGTH_OF_ASPM_LM_Session
+         : type == PDU_TYPE::PDU_ASPM_LM_ObjSegment ? LENGTH_OF_ASPM_LM_ObjSegment
+         : type == PDU_TYPE::PDU_ASPM_LM_Trunc ? LENGTH_OF_ASPM_LM_Trunc
+         : type == PDU_TYPE::PDU_TCM_LM ? LENGTH_OF_TCM_LM
+         : type == PDU_TYPE::PDU_TCM_RemoteControl ? LENGTH_OF_TCM_RemoteControl
+         : type == PDU_TYPE::PDU_TCM_LM_Session ? LENGTH_OF_TCM_LM_Session
+         : type == PDU_TYPE::PDU_TCM_TransportKey ? LENGTH_OF_TCM_TransportKey
+         : type == PDU_TYPE::PDU_TCM_LM_App ? LENGTH_OF_TCM_LM_App
+         : type == PDU_TYPE::PDU_TCM_LM_KeyID ? LENGTH_OF_TCM_LM_KeyID
+         : type == PDU_TYPE::PDU_TCM_LM_KeyAlpha ? LENGTH_OF_TCM_LM_KeyAlpha
+         : type == PDU_TYPE::PDU_TCM_LM_KeyBeta ? LENGTH_OF_TCM_LM_KeyBeta
+         : type == PDU_TYPE::PDU_TCM_LM_KeyGamma ? LENGTH_OF_TCM_LM_KeyGamma
+         : 0;
+}
+
+static_assert( aspmPduType( HRD_ID_OF_ASPM_LM_ObjSegment ) == PDU_TYPE::PDU_ASPM_LM_ObjSegment &&
+               tcmPduType( HRD_ID_OF_TCM_LM_App ) == PDU_TYPE::PDU_TCM_LM_App,
+               "header IDs shared by both directions resolve by sender" );
+
+/*!
+ * \brief Reads and writes one PDU of a UDP datagram in place.
+ *
+ * A pointer and the number of bytes left in the datagram, so it is copied
+ * freely and costs nothing to make.  Header fields are read and written
+ * through memcpy, so the PDU may start at any byte, and nothing is read or
+ * written past the end of the datagram: a view without room for a header,
+ * or for the payload length its header gives, is not valid.
+ *
+ * \sa SignalHandler::encodeTCMSignalData
+ * \sa SignalHandler::decodeASPMSignalData
+ */
+class PduView
+{
+
+public:
+
+    /*!
+     * View of the PDU at \p start.
+     *
+     * \param start      first byte of the PDU header
+     * \param available  bytes from \p start to the end of the datagram
+     */
+    PduView( uint8_t* start, const size_t& available )
+            :
+            start_( start ),
+            available_( available )
+    {
+
+    }
+
+    /*!
+     * \returns whether the header and the payload it announces fit
+     */
+    bool isValid( ) const
+    {
+        return available_ >= sizeof( pdu_header_t )
+               && getPayloadLength( ) <= available_ - sizeof( pdu_header_t );
+    }
+
+    /*!
+     * \returns header ID of the PDU, or 0 if there is no room for a header
+     */
+    uint32_t getHeaderID( ) const
+    {
+        return readField_( 0 );
+    }
+
+    /*!
+     * \returns payload length given in the header, or 0 if there is no room
+     * for a header
+     */
+    uint32_t getPayloadLength( ) const
+    {
+        return readField_( sizeof( uint32_t ) );
+    }
+
+    /*!
+     * \returns bytes from the start of this PDU to the end of the datagram
+     */
+    size_t getAvailable( ) const
+    {
+        return available_;
+    }
+
+    /*!
+     * \returns first byte of the payload
+     */
+    uint8_t* getPayload( ) const
+    {
+        return start_ + sizeof( pdu_header_t );
+    }
+
+    /*!
+     * Write the header, if the header and payload fit.
+     *
+     * \param headerID  PDU header ID
+     * \param length    payload length in bytes
+     * \returns false if they do not fit; nothing is written
+     */
+    bool putHeader( const uint32_t& headerID, const uint32_t& length )
+    {
+        if( available_ < sizeof( pdu_header_t ) || length > available_ - sizeof( pdu_header_t ) )
+        {
+            return false;
+        }
+
+        writeField_( 0, headerID );
+        writeField_( sizeof( uint32_t ), length );
+
+        return true;
+    }
+
+    /*!
+     * \returns view of the PDU after this one; empty if this one is not valid
+     */
+    PduView next( ) const
+    {
+        size_t used( isValid( ) ? sizeof( pdu_header_t ) + getPayloadLength( ) : available_ );
+
+        return PduView( start_ + used, available_ - used );
+    }
+
+
+private:
+
+    uint32_t readField_( const size_t& offset ) const
+    {
+        if( available_ < sizeof( pdu_header_t ) )
+        {
+            return 0;
+        }
+
+        uint32_t field;
+        memcpy( &field, start_ + offset, sizeof( field ) );
+
+        return ntohl( field );
+    }
+
+    void writeField_( const size_t& offset, const uint32_t& value )
+    {
+        uint32_t field( htonl( value ) );
+        memcpy( start_ + offset, &field, sizeof( field ) );
+    }
+
+    /*!
+     * first byte of the PDU header.
+     */
+    uint8_t* start_;
+
+    /*!
+     * bytes from start_ to the end of the datagram.
+     */
+    size_t available_;
+
+};
+
+static_assert( std::is_trivially_copyable<PduView>::value, "PduView is passed by value" );
+
 /*!
  * \brief Constructs and interprets PDU packets passed between the TCM and the ASPM
  *
@@ -61,8 +274,7 @@ typedef struct
  * which are byte arrays used for UDP communication between the TCM and the ASPM.
  * Each UDP datagram has several PDUs sent in sequence, each with their own header and payload.
  *
- * \sa SignalHandler::encodeTCMSignalData
- * \sa SignalHandler::decodeASPMSignalData
+ * \sa PduView for the same in place, without allocating
  */
 class SomePacket
 {
@@ -91,56 +303,10 @@ public :
         //printf("SomePacket(%p, %p)", start, payload);
 
         if (pkt_type == UdpPacketType::ReadASPMPacket) {
-            switch(getHeaderID()) {
-                case HRD_ID_OF_ASPM_LM:
-                    this->pdu_type = PDU_TYPE::PDU_ASPM_LM;
-                    break;
-                case HRD_ID_OF_ASPM_RemoteTarget:
-                    this->pdu_type = PDU_TYPE::PDU_ASPM_RemoteTarget;
-                    break;
-                case HRD_ID_OF_ASPM_LM_Session:
-                    this->pdu_type = PDU_TYPE::PDU_ASPM_LM_Session;
-                    break;
-                case HRD_ID_OF_ASPM_LM_ObjSegment:
-                    this->pdu_type = PDU_TYPE::PDU_ASPM_LM_ObjSegment;
-                    break;
-                case HRD_ID_OF_ASPM_LM_Trunc:
-                    this->pdu_type = PDU_TYPE::PDU_ASPM_LM_Trunc;
-                    break;
-                default :
-                    break;
-            }
+            this->pdu_type = aspmPduType(getHeaderID());
         }
         else if (pkt_type == UdpPacketType::ReadTCMPacket) {
-            switch(getHeaderID()) {
-                case HRD_ID_OF_TCM_LM:
-                    this->pdu_type = PDU_TYPE::PDU_TCM_LM;
-                    break;
-                case HRD_ID_OF_TCM_LM_App:
-                    this->pdu_type = PDU_TYPE::PDU_TCM_LM_App;
-                    break;
-                case HRD_ID_OF_TCM_LM_KeyAlpha:
-                    this->pdu_type = PDU_TYPE::PDU_TCM_LM_KeyAlpha;
-                    break;
-                case HRD_ID_OF_TCM_LM_KeyBeta:
-                    this->pdu_type = PDU_TYPE::PDU_TCM_LM_KeyBeta;
-                    break;
-                case HRD_ID_OF_TCM_LM_KeyGamma:
-                    this->pdu_type = PDU_TYPE::PDU_TCM_LM_KeyGamma;
-                    break;
-                case HRD_ID_OF_TCM_LM_KeyID:
-                    this->pdu_type = PDU_TYPE::PDU_TCM_LM_KeyID;
-                    break;
-                case HRD_ID_OF_TCM_LM_Session:
-                    this->pdu_type = PDU_TYPE::PDU_TCM_LM_Session;
-                    break;
-                case HRD_ID_OF_TCM_RemoteControl:
-                    this->pdu_type = PDU_TYPE::PDU_TCM_RemoteControl;
-                    break;
-                case HRD_ID_OF_TCM_TransportKey:
-                    this->pdu_type = PDU_TYPE::PDU_TCM_TransportKey;
-                    break;
-            }
+            this->pdu_type = tcmPduType(getHeaderID());
         }
     }
     virtual ~SomePacket() {};
@@ -156,70 +322,18 @@ public :
             someip->header.header_id = htonl(headerID);
 
             if (pkt_type == UdpPacketType::SendTCMPacket) {
-                switch(headerID) {
-                    case HRD_ID_OF_TCM_LM:
-                        this->pdu_type = PDU_TYPE::PDU_TCM_LM;
-                        this->putPayloadLength(LENGTH_OF_TCM_LM);
-                        break;
-                    case HRD_ID_OF_TCM_RemoteControl:
-                        this->pdu_type = PDU_TYPE::PDU_TCM_RemoteControl;
-                        this->putPayloadLength(LENGTH_OF_TCM_RemoteControl);
-                        break;
-                    case HRD_ID_OF_TCM_LM_Session:
-                        this->pdu_type = PDU_TYPE::PDU_TCM_LM_Session;
-                        this->putPayloadLength(LENGTH_OF_TCM_LM_Session);
-                        break;
-                    case HRD_ID_OF_TCM_TransportKey:
-                        this->pdu_type = PDU_TYPE::PDU_TCM_TransportKey;
-                        this->putPayloadLength(LENGTH_OF_TCM_TransportKey);
-                        break;
-                    case HRD_ID_OF_TCM_LM_App:
-                        this->pdu_type = PDU_TYPE::PDU_TCM_LM_App;
-                        this->putPayloadLength(LENGTH_OF_TCM_LM_App);
-                        break;
-                    case HRD_ID_OF_TCM_LM_KeyID:
-                        this->pdu_type = PDU_TYPE::PDU_TCM_LM_KeyID;
-                        this->putPayloadLength(LENGTH_OF_TCM_LM_KeyID);
-                        break;
-                    case HRD_ID_OF_TCM_LM_KeyAlpha:
-                        this->pdu_type = PDU_TYPE::PDU_TCM_LM_KeyAlpha;
-                        this->putPayloadLength(LENGTH_OF_TCM_LM_KeyAlpha);
-                        break;
-                    case HRD_ID_OF_TCM_LM_KeyBeta:
-                        this->pdu_type = PDU_TYPE::PDU_TCM_LM_KeyBeta;
-                        this->putPayloadLength(LENGTH_OF_TCM_LM_KeyBeta);
-                        break;
-                    case HRD_ID_OF_TCM_LM_KeyGamma:
-                        this->pdu_type = PDU_TYPE::PDU_TCM_LM_KeyGamma;
-                        this->putPayloadLength(LENGTH_OF_TCM_LM_KeyGamma);
-                        break;
-                    default :
-                        printf("Invalid header information.");
-                        break;
+                this->pdu_type = tcmPduType(headerID);
+                if (this->pdu_type == PDU_TYPE::PDU_NONE) {
+                    printf("Invalid header information.");
+                }
+                else {
+                    this->putPayloadLength(pduPayloadLength(this->pdu_type));
                 }
             }
             else if (pkt_type == UdpPacketType::SendASPMPacket) {
-                switch(headerID) {
-                    case HRD_ID_OF_ASPM_LM:
-                        this->pdu_type = PDU_TYPE::PDU_ASPM_LM;
-                        this->putPayloadLength(LENGTH_OF_ASPM_LM);
-                        break;
-                    case HRD_ID_OF_ASPM_LM_ObjSegment:
-                        this->pdu_type = PDU_TYPE::PDU_ASPM_LM_ObjSegment;
-                        this->putPayloadLength(LENGTH_OF_ASPM_LM_ObjSegment);
-                        break;
-                    case HRD_ID_OF_ASPM_LM_Session:
-                        this->pdu_type = PDU_TYPE::PDU_ASPM_LM_Session;
-                        this->putPayloadLength(LENGTH_OF_ASPM_LM_Session);
-                        break;
-                    case HRD_ID_OF_ASPM_LM_Trunc:
-                        this->pdu_type = PDU_TYPE::PDU_ASPM_LM_Trunc;
-                        this->putPayloadLength(LENGTH_OF_ASPM_LM_Trunc);
-                        break;
-                    case HRD_ID_OF_ASPM_RemoteTarget:
-                        this->pdu_type = PDU_TYPE::PDU_ASPM_RemoteTarget;
-                        this->putPayloadLength(LENGTH_OF_ASPM_RemoteTarget);
-                        break;
+                this->pdu_type = aspmPduType(headerID);
+                if (this->pdu_type != PDU_TYPE::PDU_NONE) {
+                    this->putPayloadLength(pduPayloadLength(this->pdu_type));
                 }
             }
             //RCD_LOGD("==================> SEND PACKET: %d", this->pdu_type);
@@ -278,3 +392,6 @@ public :
     }
     ///////////////////////////////////////////////////
 };
+
+
+#endif //UDPPACKET_HPP
@@ -0,0 +1,239 @@
+/*! \license
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * \copyright 2021 Dan Fernández
+ *
+ *
+ * \file Header for \p UringQueue class.
+ *
+ * \author fdaniel, trice2
+ */
+
+#if !defined( URINGQUEUE_HPP )
+#define URINGQUEUE_HPP
+
+#include <cstddef>
+#include <stdint.h>
+
+#include <sys/uio.h>
+#include <sys/socket.h>
+#include <linux/io_uring.h>
+
+
+/*!
+ * \brief Minimal io_uring submission / completion queue pair.
+ *
+ * Talks to the kernel through the raw io_uring system calls so that no
+ * userspace library is required.  Operations are prepared into the
+ * submission ring without any system call and handed to the kernel together
+ * by submit( ), which can also wait for their completions in the same call.
+ * Buffers registered up front are pinned once and referenced by index by the
+ * fixed read / write operations.
+ *
+ * Not thread-safe; each queue is owned by a single thread.
+ *
+ */
+class UringQueue
+{
+
+public:
+
+    /*!
+     * constructor
+     */
+    UringQueue( );
+
+    /*!
+     * destructor
+     */
+    ~UringQueue( );
+
+    UringQueue( const UringQueue& ) = delete;
+    UringQueue& operator=( const UringQueue& ) = delete;
+
+    /*!
+     * Create the rings and map them into this process.
+     *
+     * \param entries  submission queue depth
+     *
+     * \return bool  true if the kernel supports io_uring and setup succeeded
+     */
+    bool init( const unsigned& entries );
+
+    /*!
+     * \return bool  true once init( ) has succeeded
+     */
+    bool isReady( ) const;
+
+    /*!
+     * Pin buffers for use by prepareReadFixed( ) / prepareWriteFixed( ).
+     *
+     * \param buffers  buffers to register; index in this array is the
+     * buffer index used by the fixed operations
+     * \param count  number of buffers
+     *
+     * \return bool  true on success
+     */
+    bool registerBuffers( const struct iovec* buffers, const unsigned& count );
+
+    /*!
+     * Queue a sendmsg( ); \p msg must stay valid until the completion.
+     *
+     * \param socket  socket to send on
+     * \param msg  message to send
+     * \param flags  sendmsg( ) flags
+     * \param userData  value returned with the completion
+     *
+     * \return bool  false if the submission queue is full
+     */
+    bool prepareSendMsg(
+            const int& socket,
+            const struct msghdr* msg,
+            const int& flags,
+            const uint64_t& userData );
+
+    /*!
+     * Queue a recvmsg( ); \p msg must stay valid until the completion.
+     * Unlike a fixed read, control data such as receive timestamps is
+     * returned.
+     *
+     * \param socket  socket to receive on
+     * \param msg  destination message
+     * \param flags  recvmsg( ) flags
+     * \param userData  value returned with the completion
+     *
+     * \return bool  false if the submission queue is full
+     */
+    bool prepareRecvMsg(
+            const int& socket,
+            struct msghdr* msg,
+            const int& flags,
+            const uint64_t& userData );
+
+    /*!
+     * Queue a write from a registered buffer.
+     *
+     * \param socket  connected socket to write to
+     * \param buffer  start of data, inside registered buffer \p bufIndex
+     * \param len  number of bytes to write
+     * \param bufIndex  index of the registered buffer
+     * \param userData  value returned with the completion
+     * \param link  true to start the next queued operation only after this
+     * one completes
+     *
+     * \return bool  false if the submission queue is full
+     */
+    bool prepareWriteFixed(
+            const int& socket,
+            const void* buffer,
+            const uint32_t& len,
+            const uint16_t& bufIndex,
+            const uint64_t& userData,
+            const bool& link = false );
+
+    /*!
+     * Queue a read into a registered buffer.
+     *
+     * \param socket  connected socket to read from
+     * \param buffer  destination, inside registered buffer \p bufIndex
+     * \param len  maximum number of bytes to read
+     * \param bufIndex  index of the registered buffer
+     * \param userData  value returned with the completion
+     *
+     * \return bool  false if the submission queue is full
+     */
+    bool prepareReadFixed(
+            const int& socket,
+            void* buffer,
+            const uint32_t& len,
+            const uint16_t& bufIndex,
+            const uint64_t& userData );
+
+    /*!
+     * Hand every prepared operation to the kernel in one system call.
+     *
+     * \param waitFor  number of completions to wait for before returning
+     *
+     * \return int  number of operations submitted, or -1 with errno set
+     */
+    int submit( const unsigned& waitFor );
+
+    /*!
+     * Take the oldest completion off the completion ring.
+     *
+     * \param userData  value passed when the operation was prepared
+     * \param result  operation result; negative errno on failure
+     *
+     * \return bool  false if no completion is available
+     */
+    bool popCompletion( uint64_t& userData, int32_t& result );
+
+    /*!
+     * Unmap the rings and close the io_uring instance.
+     */
+    void release( );
+
+private:
+
+    /*!
+     * Claim and clear the next free submission queue entry.
+     *
+     * \return io_uring_sqe*  entry, or NULL if the queue is full
+     */
+    struct io_uring_sqe* nextEntry_( );
+
+    /*!
+     * io_uring instance file descriptor.
+     */
+    int ringSocket_;
+
+    /*!
+     * mapped submission ring, completion ring and entry array.
+     */
+    void* sqRing_;
+    void* cqRing_;
+    struct io_uring_sqe* sqEntries_;
+    size_t sqRingSize_;
+    size_t cqRingSize_;
+    size_t sqEntriesSize_;
+
+    /*!
+     * pointers into the shared rings.
+     */
+    unsigned* sqHead_;
+    unsigned* sqTail_;
+    unsigned* sqMask_;
+    unsigned* sqEntryCount_;
+    unsigned* sqArray_;
+    unsigned* cqHead_;
+    unsigned* cqTail_;
+    unsigned* cqMask_;
+    struct io_uring_cqe* cqEntries_;
+
+    /*!
+     * local submission tail, published to the kernel by submit( ).
+     */
+    unsigned sqLocalTail_;
+
+};
+
+#endif //URINGQUEUE_HPP
@@ -0,0 +1,266 @@
+/*! \license
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * \copyright 2021 Dan Fernández
+ *
+ *
+ * \file Header for \p VehicleGateway class.
+ *
+ * \author fdaniel, trice2
+ */
+
+#if !defined( VEHICLEGATEWAY_HPP )
+#define VEHICLEGATEWAY_HPP
+
+#include "remotedevicehandler.hpp"
+#include "latencyhistogram.hpp"
+
+#include <vector>
+#include <memory>
+#include <atomic>
+#include <thread>
+#include <string>
+
+constexpr auto GATEWAY_MAX_EVENTS = 64;             // epoll events, per wait
+constexpr auto GATEWAY_TCP_PORT_BASE = 9100;        // first vehicle, if unset
+constexpr auto GATEWAY_ASP_PORT_BASE = 9600;        // first vehicle, if unset
+constexpr auto GATEWAY_REPORT_PERIOD = 10;          // s, between spin( ) reports
+
+
+/*!
+ * Endpoints of one vehicle served by a \p VehicleGateway.
+ */
+struct VehicleConfig
+{
+
+    std::string name;               //!< label used in reports
+    uint16_t tcpPort;               //!< mobile devices connect here
+    uint16_t aspPort;               //!< ASP channel, see AspTransport::setPort( )
+    AspTransportType transport;     //!< link to this vehicle's ASP
+
+};
+
+
+/*!
+ * \brief Serves many vehicles from one process.
+ *
+ * Each vehicle has its own \p SignalHandler and \p RemoteDeviceHandler, so
+ * its signal state is separate, and its own TCP port and ASP channel.  No
+ * vehicle starts threads of its own.  One I/O thread waits on every
+ * vehicle's mobile sockets through a single epoll, a second on every ASP
+ * link, and one timer thread runs every vehicle's status, ranging and ASP
+ * send cycle each ASP_REFRESH_RATE.  The thread count stays at three as
+ * vehicles are added.  ASP replies have a thread of their own because a
+ * mobile request may wait for the ASP state to change.
+ */
+class VehicleGateway
+{
+
+public:
+
+    /*!
+     * constructor
+     */
+    VehicleGateway( );
+
+    /*!
+     * destructor; stops the gateway if still running.
+     */
+    ~VehicleGateway( );
+
+    /*!
+     * Read vehicles from a JSON config.  Either list them:
+     *
+     *     { "vehicles": [ { "name": "bench-1", "tcp_port": 9100,
+     *                       "asp_port": 9600, "transport": "udp" } ] }
+     *
+     * or give a count, and ports are assigned upwards from the bases:
+     *
+     *     { "count": 100, "tcp_port_base": 9100, "asp_port_base": 9600,
+     *       "transport": "unix" }
+     *
+     * A top-level "transport" is the default for listed vehicles.
+     *
+     * \param config  config text
+     * \param vehicles  vehicles found, appended
+     *
+     * \return bool  false if the config is not valid JSON or lists no vehicle
+     */
+    static bool parseConfig( const std::string& config, std::vector<VehicleConfig>& vehicles );
+
+    /*!
+     * Add the vehicles of a config file; see parseConfig( ).
+     *
+     * \param path  config file
+     *
+     * \return bool  false if the file cannot be read or parsed
+     */
+    bool loadConfig( const std::string& path );
+
+    /*!
+     * Add a vehicle; only before start( ).
+     *
+     * \param config  endpoints of the vehicle
+     */
+    void addVehicle( const VehicleConfig& config );
+
+    /*!
+     * \return size_t  number of vehicles
+     */
+    size_t getVehicleCount( ) const;
+
+    /*!
+     * \param index  vehicle, in the order added
+     *
+     * \return std::shared_ptr<SignalHandler>  signal state of the vehicle
+     */
+    std::shared_ptr<SignalHandler> getSignalHandler( const size_t& index );
+
+    /*!
+     * Open every vehicle and start the I/O and timer threads.
+     *
+     * \return bool  false if the shared epoll could not be set up
+     */
+    bool start( );
+
+    /*!
+     * main blocking call; start( ), then print a report every
+     * GATEWAY_REPORT_PERIOD until stop( ) is called.
+     */
+    void spin( );
+
+    /*!
+     * Stop both threads and close every vehicle.
+     */
+    void stop( );
+
+    /*!
+     * \return uint64_t  timer cycles that overran ASP_REFRESH_RATE
+     */
+    uint64_t getOverrunCount( ) const;
+
+    /*!
+     * Print ASP packets decoded per second across all vehicles, and
+     * arrival-to-decode latency over all vehicles and for the slowest one.
+     *
+     * \param perVehicle  also print one line per vehicle
+     */
+    void printReport( const bool& perVehicle = false );
+
+private:
+
+    /*!
+     * One vehicle: its signal state and its mobile device handler.
+     */
+    struct Vehicle
+    {
+        VehicleConfig config;
+        std::shared_ptr<SignalHandler> TCM;
+        std::unique_ptr<RemoteDeviceHandler> handler;
+    };
+
+    /*!
+     * Read a port from a config object.
+     *
+     * \param object  config object
+     * \param key  member holding the port
+     * \param fallback  used if the member is absent
+     * \param port  port read
+     *
+     * \return bool  false if the port is not a number from 1 to 65535
+     */
+    static bool readPort_(
+            const nlohmann::json& object,
+            const std::string& key,
+            const uint32_t& fallback,
+            uint16_t& port );
+
+    /*!
+     * Service whichever vehicle sockets are ready, until stop( ).
+     *
+     * \param epollSocket  epollSocket_ or aspEpollSocket_
+     */
+    void ioEventLoop_( const int& epollSocket );
+
+    /*!
+     * Run every vehicle's periodic work each ASP_REFRESH_RATE, until stop( ).
+     */
+    void timerEventLoop_( );
+
+    /*!
+     * vehicles, in the order added.
+     */
+    std::vector<std::unique_ptr<Vehicle>> vehicles_;
+
+    /*!
+     * epoll over every vehicle's mobile sockets.
+     */
+    int epollSocket_;
+
+    /*!
+     * epoll over every vehicle's ASP link.
+     */
+    int aspEpollSocket_;
+
+    /*!
+     * eventfd used by stop( ) to wake the I/O threads.
+     */
+    int wakeSocket_;
+
+    /*!
+     * timerfd driving the timer thread.
+     */
+    int timerSocket_;
+
+    /*!
+     * time start( ) was called, in nanoseconds.
+     */
+    uint64_t startTime_;
+
+    /*!
+     * timer thread cycles that overran ASP_REFRESH_RATE.
+     */
+    std::atomic<uint64_t> overruns_;
+
+    /*!
+     * indicates that the threads are running.
+     */
+    std::atomic<bool> running_;
+
+    /*!
+     * thread running ioEventLoop_( ) for mobile devices.
+     */
+    std::thread ioLoopHandler_;
+
+    /*!
+     * thread running ioEventLoop_( ) for ASP links.
+     */
+    std::thread aspLoopHandler_;
+
+    /*!
+     * thread running timerEventLoop_( ).
+     */
+    std::thread timerLoopHandler_;
+
+};
+
+#endif //VEHICLEGATEWAY_HPP
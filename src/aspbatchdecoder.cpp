@@ -0,0 +1,208 @@
+/*! \license
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * \copyright 2021 Dan Fernández
+ *
+ *
+ * \file Class definitions for \p AspBatchDecoder class.
+ *
+ * \author fdaniel, trice2
+ */
+
+#include "aspbatchdecoder.hpp"
+#include "pdusignals.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+#if defined( __SSE2__ )
+#include <emmintrin.h>
+#endif
+
+namespace
+{
+
+// Each ObjSegment byte is one segment: an unused bit, a 2-bit type and a
+// 5-bit distance.
+constexpr unsigned SEGMENT_TYPE_SHIFT = 5;
+constexpr uint8_t SEGMENT_TYPE_MASK = 0x03;
+constexpr uint8_t SEGMENT_DIST_MASK = 0x1F;
+
+static_assert( AspmLmObjSegmentCodec::BYTES == 2 * ASP_THREAT_SEGMENT_COUNT,
+               "ASPM_LM_ObjSegment is not one byte per segment" );
+
+#define SNAPSHOT_LM_ID( NAME ) ASPM_LM::NAME,
+constexpr int SNAPSHOT_LM_IDS[] = { ASP_SNAPSHOT_LM_FIELDS( SNAPSHOT_LM_ID ) };
+constexpr size_t SNAPSHOT_LM_COUNT = sizeof( SNAPSHOT_LM_IDS ) / sizeof( SNAPSHOT_LM_IDS[ 0 ] );
+
+// id if the signal is in the snapshot, else -1 so the codec skips it
+constexpr int snapshotId( int id, size_t index = 0 )
+{
+    return index == SNAPSHOT_LM_COUNT ? -1
+            : SNAPSHOT_LM_IDS[ index ] == id ? id
+            : snapshotId( id, index + 1 );
+}
+
+#define SNAPSHOT_CODEC_SIGNAL( PDU, NAME, BITS ) PduSignal< snapshotId( PDU::NAME ), BITS >,
+typedef PduCodec< ASPM_LM_SIGNALS( SNAPSHOT_CODEC_SIGNAL ) PduEnd > SnapshotLmCodec;
+
+static_assert( SnapshotLmCodec::BYTES == LENGTH_OF_ASPM_LM, "ASPM_LM layout changed" );
+
+void copyLm( const uint64_t* values, AspSnapshot& out )
+{
+#define COPY_LM_FIELD( NAME ) out.NAME = (ASP::NAME)values[ ASPM_LM::NAME ];
+    ASP_SNAPSHOT_LM_FIELDS( COPY_LM_FIELD )
+#undef COPY_LM_FIELD
+}
+
+void clearLm( AspSnapshot& out )
+{
+#define CLEAR_LM_FIELD( NAME ) out.NAME = (ASP::NAME)0;
+    ASP_SNAPSHOT_LM_FIELDS( CLEAR_LM_FIELD )
+#undef CLEAR_LM_FIELD
+}
+
+// split ASP_THREAT_SEGMENT_COUNT segment bytes into distances and types
+void splitSegments( const uint8_t* in, uint8_t* distances, uint8_t* types )
+{
+#if defined( __SSE2__ )
+    static_assert( ASP_THREAT_SEGMENT_COUNT == sizeof( __m128i ), "one vector per end" );
+    const __m128i segments( _mm_loadu_si128( reinterpret_cast<const __m128i*>( in ) ) );
+    _mm_storeu_si128( reinterpret_cast<__m128i*>( distances ),
+                      _mm_and_si128( segments, _mm_set1_epi8( SEGMENT_DIST_MASK ) ) );
+    _mm_storeu_si128( reinterpret_cast<__m128i*>( types ),
+                      _mm_and_si128( _mm_srli_epi16( segments, SEGMENT_TYPE_SHIFT ),
+                                     _mm_set1_epi8( SEGMENT_TYPE_MASK ) ) );
+#else
+    // Eight segments per word; bits shifted in from the next byte are masked off.
+    const uint64_t bytes( 0x0101010101010101ull );
+    for( size_t ii = 0; ii < ASP_THREAT_SEGMENT_COUNT; ii += sizeof( uint64_t ) )
+    {
+        uint64_t segments;
+        memcpy( &segments, in + ii, sizeof( segments ) );
+        const uint64_t distance( segments & ( bytes * SEGMENT_DIST_MASK ) );
+        const uint64_t type( ( segments >> SEGMENT_TYPE_SHIFT ) & ( bytes * SEGMENT_TYPE_MASK ) );
+        memcpy( distances + ii, &distance, sizeof( distance ) );
+        memcpy( types + ii, &type, sizeof( type ) );
+    }
+#endif
+}
+
+void decodeRange( const uint8_t* packets, size_t n, AspSnapshot* out )
+{
+    for( size_t ii = 0; ii < n; ++ii )
+    {
+        AspBatchDecoder::decode( packets + ii * ASPM_TOTAL_PACKET_SIZE, out[ ii ] );
+    }
+}
+
+}
+
+
+void AspBatchDecoder::decode( const uint8_t* packet, AspSnapshot& out )
+{
+
+    uint64_t lm[ ASPM_LM::MAXSignal ];
+    bool lmFound( false );
+    bool objSegmentFound( false );
+
+    // PduView only writes through putHeader( ), which is not called here.
+    PduView pdu( const_cast<uint8_t*>( packet ), ASPM_TOTAL_PACKET_SIZE );
+
+    for( int ii = 0; ii < NUMBER_OF_ASPM_PDU && pdu.isValid( ); ++ii, pdu = pdu.next( ) )
+    {
+        PDU_TYPE::ID type( aspmPduType( pdu.getHeaderID( ) ) );
+
+        if( pdu.getPayloadLength( ) != pduPayloadLength( type ) )
+        {
+            continue;
+        }
+
+        switch( type )
+        {
+            case PDU_TYPE::PDU_ASPM_LM:
+                SnapshotLmCodec::decode( pdu.getPayload( ), lm );
+                copyLm( lm, out );
+                lmFound = true;
+                break;
+            case PDU_TYPE::PDU_ASPM_LM_ObjSegment:
+                splitSegments( pdu.getPayload( ), out.ASPMFrontSegDistRMT, out.ASPMFrontSegTypeRMT );
+                splitSegments( pdu.getPayload( ) + ASP_THREAT_SEGMENT_COUNT,
+                               out.ASPMRearSegDistRMT, out.ASPMRearSegTypeRMT );
+                objSegmentFound = true;
+                break;
+            default:
+                break;
+        }
+    }
+
+    if( !lmFound )
+    {
+        clearLm( out );
+    }
+
+    if( !objSegmentFound )
+    {
+        memset( out.ASPMFrontSegDistRMT, ASP_THREAT_DISTANCE_NONE, ASP_THREAT_SEGMENT_COUNT );
+        memset( out.ASPMRearSegDistRMT, ASP_THREAT_DISTANCE_NONE, ASP_THREAT_SEGMENT_COUNT );
+        memset( out.ASPMFrontSegTypeRMT, 0, ASP_THREAT_SEGMENT_COUNT );
+        memset( out.ASPMRearSegTypeRMT, 0, ASP_THREAT_SEGMENT_COUNT );
+    }
+}
+
+
+void AspBatchDecoder::decodeBatch( const uint8_t* packets, size_t n, AspSnapshot* out, unsigned threads )
+{
+
+    if( threads == 0 )
+    {
+        threads = std::max( 1u, std::thread::hardware_concurrency( ) );
+    }
+
+    const size_t chunks( std::min<size_t>( threads, n / ASP_BATCH_THREAD_PACKETS ) );
+
+    if( chunks <= 1 )
+    {
+        decodeRange( packets, n, out );
+        return;
+    }
+
+    // This thread takes the first chunk and a worker each of the rest.
+    const size_t perChunk( ( n + chunks - 1 ) / chunks );
+    std::vector<std::thread> workers;
+
+    for( size_t first = perChunk; first < n; first += perChunk )
+    {
+        workers.emplace_back( decodeRange,
+                              packets + first * ASPM_TOTAL_PACKET_SIZE,
+                              std::min( perChunk, n - first ),
+                              out + first );
+    }
+
+    decodeRange( packets, perChunk, out );
+
+    for( auto& worker : workers )
+    {
+        worker.join( );
+    }
+}
@@ -0,0 +1,708 @@
+/*! \license
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * \copyright 2021 Dan Fernández
+ *
+ * \file Class definitions for \p AspTransport classes.
+ *
+ * \author fdaniel, trice2
+ */
+
+#include "asptransport.hpp"
+
+#include <limits.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <linux/futex.h>
+
+
+std::unique_ptr<AspTransport> AspTransport::create( const AspTransportType& type )
+{
+
+    switch( type )
+    {
+        case AspTransportType::UnixDgram:
+            return std::unique_ptr<AspTransport>( new UnixDgramTransport( ) );
+
+        case AspTransportType::SharedMemory:
+            return std::unique_ptr<AspTransport>( new SharedMemoryTransport( ) );
+
+        default:
+            return std::unique_ptr<AspTransport>( new UdpTransport( ) );
+    }
+
+}
+
+
+AspTransportType AspTransport::parseType( const std::string& type )
+{
+
+    if( type == "unix" )
+    {
+        return AspTransportType::UnixDgram;
+    }
+    else if( type == "shm" )
+    {
+        return AspTransportType::SharedMemory;
+    }
+
+    return AspTransportType::Udp;
+
+}
+
+
+void AspTransport::setPort( const uint16_t& port )
+{
+
+    port_ = port;
+
+}
+
+
+uint16_t AspTransport::getPort( ) const
+{
+
+    return port_;
+
+}
+
+
+std::string AspTransport::channelName_( const char* name ) const
+{
+
+    if( port_ == UDP_PORT )
+    {
+        return name;
+    }
+
+    return (std::string)name + "-" + std::to_string( port_ );
+
+}
+
+
+int AspTransport::getEventSocket( )
+{
+
+    return -1;
+
+}
+
+
+ssize_t AspTransport::receiveLatest(
+        void* buffer,
+        const uint16_t& bufSize,
+        const uint16_t& /* validSize */ )
+{
+
+    // Only used by links that keep nothing but the newest packet, so there
+    // is no older valid one to prefer.
+
+    return receive( buffer, bufSize );
+
+}
+
+
+uint64_t AspTransport::getSupersededCount( )
+{
+
+    return superseded_;
+
+}
+
+
+uint64_t AspTransport::getLastReceiveTime( )
+{
+
+    return lastReceiveTime_;
+
+}
+
+
+ssize_t AspTransport::exchange(
+        const void* bufferOut,
+        const uint16_t& sizeOut,
+        void* bufferIn,
+        const uint16_t& sizeIn,
+        const uint16_t& validSize )
+{
+
+    if( send( bufferOut, sizeOut ) < 0 )
+    {
+        return -1;
+    }
+
+    return receiveLatest( bufferIn, sizeIn, validSize );
+
+}
+
+
+bool UdpTransport::open( const bool& isTCM )
+{
+
+    socketHandler_.connectServer(
+            (int32_t)SOCK_DGRAM,
+            (uint64_t)UDP_ADDR,
+            port_,
+            isTCM );
+
+    return true;
+
+}
+
+
+ssize_t UdpTransport::receive( void* buffer, const uint16_t& bufSize )
+{
+
+    return socketHandler_.receiveUDP( buffer, bufSize );
+
+}
+
+
+ssize_t UdpTransport::receiveLatest(
+        void* buffer,
+        const uint16_t& bufSize,
+        const uint16_t& validSize )
+{
+
+    return socketHandler_.receiveLatestUDP( buffer, bufSize, validSize );
+
+}
+
+
+ssize_t UdpTransport::pollLatest(
+        void* buffer,
+        const uint16_t& bufSize,
+        const uint16_t& validSize )
+{
+
+    return socketHandler_.pollLatestUDP( buffer, bufSize, validSize );
+
+}
+
+
+int UdpTransport::getEventSocket( )
+{
+
+    return socketHandler_.getServerSocket( );
+
+}
+
+
+uint64_t UdpTransport::getSupersededCount( )
+{
+
+    return socketHandler_.getSupersededPacketCount( );
+
+}
+
+
+uint64_t UdpTransport::getLastReceiveTime( )
+{
+
+    return socketHandler_.getLastReceiveTimestamp( );
+
+}
+
+
+int32_t UdpTransport::send( const void* buffer, const uint16_t& bufSize )
+{
+
+    return socketHandler_.sendUDP( buffer, bufSize );
+
+}
+
+
+ssize_t UdpTransport::exchange(
+        const void* bufferOut,
+        const uint16_t& sizeOut,
+        void* bufferIn,
+        const uint16_t& sizeIn,
+        const uint16_t& validSize )
+{
+
+    return socketHandler_.exchangeUDP( bufferOut, sizeOut, bufferIn, sizeIn, validSize );
+
+}
+
+
+void UdpTransport::close( )
+{
+
+    socketHandler_.disconnectClient( false );
+    socketHandler_.disconnectServer( );
+
+    return;
+
+}
+
+
+UnixDgramTransport::UnixDgramTransport( )
+        :
+        socket_( -1 ),
+        peer_( ),
+        peerSize_( 0 )
+{
+
+    bzero( (char *) &peer_, sizeof( peer_ ) );
+
+}
+
+
+UnixDgramTransport::~UnixDgramTransport( )
+{
+
+    if( socket_ >= 0 )
+    {
+        ::close( socket_ );
+    }
+
+}
+
+
+bool UnixDgramTransport::open( const bool& isTCM )
+{
+
+    socket_ = socket( AF_UNIX, SOCK_DGRAM | SOCK_CLOEXEC, 0 );
+
+    struct sockaddr_un address;
+    std::string aspName = channelName_( ASP_UNIX_NAME );
+    std::string tcmName = channelName_( TCM_UNIX_NAME );
+    socklen_t addressSize = setAddress_(
+            address, isTCM ? tcmName.c_str( ) : aspName.c_str( ) );
+
+    if( socket_ < 0 || bind( socket_, (struct sockaddr*)&address, addressSize ) != 0 )
+    {
+        perror( "ERROR binding AF_UNIX socket." );
+
+        return false;
+    }
+
+    // The TCM always talks to the ASP; the ASP learns the TCM on receipt.
+    if( isTCM == true )
+    {
+        peerSize_ = setAddress_( peer_, aspName.c_str( ) );
+    }
+
+    std::cout << "---" << std::endl << ( isTCM ? "TCM" : "ASPM" );
+    std::cout << " AF_UNIX socket bound to: @" << address.sun_path + 1 << std::endl;
+
+
+    return true;
+
+}
+
+
+ssize_t UnixDgramTransport::receive( void* buffer, const uint16_t& bufSize )
+{
+
+    return receive_( buffer, bufSize, 0 );
+
+}
+
+
+ssize_t UnixDgramTransport::receive_(
+        void* buffer,
+        const uint16_t& bufSize,
+        const int& flags )
+{
+
+    struct sockaddr_un sender;
+    socklen_t senderSize = sizeof( sender );
+
+    ssize_t received = recvfrom(
+            socket_,
+            buffer,
+            bufSize,
+            flags,
+            (struct sockaddr*)&sender,
+            &senderSize );
+
+    if( received > 0 && senderSize > sizeof( sa_family_t ) )
+    {
+        peer_ = sender;
+        peerSize_ = senderSize;
+    }
+
+    if( received >= 0 )
+    {
+        lastReceiveTime_ = LatencyHistogram::now( );
+    }
+
+    return received;
+
+}
+
+
+ssize_t UnixDgramTransport::receiveLatest(
+        void* buffer,
+        const uint16_t& bufSize,
+        const uint16_t& validSize )
+{
+
+    return drain_( buffer, bufSize, validSize, receive_( buffer, bufSize, 0 ) );
+
+}
+
+
+ssize_t UnixDgramTransport::pollLatest(
+        void* buffer,
+        const uint16_t& bufSize,
+        const uint16_t& validSize )
+{
+
+    ssize_t result = receive_( buffer, bufSize, MSG_DONTWAIT );
+
+    if( result < 0 )
+    {
+        return result;
+    }
+
+    return drain_( buffer, bufSize, validSize, result );
+
+}
+
+
+int UnixDgramTransport::getEventSocket( )
+{
+
+    return socket_;
+
+}
+
+
+ssize_t UnixDgramTransport::drain_(
+        void* buffer,
+        const uint16_t& bufSize,
+        const uint16_t& validSize,
+        const ssize_t& current )
+{
+
+    ssize_t result = current;
+    bool haveValid = ( result > 0 && ( validSize == 0 || result == validSize ) );
+
+    uint8_t packet[ ASP_SHM_SLOT_SIZE ];
+    ssize_t received;
+
+    // Take whatever else is already queued, keeping the newest valid packet.
+    while( ( received = recv( socket_, packet, sizeof( packet ), MSG_DONTWAIT ) ) > 0 )
+    {
+        if( validSize != 0 && received != validSize )
+        {
+            continue;
+        }
+
+        if( haveValid == true )
+        {
+            ++superseded_;
+        }
+        haveValid = true;
+
+        result = ( received < bufSize ) ? received : bufSize;
+        memcpy( buffer, packet, result );
+        lastReceiveTime_ = LatencyHistogram::now( );
+    }
+
+    return result;
+
+}
+
+
+int32_t UnixDgramTransport::send( const void* buffer, const uint16_t& bufSize )
+{
+
+    if( peerSize_ == 0 )
+    {
+        errno = ENOTCONN;
+
+        return -1;
+    }
+
+    return sendto(
+            socket_,
+            buffer,
+            bufSize,
+            0,
+            (const struct sockaddr*)&peer_,
+            peerSize_ );
+
+}
+
+
+void UnixDgramTransport::close( )
+{
+
+    // Wakes a receive( ) blocked on another thread; the descriptor itself
+    // is closed on destruction.
+    if( socket_ >= 0 )
+    {
+        shutdown( socket_, SHUT_RDWR );
+    }
+
+    return;
+
+}
+
+
+socklen_t UnixDgramTransport::setAddress_( struct sockaddr_un& address, const char* name )
+{
+
+    bzero( (char *) &address, sizeof( address ) );
+    address.sun_family = AF_UNIX;
+
+    // Leading NUL selects the abstract namespace.
+    size_t nameLen = strnlen( name, sizeof( address.sun_path ) - 1 );
+    memcpy( address.sun_path + 1, name, nameLen );
+
+    return (socklen_t)( offsetof( struct sockaddr_un, sun_path ) + 1 + nameLen );
+
+}
+
+
+SharedMemoryTransport::SharedMemoryTransport( )
+        :
+        region_( NULL ),
+        tx_( NULL ),
+        rx_( NULL ),
+        lastSequence_( 0 ),
+        closing_( false )
+{
+
+}
+
+
+SharedMemoryTransport::~SharedMemoryTransport( )
+{
+
+    // The object itself is kept, so either end can restart and reattach.
+    if( region_ != NULL )
+    {
+        munmap( region_, sizeof( AspShmRegion ) );
+    }
+
+}
+
+
+bool SharedMemoryTransport::open( const bool& isTCM )
+{
+
+    // Either end may come up first; a new object is zero filled.
+    std::string name = channelName_( ASP_SHM_NAME );
+    int shm = shm_open( name.c_str( ), O_CREAT | O_RDWR | O_CLOEXEC, 0600 );
+
+    if( shm < 0 || ftruncate( shm, sizeof( AspShmRegion ) ) != 0 )
+    {
+        perror( "ERROR opening ASP shared memory." );
+
+        if( shm >= 0 )
+        {
+            ::close( shm );
+        }
+
+        return false;
+    }
+
+    void* region = mmap( NULL, sizeof( AspShmRegion ), PROT_READ | PROT_WRITE,
+                         MAP_SHARED, shm, 0 );
+    ::close( shm );
+
+    if( region == MAP_FAILED )
+    {
+        perror( "ERROR mapping ASP shared memory." );
+
+        return false;
+    }
+
+    region_ = (AspShmRegion*)region;
+    tx_ = ( isTCM == true ) ? &region_->toASP : &region_->toTCM;
+    rx_ = ( isTCM == true ) ? &region_->toTCM : &region_->toASP;
+
+    // Anything already published is from a previous session.
+    lastSequence_ = rx_->sequence.load( std::memory_order_acquire );
+
+    std::cout << "---" << std::endl << ( isTCM ? "TCM" : "ASPM" );
+    std::cout << " shared memory mapped: " << name << std::endl;
+
+
+    return true;
+
+}
+
+
+ssize_t SharedMemoryTransport::receive( void* buffer, const uint16_t& bufSize )
+{
+
+    return receive_( buffer, bufSize, true );
+
+}
+
+
+ssize_t SharedMemoryTransport::pollLatest(
+        void* buffer,
+        const uint16_t& bufSize,
+        const uint16_t& /* validSize */ )
+{
+
+    return receive_( buffer, bufSize, false );
+
+}
+
+
+ssize_t SharedMemoryTransport::receive_(
+        void* buffer,
+        const uint16_t& bufSize,
+        const bool& wait )
+{
+
+    if( rx_ == NULL )
+    {
+        errno = ENOTCONN;
+
+        return -1;
+    }
+
+    while( closing_.load( ) == false )
+    {
+
+        uint32_t sequence = rx_->sequence.load( std::memory_order_acquire );
+
+        if( sequence != lastSequence_ )
+        {
+
+            uint32_t index = sequence & 1;
+            uint32_t before = rx_->version[ index ].load( std::memory_order_acquire );
+
+            // An odd version means the writer is already refilling the slot
+            // with a newer packet, so sequence has moved on; read it again.
+            if( ( before & 1 ) != 0 )
+            {
+                continue;
+            }
+
+            uint32_t packet = rx_->packet[ index ];
+            uint32_t length = rx_->length[ index ];
+
+            if( length > ASP_SHM_SLOT_SIZE )
+            {
+                length = ASP_SHM_SLOT_SIZE;
+            }
+            if( length > bufSize )
+            {
+                length = bufSize;
+            }
+
+            memcpy( buffer, rx_->slot[ index ], length );
+
+            // A version that moved means the copy may be torn; a different
+            // packet means the slot was refilled before the copy began.
+            std::atomic_thread_fence( std::memory_order_acquire );
+            if( rx_->version[ index ].load( std::memory_order_relaxed ) == before
+                && packet == sequence )
+            {
+                superseded_ += sequence - lastSequence_ - 1;
+                lastSequence_ = sequence;
+                lastReceiveTime_ = LatencyHistogram::now( );
+
+                return length;
+            }
+
+            continue;
+
+        }
+
+        if( wait == false )
+        {
+            errno = EAGAIN;
+
+            return -1;
+        }
+
+        // Sleep until the writer bumps the sequence, rechecking for close( ).
+        struct timespec timeout = { 0, ASP_SHM_WAIT_MS * 1000000L };
+        syscall( SYS_futex, (uint32_t*)&rx_->sequence, FUTEX_WAIT,
+                 sequence, &timeout, NULL, 0 );
+
+    }
+
+
+    return 0;
+
+}
+
+
+int32_t SharedMemoryTransport::send( const void* buffer, const uint16_t& bufSize )
+{
+
+    if( tx_ == NULL )
+    {
+        errno = ENOTCONN;
+
+        return -1;
+    }
+    if( bufSize > ASP_SHM_SLOT_SIZE )
+    {
+        errno = EMSGSIZE;
+
+        return -1;
+    }
+
+    // Fill the unpublished slot, then publish it.
+    uint32_t sequence = tx_->sequence.load( std::memory_order_relaxed ) + 1;
+    uint32_t index = sequence & 1;
+
+    // Mark the slot busy first: a reader may still be copying the packet
+    // two before this one out of it.  An odd version left by a writer that
+    // died mid-copy is reused as is.
+    uint32_t busy = tx_->version[ index ].load( std::memory_order_relaxed ) | 1;
+    tx_->version[ index ].store( busy, std::memory_order_relaxed );
+    std::atomic_thread_fence( std::memory_order_release );
+
+    memcpy( tx_->slot[ index ], buffer, bufSize );
+    tx_->length[ index ] = bufSize;
+    tx_->packet[ index ] = sequence;
+
+    tx_->version[ index ].store( busy + 1, std::memory_order_release );
+    tx_->sequence.store( sequence, std::memory_order_release );
+
+    syscall( SYS_futex, (uint32_t*)&tx_->sequence, FUTEX_WAKE, INT_MAX, NULL, NULL, 0 );
+
+
+    return bufSize;
+
+}
+
+
+void SharedMemoryTransport::close( )
+{
+
+    // The mapping stays until destruction, since another thread may still
+    // be inside receive( ).
+    closing_ = true;
+
+    if( rx_ != NULL )
+    {
+        syscall( SYS_futex, (uint32_t*)&rx_->sequence, FUTEX_WAKE, INT_MAX, NULL, NULL, 0 );
+    }
+
+    return;
+
+}
@@ -0,0 +1,133 @@
+/*! \license
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * \copyright 2021 Dan Fernández
+ *
+ * \file Class definitions for \p BodyCodec class.
+ *
+ * \author fdaniel, trice2
+ */
+
+#include "bodycodec.hpp"
+
+using json = nlohmann::json;
+
+
+bool BodyCodec::parseEncoding( const std::string& name, BodyEncoding& encoding )
+{
+
+    if( name == "json" )
+    {
+        encoding = BodyEncoding::Json;
+    }
+    else if( name == "cbor" )
+    {
+        encoding = BodyEncoding::Cbor;
+    }
+    else if( name == "msgpack" )
+    {
+        encoding = BodyEncoding::MsgPack;
+    }
+    else
+    {
+        return false;
+    }
+
+    return true;
+
+}
+
+
+const char* BodyCodec::getEncodingName( const BodyEncoding& encoding )
+{
+
+    switch( encoding )
+    {
+        case BodyEncoding::Cbor:        return "cbor";
+        case BodyEncoding::MsgPack:     return "msgpack";
+        default:                        return "json";
+    }
+
+}
+
+
+std::string BodyCodec::encode( const json& body, const BodyEncoding& encoding )
+{
+
+    std::string out;
+
+    switch( encoding )
+    {
+        case BodyEncoding::Cbor:
+        {
+            json::to_cbor( body, out );
+            break;
+        }
+        case BodyEncoding::MsgPack:
+        {
+            json::to_msgpack( body, out );
+            break;
+        }
+        default:
+        {
+            out = body.dump( );
+            break;
+        }
+    }
+
+    return out;
+
+}
+
+
+bool BodyCodec::decode(
+        const char* raw,
+        const size_t& size,
+        const BodyEncoding& encoding,
+        json& body )
+{
+
+    const uint8_t* first( (const uint8_t*)raw );
+    const uint8_t* last( first + size );
+
+    switch( encoding )
+    {
+        case BodyEncoding::Cbor:
+        {
+            body = json::from_cbor( first, last, true, false );
+            break;
+        }
+        case BodyEncoding::MsgPack:
+        {
+            body = json::from_msgpack( first, last, true, false );
+            break;
+        }
+        default:
+        {
+            body = json::parse( raw, raw + size, nullptr, false );
+            break;
+        }
+    }
+
+    return body.is_discarded( ) == false;
+
+}
@@ -0,0 +1,86 @@
+/*! \license
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * \copyright 2021 Dan Fernández
+ *
+ * \file Class definitions for \p DmhFrame class.
+ *
+ * \author fdaniel, trice2
+ */
+
+#include "dmhframe.hpp"
+
+namespace
+{
+
+uint16_t readWord( const uint8_t* in )
+{
+    return (uint16_t)( ( in[ 0 ] << 8 ) | in[ 1 ] );
+}
+
+void writeWord( const uint16_t& value, uint8_t* out )
+{
+    out[ 0 ] = (uint8_t)( value >> 8 );
+    out[ 1 ] = (uint8_t)( value & 0xFF );
+}
+
+}
+
+
+bool DmhFrame::decode( const char* raw, const size_t& size, DmhSample& sample )
+{
+
+    const uint8_t* in( reinterpret_cast<const uint8_t*>( raw ) );
+
+    if(     size != DMH_FRAME_SIZE
+            || in[ 0 ] != DMH_FRAME_TYPE
+            || ( in[ 1 ] & ~DMH_FLAG_ENABLE_MOTION ) != 0
+            || in[ 3 ] != 0 )
+    {
+        return false;
+    }
+
+    sample.gesture = ( in[ 1 ] & DMH_FLAG_ENABLE_MOTION ) != 0;
+    sample.percent = in[ 2 ];
+    sample.x = readWord( in + 4 );
+    sample.y = readWord( in + 6 );
+    sample.crc = readWord( in + 8 );
+
+    return true;
+}
+
+
+void DmhFrame::encode( const DmhSample& sample, char* out )
+{
+
+    uint8_t* bytes( reinterpret_cast<uint8_t*>( out ) );
+
+    bytes[ 0 ] = DMH_FRAME_TYPE;
+    bytes[ 1 ] = sample.gesture ? DMH_FLAG_ENABLE_MOTION : 0;
+    bytes[ 2 ] = sample.percent;
+    bytes[ 3 ] = 0;
+    writeWord( sample.x, bytes + 4 );
+    writeWord( sample.y, bytes + 6 );
+    writeWord( sample.crc, bytes + 8 );
+
+    return;
+}
@@ -0,0 +1,190 @@
+/*! \license
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * \copyright 2021 Dan Fernández
+ *
+ * \file Class definitions for \p EventWaiter class.
+ *
+ * \author fdaniel, trice2
+ */
+
+#include "eventwaiter.hpp"
+
+#include <stdio.h>
+#include <time.h>
+
+
+EventWaiter::EventWaiter( )
+        :
+        eventSocket_( eventfd( 0, EFD_NONBLOCK | EFD_CLOEXEC ) ),
+        notified_( false )
+{
+
+    if( eventSocket_ < 0 )
+    {
+        perror( "ERROR creating wakeup eventfd." );
+    }
+
+}
+
+
+EventWaiter::~EventWaiter( )
+{
+
+    if( eventSocket_ >= 0 )
+    {
+        close( eventSocket_ );
+    }
+
+}
+
+
+bool EventWaiter::waitFor( const uint32_t& micros )
+{
+
+    if( notified_ == true )
+    {
+        return false;
+    }
+
+    // Without an eventfd, degrade to a plain sleep.
+    if( eventSocket_ < 0 )
+    {
+        usleep( micros );
+
+        return notified_ == false;
+    }
+
+    struct pollfd event;
+    event.fd = eventSocket_;
+    event.events = POLLIN;
+    event.revents = 0;
+
+    struct timespec timeout;
+    timeout.tv_sec = micros / 1000000;
+    timeout.tv_nsec = ( micros % 1000000 ) * 1000L;
+
+    struct timespec deadline;
+    clock_gettime( CLOCK_MONOTONIC, &deadline );
+    deadline.tv_sec += timeout.tv_sec;
+    deadline.tv_nsec += timeout.tv_nsec;
+    if( deadline.tv_nsec >= 1000000000L )
+    {
+        deadline.tv_sec += 1;
+        deadline.tv_nsec -= 1000000000L;
+    }
+
+    // The glibc ppoll( ) does not write back the time left, so after a
+    // signal the wait resumes with what remains until the deadline.
+    while( ppoll( &event, 1, &timeout, NULL ) < 0 && errno == EINTR )
+    {
+        struct timespec now;
+        clock_gettime( CLOCK_MONOTONIC, &now );
+
+        timeout.tv_sec = deadline.tv_sec - now.tv_sec;
+        timeout.tv_nsec = deadline.tv_nsec - now.tv_nsec;
+        if( timeout.tv_nsec < 0 )
+        {
+            timeout.tv_sec -= 1;
+            timeout.tv_nsec += 1000000000L;
+        }
+
+        if( timeout.tv_sec < 0 )
+        {
+            break;
+        }
+    }
+
+    return notified_ == false;
+
+}
+
+
+void EventWaiter::wait( )
+{
+
+    // Without an eventfd, degrade to polling the flag.
+    if( eventSocket_ < 0 )
+    {
+        while( notified_ == false )
+        {
+            usleep( 1000 );
+        }
+
+        return;
+    }
+
+    struct pollfd event;
+    event.fd = eventSocket_;
+    event.events = POLLIN;
+    event.revents = 0;
+
+    while( notified_ == false && ppoll( &event, 1, NULL, NULL ) < 0 && errno == EINTR )
+    {
+    }
+
+    return;
+
+}
+
+
+void EventWaiter::notify( )
+{
+
+    notified_ = true;
+
+    if( eventSocket_ >= 0 )
+    {
+        eventfd_write( eventSocket_, 1 );
+    }
+
+    return;
+
+}
+
+
+void EventWaiter::reset( )
+{
+
+    notified_ = false;
+
+    if( eventSocket_ >= 0 )
+    {
+        eventfd_t count;
+        eventfd_read( eventSocket_, &count );
+    }
+
+    return;
+
+}
+
+
+bool EventWaiter::isNotified( ) const
+{
+    return notified_;
+}
+
+
+int EventWaiter::getEventSocket( ) const
+{
+    return eventSocket_;
+}
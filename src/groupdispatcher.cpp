@@ -0,0 +1,112 @@
+/*! \license
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * \copyright 2021 Dan Fernández
+ *
+ * \file Class definitions for \p GroupDispatcher class.
+ *
+ * \author fdaniel, trice2
+ */
+
+#include "groupdispatcher.hpp"
+
+#include <string.h>
+
+
+const RequestSchema GroupDispatcher::NO_FIELDS = { nullptr, 0 };
+
+
+bool GroupDispatcher::add(
+        const char* group,
+        const GroupHandler& handler,
+        const RequestSchema& schema )
+{
+
+    Entry& entry = table_[ slot( group ) ];
+
+    if( entry.group != nullptr && strcmp( entry.group, group ) != 0 )
+    {
+        return false;
+    }
+
+    entry.group = group;
+    entry.schema = &schema;
+    entry.handler = handler;
+
+    return true;
+
+}
+
+
+const RequestSchema* GroupDispatcher::getSchema( const char* group, const size_t& length ) const
+{
+
+    const Entry* entry = find_( group, length );
+
+    return ( entry == nullptr ) ? nullptr : entry->schema;
+
+}
+
+
+bool GroupDispatcher::dispatch(
+        const char* group,
+        const size_t& length,
+        const RequestBody& body ) const
+{
+
+    const Entry* entry = find_( group, length );
+
+    if( entry == nullptr )
+    {
+        return false;
+    }
+
+    entry->handler( body );
+
+    return true;
+
+}
+
+
+const GroupDispatcher::Entry* GroupDispatcher::find_( const char* group, const size_t& length ) const
+{
+
+    uint32_t hash( DISPATCH_HASH_SEED );
+    for( size_t i = 0; i < length; ++i )
+    {
+        hash = ( hash ^ (uint8_t)group[ i ] ) * 16777619u;
+    }
+
+    const Entry& entry = table_[ hash & ( DISPATCH_TABLE_SIZE - 1 ) ];
+
+    // Names with an embedded NUL must not match their prefix; compare in full.
+    if( entry.group == nullptr
+        || memchr( group, '\0', length ) != nullptr
+        || strncmp( entry.group, group, length ) != 0
+        || entry.group[ length ] != '\0' )
+    {
+        return nullptr;
+    }
+
+    return &entry;
+
+}
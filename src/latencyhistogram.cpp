@@ -0,0 +1,191 @@
+/*! \license
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * \copyright 2021 Dan Fernández
+ *
+ * \file Class definitions for \p LatencyHistogram class.
+ *
+ * \author fdaniel, trice2
+ */
+
+#include "latencyhistogram.hpp"
+
+
+LatencyHistogram::LatencyHistogram( )
+        :
+        count_( 0 ),
+        max_( 0 )
+{
+
+    for( auto& it : buckets_ )
+    {
+        it = 0;
+    }
+
+}
+
+
+uint64_t LatencyHistogram::now( )
+{
+
+    struct timespec stamp;
+    clock_gettime( CLOCK_REALTIME, &stamp );
+
+    return (uint64_t)stamp.tv_sec * 1000000000ull + (uint64_t)stamp.tv_nsec;
+
+}
+
+
+void LatencyHistogram::record( const uint64_t& startNs, const uint64_t& endNs )
+{
+
+    if( startNs == 0 || endNs < startNs )
+    {
+        return;
+    }
+
+    uint64_t micros = ( endNs - startNs ) / 1000;
+
+    int bucket = 0;
+    while( bucket < LATENCY_BUCKETS - 1 && ( micros >> bucket ) != 0 )
+    {
+        ++bucket;
+    }
+
+    ++buckets_[ bucket ];
+    ++count_;
+
+    uint64_t largest = max_.load( );
+    while( micros > largest && max_.compare_exchange_weak( largest, micros ) == false )
+    {
+    }
+
+    return;
+
+}
+
+
+uint64_t LatencyHistogram::getCount( ) const
+{
+    return count_;
+}
+
+
+uint64_t LatencyHistogram::getMax( ) const
+{
+    return max_;
+}
+
+
+uint64_t LatencyHistogram::getPercentile( const double& percentile ) const
+{
+
+    uint64_t total = count_;
+
+    if( total == 0 )
+    {
+        return 0;
+    }
+
+    uint64_t target = (uint64_t)( total * percentile / 100.0 );
+    if( target == 0 )
+    {
+        target = 1;
+    }
+
+    uint64_t seen = 0;
+    for( int i = 0; i < LATENCY_BUCKETS; ++i )
+    {
+        seen += buckets_[ i ];
+
+        if( seen >= target )
+        {
+            return 1ull << i;
+        }
+    }
+
+    return max_;
+
+}
+
+
+uint64_t LatencyHistogram::getBucket( const int& bucket ) const
+{
+
+    if( bucket < 0 || bucket >= LATENCY_BUCKETS )
+    {
+        return 0;
+    }
+
+    return buckets_[ bucket ];
+
+}
+
+
+void LatencyHistogram::merge( const LatencyHistogram& other )
+{
+
+    for( int i = 0; i < LATENCY_BUCKETS; ++i )
+    {
+        buckets_[ i ] += other.buckets_[ i ];
+    }
+
+    count_ += other.count_;
+
+    uint64_t largest = max_.load( );
+    uint64_t otherMax = other.max_.load( );
+    while( otherMax > largest && max_.compare_exchange_weak( largest, otherMax ) == false )
+    {
+    }
+
+    return;
+
+}
+
+
+void LatencyHistogram::reset( )
+{
+
+    for( auto& it : buckets_ )
+    {
+        it = 0;
+    }
+
+    count_ = 0;
+    max_ = 0;
+
+    return;
+
+}
+
+
+void LatencyHistogram::print( const std::string& name ) const
+{
+
+    std::cout << "---" << std::endl << name << ": " << getCount( ) << " samples";
+    std::cout << "\tp50 < " << getPercentile( 50 ) << " us";
+    std::cout << "\tp99 < " << getPercentile( 99 ) << " us";
+    std::cout << "\tmax " << getMax( ) << " us" << std::endl;
+
+    return;
+
+}
@@ -28,12 +28,16 @@
  */
 
 #include "remotedevicehandler.hpp"
+#include "vehiclegateway.hpp"
 
 
 /**
  * Entry point for the API.  The node will create a RemoteDeviceHandler object
  * and listen for messages from a mobile device.  The "spin( )" is a blocking
- * call; users must use Ctrl-C to exit this function.
+ * call; users must use Ctrl-C to exit this function.  An optional argument
+ * selects the ASP link: "udp" (default), "unix" or "shm".  Alternatively,
+ * "gateway <config.json>" serves every vehicle listed in the config from
+ * this one process; see VehicleGateway::parseConfig( ).
  */
 int main( int argc, char *argv[ ] )
 {
@@ -45,7 +49,28 @@ int main( int argc, char *argv[ ] )
         return 0;
     }
 
-    RemoteDeviceHandler jsonParser( std::make_shared <SignalHandler>( ) );
+    if( argc > 2 && (std::string)argv[1] == "gateway" )
+    {
+        VehicleGateway gateway;
+
+        if( gateway.loadConfig( (std::string)argv[2] ) == false )
+        {
+            return 1;
+        }
+
+        gateway.spin( );
+
+        return 0;
+    }
+
+    std::shared_ptr <SignalHandler> TCM( std::make_shared <SignalHandler>( ) );
+
+    if( argc > 1 )
+    {
+        TCM->setTransport( AspTransport::parseType( (std::string)argv[1] ) );
+    }
+
+    RemoteDeviceHandler jsonParser( TCM );
 
     jsonParser.spin( );
 
@@ -0,0 +1,282 @@
+/*! \license
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * \copyright 2021 Dan Fernández
+ *
+ * \file Class definitions for \p MessageWriter class.
+ *
+ * \author fdaniel, trice2
+ */
+
+#include "messagewriter.hpp"
+
+namespace
+{
+
+template <size_t N>
+const char* lookupText( const char* const ( &table )[ N ], const int& value )
+{
+    if( value < 0 || value >= (int)N )
+    {
+        return "InvalidSig";
+    }
+
+    return table[ value ];
+}
+
+// Keys of the fixed-schema bodies, with their punctuation.
+const char* const VEHICLE_STATUS_KEYS[ VEHICLE_STATUS_COUNT ] =
+{
+    "{\"status_1xx\":{\"status_code\":",
+    ",\"status_2xx\":{\"status_code\":",
+    ",\"status_3xx\":{\"status_code\":",
+    ",\"status_4xx\":{\"status_code\":",
+    ",\"status_5xx\":{\"status_code\":",
+    ",\"status_6xx\":{\"status_code\":",
+    ",\"status_7xx\":{\"status_code\":",
+    ",\"status_8xx\":{\"status_code\":",
+    ",\"status_9xx\":{\"status_code\":"
+};
+
+}
+
+
+const char* MessageWriter::getStatusText(
+        const VehicleStatusPrefix& prefix,
+        const int& value )
+{
+    switch( prefix )
+    {
+        case VehicleStatusPrefix::NoFeatureAvailableMsg:
+        {
+            return lookupText( NO_FEATURE_AVAILABLE_MSG_TEXT, value );
+        }
+        case VehicleStatusPrefix::CancelMsg:
+        {
+            return lookupText( CANCEL_MSG_TEXT, value );
+        }
+        case VehicleStatusPrefix::PauseMsg1:
+        {
+            return lookupText( PAUSE_MSG_1_TEXT, value );
+        }
+        case VehicleStatusPrefix::PauseMsg2:
+        {
+            return lookupText( PAUSE_MSG_2_TEXT, value );
+        }
+        case VehicleStatusPrefix::InfoMsg:
+        {
+            return lookupText( INFO_MSG_TEXT, value );
+        }
+        case VehicleStatusPrefix::InstructMsg:
+        {
+            return lookupText( INSTRUCT_MSG_TEXT, value );
+        }
+        case VehicleStatusPrefix::AcknowledgeRemotePIN:
+        {
+            return lookupText( ACKNOWLEDGE_REMOTE_PIN_TEXT, value );
+        }
+        case VehicleStatusPrefix::ErrorMsg:
+        {
+            return lookupText( ERROR_MSG_TEXT, value );
+        }
+        case VehicleStatusPrefix::ManeuverStatus:
+        {
+            return lookupText( MANEUVER_STATUS_TEXT, value );
+        }
+
+        default: break;
+    }
+
+    return "InvalidSig";
+}
+
+
+void MessageWriter::writeHeader( const std::string& group, std::string& out )
+{
+    out += "{\"group\":";
+    writeString_( group.c_str( ), out );
+    out += '}';
+}
+
+
+void MessageWriter::writeVehicleStatus(
+        const StatusEntry ( &status )[ VEHICLE_STATUS_COUNT ],
+        std::string& out )
+{
+    for( int i = 0; i < VEHICLE_STATUS_COUNT; i++ )
+    {
+        out += VEHICLE_STATUS_KEYS[ i ];
+        writeInt_( status[ i ].code, out );
+        out += ",\"status_text\":";
+        writeString_( status[ i ].text, out );
+        out += '}';
+    }
+
+    out += '}';
+}
+
+
+void MessageWriter::writeManeuverStatus(
+        const std::string& maneuver,
+        const int& progress,
+        const int& status,
+        std::string& out )
+{
+    out += "{\"maneuver\":";
+    writeString_( maneuver.c_str( ), out );
+    out += ",\"progress\":";
+    writeInt_( progress, out );
+    out += ",\"status\":";
+    writeInt_( status, out );
+    out += '}';
+}
+
+
+void MessageWriter::writeCabinStatus(
+        const bool& engineOff,
+        const bool& doorsLocked,
+        std::string& out )
+{
+    out += "{\"door_open_driver\":false,\"door_open_engine_hood\":false,"
+            "\"door_open_lr\":false,\"door_open_passenger\":false,"
+            "\"door_open_rr\":false,\"door_open_tailgate\":false,"
+            "\"lock_status\":";
+    writeBool_( doorsLocked, out );
+    out += ",\"power_status\":";
+    writeBool_( engineOff, out );
+    out += '}';
+}
+
+
+void MessageWriter::writeAvailableManeuvers(
+        const std::string& defaultManeuver,
+        const bool& continueExploring,
+        const bool ( &offered )[ AVAILABLE_MANEUVER_COUNT ],
+        std::string& out )
+{
+    out += "{\"continue_exploring\":";
+    writeBool_( continueExploring, out );
+    out += ",\"default\":";
+    writeString_( defaultManeuver.c_str( ), out );
+    out += ",\"maneuvers\":{";
+
+    for( int i = 0; i < AVAILABLE_MANEUVER_COUNT; i++ )
+    {
+        if( i > 0 )
+        {
+            out += ',';
+        }
+        writeString_( AVAILABLE_MANEUVER_NAMES[ i ], out );
+        out += ':';
+        writeBool_( offered[ i ], out );
+    }
+
+    out += "}}";
+}
+
+
+void MessageWriter::writeThreatData(
+        const uint8_t ( &threats )[ THREAT_SEGMENT_COUNT ],
+        std::string& out )
+{
+    out += "{\"threats\":[";
+
+    for( int i = 0; i < THREAT_SEGMENT_COUNT; i++ )
+    {
+        if( i > 0 )
+        {
+            out += ',';
+        }
+        writeInt_( threats[ i ], out );
+    }
+
+    out += "]}";
+}
+
+
+void MessageWriter::writeString_( const char* value, std::string& out )
+{
+    static const char* hex = "0123456789abcdef";
+
+    out += '"';
+
+    // Escapes match nlohmann::json::dump( ).
+    for( const char* ptr = value; *ptr != '\0'; ++ptr )
+    {
+        unsigned char c = (unsigned char)*ptr;
+        switch( c )
+        {
+            case '"':  out += "\\\""; break;
+            case '\\': out += "\\\\"; break;
+            case '\b': out += "\\b"; break;
+            case '\f': out += "\\f"; break;
+            case '\n': out += "\\n"; break;
+            case '\r': out += "\\r"; break;
+            case '\t': out += "\\t"; break;
+            default:
+            {
+                if( c < 0x20 )
+                {
+                    out += "\\u00";
+                    out += hex[ c >> 4 ];
+                    out += hex[ c & 0x0F ];
+                }
+                else
+                {
+                    out += (char)c;
+                }
+                break;
+            }
+        }
+    }
+
+    out += '"';
+}
+
+
+void MessageWriter::writeInt_( const int& value, std::string& out )
+{
+    char digits[ 12 ];
+    char* ptr = digits + sizeof( digits );
+
+    unsigned int magnitude = ( value < 0 )
+            ? 0u - (unsigned int)value : (unsigned int)value;
+
+    do
+    {
+        *--ptr = (char)( '0' + magnitude % 10 );
+        magnitude /= 10;
+    } while( magnitude != 0 );
+
+    if( value < 0 )
+    {
+        *--ptr = '-';
+    }
+
+    out.append( ptr, digits + sizeof( digits ) - ptr );
+}
+
+
+void MessageWriter::writeBool_( const bool& value, std::string& out )
+{
+    out += ( value ) ? "true" : "false";
+}
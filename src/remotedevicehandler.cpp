@@ -31,44 +31,106 @@
 
 using json = nlohmann::json;
 
+namespace
+{
+
+// Fields read from each inbound message; anything else is skipped.
+constexpr FieldSpec HEADER_FIELDS[ ] = {
+    { "group", FieldType::String, false },
+    { "encoding", FieldType::String, false } };
+
+constexpr FieldSpec SET_BODY_ENCODING_FIELDS[ ] = {
+    { "encoding", FieldType::String, false },
+    { "binary_dmh", FieldType::Bool, false } };
+
+constexpr FieldSpec SEND_PIN_FIELDS[ ] = {
+    { "pin", FieldType::String, true } };
+
+constexpr FieldSpec MOBILE_INIT_FIELDS[ ] = {
+    { "terms_accepted", FieldType::Bool, false } };
+
+constexpr FieldSpec MANEUVER_INIT_FIELDS[ ] = {
+    { "maneuver", FieldType::String, false } };
+
+constexpr FieldSpec MOBILE_RESPONSE_FIELDS[ ] = {
+    { "response_to_challenge", FieldType::String, true } };
+
+constexpr FieldSpec DEADMANS_HANDLE_FIELDS[ ] = {
+    { "enable_vehicle_motion", FieldType::Bool, true },
+    { "dmh_gesture_progress", FieldType::Number, true },
+    { "dmh_horizontal_touch", FieldType::Number, true },
+    { "dmh_vertical_touch", FieldType::Number, true },
+    { "crc_value", FieldType::Number, true } };
+
+constexpr FieldSpec CABIN_COMMANDS_FIELDS[ ] = {
+    { "engine_off", FieldType::Bool, true },
+    { "doors_locked", FieldType::Bool, true } };
+
+constexpr RequestSchema HEADER_SCHEMA = makeSchema( HEADER_FIELDS );
+constexpr RequestSchema SET_BODY_ENCODING_SCHEMA = makeSchema( SET_BODY_ENCODING_FIELDS );
+constexpr RequestSchema SEND_PIN_SCHEMA = makeSchema( SEND_PIN_FIELDS );
+constexpr RequestSchema MOBILE_INIT_SCHEMA = makeSchema( MOBILE_INIT_FIELDS );
+constexpr RequestSchema MANEUVER_INIT_SCHEMA = makeSchema( MANEUVER_INIT_FIELDS );
+constexpr RequestSchema MOBILE_RESPONSE_SCHEMA = makeSchema( MOBILE_RESPONSE_FIELDS );
+constexpr RequestSchema DEADMANS_HANDLE_SCHEMA = makeSchema( DEADMANS_HANDLE_FIELDS );
+constexpr RequestSchema CABIN_COMMANDS_SCHEMA = makeSchema( CABIN_COMMANDS_FIELDS );
+
+}
+
 
-RemoteDeviceHandler::RemoteDeviceHandler( std::shared_ptr <SignalHandler> TCM )
+RemoteDeviceHandler::RemoteDeviceHandler(
+        std::shared_ptr <SignalHandler> TCM,
+        const bool& startThreads )
         :
         TCM_( TCM ),
         templates_( ),
+        activeConnection_( -1 ),
+        controllingConnection_( -1 ),
+        deferredCount_( 0 ),
         running_( true ),
-        eventLoopHandler_( &RemoteDeviceHandler::statusUpdateEventLoop_, this )
+        statusSignals_( TCM->getSignalBus( ).subscribe( ALL_STATUS_SIGNALS ) ),
+        eventLoopHandler_( )
 {
 
     // Generate client sockets
     SocketHandler socketHandler_;
 
     // Populate assigned signal values.
-    prevSig_.ManeuverStatus = TCM_->ManeuverStatus;
-    prevSig_.NoFeatureAvailableMsg = TCM_->NoFeatureAvailableMsg;
-    prevSig_.CancelMsg = TCM_->CancelMsg;
-    prevSig_.PauseMsg1 = TCM_->PauseMsg1;
-    prevSig_.PauseMsg2 = TCM_->PauseMsg2;
-    prevSig_.InfoMsg = TCM_->InfoMsg;
-    prevSig_.InstructMsg = TCM_->InstructMsg;
+    const AspSnapshot asp( TCM_->getAspSnapshot( ) );
+    prevSig_.ManeuverStatus = asp.ManeuverStatus;
+    prevSig_.NoFeatureAvailableMsg = asp.NoFeatureAvailableMsg;
+    prevSig_.CancelMsg = asp.CancelMsg;
+    prevSig_.PauseMsg1 = asp.PauseMsg1;
+    prevSig_.PauseMsg2 = asp.PauseMsg2;
+    prevSig_.InfoMsg = asp.InfoMsg;
+    prevSig_.InstructMsg = asp.InstructMsg;
     prevSig_.AcknowledgeRemotePIN = TCM_->AcknowledgeRemotePIN;
     prevSig_.ErrorMsg = TCM_->ErrorMsg;
-    prevSig_.MobileChallengeSend = TCM_->MobileChallengeSend;
+    prevSig_.MobileChallengeSend = asp.MobileChallengeSend;
 
-    // Populate assigned signal values.
-    mapMsgText_( sigText_.ManeuverStatus, rawTextManeuverStatus );
-    mapMsgText_( sigText_.NoFeatureAvailableMsg, rawTextNoFeatureAvailableMsg );
-    mapMsgText_( sigText_.CancelMsg, rawTextCancelMsg );
-    mapMsgText_( sigText_.PauseMsg1, rawTextPauseMsg1 );
-    mapMsgText_( sigText_.PauseMsg2, rawTextPauseMsg2 );
-    mapMsgText_( sigText_.InfoMsg, rawTextLMInfoRMT );
-    mapMsgText_( sigText_.InstructMsg, rawTextInstructMsg );
-    mapMsgText_( sigText_.AcknowledgeRemotePIN, rawAcknowledgeRemotePIN );
-    mapMsgText_( sigText_.ErrorMsg, rawErrorMsg );
+    registerGroupHandlers_( );
 
+    // Deferred replies complete as soon as the ASP state they await arrives.
+    TCM_->setStateCallback( [ this ]( )
+    {
+        if( deferredCount_ > 0 )
+        {
+            this->socketHandler_.wake( );
+        }
+    } );
+
+    if( startThreads == false )
+    {
+        TCM_->initiateTicks( );
+
+        return;
+    }
 
     TCM_->initiateEventLoops( );
 
+    // Start only once prevSig_ is populated.
+    eventLoopHandler_ = std::thread( &RemoteDeviceHandler::statusUpdateEventLoop_, this );
+
     std::cout << "Using API version " << API_DOC_VERSION << std::endl;
 
 }
@@ -76,7 +138,14 @@ RemoteDeviceHandler::RemoteDeviceHandler( std::shared_ptr <SignalHandler> TCM )
 
 RemoteDeviceHandler::~RemoteDeviceHandler( )
 {
-    eventLoopHandler_.join();
+    if( eventLoopHandler_.joinable( ) )
+    {
+        eventLoopHandler_.join();
+    }
+
+    // The signal handler may outlive this handler.
+    TCM_->setStateCallback( nullptr );
+    TCM_->getSignalBus( ).unsubscribe( statusSignals_ );
 }
 
 
@@ -102,9 +171,12 @@ bool RemoteDeviceHandler::checkMessageReadability_( const ssize_t& receiptVal )
 }
 
 
-bool RemoteDeviceHandler::checkClientConnection_( const std::string& msg )
+bool RemoteDeviceHandler::checkClientConnection_(
+        const int& connection,
+        const char* msg,
+        const size_t& msgLen )
 {
-    if( socketHandler_.checkClientConnection( ) != 0 )
+    if( socketHandler_.checkClientConnection( connection ) != 0 )
     {
         std::cout << "---" << std::endl;
         std::cout << "Mobile device link to API severed." << std::endl;
@@ -112,7 +184,11 @@ bool RemoteDeviceHandler::checkClientConnection_( const std::string& msg )
         return false;
     }
 
-    if( msg.find( "disconnectMobile" ) != std::string::npos )
+    static const std::string disconnectRequest( "disconnectMobile" );
+
+    if( std::search( msg, msg + msgLen,
+                     disconnectRequest.begin( ),
+                     disconnectRequest.end( ) ) != msg + msgLen )
     {
 
         std::cout << "---" << std::endl;
@@ -145,16 +221,18 @@ void RemoteDeviceHandler::setKeyFobRangingRate_(
 
 
 void RemoteDeviceHandler::messageEvent_(
-        const std::string& rawMsgIn,
+        const char* rawMsgIn,
         const uint32_t& headerLen,
         const uint32_t& bodyLen )
 {
 
-    json msgInHeader;
-    json msgInBody;
+    // DOMs are only built for binary bodies and escaped strings.
+    json domHeader;
+    json domBody;
 
-    std::string rawHeader( rawMsgIn.substr( 0, headerLen ) );
-    std::string rawBody( rawMsgIn.substr( headerLen, bodyLen ) );
+    // Parse in place; header and body are views into the receive buffer.
+    const char* rawHeader( rawMsgIn );
+    const char* rawBody( rawMsgIn + headerLen );
 
     // leave per commonly-used state debugging statements.
     // std::cout << std::setw(4) << rawMsgIn << std::endl;
@@ -163,425 +241,903 @@ void RemoteDeviceHandler::messageEvent_(
     // std::cout << "bodyLen = " << (int)bodyLen << std::endl;
     // std::cout << "rawBody: " << rawBody << std::endl;
 
-    try
+    RequestBody msgInHeader( HEADER_SCHEMA );
+    ParseStatus status( RequestParser::parse( rawHeader, headerLen, msgInHeader ) );
+
+    if( status == ParseStatus::Unsupported )
     {
-        msgInHeader = json::parse( rawHeader );
-        if( !rawBody.empty( ) )
-        {
-            msgInBody = json::parse( rawBody );
-        }
+        status = BodyCodec::decode( rawHeader, headerLen, BodyEncoding::Json, domHeader )
+                ? RequestParser::parseDom( domHeader, msgInHeader )
+                : ParseStatus::Malformed;
     }
-    catch( std::exception& e )
-    {
 
-        std::cout << "Exception thrown parsing JSON message: " << e.what( );
+    if( status == ParseStatus::Malformed )
+    {
+        std::cout << "---" << std::endl;
+        std::cout << "Malformed JSON message header." << std::endl;
 
         sendMsg_( "Parsing error; check JSON input.", RD::DEBUG );
 
         return;
+    }
+
+    const FieldValue& msgGroup = msgInHeader.get( "group" );
 
+    if( msgGroup.present == false )
+    {
+        sendMsg_( ( status == ParseStatus::TypeMismatch )
+                ? "Read in error: Unknown group in msg."
+                : "Read in error: No message group available.", RD::DEBUG );
+
+        return;
     }
 
-    if( msgInHeader.contains( "group" ) )
+    std::cout << "---" << std::endl;
+    std::cout << "Message read: \"";
+    std::cout.write( msgGroup.string, msgGroup.length ) << "\"" << std::endl;
+
+    const RequestSchema* schema = groupHandlers_.getSchema( msgGroup.string, msgGroup.length );
+
+    if( schema == nullptr )
     {
+        sendMsg_( "Read in error: Unknown group in msg.", RD::DEBUG );
+
+        return;
+    }
 
-        auto& msgGroup = msgInHeader[ "group" ];
+    // Bodies use the negotiated encoding unless their header names another.
+    BodyEncoding bodyEncoding( getBodyEncoding_( activeConnection_ ) );
 
-        std::cout << "---" << std::endl;
-        std::cout << "Message read: " << msgGroup << std::endl;
+    if( msgInHeader.has( "encoding" ) )
+    {
+        BodyCodec::parseEncoding( msgInHeader.getString( "encoding" ), bodyEncoding );
+    }
+
+    RequestBody msgInBody( *schema );
+
+    status = ( bodyEncoding == BodyEncoding::Json )
+            ? RequestParser::parse( rawBody, bodyLen, msgInBody )
+            : ParseStatus::Unsupported;
+
+    if( status == ParseStatus::Unsupported )
+    {
+        status = ( bodyLen == 0 || BodyCodec::decode( rawBody, bodyLen, bodyEncoding, domBody ) )
+                ? RequestParser::parseDom( domBody, msgInBody )
+                : ParseStatus::Malformed;
+    }
 
-        // Parse messages by group
-        if( msgGroup == RD::GET_API_VERSION )
+    switch( status )
+    {
+        case ParseStatus::Ok:
         {
-            sendVehicleAPIVersion_( );
+            groupHandlers_.dispatch( msgGroup.string, msgGroup.length, msgInBody );
+            break;
         }
-        else if( msgGroup == RD::SEND_PIN )
+        case ParseStatus::MissingField:
+        case ParseStatus::TypeMismatch:
+        {
+            sendMsg_( "JSON template mismatch; Check input format.", RD::DEBUG );
+            break;
+        }
+        default:
         {
+            std::cout << "---" << std::endl;
+            std::cout << "Malformed " << BodyCodec::getEncodingName( bodyEncoding )
+            << " message body." << std::endl;
 
-            auto& msgPIN = msgInBody[ "pin" ];
+            sendMsg_( "Parsing error; check JSON input.", RD::DEBUG );
+            break;
+        }
+    }
 
-            try
-            {
-                setRemoteControlPIN_( msgPIN );
+    return;
+}
 
-                while(  TCM_->AcknowledgeRemotePIN == DCM::AcknowledgeRemotePIN::None ||
-                        TCM_->AcknowledgeRemotePIN == DCM::AcknowledgeRemotePIN::ExpiredPIN )
-                {
 
-                    usleep( ASP_REFRESH_RATE );
-                    setRemoteControlPIN_( msgPIN );
+void RemoteDeviceHandler::registerGroupHandlers_( )
+{
 
-                }
-            }
-            catch( std::exception& e )
+    groupHandlers_.add( RD::GET_API_VERSION, [ this ]( const RequestBody& ) { sendVehicleAPIVersion_( ); } );
+    addGroupHandler_( RD::HEARTBEAT, &RemoteDeviceHandler::handleHeartbeat_ );
+    groupHandlers_.add(
+            RD::SET_BODY_ENCODING,
+            [ this ]( const RequestBody& body ) { setBodyEncoding_( body ); },
+            SET_BODY_ENCODING_SCHEMA );
+    addGroupHandler_( RD::SEND_PIN, &RemoteDeviceHandler::handleSendPIN_, SEND_PIN_SCHEMA );
+    addGroupHandler_( RD::MOBILE_INIT, &RemoteDeviceHandler::handleMobileInit_, MOBILE_INIT_SCHEMA );
+    addGroupHandler_( RD::GET_THREAT_DATA, &RemoteDeviceHandler::handleGetThreatData_ );
+    addGroupHandler_( RD::LIST_MANEUVERS, &RemoteDeviceHandler::handleListManeuvers_ );
+    addGroupHandler_( RD::MANEUVER_INIT, &RemoteDeviceHandler::handleManeuverInit_, MANEUVER_INIT_SCHEMA );
+    addGroupHandler_( RD::MOBILE_RESPONSE, &RemoteDeviceHandler::handleMobileResponse_, MOBILE_RESPONSE_SCHEMA );
+    addGroupHandler_( RD::DEADMANS_HANDLE, &RemoteDeviceHandler::handleDeadmansHandle_, DEADMANS_HANDLE_SCHEMA );
+    addGroupHandler_( RD::CANCEL_DRIVE_ON, &RemoteDeviceHandler::handleCancelDriveOn_ );
+    addGroupHandler_( RD::CANCEL_MANEUVER, &RemoteDeviceHandler::handleCancelManeuver_ );
+    groupHandlers_.add( RD::VEHICLE_STATUS, [ this ]( const RequestBody& ) { sendVehicleStatus_( ); } );
+    groupHandlers_.add( RD::MANEUVER_STATUS, [ this ]( const RequestBody& ) { sendManeuverStatus_( ); } );
+    groupHandlers_.add( RD::GET_CABIN_STATUS, [ this ]( const RequestBody& ) { sendCabinStatus_( ); } );
+    addGroupHandler_( RD::CABIN_COMMANDS, &RemoteDeviceHandler::handleCabinCommands_, CABIN_COMMANDS_SCHEMA );
+    groupHandlers_.add( RD::MOBILE_CHALLENGE, [ this ]( const RequestBody& )
+    {
+        sendMsg_( "Message type not currently supported.", RD::DEBUG );
+    } );
+
+}
+
+
+void RemoteDeviceHandler::addGroupHandler_(
+        const char* group,
+        void ( RemoteDeviceHandler::*handler )( const RequestBody& ),
+        const RequestSchema& schema )
+{
+    groupHandlers_.add( group, std::bind( handler, this, std::placeholders::_1 ), schema );
+}
+
+
+void RemoteDeviceHandler::handleHeartbeat_( const RequestBody& /* msgInBody */ )
+{
+
+    // First heartbeat opts the device in to liveness supervision.
+    socketHandler_.setLivenessTimeout( activeConnection_, TCP_HEARTBEAT_TIMEOUT );
+    sendMsg_( json::object( ), RD::HEARTBEAT );
+
+}
+
+
+void RemoteDeviceHandler::handleSendPIN_( const RequestBody& msgInBody )
+{
+
+    std::string msgPIN( msgInBody.getString( "pin" ) );
+    DCM::AcknowledgeRemotePIN previous( TCM_->AcknowledgeRemotePIN );
+
+    setRemoteControlPIN_( msgPIN );
+
+    deferReply_(
+            [ this ]( )
             {
-                sendMsg_( "JSON template mismatch; Check input format.", RD::DEBUG );
+                return TCM_->AcknowledgeRemotePIN != DCM::AcknowledgeRemotePIN::None &&
+                        TCM_->AcknowledgeRemotePIN != DCM::AcknowledgeRemotePIN::ExpiredPIN;
+            },
+            [ this, previous ]( )
+            {
+                // A changed result is published, and the status loop reports it.
+                if( TCM_->AcknowledgeRemotePIN == previous )
+                {
+                    sendVehicleStatus_( );
+                    prevSig_.AcknowledgeRemotePIN = TCM_->AcknowledgeRemotePIN;
+                }
+            },
+            DEFERRED_REPLY_TIMEOUT,
+            [ this, msgPIN ]( ) { setRemoteControlPIN_( msgPIN ); } );
 
-                std::cout << "Exception thrown parsing JSON message: " << e.what( );
+}
 
-                return;
-            }
 
-            sendVehicleStatus_( );
-            prevSig_.AcknowledgeRemotePIN = TCM_->AcknowledgeRemotePIN;
+void RemoteDeviceHandler::handleMobileInit_( const RequestBody& msgInBody )
+{
 
-        }
-        else if( msgGroup == RD::MOBILE_INIT )
+    // std::lock_guard<std::mutex> lock( TCM_->getMutex( ) );
+    bool msgTerms( msgInBody.getBool( "terms_accepted" ) );
+    if( msgTerms == true && checkAuthenticatedPIN_( ) )
+    {
+        setConnectionApproved_( TCM::ConnectionApproval::AllowedDevice );
+        controllingConnection_ = activeConnection_;
+        if( checkDeviceCompatibility_( ) )
         {
-            // std::lock_guard<std::mutex> lock( TCM_->getMutex( ) );
-            auto& msgTerms = msgInBody[ "terms_accepted" ];
-            if( msgTerms == true && checkAuthenticatedPIN_( ) )
+            if( !checkManeuversInProgress_( ) )
             {
-                setConnectionApproved_( TCM::ConnectionApproval::AllowedDevice );
-                if( checkDeviceCompatibility_( ) )
-                {
-                    if( !checkManeuversInProgress_( ) )
-                    {
-                        std::cout << "PIN Authenticated. Passing RCMainMenu to ASP."
-                        << std::endl;
+                std::cout << "PIN Authenticated. Passing RCMainMenu to ASP."
+                << std::endl;
 
-                        loadMainMenu_( );
-                    }
-                    else if( TCM_->ActiveParkingMode == ASP::ActiveParkingMode::ParkIn )
-                    {
-                        parkInSelected_( TCM_->getManeuverFromASP( ) );
-                    }
-                }
+                loadMainMenu_( );
             }
-            else
+            else if( TCM_->getAspSnapshot( ).ActiveParkingMode == ASP::ActiveParkingMode::ParkIn )
             {
-                std::string error;
-                if( !msgTerms )
-                {
-                    error += "* Message terms not accepted *";
-                }
-                if( !checkAuthenticatedPIN_( ) )
-                {
-                    error += "* PIN is invalid. Try send_pin again. *";
-                }
-                if( !checkDeviceCompatibility_( ) )
+                parkInSelected_( SignalHandler::getManeuverFromASP( TCM_->getAspSnapshot( ) ) );
+            }
+        }
+    }
+    else
+    {
+        std::string error;
+        if( !msgTerms )
+        {
+            error += "* Message terms not accepted *";
+        }
+        if( !checkAuthenticatedPIN_( ) )
+        {
+            error += "* PIN is invalid. Try send_pin again. *";
+        }
+        if( !checkDeviceCompatibility_( ) )
+        {
+            error += "* There is no compatible device connected. *";
+        }
+        if( checkManeuversInProgress_( ) )
+        {
+            error += "* Maneuvers in progress. *";
+        }
+        std::cout << error + " * bypassing RCMainMenu *" << std::endl;
+    }
+
+    // for mobile_init, return vehicle init.
+    sendVehicleInit_( );
+
+}
+
+
+void RemoteDeviceHandler::handleGetThreatData_( const RequestBody& /* msgInBody */ )
+{
+
+    // This if statement should be eventually be removed.  App currently
+    // calls for cancel_maneuver at the end of a maneuver; simulated ASP
+    // must therefore be reset
+    if( TCM_->getAspSnapshot( ).ManeuverStatus == ASP::ManeuverStatus::Cancelled )
+    {
+        loadMainMenu_( );
+    }
+
+    deferReply_(
+            [ this ]( ) { return TCM_->getAspSnapshot( ).ManeuverStatus != ASP::ManeuverStatus::Scanning; },
+            [ this ]( ) { sendThreatData_( ); },
+            DEFERRED_REPLY_TIMEOUT );
+
+}
+
+
+void RemoteDeviceHandler::handleListManeuvers_( const RequestBody& /* msgInBody */ )
+{
+
+    uint64_t notBefore( LatencyHistogram::now( ) );
+
+    // This if statement should be eventually be removed.  App currently
+    // calls for cancel_maneuver at the end of a maneuver; simulated ASP
+    // must therefore be reset
+    ASP::ManeuverStatus status( TCM_->getAspSnapshot( ).ManeuverStatus );
+    if(     status == ASP::ManeuverStatus::Cancelled ||
+            status == ASP::ManeuverStatus::Finishing ||
+            status == ASP::ManeuverStatus::Ended )
+    {
+        loadMainMenu_( );
+
+        // Give the ASP a cycle to act on the main menu.
+        notBefore += (uint64_t)ASP_REFRESH_RATE * 1000;
+    }
+
+    deferReply_(
+            [ this, notBefore ]( )
+            {
+                return LatencyHistogram::now( ) >= notBefore &&
+                        TCM_->getAspSnapshot( ).ManeuverStatus != ASP::ManeuverStatus::Scanning;
+            },
+            [ this ]( )
+            {
+                if( !checkAuthenticatedPIN_( ) || !checkDeviceCompatibility_( ) )
                 {
-                    error += "* There is no compatible device connected. *";
+
+                    // Per FDJ demo requirements, device compatability is implied
+                    // if connection is made, so PIN must be bad.
+                    sendMsg_( "Incorrect PIN entered.  Send mobile_init.", RD::DEBUG );
+
+                    return;
+
                 }
-                if( checkManeuversInProgress_( ) )
+
+                ASP::ManeuverProgressBar progress( TCM_->getAspSnapshot( ).ManeuverProgressBar );
+                if( progress == 0 || progress == 100 )
                 {
-                    error += "* Maneuvers in progress. *";
+                    loadSpaceSelection_( );
                 }
-                std::cout << error + " * bypassing RCMainMenu *" << std::endl;
-            }
 
-            // for mobile_init, return vehicle init.
-            sendVehicleInit_( );
-        }
+                sendAvailableManeuvers_( );
+            },
+            DEFERRED_REPLY_TIMEOUT );
+
+}
+
 
-        else if( msgGroup == RD::GET_THREAT_DATA )
+void RemoteDeviceHandler::handleManeuverInit_( const RequestBody& msgInBody )
+{
+
+    if( msgInBody.has( "maneuver" ) )
+    {
+
+        if( !checkAuthenticatedPIN_( ) || !checkDeviceCompatibility_( ) )
         {
 
-            // This if statement should be eventually be removed.  App currently
-            // calls for cancel_maneuver at the end of a maneuver; simulated ASP
-            // must therefore be reset
-            if( TCM_->ManeuverStatus == ASP::ManeuverStatus::Cancelled )
-            {
-                loadMainMenu_( );
-            }
+            // Per FDJ demo requirements, device compatability is implied
+            // if connection is made, so PIN must be bad.
+            sendMsg_( "Incorrect PIN entered.  Send mobile_init.", RD::DEBUG );
 
-            while( TCM_->ManeuverStatus == ASP::ManeuverStatus::Scanning )
-            {
-                usleep( ASP_REFRESH_RATE );
-            }
+            return;
 
-            sendThreatData_( );
         }
 
-        else if( msgGroup == RD::LIST_MANEUVERS )
+        const std::string msgManeuver( msgInBody.getString( "maneuver" ) );
+
+        // check if maneuver in progress is the same as inbound request
+        if( checkManeuversInProgress_( ) )
         {
-            // This if statement should be eventually be removed.  App currently
-            // calls for cancel_maneuver at the end of a maneuver; simulated ASP
-            // must therefore be reset
-            if(     TCM_->ManeuverStatus == ASP::ManeuverStatus::Cancelled ||
-                    TCM_->ManeuverStatus == ASP::ManeuverStatus::Finishing ||
-                    TCM_->ManeuverStatus == ASP::ManeuverStatus::Ended )
+            if( msgManeuver == SignalHandler::getManeuverFromASP( TCM_->getAspSnapshot( ) ) )
             {
-                loadMainMenu_( );
-                usleep( ASP_REFRESH_RATE );
+                std::cout << "Duplicate maneuver_init received." << std::endl;
+                sendManeuverStatus_( );
+
+                return;
             }
 
-            while(  TCM_->ManeuverStatus == ASP::ManeuverStatus::Scanning )
+            // **TECH DEBT** else reset the ASPM to space selection
+            else
             {
-                usleep( ASP_REFRESH_RATE );
+                loadSpaceSelection_( );
+                deferReply_(
+                        [ this ]( )
+                        {
+                            const AspSnapshot asp( TCM_->getAspSnapshot( ) );
+                            return asp.ConfirmAvailability != ASP::ConfirmAvailability::OfferEnabled &&
+                                    asp.ResumeAvailability != ASP::ResumeAvailability::OfferEnabled;
+                        },
+                        [ this, msgManeuver ]( ) { selectManeuver_( msgManeuver ); },
+                        DEFERRED_REPLY_TIMEOUT );
+
+                return;
             }
+        }
+
+        selectManeuver_( msgManeuver );
+    }
+    else
+    {
+        sendMsg_( "Read error: No maneuver in 'data' available.", RD::DEBUG );
+
+        return;
+    }
+
+}
+
+
+void RemoteDeviceHandler::selectManeuver_( const std::string& msgManeuver )
+{
+
+    if( msgManeuver == "StrFwd" || msgManeuver == "StrRvs" )
+    {
+        pushPullSelected_( msgManeuver );
+    }
+    else if( msgManeuver == "InLftFwd" || msgManeuver == "InLftRvs" ||
+             msgManeuver == "InRgtFwd" || msgManeuver == "InRgtRvs" )
+    {
+        parkInSelected_( msgManeuver );
+    }
+    else if( msgManeuver == "OutLftFwd" || msgManeuver == "OutLftRvs" ||
+             msgManeuver == "OutRgtFwd" || msgManeuver == "OutRgtRvs" ||
+             msgManeuver == "OutLftPrl" || msgManeuver == "OutRgtPrl" )
+    {
+        parkOutSelected_( msgManeuver );
+    }
+    else if ( msgManeuver == "NdgFwd" || msgManeuver == "NdgRvs" )
+    {
+        adjustSelected_( msgManeuver );
+    }
+    else if ( msgManeuver == "RtnToOgn" )
+    {
+        returnToOriginSelected_( );
+    }
+    else
+    {
+        std::cout << "Maneuver " << msgManeuver;
+        std::cout << " is not currently supported." << std::endl;
+
+        sendMsg_( "Received Maneuver not supported.", RD::DEBUG );
 
-            if( !checkAuthenticatedPIN_( ) || !checkDeviceCompatibility_( ) )
+        return;
+    }
+
+    // after 150ms of attempting to send the maneuver_init, drop out
+    deferReply_(
+            [ this, msgManeuver ]( )
+            {
+                const AspSnapshot asp( TCM_->getAspSnapshot( ) );
+                return asp.ConfirmAvailability != ASP::ConfirmAvailability::None &&
+                        SignalHandler::getManeuverFromASP( asp ) == msgManeuver;
+            },
+            [ this, msgManeuver ]( )
             {
+                std::string aspManeuver( SignalHandler::getManeuverFromASP( TCM_->getAspSnapshot( ) ) );
+                if( aspManeuver != msgManeuver )
+                {
+                    std::cout << "Default maneuver mismatch:\tmsgManeuver: "
+                    << msgManeuver << "\tgetManeuverFromASP: "
+                    << aspManeuver << std::endl;
+                }
 
-                // Per FDJ demo requirements, device compatability is implied
-                // if connection is made, so PIN must be bad.
-                sendMsg_( "Incorrect PIN entered.  Send mobile_init.", RD::DEBUG );
+                sendManeuverStatus_( );
+            },
+            MANEUVER_INIT_TIMEOUT );
 
-                return;
+}
 
-            }
 
-            if( TCM_->ManeuverProgressBar == 0 || TCM_->ManeuverProgressBar == 100 )
+void RemoteDeviceHandler::handleMobileResponse_( const RequestBody& msgInBody )
+{
+
+    std::string responseVal( msgInBody.getString( "response_to_challenge" ) );
+    (std::istringstream)responseVal >> TCM_->MobileChallengeReply;
+
+}
+
+
+void RemoteDeviceHandler::handleDeadmansHandle_( const RequestBody& msgInBody )
+{
+
+    bool msgGestureEnabled( msgInBody.getBool( "enable_vehicle_motion" ) );
+    int msgGestureProgress( (int)msgInBody.getNumber( "dmh_gesture_progress" ) );
+    float msgAppSliderPosX( (float)msgInBody.getNumber( "dmh_horizontal_touch" ) );
+    float msgAppSliderPosY( (float)msgInBody.getNumber( "dmh_vertical_touch" ) );
+    int msgCRCValue( (int)msgInBody.getNumber( "crc_value" ) );
+
+    updateDMH_(
+            msgAppSliderPosX,
+            msgAppSliderPosY,
+            msgGestureProgress,
+            msgGestureEnabled,
+            msgCRCValue );
+
+}
+
+
+void RemoteDeviceHandler::dmhFrameEvent_( const char* rawBody, const uint32_t& bodyLen )
+{
+
+    bool negotiated;
+
+    {
+        std::lock_guard<std::mutex> lock( encodingMtx_ );
+        negotiated = ( binaryDmh_.count( activeConnection_ ) != 0 );
+    }
+
+    if( negotiated == false )
+    {
+        sendMsg_( "Read in error: Binary DMH not negotiated.", RD::DEBUG );
+
+        return;
+    }
+
+    DmhSample sample;
+
+    if( DmhFrame::decode( rawBody, bodyLen, sample ) == false )
+    {
+        std::cout << "---" << std::endl;
+        std::cout << "Malformed binary DMH frame." << std::endl;
+
+        sendMsg_( "Parsing error; check DMH frame layout.", RD::DEBUG );
+
+        return;
+    }
+
+    updateDMH_(
+            (float)sample.x,
+            (float)sample.y,
+            (int)sample.percent,
+            sample.gesture,
+            (int)sample.crc );
+
+}
+
+
+void RemoteDeviceHandler::handleCancelDriveOn_( const RequestBody& /* msgInBody */ )
+{
+
+    // Unclear what to send beyond ManeuverButtonPress; it is assumed
+    // that this only arrives if the vehicle is in some paused state.
+    TCM_->setManeuverButtonPress( TCM::ManeuverButtonPress::ResumeSelected );
+
+}
+
+
+void RemoteDeviceHandler::handleCancelManeuver_( const RequestBody& /* msgInBody */ )
+{
+
+    //  **TODO** What to send here??
+
+    if( TCM_->getAspSnapshot( ).ManeuverStatus == ASP::ManeuverStatus::Cancelled )
+    {
+        return;
+    }
+
+    TCM_->setManeuverButtonPress( TCM::ManeuverButtonPress::CancellationSelected );
+
+    deferReply_(
+            [ this ]( ) { return TCM_->getAspSnapshot( ).ManeuverStatus == ASP::ManeuverStatus::Cancelled; },
+            nullptr,
+            DEFERRED_REPLY_TIMEOUT,
+            [ this ]( )
             {
-                loadSpaceSelection_( );
-            }
+                TCM_->setManeuverButtonPress( TCM::ManeuverButtonPress::CancellationSelected );
+            } );
+
+}
+
+
+void RemoteDeviceHandler::handleCabinCommands_( const RequestBody& msgInBody )
+{
+
+    TCM_->setCabinCommands(
+            msgInBody.getBool( "engine_off" ),
+            msgInBody.getBool( "doors_locked" ) );
+
+    // **TODO** The below is semi-deprecated until use case for
+    // TCM::ManeuverButtonPress::EndManouevre is properly defined.
+    // if (msgInBody["engine_off"] && msgInBody["doors_locked"])
+    // {
+    //     while( TCM_->ManeuverStatus != ASP::ManeuverStatus::Ended )
+    //     {
+    //         TCM_->setManeuverButtonPress( TCM::ManeuverButtonPress::EndManouevre );
+    //         usleep( ASP_REFRESH_RATE );
+    //     }
+    // }
+    sendCabinStatus_( );
+
+}
+
+
+void RemoteDeviceHandler::deferReply_(
+        const std::function< bool( ) >& ready,
+        const std::function< void( ) >& reply,
+        const uint32_t& timeout,
+        const std::function< void( ) >& retry )
+{
+
+    if( ready( ) )
+    {
+        if( reply )
+        {
+            reply( );
+        }
+
+        return;
+    }
+
+    uint64_t now( LatencyHistogram::now( ) );
+
+    DeferredReply pending;
+    pending.connection = activeConnection_;
+    pending.ready = ready;
+    pending.reply = reply;
+    pending.retry = retry;
+    pending.deadline = now + (uint64_t)timeout * 1000;
+    pending.nextRetry = now + (uint64_t)ASP_REFRESH_RATE * 1000;
+
+    deferredReplies_.push_back( pending );
+    deferredCount_ = deferredReplies_.size( );
+
+}
+
+
+void RemoteDeviceHandler::serviceDeferredReplies_( )
+{
+
+    uint64_t now( LatencyHistogram::now( ) );
+    std::vector<DeferredReply> due;
+
+    for( auto it = deferredReplies_.begin( ); it != deferredReplies_.end( ); )
+    {
+        if( it->ready( ) || now >= it->deadline )
+        {
+            due.push_back( std::move( *it ) );
+            it = deferredReplies_.erase( it );
+
+            continue;
+        }
+
+        if( it->retry && now >= it->nextRetry )
+        {
+            it->retry( );
+            it->nextRetry = now + (uint64_t)ASP_REFRESH_RATE * 1000;
+        }
+
+        ++it;
+    }
+
+    deferredCount_ = deferredReplies_.size( );
 
-            sendAvailableManeuvers_( );
+    // Replies may defer again, e.g. maneuver_init once space selection is back.
+    for( auto& pending : due )
+    {
+        if( !pending.reply )
+        {
+            continue;
         }
 
-        else if( msgGroup == RD::MANEUVER_INIT )
+        activeConnection_ = pending.connection;
+        socketHandler_.dispatchAs( pending.connection, pending.reply );
+        activeConnection_ = -1;
+    }
+
+}
+
+
+void RemoteDeviceHandler::sendMsg_(
+        const json& msgOut,
+        const std::string& msgGroup,
+        const uint64_t& version )
+{
+
+    json header = templates_.getRawHeaderTemplate();
+    header[ "group" ] = msgGroup;
+    std::string headerOut = header.dump( );
+
+    if( socketHandler_.checkClientConnection( ) != 0 )
+    {
+        std::cout << "---" << std::endl;
+        std::cout << "Mobile device not connected -- message of type "
+        << headerOut << " generated but not sent."<< std::endl;
+
+        return;
+    }
+
+    // check if json in or just a debug msg as string.
+    if ( msgGroup == RD::DEBUG )
+    {
+        json body = templates_.getRawVehicleStatusTemplate();
+
+        body[ "status_9xx" ][ "status_code" ] = 999;
+        body[ "status_9xx" ][ "status_code" ] = msgOut;
+
+        // Populate response to client
+        std::string bodyOut = body.dump( );
+
+        // TODO: the app can't seem handle the "debug" message group anymore without crashing,
+        // we should either wait until it can before re-enabling these, or just remove the
+        // group and just replace them with local error messages
+        // For now we'll just print the debug message instead of sending it
+        std::cout << "DEBUG - " << bodyOut << std::endl;
+        return;
+    }
+
+    std::string supersedeKey( getSupersedeKey_( msgGroup ) );
+
+    // Send reply back to client
+    if( isJsonOnly_( ) )
+    {
+        std::string bodyOut( msgOut.dump( ) );
+
+        responseCache_.store( msgGroup, BodyEncoding::Json, version, headerOut, bodyOut );
+        socketHandler_.sendTCP( headerOut, bodyOut, supersedeKey );
+
+        return;
+    }
+
+    // Each encoding in use is serialized once.
+    std::vector<int> targets( getTargets_( ) );
+
+    std::string headersOut[ BODY_ENCODING_COUNT ];
+    std::string bodiesOut[ BODY_ENCODING_COUNT ];
+
+    for( auto& target : targets )
+    {
+        BodyEncoding encoding( getBodyEncoding_( target ) );
+        size_t index( (size_t)encoding );
+
+        if( headersOut[ index ].empty( ) )
         {
+            headersOut[ index ] = headerOut;
 
-            if( msgInBody.contains("maneuver") )
+            // Binary bodies are announced in the header, which stays JSON.
+            if( encoding != BodyEncoding::Json )
             {
+                json encodedHeader( header );
+                encodedHeader[ "encoding" ] = BodyCodec::getEncodingName( encoding );
 
-                if( !checkAuthenticatedPIN_( ) || !checkDeviceCompatibility_( ) )
-                {
+                headersOut[ index ] = encodedHeader.dump( );
+            }
 
-                    // Per FDJ demo requirements, device compatability is implied
-                    // if connection is made, so PIN must be bad.
-                    sendMsg_( "Incorrect PIN entered.  Send mobile_init.", RD::DEBUG );
+            bodiesOut[ index ] = BodyCodec::encode( msgOut, encoding );
 
-                    return;
+            responseCache_.store( msgGroup, encoding, version, headersOut[ index ], bodiesOut[ index ] );
+        }
 
-                }
+        socketHandler_.sendTCP( target, headersOut[ index ], bodiesOut[ index ], supersedeKey );
+    }
 
-                auto& msgManeuver = msgInBody[ "maneuver" ];
+    return;
+}
 
-                // check if maneuver in progress is the same as inbound request
-                if( checkManeuversInProgress_( ) )
-                {
-                    if( msgManeuver == TCM_->getManeuverFromASP( ) )
-                    {
-                        std::cout << "Duplicate maneuver_init received." << std::endl;
-                        sendManeuverStatus_( );
 
-                        return;
-                    }
+void RemoteDeviceHandler::sendBody_(
+        const std::string& bodyOut,
+        const std::string& msgGroup,
+        const uint64_t& version )
+{
 
-                    // **TECH DEBT** else reset the ASPM to space selection
-                    else
-                    {
-                        loadSpaceSelection_( );
-                        while(  TCM_->ConfirmAvailability == ASP::ConfirmAvailability::OfferEnabled ||
-                                TCM_->ResumeAvailability == ASP::ResumeAvailability::OfferEnabled )
-                        {
-                            usleep( ASP_REFRESH_RATE );
-                        }
-                    }
-                }
+    // Binary encodings still go through the DOM.
+    if( isJsonOnly_( ) == false )
+    {
+        sendMsg_( json::parse( bodyOut ), msgGroup, version );
 
-                if( msgManeuver == "StrFwd" || msgManeuver == "StrRvs" )
-                {
-                    pushPullSelected_( msgManeuver );
-                }
-                else if( msgManeuver == "InLftFwd" || msgManeuver == "InLftRvs" ||
-                         msgManeuver == "InRgtFwd" || msgManeuver == "InRgtRvs" )
-                {
-                    parkInSelected_( msgManeuver );
-                }
-                else if( msgManeuver == "OutLftFwd" || msgManeuver == "OutLftRvs" ||
-                         msgManeuver == "OutRgtFwd" || msgManeuver == "OutRgtRvs" ||
-                         msgManeuver == "OutLftPrl" || msgManeuver == "OutRgtPrl" )
-                {
-                    parkOutSelected_( msgManeuver );
-                }
-                else if ( msgManeuver == "NdgFwd" || msgManeuver == "NdgRvs" )
-                {
-                    adjustSelected_( msgManeuver );
-                }
-                else if ( msgManeuver == "RtnToOgn" )
-                {
-                    returnToOriginSelected_( );
-                }
-                else
-                {
-                    std::cout << "Maneuver " << msgManeuver;
-                    std::cout << " is not currently supported." << std::endl;
+        return;
+    }
+
+    thread_local std::string headerOut;
+    headerOut.clear( );
+    MessageWriter::writeHeader( msgGroup, headerOut );
+
+    if( socketHandler_.checkClientConnection( ) != 0 )
+    {
+        std::cout << "---" << std::endl;
+        std::cout << "Mobile device not connected -- message of type "
+        << headerOut << " generated but not sent."<< std::endl;
+
+        return;
+    }
+
+    responseCache_.store( msgGroup, BodyEncoding::Json, version, headerOut, bodyOut );
+    socketHandler_.sendTCP( headerOut, bodyOut, getSupersedeKey_( msgGroup ) );
 
-                    sendMsg_( "Received Maneuver not supported.", RD::DEBUG );
+    return;
+}
 
-                    return;
-                }
 
-                // after 150ms of attempting to send the maneuver_init, drop out
-                int maneuverInitAttemptCount( 0 );
+bool RemoteDeviceHandler::isJsonOnly_( )
+{
+    std::lock_guard<std::mutex> lock( encodingMtx_ );
 
-                while(  ( TCM_->ConfirmAvailability == ASP::ConfirmAvailability::None
-                        || TCM_->getManeuverFromASP( ) != msgManeuver )
-                        && maneuverInitAttemptCount < 5 )
-                {
-                    // ++maneuverInitAttemptCount;
-                    std::cout << "Default maneuver mismatch, attempt "
-                    << ++maneuverInitAttemptCount << ":\tmsgManeuver: "
-                    << msgManeuver << "\tgetManeuverFromASP: "
-                    << TCM_->getManeuverFromASP( ) << std::endl;
+    return bodyEncodings_.empty( );
+}
 
-                    usleep( ASP_REFRESH_RATE );
-                }
 
-                sendManeuverStatus_( );
-            }
-            else
-            {
-                sendMsg_( "Read error: No maneuver in 'data' available.", RD::DEBUG );
+bool RemoteDeviceHandler::sendCached_( const std::string& msgGroup, const uint64_t& version )
+{
 
-                return;
-            }
-        }
+    // Left to sendMsg_( ), which reports it.
+    if( socketHandler_.checkClientConnection( ) != 0 )
+    {
+        return false;
+    }
+
+    bool anyBinary;
+    {
+        std::lock_guard<std::mutex> lock( encodingMtx_ );
+        anyBinary = ( bodyEncodings_.empty( ) == false );
+    }
 
-        else if( msgGroup == RD::MOBILE_RESPONSE )
+    std::string headersOut[ BODY_ENCODING_COUNT ];
+    std::string bodiesOut[ BODY_ENCODING_COUNT ];
+
+    if( anyBinary == false )
+    {
+        if( responseCache_.lookup( msgGroup, BodyEncoding::Json, version, headersOut[ 0 ], bodiesOut[ 0 ] ) == false )
         {
-            try
-            {
-                std::string responseVal( msgInBody[ "response_to_challenge" ] );
-                (std::istringstream)responseVal >> TCM_->MobileChallengeReply;
-            }
-            catch( std::exception& e )
-            {
-                std::cout << "Exception parsing mobile_challenge: " << e.what( );
-                sendMsg_( "Parsing error; mobile_challenge format.", RD::DEBUG );
-            }
+            return false;
         }
 
+        socketHandler_.sendTCP( headersOut[ 0 ], bodiesOut[ 0 ], getSupersedeKey_( msgGroup ) );
 
-        else if( msgGroup == RD::DEADMANS_HANDLE )
-        {
+        return true;
+    }
 
-            auto& msgGestureEnabled = msgInBody[ "enable_vehicle_motion" ];
-            auto& msgGestureProgress = msgInBody[ "dmh_gesture_progress" ];
-            auto& msgAppSliderPosX = msgInBody[ "dmh_horizontal_touch" ];
-            auto& msgAppSliderPosY = msgInBody[ "dmh_vertical_touch" ];
-            auto& msgCRCValue = msgInBody[ "crc_value" ];
+    // Every encoding must hit before anything is sent.
+    std::vector<int> targets( getTargets_( ) );
+    std::vector<BodyEncoding> encodings;
 
-            updateDMH_(
-                    msgAppSliderPosX,
-                    msgAppSliderPosY,
-                    msgGestureProgress,
-                    msgGestureEnabled,
-                    msgCRCValue );
+    for( auto& target : targets )
+    {
+        BodyEncoding encoding( getBodyEncoding_( target ) );
+        size_t index( (size_t)encoding );
 
-        }
+        encodings.push_back( encoding );
 
-        else if( msgGroup == RD::CANCEL_DRIVE_ON )
+        if( headersOut[ index ].empty( ) &&
+            responseCache_.lookup( msgGroup, encoding, version, headersOut[ index ], bodiesOut[ index ] ) == false )
         {
-            // Unclear what to send beyond ManeuverButtonPress; it is assumed
-            // that this only arrives if the vehicle is in some paused state.
-            TCM_->setManeuverButtonPress( TCM::ManeuverButtonPress::ResumeSelected );
+            return false;
         }
+    }
 
-        else if( msgGroup == RD::CANCEL_MANEUVER )
-        {
-            //  **TODO** What to send here??
-
-            while( TCM_->ManeuverStatus != ASP::ManeuverStatus::Cancelled )
-            {
-                TCM_->setManeuverButtonPress( TCM::ManeuverButtonPress::CancellationSelected );
-                usleep( ASP_REFRESH_RATE );
-            }
+    std::string supersedeKey( getSupersedeKey_( msgGroup ) );
 
-        }
+    for( size_t i = 0; i < targets.size( ); ++i )
+    {
+        size_t index( (size_t)encodings[ i ] );
 
-        else if( msgGroup == RD::VEHICLE_STATUS )
-        {
-            sendVehicleStatus_( );
-        }
+        socketHandler_.sendTCP( targets[ i ], headersOut[ index ], bodiesOut[ index ], supersedeKey );
+    }
 
-        else if( msgGroup == RD::MANEUVER_STATUS )
-        {
-            sendManeuverStatus_( );
-        }
+    return true;
 
-        else if ( msgGroup == RD::GET_CABIN_STATUS )
-        {
-            sendCabinStatus_( );
-        }
+}
 
-        else if ( msgGroup == RD::CABIN_COMMANDS )
-        {
-            TCM_->setCabinCommands(msgInBody["engine_off"], msgInBody["doors_locked"]);
-
-            // **TODO** The below is semi-deprecated until use case for
-            // TCM::ManeuverButtonPress::EndManouevre is properly defined.
-            // if (msgInBody["engine_off"] && msgInBody["doors_locked"])
-            // {
-            //     while( TCM_->ManeuverStatus != ASP::ManeuverStatus::Ended )
-            //     {
-            //         TCM_->setManeuverButtonPress( TCM::ManeuverButtonPress::EndManouevre );
-            //         usleep( ASP_REFRESH_RATE );
-            //     }
-            // }
-            sendCabinStatus_( );
-        }
 
-        else if( msgGroup == RD::MOBILE_CHALLENGE )
-        {
-            sendMsg_( "Message type not currently supported.", RD::DEBUG );
-        }
+std::vector<int> RemoteDeviceHandler::getTargets_( )
+{
 
-        else
-        {
-            sendMsg_( "Read in error: Unknown group in msg.", RD::DEBUG );
-        }
+    std::vector<int> targets;
+    int replyTo( socketHandler_.getDispatchConnection( ) );
 
+    // Replies go to the sender only, pushes to everyone.
+    if( replyTo >= 0 )
+    {
+        targets.push_back( replyTo );
     }
     else
     {
-        sendMsg_( "Read in error: No message group available.", RD::DEBUG );
+        targets = socketHandler_.getConnections( );
     }
-    return;
+
+    return targets;
+
 }
 
 
-void RemoteDeviceHandler::sendMsg_(
-        const json& msgOut,
-        const std::string& msgGroup )
+std::string RemoteDeviceHandler::getSupersedeKey_( const std::string& msgGroup )
 {
 
-    json header = templates_.getRawHeaderTemplate();
-    header[ "group" ] = msgGroup;
-    std::string headerOut = header.dump( );
-
-    if( socketHandler_.checkClientConnection( ) != 0 )
+    // Status pushes are latest-wins: an unsent older copy is superseded.
+    if( msgGroup == RD::VEHICLE_STATUS || msgGroup == RD::MANEUVER_STATUS )
     {
-        std::cout << "---" << std::endl;
-        std::cout << "Mobile device not connected -- message of type "
-        << headerOut << " generated but not sent."<< std::endl;
+        if( msgGroup == RD::MANEUVER_STATUS )
+        {
+            TCM_->recordManeuverStatusSent( );
+        }
 
-        return;
+        return msgGroup;
     }
 
-    std::string bodyOut;
+    return std::string( );
 
-    // check if json in or just a debug msg as string.
-    if ( msgGroup == RD::DEBUG )
-    {
-        json body = templates_.getRawVehicleStatusTemplate();
+}
 
-        body[ "status_9xx" ][ "status_code" ] = 999;
-        body[ "status_9xx" ][ "status_code" ] = msgOut;
 
-        // Populate response to client
-        bodyOut = body.dump( );
+void RemoteDeviceHandler::setBodyEncoding_( const RequestBody& msgBody )
+{
 
-        // TODO: the app can't seem handle the "debug" message group anymore without crashing,
-        // we should either wait until it can before re-enabling these, or just remove the
-        // group and just replace them with local error messages
-        // For now we'll just print the debug message instead of sending it
-        std::cout << "DEBUG - " << bodyOut << std::endl;
-        return;
+    BodyEncoding encoding( getBodyEncoding_( activeConnection_ ) );
+    bool binaryDmh;
+
+    if( msgBody.has( "encoding" ) )
+    {
+        BodyCodec::parseEncoding( msgBody.getString( "encoding" ), encoding );
     }
-    else
+
     {
-        // Populate response to client
-        bodyOut = msgOut.dump( );
+        std::lock_guard<std::mutex> lock( encodingMtx_ );
+
+        if( encoding == BodyEncoding::Json )
+        {
+            bodyEncodings_.erase( activeConnection_ );
+        }
+        else
+        {
+            bodyEncodings_[ activeConnection_ ] = encoding;
+        }
+
+        if( msgBody.has( "binary_dmh" ) && msgBody.getBool( "binary_dmh" ) )
+        {
+            binaryDmh_.insert( activeConnection_ );
+        }
+        else if( msgBody.has( "binary_dmh" ) )
+        {
+            binaryDmh_.erase( activeConnection_ );
+        }
+
+        binaryDmh = ( binaryDmh_.count( activeConnection_ ) != 0 );
     }
 
-    // Send reply back to client
-    socketHandler_.sendTCP( headerOut, bodyOut );
+    json msgOut;
+    msgOut[ "encoding" ] = BodyCodec::getEncodingName( encoding );
+    msgOut[ "binary_dmh" ] = binaryDmh;
+
+    sendMsg_( msgOut, RD::BODY_ENCODING );
+
+}
+
+
+BodyEncoding RemoteDeviceHandler::getBodyEncoding_( const int& connection )
+{
+
+    std::lock_guard<std::mutex> lock( encodingMtx_ );
+
+    auto it = bodyEncodings_.find( connection );
+
+    return ( it == bodyEncodings_.end( ) ) ? BodyEncoding::Json : it->second;
 
-    return;
 }
 
 
@@ -603,49 +1159,41 @@ void RemoteDeviceHandler::sendVehicleAPIVersion_( )
 void RemoteDeviceHandler::sendVehicleStatus_( )
 {
 
-    json msgOut = templates_.getRawVehicleStatusTemplate( );
-
-    auto& msgStatusCode1 = msgOut[ "status_1xx" ][ "status_code" ];
-    auto& msgStatusCode2 = msgOut[ "status_2xx" ][ "status_code" ];
-    auto& msgStatusCode3 = msgOut[ "status_3xx" ][ "status_code" ];
-    auto& msgStatusCode4 = msgOut[ "status_4xx" ][ "status_code" ];
-    auto& msgStatusCode5 = msgOut[ "status_5xx" ][ "status_code" ];
-    auto& msgStatusCode6 = msgOut[ "status_6xx" ][ "status_code" ];
-    auto& msgStatusCode7 = msgOut[ "status_7xx" ][ "status_code" ];
-    auto& msgStatusCode8 = msgOut[ "status_8xx" ][ "status_code" ];
-    auto& msgStatusCode9 = msgOut[ "status_9xx" ][ "status_code" ];
-
-    auto& msgStatusText1 = msgOut[ "status_1xx" ][ "status_text" ];
-    auto& msgStatusText2 = msgOut[ "status_2xx" ][ "status_text" ];
-    auto& msgStatusText3 = msgOut[ "status_3xx" ][ "status_text" ];
-    auto& msgStatusText4 = msgOut[ "status_4xx" ][ "status_text" ];
-    auto& msgStatusText5 = msgOut[ "status_5xx" ][ "status_text" ];
-    auto& msgStatusText6 = msgOut[ "status_6xx" ][ "status_text" ];
-    auto& msgStatusText7 = msgOut[ "status_7xx" ][ "status_text" ];
-    auto& msgStatusText8 = msgOut[ "status_8xx" ][ "status_text" ];
-    auto& msgStatusText9 = msgOut[ "status_9xx" ][ "status_text" ];
-
-    msgStatusCode1 = prefixStatus_( VehicleStatusPrefix::NoFeatureAvailableMsg );
-    msgStatusCode2 = prefixStatus_( VehicleStatusPrefix::CancelMsg );
-    msgStatusCode3 = prefixStatus_( VehicleStatusPrefix::PauseMsg1 );
-    msgStatusCode4 = prefixStatus_( VehicleStatusPrefix::PauseMsg2 );
-    msgStatusCode5 = prefixStatus_( VehicleStatusPrefix::InfoMsg );
-    msgStatusCode6 = prefixStatus_( VehicleStatusPrefix::InstructMsg );
-    msgStatusCode7 = prefixStatus_( VehicleStatusPrefix::AcknowledgeRemotePIN );
-    msgStatusCode8 = prefixStatus_( VehicleStatusPrefix::ErrorMsg );
-    msgStatusCode9 = prefixStatus_( VehicleStatusPrefix::ManeuverStatus );
-
-    msgStatusText1 = sigText_.NoFeatureAvailableMsg[ (int)TCM_->NoFeatureAvailableMsg ];
-    msgStatusText2 = sigText_.CancelMsg[ (int)TCM_->CancelMsg ];
-    msgStatusText3 = sigText_.PauseMsg1[ (int)TCM_->PauseMsg1 ];
-    msgStatusText4 = sigText_.PauseMsg2[ (int)TCM_->PauseMsg2 ];
-    msgStatusText5 = sigText_.InfoMsg[ (int)TCM_->InfoMsg ];
-    msgStatusText6 = sigText_.InstructMsg[ (int)TCM_->InstructMsg ];
-    msgStatusText7 = sigText_.AcknowledgeRemotePIN[ (int)TCM_->AcknowledgeRemotePIN ];
-    msgStatusText8 = sigText_.ErrorMsg[ (int)TCM_->ErrorMsg ];
-    msgStatusText9 = sigText_.ManeuverStatus[ (int)TCM_->ManeuverStatus ];
-
-    sendMsg_( msgOut, RD::VEHICLE_STATUS );
+    uint64_t version( TCM_->getStateVersion( ) );
+
+    if( sendCached_( RD::VEHICLE_STATUS, version ) )
+    {
+        return;
+    }
+
+    const AspSnapshot asp( TCM_->getAspSnapshot( ) );
+
+    const VehicleStatusPrefix prefixes[ VEHICLE_STATUS_COUNT ] =
+    {
+        VehicleStatusPrefix::NoFeatureAvailableMsg,
+        VehicleStatusPrefix::CancelMsg,
+        VehicleStatusPrefix::PauseMsg1,
+        VehicleStatusPrefix::PauseMsg2,
+        VehicleStatusPrefix::InfoMsg,
+        VehicleStatusPrefix::InstructMsg,
+        VehicleStatusPrefix::AcknowledgeRemotePIN,
+        VehicleStatusPrefix::ErrorMsg,
+        VehicleStatusPrefix::ManeuverStatus
+    };
+
+    StatusEntry status[ VEHICLE_STATUS_COUNT ];
+    for( int i = 0; i < VEHICLE_STATUS_COUNT; i++ )
+    {
+        status[ i ].code = prefixStatus_( prefixes[ i ], asp );
+        status[ i ].text = MessageWriter::getStatusText(
+                prefixes[ i ], status[ i ].code - (int)prefixes[ i ] );
+    }
+
+    thread_local std::string bodyOut;
+    bodyOut.clear( );
+    MessageWriter::writeVehicleStatus( status, bodyOut );
+
+    sendBody_( bodyOut, RD::VEHICLE_STATUS, version );
 
     return;
 }
@@ -654,6 +1202,8 @@ void RemoteDeviceHandler::sendVehicleStatus_( )
 void RemoteDeviceHandler::sendVehicleInit_( )
 {
 
+    const AspSnapshot asp( TCM_->getAspSnapshot( ) );
+
     json msgOut = templates_.getRawVehicleInitTemplate();
     auto& msgReady = msgOut[ "ready" ];
     auto& msgActiveManeuver = msgOut[ "active_maneuver" ];
@@ -663,8 +1213,8 @@ void RemoteDeviceHandler::sendVehicleInit_( )
     msgReady = false;
     if( TCM_->ConnectionApproval == TCM::ConnectionApproval::AllowedDevice
             && TCM_->AcknowledgeRemotePIN == DCM::AcknowledgeRemotePIN::CorrectPIN
-            && TCM_->ActiveAutonomousFeature == ASP::ActiveAutonomousFeature::Parking
-            // || TCM_->InfoMsg == ASP::InfoMsg::RemoteManeuverReady )
+            && asp.ActiveAutonomousFeature == ASP::ActiveAutonomousFeature::Parking
+            // || asp.InfoMsg == ASP::InfoMsg::RemoteManeuverReady )
             )
     {
         msgReady = true;
@@ -673,11 +1223,11 @@ void RemoteDeviceHandler::sendVehicleInit_( )
     // Mobile only checks for this flag when it is returning from an
     // mid-maneuver state.
     msgActiveManeuver = false;
-    switch( TCM_->ManeuverStatus )
+    switch( asp.ManeuverStatus )
     {
         case ASP::ManeuverStatus::Selecting:
         {
-            if( TCM_->ConfirmAvailability != ASP::ConfirmAvailability::OfferEnabled )
+            if( asp.ConfirmAvailability != ASP::ConfirmAvailability::OfferEnabled )
             {
                 break;
             }
@@ -710,30 +1260,34 @@ void RemoteDeviceHandler::sendVehicleInit_( )
 void RemoteDeviceHandler::sendThreatData_( )
 {
 
-    json msgOut = templates_.getRawThreatDataTemplate();
-    auto& msgThreats = msgOut[ "threats" ];
+    const AspSnapshot asp( TCM_->getAspSnapshot( ) );
+    uint8_t msgThreats[ THREAT_SEGMENT_COUNT ];
 
     /*  Send back threat data based on the front and rear integer vectors.
     //  Since the pattern starts at the driver side door and makes a
     //  continuous circle, the rear values must be inverted when populating.
     */
-    for( int i = 0; i < TCM_->ASPMFrontSegDistxxRMT.size( ); i++ )
+    for( int i = 0; i < ASP_THREAT_SEGMENT_COUNT; i++ )
     {
-        if (TCM_->getASPMFrontSegTypexxRMT(i) == 1) { // 1 indicates a threat is detected
-            msgThreats[ i ] = TCM_->getASPMFrontSegDistxxRMT(i);
+        if (asp.ASPMFrontSegTypeRMT[i] == 1) { // 1 indicates a threat is detected
+            msgThreats[ i ] = asp.ASPMFrontSegDistRMT[i];
         }
         else { // no threat detected
             msgThreats[ i ] = 19;
         }
-        if (TCM_->getASPMRearSegTypexxRMT(i) == 1) { // 1 indicates a threat is detected
-            msgThreats[ 31-i ] = TCM_->getASPMRearSegDistxxRMT(i);
+        if (asp.ASPMRearSegTypeRMT[i] == 1) { // 1 indicates a threat is detected
+            msgThreats[ 31-i ] = asp.ASPMRearSegDistRMT[i];
         }
         else { // no threat detected
             msgThreats[ 31-i ] = 19;
         }
     }
 
-    sendMsg_( msgOut, RD::THREAT_DATA );
+    thread_local std::string bodyOut;
+    bodyOut.clear( );
+    MessageWriter::writeThreatData( msgThreats, bodyOut );
+
+    sendBody_( bodyOut, RD::THREAT_DATA );
 
 
     return;
@@ -744,31 +1298,38 @@ void RemoteDeviceHandler::sendThreatData_( )
 void RemoteDeviceHandler::sendAvailableManeuvers_( )
 {
 
-    json msgOut = templates_.getRawAvailableManeuversTemplate();
-    auto& msgDefaultManeuver = msgOut[ "default" ];
-    auto& msgContinueExplore = msgOut[ "continue_exploring" ];
-    auto& msgManeuversPOLF = msgOut[ "maneuvers" ][ "OutLftFwd" ];
-    auto& msgManeuversPOLR = msgOut[ "maneuvers" ][ "OutLftRvs" ];
-    auto& msgManeuversPORF = msgOut[ "maneuvers" ][ "OutRgtFwd" ];
-    auto& msgManeuversPORR = msgOut[ "maneuvers" ][ "OutRgtRvs" ];
-    auto& msgManeuversPILF = msgOut[ "maneuvers" ][ "InLftFwd" ];
-    auto& msgManeuversPILR = msgOut[ "maneuvers" ][ "InLftRvs" ];
-    auto& msgManeuversPIRF = msgOut[ "maneuvers" ][ "InRgtFwd" ];
-    auto& msgManeuversPIRR = msgOut[ "maneuvers" ][ "InRgtRvs" ];
-    auto& msgManeuversNF = msgOut[ "maneuvers" ][ "NdgFwd" ];
-    auto& msgManeuversNR = msgOut[ "maneuvers" ][ "NdgRvs" ];
-    auto& msgManeuversSF = msgOut[ "maneuvers" ][ "StrFwd" ];
-    auto& msgManeuversSR = msgOut[ "maneuvers" ][ "StrRvs" ];
-    auto& msgManeuversPOLP = msgOut[ "maneuvers" ][ "OutLftPrl" ];
-    auto& msgManeuversPORP = msgOut[ "maneuvers" ][ "OutRgtPrl" ];
-    auto& msgManeuversRTS = msgOut[ "maneuvers" ][ "RtnToOgn" ];
+    uint64_t version( TCM_->getStateVersion( ) );
+
+    if( sendCached_( RD::AVAILABLE_MANEUVERS, version ) )
+    {
+        return;
+    }
+
+    const AspSnapshot asp( TCM_->getAspSnapshot( ) );
+
+    bool offered[ AVAILABLE_MANEUVER_COUNT ] = { false };
+    bool& msgManeuversPOLF = offered[ (int)AvailableManeuver::OutLftFwd ];
+    bool& msgManeuversPOLR = offered[ (int)AvailableManeuver::OutLftRvs ];
+    bool& msgManeuversPORF = offered[ (int)AvailableManeuver::OutRgtFwd ];
+    bool& msgManeuversPORR = offered[ (int)AvailableManeuver::OutRgtRvs ];
+    bool& msgManeuversPILF = offered[ (int)AvailableManeuver::InLftFwd ];
+    bool& msgManeuversPILR = offered[ (int)AvailableManeuver::InLftRvs ];
+    bool& msgManeuversPIRF = offered[ (int)AvailableManeuver::InRgtFwd ];
+    bool& msgManeuversPIRR = offered[ (int)AvailableManeuver::InRgtRvs ];
+    bool& msgManeuversNF = offered[ (int)AvailableManeuver::NdgFwd ];
+    bool& msgManeuversNR = offered[ (int)AvailableManeuver::NdgRvs ];
+    bool& msgManeuversSF = offered[ (int)AvailableManeuver::StrFwd ];
+    bool& msgManeuversSR = offered[ (int)AvailableManeuver::StrRvs ];
+    bool& msgManeuversPOLP = offered[ (int)AvailableManeuver::OutLftPrl ];
+    bool& msgManeuversPORP = offered[ (int)AvailableManeuver::OutRgtPrl ];
+    bool& msgManeuversRTS = offered[ (int)AvailableManeuver::RtnToOgn ];
 
     /*  The logic below is for populating the Push/Pull maneuvers.  First,
     //  the ExploreModeAvailability signal is referenced to see whether
     //  Push/Pull is offered.  In the case that it is, ManeuverDirectionAvailability
     //  references in which direction push/pull can be carried out.
     */
-    switch( TCM_->ExploreModeAvailability )
+    switch( asp.ExploreModeAvailability )
     {
 
         // int value of 0, 2, 3, --> false
@@ -780,7 +1341,7 @@ void RemoteDeviceHandler::sendAvailableManeuvers_( )
         case ASP::ExploreModeAvailability::OfferEnabled:
         {
             // Check forward, backward, or both
-            switch( TCM_->ManeuverDirectionAvailability )
+            switch( asp.ManeuverDirectionAvailability )
             {
 
                 // int value of 0 --> ** UNKNOWN **
@@ -823,7 +1384,7 @@ void RemoteDeviceHandler::sendAvailableManeuvers_( )
     //  offered.  In the case that it is, ManeuverDirectionAvailability is referenced
     //  to check in which direction nudging can be carried out.
     */
-    switch( TCM_->LongitudinalAdjustAvailability )
+    switch( asp.LongitudinalAdjustAvailability )
     {
 
         // int value of 0, 2, 3, --> false
@@ -835,7 +1396,7 @@ void RemoteDeviceHandler::sendAvailableManeuvers_( )
         case ASP::LongitudinalAdjustAvailability::OfferEnabled:
         {
             // Check forward, backward, or both
-            switch( TCM_->ManeuverDirectionAvailability )
+            switch( asp.ManeuverDirectionAvailability )
             {
 
                 // int value of 0 --> ** UNKNOWN **
@@ -877,7 +1438,7 @@ void RemoteDeviceHandler::sendAvailableManeuvers_( )
     //  This leverages the ASP::ReturnToStartAvailability signal and returns true if
     //  it is enabled (int val of 1)
     */
-    switch( TCM_->ReturnToStartAvailability )
+    switch( asp.ReturnToStartAvailability )
     {
 
         // int value of 0, 2, 3, --> false
@@ -904,7 +1465,7 @@ void RemoteDeviceHandler::sendAvailableManeuvers_( )
     //  ManeuverSideAvailability is referenced to check in which direction the maneuver
     //  can be carried out.
     */
-    switch( TCM_->ActiveParkingMode )
+    switch( asp.ActiveParkingMode )
     {
 
         // int value of 0, 3 --> false
@@ -915,7 +1476,7 @@ void RemoteDeviceHandler::sendAvailableManeuvers_( )
         case ASP::ActiveParkingMode::ParkIn:
         {
             // Check parallel, perpendicular rear or front
-            switch( TCM_->ActiveManeuverOrientation )
+            switch( asp.ActiveManeuverOrientation )
             {
 
                 // int value of 0 --> ** UNKNOWN **
@@ -928,7 +1489,7 @@ void RemoteDeviceHandler::sendAvailableManeuvers_( )
                 case ASP::ActiveManeuverOrientation::PerpendicularRear:
                 {
                     // Check left, right, or both
-                    switch( TCM_->ManeuverSideAvailability )
+                    switch( asp.ManeuverSideAvailability )
                     {
 
                         // int value of 0 --> ** UNKNOWN **
@@ -966,7 +1527,7 @@ void RemoteDeviceHandler::sendAvailableManeuvers_( )
                 case ASP::ActiveManeuverOrientation::PerpendicularFront:
                 {
                     // Check left, right, or both
-                    switch( TCM_->ManeuverSideAvailability )
+                    switch( asp.ManeuverSideAvailability )
                     {
 
                         // int value of 0 --> ** UNKNOWN **
@@ -1036,7 +1597,7 @@ void RemoteDeviceHandler::sendAvailableManeuvers_( )
             }
 
             // Check parallel, perpendicular rear or front
-            switch( TCM_->ActiveManeuverOrientation )
+            switch( asp.ActiveManeuverOrientation )
             {
 
                 // int value of 0 --> ** UNKNOWN **
@@ -1046,7 +1607,7 @@ void RemoteDeviceHandler::sendAvailableManeuvers_( )
                 case ASP::ActiveManeuverOrientation::Parallel:
                 {
                     // Check left, right, or both
-                    switch( TCM_->ManeuverSideAvailability )
+                    switch( asp.ManeuverSideAvailability )
                     {
 
                         // int value of 0 --> ** UNKNOWN **
@@ -1084,7 +1645,7 @@ void RemoteDeviceHandler::sendAvailableManeuvers_( )
                 case ASP::ActiveManeuverOrientation::PerpendicularFront:
                 {
                     // Check left, right, or both
-                    switch( TCM_->ManeuverSideAvailability )
+                    switch( asp.ManeuverSideAvailability )
                     {
 
                         // int value of 0 --> ** UNKNOWN **
@@ -1122,7 +1683,7 @@ void RemoteDeviceHandler::sendAvailableManeuvers_( )
                 case ASP::ActiveManeuverOrientation::PerpendicularRear:
                 {
                     // Check left, right, or both
-                    switch( TCM_->ManeuverSideAvailability )
+                    switch( asp.ManeuverSideAvailability )
                     {
 
                         // int value of 0 --> ** UNKNOWN **
@@ -1168,12 +1729,15 @@ void RemoteDeviceHandler::sendAvailableManeuvers_( )
         default:                                            break;
     }
 
-    msgDefaultManeuver = TCM_->getManeuverFromASP( );
-    msgContinueExplore = checkContinueExploratoryMode_( );
+    thread_local std::string bodyOut;
+    bodyOut.clear( );
+    MessageWriter::writeAvailableManeuvers(
+            SignalHandler::getManeuverFromASP( asp ),
+            checkContinueExploratoryMode_( asp ),
+            offered,
+            bodyOut );
 
-    // std::cout << std::setw(4) << msgOut << std::endl;
-
-    sendMsg_( msgOut, RD::AVAILABLE_MANEUVERS );
+    sendBody_( bodyOut, RD::AVAILABLE_MANEUVERS, version );
 
 
     return;
@@ -1188,7 +1752,7 @@ void RemoteDeviceHandler::sendMobileChallenge_( )
     auto& msgBytes = msgOut[ "packed_bytes" ];
 
     std::ostringstream challengeVal;
-    challengeVal << TCM_->MobileChallengeSend;
+    challengeVal << TCM_->getAspSnapshot( ).MobileChallengeSend;
     msgBytes = challengeVal.str( );
 
     sendMsg_( msgOut, RD::MOBILE_CHALLENGE );
@@ -1202,16 +1766,24 @@ void RemoteDeviceHandler::sendMobileChallenge_( )
 void RemoteDeviceHandler::sendManeuverStatus_( )
 {
 
-    json msgOut = templates_.getRawManeuverStatusTemplate();
-    auto& msgManeuver = msgOut[ "maneuver" ];
-    auto& msgProgress = msgOut[ "progress" ];
-    auto& msgStatus = msgOut[ "status" ];
+    uint64_t version( TCM_->getStateVersion( ) );
+
+    if( sendCached_( RD::MANEUVER_STATUS, version ) )
+    {
+        return;
+    }
+
+    const AspSnapshot asp( TCM_->getAspSnapshot( ) );
 
-    msgManeuver = TCM_->getManeuverFromASP( );
-    msgProgress = (int)TCM_->ManeuverProgressBar;
-    msgStatus = prefixStatus_( VehicleStatusPrefix::ManeuverStatus );
+    thread_local std::string bodyOut;
+    bodyOut.clear( );
+    MessageWriter::writeManeuverStatus(
+            SignalHandler::getManeuverFromASP( asp ),
+            (int)asp.ManeuverProgressBar,
+            prefixStatus_( VehicleStatusPrefix::ManeuverStatus, asp ),
+            bodyOut );
 
-    sendMsg_( msgOut, RD::MANEUVER_STATUS );
+    sendBody_( bodyOut, RD::MANEUVER_STATUS, version );
 
 
     return;
@@ -1220,12 +1792,16 @@ void RemoteDeviceHandler::sendManeuverStatus_( )
 
 void RemoteDeviceHandler::sendCabinStatus_()
 {
-    json msgOut = templates_.getRawCabinStatusTemplate();
-    auto& msgEngineOff = msgOut[ "power_status" ];
-    auto& msgDoorsLocked = msgOut[ "lock_status" ];
-    msgEngineOff = TCM_->getEngineOff();
-    msgDoorsLocked = TCM_->getDoorsLocked();
-    sendMsg_( msgOut, RD::CABIN_STATUS );
+    uint64_t version( TCM_->getStateVersion( ) );
+    if( sendCached_( RD::CABIN_STATUS, version ) )
+    {
+        return;
+    }
+
+    thread_local std::string bodyOut;
+    bodyOut.clear( );
+    MessageWriter::writeCabinStatus( TCM_->getEngineOff( ), TCM_->getDoorsLocked( ), bodyOut );
+    sendBody_( bodyOut, RD::CABIN_STATUS, version );
 }
 
 
@@ -1236,7 +1812,7 @@ void RemoteDeviceHandler::toggleEngineOnOff_( )
     */
     TCM_->setManeuverButtonPress( TCM::ManeuverButtonPress::None );
     TCM_->setDeviceControlMode( TCM::DeviceControlMode::RCStartStop );
-    TCM_->setManeuverEnableInput( 0000, 0000, 0000, false );
+    TCM_->setManeuverEnableInput( 0000, 0000, 0000, false, 0000 );
 
 }
 
@@ -1248,7 +1824,7 @@ void RemoteDeviceHandler::loadMainMenu_( )
     */
     TCM_->setManeuverButtonPress( TCM::ManeuverButtonPress::None );
     TCM_->setDeviceControlMode( TCM::DeviceControlMode::RCMainMenu );
-    TCM_->setManeuverEnableInput( 0000, 0000, 0000, false );
+    TCM_->setManeuverEnableInput( 0000, 0000, 0000, false, 0000 );
 
 }
 
@@ -1260,7 +1836,7 @@ void RemoteDeviceHandler::loadSpaceSelection_( )
     */
     TCM_->setManeuverButtonPress( TCM::ManeuverButtonPress::None );
     TCM_->setDeviceControlMode( TCM::DeviceControlMode::RCParkOutSpaceSlctn );
-    TCM_->setManeuverEnableInput( 0000, 0000, 0000, false );
+    TCM_->setManeuverEnableInput( 0000, 0000, 0000, false, 0000 );
 
 }
 
@@ -1273,7 +1849,7 @@ void RemoteDeviceHandler::pushPullSelected_( const std::string& direction )
     //  testing against a production ASPM is possible.
     */
     TCM_->setDeviceControlMode( TCM::DeviceControlMode::RCPushPull );
-    TCM_->setManeuverEnableInput( 0000, 0000, 0000, false );
+    TCM_->setManeuverEnableInput( 0000, 0000, 0000, false, 0000 );
 
 }
 
@@ -1286,7 +1862,7 @@ void RemoteDeviceHandler::parkInSelected_( const std::string& direction )
     //  testing against a production ASPM is possible.
     */
     TCM_->setDeviceControlMode( TCM::DeviceControlMode::RCParkIn );
-    TCM_->setManeuverEnableInput( 0000, 0000, 0000, false );
+    TCM_->setManeuverEnableInput( 0000, 0000, 0000, false, 0000 );
 
 }
 
@@ -1299,7 +1875,7 @@ void RemoteDeviceHandler::parkOutSelected_( const std::string& direction )
     //  testing against a production ASPM is possible.
     */
     TCM_->setDeviceControlMode( TCM::DeviceControlMode::RCParkOut );
-    TCM_->setManeuverEnableInput( 0000, 0000, 0000, false );
+    TCM_->setManeuverEnableInput( 0000, 0000, 0000, false, 0000 );
 
 }
 
@@ -1312,7 +1888,7 @@ void RemoteDeviceHandler::adjustSelected_( const std::string& direction )
     //  testing against a production ASPM is possible.
     */
     TCM_->setDeviceControlMode( TCM::DeviceControlMode::RCAdjust );
-    TCM_->setManeuverEnableInput( 0000, 0000, 0000, false );
+    TCM_->setManeuverEnableInput( 0000, 0000, 0000, false, 0000 );
 
 }
 
@@ -1323,7 +1899,7 @@ void RemoteDeviceHandler::returnToOriginSelected_( )
     */
     TCM_->setManeuverButtonPress( TCM::ManeuverButtonPress::ReturnToStart );
     TCM_->setDeviceControlMode( TCM::DeviceControlMode::NoMode );
-    TCM_->setManeuverEnableInput( 0000, 0000, 0000, false );
+    TCM_->setManeuverEnableInput( 0000, 0000, 0000, false, 0000 );
 
 }
 
@@ -1338,11 +1914,10 @@ void RemoteDeviceHandler::updateDMH_(
             static_cast<uint16_t>( x ),
             static_cast<uint16_t>( y ),
             static_cast<int64_t>( percent ),
-            gesture );
+            gesture,
+            static_cast<uint16_t>( crc ) );
 
-    TCM_->AppCalcCheck = static_cast<uint16_t>( crc );
-
-    switch( TCM_->ManeuverStatus )
+    switch( TCM_->getAspSnapshot( ).ManeuverStatus )
     {
         case ASP::ManeuverStatus::Interrupted:
         {
@@ -1416,11 +1991,13 @@ bool RemoteDeviceHandler::checkDeviceCompatibility_( )
 
 bool RemoteDeviceHandler::checkManeuversInProgress_( )
 {
-    switch( TCM_->ManeuverStatus )
+    const AspSnapshot asp( TCM_->getAspSnapshot( ) );
+
+    switch( asp.ManeuverStatus )
     {
         case ASP::ManeuverStatus::Selecting:
         {
-            if( TCM_->ConfirmAvailability != ASP::ConfirmAvailability::OfferEnabled )
+            if( asp.ConfirmAvailability != ASP::ConfirmAvailability::OfferEnabled )
             {
                 break;
             }
@@ -1439,9 +2016,9 @@ bool RemoteDeviceHandler::checkManeuversInProgress_( )
 }
 
 
-bool RemoteDeviceHandler::checkContinueExploratoryMode_( )
+bool RemoteDeviceHandler::checkContinueExploratoryMode_( const AspSnapshot& asp )
 {
-    if( TCM_->ExploreModeAvailability != ASP::ExploreModeAvailability::OfferDisabled )
+    if( asp.ExploreModeAvailability != ASP::ExploreModeAvailability::OfferDisabled )
     {
         return true;
     }
@@ -1453,11 +2030,16 @@ bool RemoteDeviceHandler::checkContinueExploratoryMode_( )
 bool RemoteDeviceHandler::checkForNewStatusSignals_( std::atomic<bool>& statusChanged )
 {
 
-    while( prevSig_.ManeuverStatus != TCM_->ManeuverStatus )
+    const AspSnapshot asp( TCM_->getAspSnapshot( ) );
+
+    while( prevSig_.ManeuverStatus != asp.ManeuverStatus )
     {
-        prevSig_.ManeuverStatus = TCM_->ManeuverStatus;
+        prevSig_.ManeuverStatus = asp.ManeuverStatus;
+
+        // Signals may be written without a decode; cached responses are stale.
+        TCM_->markStateChanged( );
 
-        switch( TCM_->ManeuverStatus )
+        switch( asp.ManeuverStatus )
         {
             case ASP::ManeuverStatus::Ended:
             {
@@ -1471,39 +2053,39 @@ bool RemoteDeviceHandler::checkForNewStatusSignals_( std::atomic<bool>& statusCh
         }
     }
 
-    while( prevSig_.NoFeatureAvailableMsg != TCM_->NoFeatureAvailableMsg )
+    while( prevSig_.NoFeatureAvailableMsg != asp.NoFeatureAvailableMsg )
     {
-        prevSig_.NoFeatureAvailableMsg = TCM_->NoFeatureAvailableMsg;
+        prevSig_.NoFeatureAvailableMsg = asp.NoFeatureAvailableMsg;
         statusChanged = true;
     }
 
-    while( prevSig_.CancelMsg != TCM_->CancelMsg )
+    while( prevSig_.CancelMsg != asp.CancelMsg )
     {
-        prevSig_.CancelMsg = TCM_->CancelMsg;
+        prevSig_.CancelMsg = asp.CancelMsg;
         statusChanged = true;
     }
 
-    while( prevSig_.PauseMsg1 != TCM_->PauseMsg1 )
+    while( prevSig_.PauseMsg1 != asp.PauseMsg1 )
     {
-        prevSig_.PauseMsg1 = TCM_->PauseMsg1;
+        prevSig_.PauseMsg1 = asp.PauseMsg1;
         statusChanged = true;
     }
 
-    while( prevSig_.PauseMsg2 != TCM_->PauseMsg2 )
+    while( prevSig_.PauseMsg2 != asp.PauseMsg2 )
     {
-        prevSig_.PauseMsg2 = TCM_->PauseMsg2;
+        prevSig_.PauseMsg2 = asp.PauseMsg2;
         statusChanged = true;
     }
 
-    while( prevSig_.InfoMsg != TCM_->InfoMsg )
+    while( prevSig_.InfoMsg != asp.InfoMsg )
     {
-        prevSig_.InfoMsg = TCM_->InfoMsg;
+        prevSig_.InfoMsg = asp.InfoMsg;
         statusChanged = true;
     }
 
-    while( prevSig_.InstructMsg != TCM_->InstructMsg )
+    while( prevSig_.InstructMsg != asp.InstructMsg )
     {
-        prevSig_.InstructMsg = TCM_->InstructMsg;
+        prevSig_.InstructMsg = asp.InstructMsg;
         statusChanged = true;
     }
 
@@ -1519,11 +2101,11 @@ bool RemoteDeviceHandler::checkForNewStatusSignals_( std::atomic<bool>& statusCh
         statusChanged = true;
     }
 
-    while( prevSig_.MobileChallengeSend != TCM_->MobileChallengeSend )
+    while( prevSig_.MobileChallengeSend != asp.MobileChallengeSend )
     {
 
         sendMobileChallenge_( );
-        prevSig_.MobileChallengeSend = TCM_->MobileChallengeSend;
+        prevSig_.MobileChallengeSend = asp.MobileChallengeSend;
 
     }
 
@@ -1536,33 +2118,33 @@ bool RemoteDeviceHandler::checkForNewStatusSignals_( std::atomic<bool>& statusCh
 }
 
 
-int RemoteDeviceHandler::prefixStatus_( const VehicleStatusPrefix& prefix )
+int RemoteDeviceHandler::prefixStatus_( const VehicleStatusPrefix& prefix, const AspSnapshot& asp )
 {
     switch( prefix )
     {
         case VehicleStatusPrefix::NoFeatureAvailableMsg:
         {
-            return (int)prefix + (int)TCM_->NoFeatureAvailableMsg;
+            return (int)prefix + (int)asp.NoFeatureAvailableMsg;
         }
         case VehicleStatusPrefix::CancelMsg:
         {
-            return (int)prefix + (int)TCM_->CancelMsg;
+            return (int)prefix + (int)asp.CancelMsg;
         }
         case VehicleStatusPrefix::PauseMsg1:
         {
-            return (int)prefix + (int)TCM_->PauseMsg1;
+            return (int)prefix + (int)asp.PauseMsg1;
         }
         case VehicleStatusPrefix::PauseMsg2:
         {
-            return (int)prefix + (int)TCM_->PauseMsg2;
+            return (int)prefix + (int)asp.PauseMsg2;
         }
         case VehicleStatusPrefix::InfoMsg:
         {
-            return (int)prefix + (int)TCM_->InfoMsg;
+            return (int)prefix + (int)asp.InfoMsg;
         }
         case VehicleStatusPrefix::InstructMsg:
         {
-            return (int)prefix + (int)TCM_->InstructMsg;
+            return (int)prefix + (int)asp.InstructMsg;
         }
         case VehicleStatusPrefix::AcknowledgeRemotePIN:
         {
@@ -1574,7 +2156,7 @@ int RemoteDeviceHandler::prefixStatus_( const VehicleStatusPrefix& prefix )
         }
         case VehicleStatusPrefix::ManeuverStatus:
         {
-            return (int)prefix + (int)TCM_->ManeuverStatus;
+            return (int)prefix + (int)asp.ManeuverStatus;
         }
 
         default: break;
@@ -1584,74 +2166,154 @@ int RemoteDeviceHandler::prefixStatus_( const VehicleStatusPrefix& prefix )
 }
 
 
-void RemoteDeviceHandler::mapMsgText_(
-        std::vector<std::string>& sigText,
-        const char* data )
+void RemoteDeviceHandler::statusUpdateEventLoop_( )
+{
+
+    while( running_ )
+    {
+
+        updateStatus( );
+
+        // A published change ends the wait right after its decode or setter.
+        statusSignals_->wait( );
+        statusSignals_->takeChanges( );
+
+    }
+
+}
+
+
+void RemoteDeviceHandler::updateStatus( )
 {
 
-    const char* ptr = data;
-    sigText.clear( );
+    std::atomic<bool> hasVehicleStatusChanged( false );
 
-    try
+    if( checkForNewStatusSignals_( hasVehicleStatusChanged ) == true )
     {
 
-        std::string newLine;
-        while( *ptr != '\0' )
+        hasVehicleStatusChanged = false;
+
+        while( checkForNewStatusSignals_( hasVehicleStatusChanged ) == true )
         {
-            newLine = "";
-            while( *ptr != ' ' )
-            {
-                // if( *pointer != '\r' )
-                newLine += *ptr;
-                ++ptr;
-            }
 
-            sigText.push_back( newLine );
-            ++ptr;
+            hasVehicleStatusChanged = false;
 
         }
 
-        return;
+        TCM_->markStateChanged( );
+        sendVehicleStatus_( );
 
     }
-    catch( std::exception& e )
-    {
 
-        std::cout << "Error populating signal text values: " << e.what( );
+}
 
-        return;
 
+ResponseCache& RemoteDeviceHandler::getResponseCache( )
+{
+    return responseCache_;
+}
+
+
+void RemoteDeviceHandler::clientConnected_( const int& connection )
+{
+
+    // Every device starts out with JSON bodies and JSON DMH.
+    {
+        std::lock_guard<std::mutex> lock( encodingMtx_ );
+        bodyEncodings_.erase( connection );
+        binaryDmh_.erase( connection );
+    }
+
+    // Only the first device resets approval; others join the existing session.
+    if( socketHandler_.getClientCount( ) == 1 )
+    {
+        setConnectionApproved_( TCM::ConnectionApproval::NotAllowedDevice );
+        setKeyFobRangingRate_( DCM::FobRangeRequestRate::DefaultRate );
     }
 
 }
 
 
-void RemoteDeviceHandler::statusUpdateEventLoop_( )
+void RemoteDeviceHandler::clientDisconnected_( const int& connection )
 {
 
-    std::atomic<bool> hasVehicleStatusChanged( false );
+    {
+        std::lock_guard<std::mutex> lock( encodingMtx_ );
+        bodyEncodings_.erase( connection );
+        binaryDmh_.erase( connection );
+    }
 
-    while( running_ )
+    // A later client may reuse the descriptor; its replies must not go there.
+    deferredReplies_.erase( std::remove_if(
+            deferredReplies_.begin( ),
+            deferredReplies_.end( ),
+            [ &connection ]( const DeferredReply& pending )
+            {
+                return pending.connection == connection;
+            } ),
+            deferredReplies_.end( ) );
+    deferredCount_ = deferredReplies_.size( );
+
+    // Once the last device leaves, revoke approval and clear the PIN.
+    if( socketHandler_.getClientCount( ) == 0 )
     {
+        controllingConnection_ = -1;
 
-        if( checkForNewStatusSignals_( hasVehicleStatusChanged ) == true )
-        {
+        setConnectionApproved_( TCM::ConnectionApproval::NoDevice );
+        setKeyFobRangingRate_( DCM::FobRangeRequestRate::None );
+        setRemoteControlPIN_( DCM::PIN_NOT_SET );
+    }
+    // A vanished controlling phone must not leave the vehicle approved for
+    // the devices still connected.
+    else if( connection == controllingConnection_ )
+    {
+        controllingConnection_ = -1;
 
-            hasVehicleStatusChanged = false;
+        setConnectionApproved_( TCM::ConnectionApproval::NotAllowedDevice );
+        setRemoteControlPIN_( DCM::PIN_NOT_SET );
+    }
 
-            while( checkForNewStatusSignals_( hasVehicleStatusChanged ) == true )
-            {
+}
 
-                hasVehicleStatusChanged = false;
 
-            }
+void RemoteDeviceHandler::frameEvent_(
+        const int& connection,
+        const char* receivedMsg,
+        const uint32_t& headerLen,
+        const uint32_t& bodyLen )
+{
 
-            sendVehicleStatus_( );
+    size_t msgLen( (size_t)headerLen + bodyLen );
 
-        }
+    // A binary DMH frame is vetted by DmhFrame::decode( ), and its raw body
+    // must not be searched for a disconnect request, so both checks are for
+    // text frames only.
+    if( headerLen != 0
+        && ( checkClientConnection_( connection, receivedMsg, msgLen ) == false
+             || checkMessageReadability_( (ssize_t)msgLen ) == false ) )
+    {
+        socketHandler_.disconnectClient( connection );
+
+        return;
+    }
+
+    activeConnection_ = connection;
+
+    // JSON headers are never empty; an empty one marks a binary DMH frame.
+    if( headerLen == 0 )
+    {
+        dmhFrameEvent_( receivedMsg, bodyLen );
+    }
+    else
+    {
+        messageEvent_( receivedMsg, headerLen, bodyLen );
+    }
 
-        usleep( ASP_REFRESH_RATE );
+    activeConnection_ = -1;
 
+    if( TCM_->AcknowledgeRemotePIN == DCM::AcknowledgeRemotePIN::NotSetInDCM )
+    {
+        sendVehicleStatus_( );
     }
 
 }
@@ -1659,55 +2321,79 @@ void RemoteDeviceHandler::statusUpdateEventLoop_( )
 
 void RemoteDeviceHandler::spin( )
 {
-    ssize_t readVal = 0;
-    std::string receivedMsg = "";
-    uint32_t headerLen = 0;
-    uint32_t bodyLen = 0;
 
-    socketHandler_.connectServer(
-            (int32_t)SOCK_STREAM,
-            (uint64_t)TCP_ADDR,
-            (uint16_t)TCP_PORT );
+    bindServer( TCP_PORT );
 
     while( running_ )
     {
-        socketHandler_.connectClient( );
+        pollEvents( ASP_REFRESH_RATE / 1000 );
+    }
 
-        setConnectionApproved_( TCM::ConnectionApproval::NotAllowedDevice );
-        setKeyFobRangingRate_( DCM::FobRangeRequestRate::DefaultRate );
+    socketHandler_.disconnectServer( );
+}
 
-        while( socketHandler_.isClientConnected == true )
-        {
-            receivedMsg.clear( );
-            socketHandler_.receiveTCP( readVal, receivedMsg, headerLen, bodyLen );
 
-            if( checkClientConnection_( receivedMsg.data( ) ) == false
-                || checkMessageReadability_( readVal ) == false )
-                {
-                    setConnectionApproved_( TCM::ConnectionApproval::NoDevice );
-                    setKeyFobRangingRate_( DCM::FobRangeRequestRate::None );
-                    setRemoteControlPIN_( DCM::PIN_NOT_SET );
+void RemoteDeviceHandler::bindServer( const uint16_t& port )
+{
 
-                    socketHandler_.disconnectClient( );
+    socketHandler_.setMessageCallback( std::bind(
+            &RemoteDeviceHandler::frameEvent_,
+            this,
+            std::placeholders::_1,
+            std::placeholders::_2,
+            std::placeholders::_3,
+            std::placeholders::_4 ) );
+    socketHandler_.setConnectCallback( std::bind(
+            &RemoteDeviceHandler::clientConnected_,
+            this,
+            std::placeholders::_1 ) );
+    socketHandler_.setDisconnectCallback( std::bind(
+            &RemoteDeviceHandler::clientDisconnected_,
+            this,
+            std::placeholders::_1 ) );
 
-                    continue;
-                }
+    socketHandler_.connectServer(
+            (int32_t)SOCK_STREAM,
+            (uint64_t)TCP_ADDR,
+            port );
+
+}
 
-            messageEvent_( receivedMsg.data( ), headerLen, bodyLen );
 
-            if( TCM_->AcknowledgeRemotePIN == DCM::AcknowledgeRemotePIN::NotSetInDCM )
-            {
-                sendVehicleStatus_( );
-            }
-        }
+int RemoteDeviceHandler::pollEvents( const int& timeoutMs )
+{
+    int ready( socketHandler_.pollEvents( timeoutMs ) );
+
+    if( deferredCount_ > 0 )
+    {
+        serviceDeferredReplies_( );
     }
+
+    return ready;
+}
+
+
+int RemoteDeviceHandler::getEventSocket( ) const
+{
+    return socketHandler_.getEventSocket( );
+}
+
+
+void RemoteDeviceHandler::closeServer( )
+{
     socketHandler_.disconnectServer( );
 }
 
 void RemoteDeviceHandler::stop( )
 {
-    TCM_->stop();
     running_ = false;
+
+    // Cut short the status loop's sleep before the signals stop.
+    statusSignals_->wake( );
+    TCM_->stop();
+    responseCache_.print( "Status response cache" );
+
+    // Wakes spin( ), which closes the server once it leaves its event loop.
     socketHandler_.disconnectClient(false);
-    socketHandler_.disconnectServer();
+    socketHandler_.wake( );
 }
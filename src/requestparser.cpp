@@ -0,0 +1,680 @@
+/*! \license
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * \copyright 2021 Dan Fernández
+ *
+ * \file Class definitions for \p RequestParser class.
+ *
+ * \author fdaniel, trice2
+ */
+
+#include "requestparser.hpp"
+
+#include <ctype.h>
+#include <stdlib.h>
+#include <string.h>
+
+namespace
+{
+
+// Returned for names outside the schema.
+const FieldValue ABSENT_FIELD = FieldValue( );
+
+}
+
+
+std::string FieldValue::str( ) const
+{
+    return ( string == nullptr ) ? std::string( ) : std::string( string, length );
+}
+
+
+bool FieldValue::equals( const char* text ) const
+{
+    return string != nullptr
+            && strlen( text ) == length
+            && memcmp( string, text, length ) == 0;
+}
+
+
+RequestBody::RequestBody( const RequestSchema& schema ) :
+    schema_( &schema )
+{
+}
+
+
+const FieldValue& RequestBody::get( const char* name ) const
+{
+    int index( find_( name, strlen( name ) ) );
+
+    return ( index < 0 ) ? ABSENT_FIELD : values_[ index ];
+}
+
+
+bool RequestBody::has( const char* name ) const
+{
+    return get( name ).present;
+}
+
+
+bool RequestBody::getBool( const char* name ) const
+{
+    return get( name ).boolean;
+}
+
+
+double RequestBody::getNumber( const char* name ) const
+{
+    return get( name ).number;
+}
+
+
+std::string RequestBody::getString( const char* name ) const
+{
+    return get( name ).str( );
+}
+
+
+int RequestBody::find_( const char* name, const size_t& length ) const
+{
+    for( size_t i = 0; i < schema_->count; ++i )
+    {
+        const char* field = schema_->fields[ i ].name;
+
+        if( strncmp( field, name, length ) == 0 && field[ length ] == '\0' )
+        {
+            return (int)i;
+        }
+    }
+
+    return -1;
+}
+
+
+ParseStatus RequestParser::parse( const char* raw, const size_t& size, RequestBody& body )
+{
+
+    for( auto& value : body.values_ )
+    {
+        value = FieldValue( );
+    }
+
+    // An empty body carries no fields.
+    if( size == 0 )
+    {
+        return checkRequired_( body );
+    }
+
+    const char* ptr = raw;
+    const char* end = raw + size;
+
+    // A type mismatch is only reported once the whole text is known good.
+    ParseStatus mismatch( ParseStatus::Ok );
+
+    skipSpace_( ptr, end );
+    if( ptr == end || *ptr != '{' )
+    {
+        return ParseStatus::Malformed;
+    }
+    ++ptr;
+
+    skipSpace_( ptr, end );
+    if( ptr != end && *ptr == '}' )
+    {
+        ++ptr;
+    }
+    else
+    {
+        while( true )
+        {
+            const char* key;
+            size_t keyLength;
+            bool escaped;
+
+            skipSpace_( ptr, end );
+            if( ptr == end || *ptr != '"' )
+            {
+                return ParseStatus::Malformed;
+            }
+
+            ParseStatus status( scanString_( ptr, end, key, keyLength, escaped ) );
+            if( status != ParseStatus::Ok )
+            {
+                return status;
+            }
+
+            // An escaped key might still spell a schema field.
+            if( escaped )
+            {
+                return ParseStatus::Unsupported;
+            }
+
+            skipSpace_( ptr, end );
+            if( ptr == end || *ptr != ':' )
+            {
+                return ParseStatus::Malformed;
+            }
+            ++ptr;
+            skipSpace_( ptr, end );
+
+            int index( body.find_( key, keyLength ) );
+            if( index < 0 )
+            {
+                status = skipValue_( ptr, end, 1 );
+            }
+            else
+            {
+                status = parseField_(
+                        ptr,
+                        end,
+                        body.schema_->fields[ index ].type,
+                        body.values_[ index ] );
+            }
+
+            if( status == ParseStatus::TypeMismatch )
+            {
+                mismatch = status;
+            }
+            else if( status != ParseStatus::Ok )
+            {
+                return status;
+            }
+
+            skipSpace_( ptr, end );
+            if( ptr == end )
+            {
+                return ParseStatus::Malformed;
+            }
+
+            if( *ptr == ',' )
+            {
+                ++ptr;
+                continue;
+            }
+
+            if( *ptr == '}' )
+            {
+                ++ptr;
+                break;
+            }
+
+            return ParseStatus::Malformed;
+        }
+    }
+
+    skipSpace_( ptr, end );
+    if( ptr != end )
+    {
+        return ParseStatus::Malformed;
+    }
+
+    if( mismatch != ParseStatus::Ok )
+    {
+        return mismatch;
+    }
+
+    return checkRequired_( body );
+
+}
+
+
+ParseStatus RequestParser::parseDom( const nlohmann::json& dom, RequestBody& body )
+{
+
+    for( auto& value : body.values_ )
+    {
+        value = FieldValue( );
+    }
+
+    if( dom.is_null( ) )
+    {
+        return checkRequired_( body );
+    }
+
+    if( dom.is_object( ) == false )
+    {
+        return ParseStatus::TypeMismatch;
+    }
+
+    for( size_t i = 0; i < body.schema_->count; ++i )
+    {
+        const FieldSpec& spec = body.schema_->fields[ i ];
+        FieldValue& value = body.values_[ i ];
+
+        auto it = dom.find( spec.name );
+        if( it == dom.end( ) )
+        {
+            continue;
+        }
+
+        switch( spec.type )
+        {
+            case FieldType::Bool:
+            {
+                if( it->is_boolean( ) == false )
+                {
+                    return ParseStatus::TypeMismatch;
+                }
+                value.boolean = it->get<bool>( );
+                break;
+            }
+            case FieldType::Number:
+            {
+                if( it->is_number( ) == false )
+                {
+                    return ParseStatus::TypeMismatch;
+                }
+                value.number = it->get<double>( );
+                break;
+            }
+            case FieldType::String:
+            {
+                if( it->is_string( ) == false )
+                {
+                    return ParseStatus::TypeMismatch;
+                }
+                const std::string& text = it->get_ref<const std::string&>( );
+                value.string = text.data( );
+                value.length = text.size( );
+                break;
+            }
+        }
+
+        value.present = true;
+    }
+
+    return checkRequired_( body );
+
+}
+
+
+ParseStatus RequestParser::checkRequired_( const RequestBody& body )
+{
+    for( size_t i = 0; i < body.schema_->count; ++i )
+    {
+        if( body.schema_->fields[ i ].required && body.values_[ i ].present == false )
+        {
+            return ParseStatus::MissingField;
+        }
+    }
+
+    return ParseStatus::Ok;
+}
+
+
+void RequestParser::skipSpace_( const char*& ptr, const char* end )
+{
+    while( ptr != end && ( *ptr == ' ' || *ptr == '\t' || *ptr == '\n' || *ptr == '\r' ) )
+    {
+        ++ptr;
+    }
+}
+
+
+ParseStatus RequestParser::scanString_(
+        const char*& ptr,
+        const char* end,
+        const char*& start,
+        size_t& length,
+        bool& escaped )
+{
+
+    ++ptr;
+    start = ptr;
+    escaped = false;
+
+    while( ptr != end )
+    {
+        unsigned char c = (unsigned char)*ptr;
+
+        if( c == '"' )
+        {
+            length = ptr - start;
+            ++ptr;
+
+            return ParseStatus::Ok;
+        }
+
+        if( c < 0x20 )
+        {
+            return ParseStatus::Malformed;
+        }
+
+        if( c == '\\' )
+        {
+            escaped = true;
+
+            if( ++ptr == end )
+            {
+                return ParseStatus::Malformed;
+            }
+
+            switch( *ptr )
+            {
+                case '"': case '\\': case '/':
+                case 'b': case 'f': case 'n': case 'r': case 't':
+                {
+                    break;
+                }
+                case 'u':
+                {
+                    for( int i = 0; i < 4; ++i )
+                    {
+                        if( ++ptr == end || isxdigit( (unsigned char)*ptr ) == 0 )
+                        {
+                            return ParseStatus::Malformed;
+                        }
+                    }
+                    break;
+                }
+                default:
+                {
+                    return ParseStatus::Malformed;
+                }
+            }
+        }
+
+        ++ptr;
+    }
+
+    return ParseStatus::Malformed;
+
+}
+
+
+ParseStatus RequestParser::scanNumber_( const char*& ptr, const char* end, double& number )
+{
+
+    const char* start = ptr;
+
+    if( ptr != end && *ptr == '-' )
+    {
+        ++ptr;
+    }
+
+    // A leading zero stands alone.
+    if( ptr != end && *ptr == '0' )
+    {
+        ++ptr;
+    }
+    else if( ptr != end && *ptr >= '1' && *ptr <= '9' )
+    {
+        while( ptr != end && isdigit( (unsigned char)*ptr ) )
+        {
+            ++ptr;
+        }
+    }
+    else
+    {
+        return ParseStatus::Malformed;
+    }
+
+    if( ptr != end && *ptr == '.' )
+    {
+        if( ++ptr == end || isdigit( (unsigned char)*ptr ) == 0 )
+        {
+            return ParseStatus::Malformed;
+        }
+        while( ptr != end && isdigit( (unsigned char)*ptr ) )
+        {
+            ++ptr;
+        }
+    }
+
+    if( ptr != end && ( *ptr == 'e' || *ptr == 'E' ) )
+    {
+        ++ptr;
+        if( ptr != end && ( *ptr == '+' || *ptr == '-' ) )
+        {
+            ++ptr;
+        }
+        if( ptr == end || isdigit( (unsigned char)*ptr ) == 0 )
+        {
+            return ParseStatus::Malformed;
+        }
+        while( ptr != end && isdigit( (unsigned char)*ptr ) )
+        {
+            ++ptr;
+        }
+    }
+
+    // strtod( ) needs a terminated copy.
+    char text[ MAX_NUMBER_LENGTH ];
+    size_t length( ptr - start );
+
+    if( length >= sizeof( text ) )
+    {
+        return ParseStatus::Unsupported;
+    }
+
+    memcpy( text, start, length );
+    text[ length ] = '\0';
+    number = strtod( text, nullptr );
+
+    return ParseStatus::Ok;
+
+}
+
+
+bool RequestParser::scanLiteral_( const char*& ptr, const char* end, const char* literal )
+{
+    size_t length( strlen( literal ) );
+
+    if( (size_t)( end - ptr ) < length || memcmp( ptr, literal, length ) != 0 )
+    {
+        return false;
+    }
+
+    ptr += length;
+
+    return true;
+}
+
+
+ParseStatus RequestParser::skipValue_( const char*& ptr, const char* end, const int& depth )
+{
+
+    if( depth > MAX_REQUEST_DEPTH )
+    {
+        return ParseStatus::Unsupported;
+    }
+
+    if( ptr == end )
+    {
+        return ParseStatus::Malformed;
+    }
+
+    switch( *ptr )
+    {
+        case '"':
+        {
+            const char* start;
+            size_t length;
+            bool escaped;
+
+            return scanString_( ptr, end, start, length, escaped );
+        }
+        case '{':
+        case '[':
+        {
+            char close( ( *ptr == '{' ) ? '}' : ']' );
+            bool isObject( *ptr == '{' );
+
+            ++ptr;
+            skipSpace_( ptr, end );
+            if( ptr != end && *ptr == close )
+            {
+                ++ptr;
+
+                return ParseStatus::Ok;
+            }
+
+            while( true )
+            {
+                ParseStatus status;
+
+                skipSpace_( ptr, end );
+                if( isObject )
+                {
+                    if( ptr == end || *ptr != '"' )
+                    {
+                        return ParseStatus::Malformed;
+                    }
+
+                    status = skipValue_( ptr, end, depth + 1 );
+                    if( status != ParseStatus::Ok )
+                    {
+                        return status;
+                    }
+
+                    skipSpace_( ptr, end );
+                    if( ptr == end || *ptr != ':' )
+                    {
+                        return ParseStatus::Malformed;
+                    }
+                    ++ptr;
+                    skipSpace_( ptr, end );
+                }
+
+                status = skipValue_( ptr, end, depth + 1 );
+                if( status != ParseStatus::Ok )
+                {
+                    return status;
+                }
+
+                skipSpace_( ptr, end );
+                if( ptr == end )
+                {
+                    return ParseStatus::Malformed;
+                }
+
+                if( *ptr == ',' )
+                {
+                    ++ptr;
+                    continue;
+                }
+
+                if( *ptr == close )
+                {
+                    ++ptr;
+
+                    return ParseStatus::Ok;
+                }
+
+                return ParseStatus::Malformed;
+            }
+        }
+        case 't':
+        {
+            return scanLiteral_( ptr, end, "true" ) ? ParseStatus::Ok : ParseStatus::Malformed;
+        }
+        case 'f':
+        {
+            return scanLiteral_( ptr, end, "false" ) ? ParseStatus::Ok : ParseStatus::Malformed;
+        }
+        case 'n':
+        {
+            return scanLiteral_( ptr, end, "null" ) ? ParseStatus::Ok : ParseStatus::Malformed;
+        }
+        default:
+        {
+            double number;
+
+            return scanNumber_( ptr, end, number );
+        }
+    }
+
+}
+
+
+ParseStatus RequestParser::parseField_(
+        const char*& ptr,
+        const char* end,
+        const FieldType& type,
+        FieldValue& value )
+{
+
+    if( ptr == end )
+    {
+        return ParseStatus::Malformed;
+    }
+
+    ParseStatus status;
+    FieldType found;
+
+    switch( *ptr )
+    {
+        case '"':
+        {
+            bool escaped;
+
+            status = scanString_( ptr, end, value.string, value.length, escaped );
+            if( status == ParseStatus::Ok && escaped && type == FieldType::String )
+            {
+                return ParseStatus::Unsupported;
+            }
+            found = FieldType::String;
+            break;
+        }
+        case 't':
+        case 'f':
+        {
+            value.boolean = ( *ptr == 't' );
+            status = scanLiteral_( ptr, end, value.boolean ? "true" : "false" )
+                    ? ParseStatus::Ok : ParseStatus::Malformed;
+            found = FieldType::Bool;
+            break;
+        }
+        case '-':
+        case '0': case '1': case '2': case '3': case '4':
+        case '5': case '6': case '7': case '8': case '9':
+        {
+            status = scanNumber_( ptr, end, value.number );
+            found = FieldType::Number;
+            break;
+        }
+        default:
+        {
+            // null, objects and arrays never match a field type.
+            status = skipValue_( ptr, end, 1 );
+
+            return ( status == ParseStatus::Ok ) ? ParseStatus::TypeMismatch : status;
+        }
+    }
+
+    if( status != ParseStatus::Ok )
+    {
+        return status;
+    }
+
+    if( found != type )
+    {
+        value = FieldValue( );
+
+        return ParseStatus::TypeMismatch;
+    }
+
+    value.present = true;
+
+    return ParseStatus::Ok;
+
+}
@@ -0,0 +1,144 @@
+/*! \license
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * \copyright 2021 Dan Fernández
+ *
+ * \file Class definitions for \p ResponseCache class.
+ *
+ * \author fdaniel, trice2
+ */
+
+#include "responsecache.hpp"
+
+#include <iostream>
+
+
+ResponseCache::ResponseCache( )
+        :
+        cacheMtx_( ),
+        entries_( ),
+        hits_( 0 ),
+        misses_( 0 )
+{
+}
+
+
+bool ResponseCache::lookup(
+        const std::string& group,
+        const BodyEncoding& encoding,
+        const uint64_t& version,
+        std::string& header,
+        std::string& body )
+{
+
+    if( version != NO_STATE_VERSION )
+    {
+        std::lock_guard<std::mutex> lock( cacheMtx_ );
+
+        auto it = entries_.find( group );
+        if( it != entries_.end( ) )
+        {
+            const Entry& entry = it->second[ (size_t)encoding ];
+
+            if( entry.version == version )
+            {
+                header = entry.header;
+                body = entry.body;
+                ++hits_;
+
+                return true;
+            }
+        }
+    }
+
+    ++misses_;
+
+    return false;
+
+}
+
+
+void ResponseCache::store(
+        const std::string& group,
+        const BodyEncoding& encoding,
+        const uint64_t& version,
+        const std::string& header,
+        const std::string& body )
+{
+
+    if( version == NO_STATE_VERSION )
+    {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock( cacheMtx_ );
+
+    Entry& entry = entries_[ group ][ (size_t)encoding ];
+
+    // A response built from older state must not replace a newer one.
+    if( entry.version > version )
+    {
+        return;
+    }
+
+    entry.version = version;
+    entry.header = header;
+    entry.body = body;
+
+    return;
+
+}
+
+
+uint64_t ResponseCache::getHits( ) const
+{
+    return hits_;
+}
+
+
+uint64_t ResponseCache::getMisses( ) const
+{
+    return misses_;
+}
+
+
+double ResponseCache::getHitRate( ) const
+{
+
+    uint64_t hits( hits_ );
+    uint64_t lookups( hits + misses_ );
+
+    return ( lookups == 0 ) ? 0.0 : (double)hits / lookups;
+
+}
+
+
+void ResponseCache::print( const std::string& name ) const
+{
+
+    std::cout << "---" << std::endl;
+    std::cout << name << ": " << getHits( ) << " hits\t" << getMisses( ) << " misses\t"
+    << (int)( getHitRate( ) * 100.0 + 0.5 ) << "% hit rate" << std::endl;
+
+    return;
+
+}
@@ -0,0 +1,145 @@
+/*! \license
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * \copyright 2021 Dan Fernández
+ *
+ * \file Class definitions for \p SignalBus class.
+ *
+ * \author fdaniel, trice2
+ */
+
+#include "signalbus.hpp"
+
+#include <algorithm>
+
+
+SignalSubscriber::SignalSubscriber( const SignalMask& mask )
+        :
+        mask_( mask ),
+        pending_( 0 ),
+        waiter_( )
+{
+}
+
+
+bool SignalSubscriber::waitFor( const uint32_t& micros )
+{
+    return waiter_.waitFor( micros );
+}
+
+
+void SignalSubscriber::wait( )
+{
+    waiter_.wait( );
+}
+
+
+SignalMask SignalSubscriber::takeChanges( )
+{
+
+    // Rearm first, so a change posted in between still wakes the next wait.
+    waiter_.reset( );
+
+    return pending_.exchange( 0 );
+
+}
+
+
+void SignalSubscriber::wake( )
+{
+    waiter_.notify( );
+}
+
+
+SignalMask SignalSubscriber::getMask( ) const
+{
+    return mask_;
+}
+
+
+int SignalSubscriber::getEventSocket( ) const
+{
+    return waiter_.getEventSocket( );
+}
+
+
+void SignalSubscriber::post_( const SignalMask& changed )
+{
+
+    pending_ |= changed;
+    waiter_.notify( );
+
+    return;
+
+}
+
+
+SignalBus::SignalBus( )
+        :
+        subscriberMtx_( ),
+        subscribers_( )
+{
+}
+
+
+std::shared_ptr<SignalSubscriber> SignalBus::subscribe( const SignalMask& mask )
+{
+
+    std::shared_ptr<SignalSubscriber> subscriber =
+            std::make_shared<SignalSubscriber>( mask );
+
+    std::lock_guard<std::mutex> lock( subscriberMtx_ );
+    subscribers_.push_back( subscriber );
+
+    return subscriber;
+
+}
+
+
+void SignalBus::unsubscribe( const std::shared_ptr<SignalSubscriber>& subscriber )
+{
+
+    std::lock_guard<std::mutex> lock( subscriberMtx_ );
+    subscribers_.erase(
+            std::remove( subscribers_.begin( ), subscribers_.end( ), subscriber ),
+            subscribers_.end( ) );
+
+    return;
+
+}
+
+
+void SignalBus::publish( const SignalMask& changed )
+{
+
+    std::lock_guard<std::mutex> lock( subscriberMtx_ );
+    for( auto& subscriber : subscribers_ )
+    {
+        if( subscriber->getMask( ) & changed )
+        {
+            subscriber->post_( subscriber->getMask( ) & changed );
+        }
+    }
+
+    return;
+
+}
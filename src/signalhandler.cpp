@@ -28,40 +28,18 @@
  */
 
 #include "signalhandler.hpp"
+#include "pdusignals.hpp"
 #include "picosha2.h"
 
+#include <string.h>
+
 using namespace std::placeholders;
 
 /*!
  * List of all signals sent in the payload of the TCM_LM PDU
  */
 lm_signal_t TCM_lm_t[] = {
-    // 1
-    {TCM_LM::AppCalcCheck, "AppCalcCheck", 0, 0, 16},
-    {TCM_LM::LMDviceAliveCntRMT, "LMDviceAliveCntRMT", 0, 0, 4},
-    {TCM_LM::ManeuverEnableInput, "ManeuverEnableInput", 0, 0, 2},
-    {TCM_LM::ManeuverGearSelect, "ManeuverGearSelect", 0, 0, 2},
-    {TCM_LM::NudgeSelect, "NudgeSelect", 0, 0, 2},
-    {TCM_LM::RCDOvrrdReqRMT, "RCDOvrrdReqRMT", 0, 0, 2},
-    {TCM_LM::AppSliderPosY, "AppSliderPosY", 0, 0, 12},
-    {TCM_LM::AppSliderPosX, "AppSliderPosX", 0, 0, 11},
-    {TCM_LM::RCDSpeedChngReqRMT, "RCDSpeedChngReqRMT", 0, 0, 6},
-    {TCM_LM::RCDSteWhlChngReqRMT, "RCDSteWhlChngReqRMT", 0, 0, 10},
-    // 11
-    {TCM_LM::ConnectionApproval, "ConnectionApproval", 0, 0, 2},
-    {TCM_LM::ManeuverButtonPress, "ManeuverButtonPress", 0, 0, 3},
-    {TCM_LM::DeviceControlMode, "DeviceControlMode", 0, 0, 4},
-    {TCM_LM::ManeuverTypeSelect, "ManeuverTypeSelect", 0, 0, 2},
-    {TCM_LM::ManeuverDirectionSelect, "ManeuverDirectionSelect", 0, 0, 2},
-    {TCM_LM::ExploreModeSelect, "ExploreModeSelect", 0, 0, 1},
-    {TCM_LM::RemoteDeviceBatteryLevel, "RemoteDeviceBatteryLevel", 0, 0, 7},
-    {TCM_LM::PairedWKeyId, "PairedWKeyId", 0, 0, 8},
-    {TCM_LM::ManeuverSideSelect, "ManeuverSideSelect", 0, 0, 2},
-    {TCM_LM::LMDviceRngeDistRMT, "LMDviceRngeDistRMT", 0, 0, 10},
-    // 21
-    {TCM_LM::TTTTTTTTTT, "TTTTTTTTTT", 0, 0, 4},
-    {TCM_LM::LMRemoteChallengeVDC, "LMRemoteChallengeVDC", 0, 0, 64},
-    {TCM_LM::MobileChallengeReply, "MobileChallengeReply", 0, 0, 64},
+    TCM_LM_SIGNALS( PDU_TABLE_SIGNAL )
     {TCM_LM::MAXSignal, "MAXSignal", 0, 0, 0},
 };
 
@@ -69,15 +47,7 @@ lm_signal_t TCM_lm_t[] = {
  * List of all signals sent in the payload of the TCM_LM_Session PDU
  */
 lm_signal_t TCM_lm_session_t[] = {
-    // 1
-    {TCM_LM_Session::LMEncrptSessionCntVDC_1, "LMEncrptSessionCntVDC_1", 0, 0, 64},
-    {TCM_LM_Session::LMEncrptSessionCntVDC_2, "LMEncrptSessionCntVDC_2", 0, 0, 64},
-    {TCM_LM_Session::LMEncryptSessionIDVDC_1, "LMEncryptSessionIDVDC_1", 0, 0, 64},
-    {TCM_LM_Session::LMEncryptSessionIDVDC_2, "LMEncryptSessionIDVDC_2", 0, 0, 64},
-    {TCM_LM_Session::LMTruncMACVDC, "LMTruncMACVDC", 0, 0, 64},
-    {TCM_LM_Session::LMTruncSessionCntVDC, "LMTruncSessionCntVDC", 0, 0, 8},
-    {TCM_LM_Session::LMSessionControlVDC, "LMSessionControlVDC", 0, 0, 3},
-    {TCM_LM_Session::LMSessionControlVDCExt, "LMSessionControlVDCExt", 0, 0, 5},
+    TCM_LM_SESSION_SIGNALS( PDU_TABLE_SIGNAL )
     {TCM_LM_Session::MAXSignal, "MAXSignal", 0, 0, 0},
 };
 
@@ -85,7 +55,7 @@ lm_signal_t TCM_lm_session_t[] = {
  * List of all signals sent in the payload of the TCM_RemoteControl PDU
  */
 lm_signal_t TCM_remotecontrol_t[] = {
-    {TCM_RemoteControl::TCMRemoteControl, "TCMRemoteControl", 0, 0, 64},
+    TCM_REMOTECONTROL_SIGNALS( PDU_TABLE_SIGNAL )
     {TCM_RemoteControl::MAXSignal, "MAXSignal", 0, 0, 0},
 };
 
@@ -93,10 +63,7 @@ lm_signal_t TCM_remotecontrol_t[] = {
  * List of all signals sent in the payload of the TCM_TransportKey PDU
  */
 lm_signal_t TCM_transportkey_t[] = {
-    {TCM_TransportKey::LMSessionKeyIDVDC, "LMSessionKeyIDVDC", 0, 0, 16},
-    {TCM_TransportKey::LMHashEnTrnsportKeyVDC, "LMHashEnTrnsportKeyVDC", 0, 0, 16},
-    {TCM_TransportKey::LMEncTransportKeyVDC_1, "LMEncTransportKeyVDC_1", 0, 0, 64},
-    {TCM_TransportKey::LMEncTransportKeyVDC_2, "LMEncTransportKeyVDC_2", 0, 0, 64},
+    TCM_TRANSPORTKEY_SIGNALS( PDU_TABLE_SIGNAL )
     {TCM_TransportKey::MAXSignal, "MAXSignal", 0, 0, 0},
 };
 
@@ -104,10 +71,7 @@ lm_signal_t TCM_transportkey_t[] = {
  * List of all signals sent in the payload of the TCM_LM_App PDU
  */
 lm_signal_t TCM_lm_app_t[] = {
-    {TCM_LM_App::LMAppTimeStampRMT, "LMAppTimeStampRMT", 0, 0, 64},
-    {TCM_LM_App::AppAccelerationX, "AppAccelerationX", 0, 0, 64},
-    {TCM_LM_App::AppAccelerationY, "AppAccelerationY", 0, 0, 64},
-    {TCM_LM_App::AppAccelerationZ, "AppAccelerationZ", 0, 0, 64},
+    TCM_LM_APP_SIGNALS( PDU_TABLE_SIGNAL )
     {TCM_LM_App::MAXSignal, "MAXSignal", 0, 0, 0},
 };
 
@@ -115,9 +79,7 @@ lm_signal_t TCM_lm_app_t[] = {
  * List of all signals sent in the payload of the TCM_LM_KeyID PDU
  */
 lm_signal_t TCM_lm_keyid_t[] = {
-    {TCM_LM_KeyID::NOT_USED_ONE_BIT, "NOT_USED_ONE_BIT", 0, 0, 1},
-    {TCM_LM_KeyID::LMRotKeyChkACKVDC, "LMRotKeyChkACKVDC", 0, 0, 3},
-    {TCM_LM_KeyID::LMSessionKeyIDVDCExt, "LMSessionKeyIDVDCExt", 0, 0, 4},
+    TCM_LM_KEYID_SIGNALS( PDU_TABLE_SIGNAL )
     {TCM_LM_KeyID::MAXSignal, "MAXSignal", 0, 0, 0},
 };
 
@@ -125,9 +87,7 @@ lm_signal_t TCM_lm_keyid_t[] = {
  * List of all signals sent in the payload of the TCM_LM_KeyAlpha PDU
  */
 lm_signal_t TCM_lm_keyalpha_t[] = {
-    {TCM_LM_KeyAlpha::LMHashEnRotKeyAlphaVDC, "LMHashEnRotKeyAlphaVDC", 0, 0, 16},
-    {TCM_LM_KeyAlpha::LMEncRotKeyAlphaVDC_1, "LMEncRotKeyAlphaVDC_1", 0, 0, 64},
-    {TCM_LM_KeyAlpha::LMEncRotKeyAlphaVDC_2, "LMEncRotKeyAlphaVDC_2", 0, 0, 64},
+    TCM_LM_KEYALPHA_SIGNALS( PDU_TABLE_SIGNAL )
     {TCM_LM_KeyAlpha::MAXSignal, "MAXSignal", 0, 0, 0},
 };
 
@@ -135,9 +95,7 @@ lm_signal_t TCM_lm_keyalpha_t[] = {
  * List of all signals sent in the payload of the TCM_LM_KeyBeta PDU
  */
 lm_signal_t TCM_lm_keybeta_t[] = {
-    {TCM_LM_KeyBeta::LMHashEncRotKeyBetaVDC, "LMHashEncRotKeyBetaVDC", 0, 0, 16},
-    {TCM_LM_KeyBeta::LMEncRotKeyBetaVDC_1, "LMEncRotKeyBetaVDC_1", 0, 0, 64},
-    {TCM_LM_KeyBeta::LMEncRotKeyBetaVDC_2, "LMEncRotKeyBetaVDC_2", 0, 0, 64},
+    TCM_LM_KEYBETA_SIGNALS( PDU_TABLE_SIGNAL )
     {TCM_LM_KeyBeta::MAXSignal, "MAXSignal", 0, 0, 0},
 };
 
@@ -145,9 +103,7 @@ lm_signal_t TCM_lm_keybeta_t[] = {
  * List of all signals sent in the payload of the TCM_LM_KeyGamma PDU
  */
 lm_signal_t TCM_lm_keygamma_t[] = {
-    {TCM_LM_KeyGamma::LMHashEncRotKeyGamaVDC, "LMHashEncRotKeyGamaVDC", 0, 0, 16},
-    {TCM_LM_KeyGamma::LMEncRotKeyGammaVDC_1, "LMEncRotKeyGammaVDC_1", 0, 0, 64},
-    {TCM_LM_KeyGamma::LMEncRotKeyGammaVDC_2, "LMEncRotKeyGammaVDC_2", 0, 0, 64},
+    TCM_LM_KEYGAMMA_SIGNALS( PDU_TABLE_SIGNAL )
     {TCM_LM_KeyGamma::MAXSignal, "MAXSignal", 0, 0, 0},
 };
 
@@ -155,66 +111,7 @@ lm_signal_t TCM_lm_keygamma_t[] = {
  * List of all signals sent in the payload of the ASPM_LM PDU
  */
 lm_signal_t ASPM_lm_t[] = {
-    // 1
-    {ASPM_LM::LMAppConsChkASPM, "LMAppConsChkASPM", 0, 0, 16},
-    {ASPM_LM::ActiveAutonomousFeature, "ActiveAutonomousFeature", 0, 0, 4},
-    {ASPM_LM::CancelAvailability, "CancelAvailability", 0, 0, 2},
-    {ASPM_LM::ConfirmAvailability, "ConfirmAvailability", 0, 0, 2},
-    {ASPM_LM::LongitudinalAdjustAvailability, "LongitudinalAdjustAvailability", 0, 0, 2},
-    {ASPM_LM::ManeuverDirectionAvailability, "ManeuverDirectionAvailability", 0, 0, 2},
-    {ASPM_LM::ManeuverSideAvailability, "ManeuverSideAvailability", 0, 0, 2},
-    {ASPM_LM::ActiveManeuverOrientation, "ActiveManeuverOrientation", 0, 0, 2},
-    {ASPM_LM::ActiveParkingMode, "ActiveParkingMode", 0, 0, 2},
-    {ASPM_LM::DirectionChangeAvailability, "DirectionChangeAvailability", 0, 0, 2},
-    // 11
-    {ASPM_LM::ParkTypeChangeAvailability, "ParkTypeChangeAvailability", 0, 0, 2},
-    {ASPM_LM::ExploreModeAvailability, "ExploreModeAvailability", 0, 0, 2},
-    {ASPM_LM::ActiveManeuverSide, "ActiveManeuverSide", 0, 0, 2},
-    {ASPM_LM::ManeuverStatus, "ManeuverStatus", 0, 0, 4},
-    {ASPM_LM::RemoteDriveOverrideState, "RemoteDriveOverrideState", 0, 0, 2},
-    {ASPM_LM::ActiveParkingType, "ActiveParkingType", 0, 0, 3},
-    {ASPM_LM::ResumeAvailability, "ResumeAvailability", 0, 0, 2},
-    {ASPM_LM::ReturnToStartAvailability, "ReturnToStartAvailability", 0, 0, 2},
-    {ASPM_LM::NNNNNNNNNN, "NNNNNNNNNN", 0, 0, 2},
-    {ASPM_LM::KeyFobRange, "KeyFobRange", 0, 0, 3},
-    // 21
-    {ASPM_LM::LMDviceAliveCntAckRMT, "LMDviceAliveCntAckRMT", 0, 0, 4},
-    {ASPM_LM::NoFeatureAvailableMsg, "NoFeatureAvailableMsg", 0, 0, 4},
-    {ASPM_LM::LMFrwdCollSnsType1RMT, "LMFrwdCollSnsType1RMT", 0, 0, 1},
-    {ASPM_LM::LMFrwdCollSnsType2RMT, "LMFrwdCollSnsType2RMT", 0, 0, 1},
-    {ASPM_LM::LMFrwdCollSnsType3RMT, "LMFrwdCollSnsType3RMT", 0, 0, 1},
-    {ASPM_LM::LMFrwdCollSnsType4RMT, "LMFrwdCollSnsType4RMT", 0, 0, 1},
-    {ASPM_LM::LMFrwdCollSnsZone1RMT, "LMFrwdCollSnsZone1RMT", 0, 0, 4},
-    {ASPM_LM::LMFrwdCollSnsZone2RMT, "LMFrwdCollSnsZone2RMT", 0, 0, 4},
-    {ASPM_LM::LMFrwdCollSnsZone3RMT, "LMFrwdCollSnsZone3RMT", 0, 0, 4},
-    {ASPM_LM::LMFrwdCollSnsZone4RMT, "LMFrwdCollSnsZone4RMT", 0, 0, 4},
-    // 31
-    {ASPM_LM::InfoMsg, "InfoMsg", 0, 0, 6},
-    {ASPM_LM::InstructMsg, "InstructMsg", 0, 0, 5},
-    {ASPM_LM::LateralControlInfo, "LateralControlInfo", 0, 0, 3},
-    {ASPM_LM::LongitudinalAdjustLength, "LongitudinalAdjustLength", 0, 0, 10},
-    {ASPM_LM::LongitudinalControlInfo, "LongitudinalControlInfo", 0, 0, 3},
-    {ASPM_LM::ManeuverAlignmentAvailability, "ManeuverAlignmentAvailability", 0, 0, 3},
-    {ASPM_LM::RemoteDriveAvailability, "RemoteDriveAvailability", 0, 0, 2},
-    {ASPM_LM::PauseMsg2, "PauseMsg2", 0, 0, 4},
-    {ASPM_LM::PauseMsg1, "PauseMsg1", 0, 0, 4},
-    {ASPM_LM::LMRearCollSnsType1RMT, "LMRearCollSnsType1RMT", 0, 0, 1},
-    // 41
-    {ASPM_LM::LMRearCollSnsType2RMT, "LMRearCollSnsType2RMT", 0, 0, 1},
-    {ASPM_LM::LMRearCollSnsType3RMT, "LMRearCollSnsType3RMT", 0, 0, 1},
-    {ASPM_LM::LMRearCollSnsType4RMT, "LMRearCollSnsType4RMT", 0, 0, 1},
-    {ASPM_LM::LMRearCollSnsZone1RMT, "LMRearCollSnsZone1RMT", 0, 0, 4},
-    {ASPM_LM::LMRearCollSnsZone2RMT, "LMRearCollSnsZone2RMT", 0, 0, 4},
-    {ASPM_LM::LMRearCollSnsZone3RMT, "LMRearCollSnsZone3RMT", 0, 0, 4},
-    {ASPM_LM::LMRearCollSnsZone4RMT, "LMRearCollSnsZone4RMT", 0, 0, 4},
-    {ASPM_LM::LMRemoteFeatrReadyRMT, "LMRemoteFeatrReadyRMT", 0, 0, 2},
-    {ASPM_LM::CancelMsg, "CancelMsg", 0, 0, 4},
-    {ASPM_LM::LMVehMaxRmteVLimRMT, "LMVehMaxRmteVLimRMT", 0, 0, 6},
-    // 51
-    {ASPM_LM::ManueverPopupDisplay, "ManueverPopupDisplay", 0, 0, 1},
-    {ASPM_LM::ManeuverProgressBar, "ManeuverProgressBar", 0, 0, 7},
-    {ASPM_LM::MobileChallengeSend, "MobileChallengeSend", 0, 0, 64},
-    {ASPM_LM::LMRemoteResponseASPM, "LMRemoteResponseASPM", 0, 0, 64},
+    ASPM_LM_SIGNALS( PDU_TABLE_SIGNAL )
     {ASPM_LM::MAXSignal, "MAXSignal", 0, 0, 0},
 };
 
@@ -222,143 +119,32 @@ lm_signal_t ASPM_lm_t[] = {
  * List of all signals sent in the payload of the ASPM_LM_ObjSegment PDU
  */
 lm_signal_t ASPM_lm_objsegment_t[] = {
-    // 1
-    {ASPM_LM_ObjSegment::ASPMXXXXX, "ASPMXXXXX", 0, 0, 1},
-    {ASPM_LM_ObjSegment::ASPMFrontSegType1RMT, "ASPMFrontSegType1RMT", 0, 0, 2},
-    {ASPM_LM_ObjSegment::ASPMFrontSegDist1RMT, "ASPMFrontSegDist1RMT", 0, 0, 5},
-    {ASPM_LM_ObjSegment::ASPMXXXXX, "ASPMXXXXX", 0, 0, 1},
-    {ASPM_LM_ObjSegment::ASPMFrontSegType2RMT, "ASPMFrontSegType2RMT", 0, 0, 2},
-    {ASPM_LM_ObjSegment::ASPMFrontSegDist2RMT, "ASPMFrontSegDist2RMT", 0, 0, 5},
-    {ASPM_LM_ObjSegment::ASPMXXXXX, "ASPMXXXXX", 0, 0, 1},
-    {ASPM_LM_ObjSegment::ASPMFrontSegType3RMT, "ASPMFrontSegType3RMT", 0, 0, 2},
-    {ASPM_LM_ObjSegment::ASPMFrontSegDist3RMT, "ASPMFrontSegDist3RMT", 0, 0, 5},
-    {ASPM_LM_ObjSegment::ASPMXXXXX, "ASPMXXXXX", 0, 0, 1},
-    {ASPM_LM_ObjSegment::ASPMFrontSegType4RMT, "ASPMFrontSegType4RMT", 0, 0, 2},
-    {ASPM_LM_ObjSegment::ASPMFrontSegDist4RMT, "ASPMFrontSegDist4RMT", 0, 0, 5},
-    {ASPM_LM_ObjSegment::ASPMXXXXX, "ASPMXXXXX", 0, 0, 1},
-    {ASPM_LM_ObjSegment::ASPMFrontSegType5RMT, "ASPMFrontSegType5RMT", 0, 0, 2},
-    {ASPM_LM_ObjSegment::ASPMFrontSegDist5RMT, "ASPMFrontSegDist5RMT", 0, 0, 5},
-    // 11
-    {ASPM_LM_ObjSegment::ASPMXXXXX, "ASPMXXXXX", 0, 0, 1},
-    {ASPM_LM_ObjSegment::ASPMFrontSegType6RMT, "ASPMFrontSegType6RMT", 0, 0, 2},
-    {ASPM_LM_ObjSegment::ASPMFrontSegDist6RMT, "ASPMFrontSegDist6RMT", 0, 0, 5},
-    {ASPM_LM_ObjSegment::ASPMXXXXX, "ASPMXXXXX", 0, 0, 1},
-    {ASPM_LM_ObjSegment::ASPMFrontSegType7RMT, "ASPMFrontSegType7RMT", 0, 0, 2},
-    {ASPM_LM_ObjSegment::ASPMFrontSegDist7RMT, "ASPMFrontSegDist7RMT", 0, 0, 5},
-    {ASPM_LM_ObjSegment::ASPMXXXXX, "ASPMXXXXX", 0, 0, 1},
-    {ASPM_LM_ObjSegment::ASPMFrontSegType8RMT, "ASPMFrontSegType8RMT", 0, 0, 2},
-    {ASPM_LM_ObjSegment::ASPMFrontSegDist8RMT, "ASPMFrontSegDist8RMT", 0, 0, 5},
-    {ASPM_LM_ObjSegment::ASPMXXXXX, "ASPMXXXXX", 0, 0, 1},
-    {ASPM_LM_ObjSegment::ASPMFrontSegType9RMT, "ASPMFrontSegType9RMT", 0, 0, 2},
-    {ASPM_LM_ObjSegment::ASPMFrontSegDist9RMT, "ASPMFrontSegDist9RMT", 0, 0, 5},
-    {ASPM_LM_ObjSegment::ASPMXXXXX, "ASPMXXXXX", 0, 0, 1},
-    {ASPM_LM_ObjSegment::ASPMFrontSegType10RMT, "ASPMFrontSegType10RMT", 0, 0, 2},
-    {ASPM_LM_ObjSegment::ASPMFrontSegDist10RMT, "ASPMFrontSegDist10RMT", 0, 0, 5},
-    // 21
-    {ASPM_LM_ObjSegment::ASPMXXXXX, "ASPMXXXXX", 0, 0, 1},
-    {ASPM_LM_ObjSegment::ASPMFrontSegType11RMT, "ASPMFrontSegType11RMT", 0, 0, 2},
-    {ASPM_LM_ObjSegment::ASPMFrontSegDist11RMT, "ASPMFrontSegDist11RMT", 0, 0, 5},
-    {ASPM_LM_ObjSegment::ASPMXXXXX, "ASPMXXXXX", 0, 0, 1},
-    {ASPM_LM_ObjSegment::ASPMFrontSegType12RMT, "ASPMFrontSegType12RMT", 0, 0, 2},
-    {ASPM_LM_ObjSegment::ASPMFrontSegDist12RMT, "ASPMFrontSegDist12RMT", 0, 0, 5},
-    {ASPM_LM_ObjSegment::ASPMXXXXX, "ASPMXXXXX", 0, 0, 1},
-    {ASPM_LM_ObjSegment::ASPMFrontSegType13RMT, "ASPMFrontSegType13RMT", 0, 0, 2},
-    {ASPM_LM_ObjSegment::ASPMFrontSegDist13RMT, "ASPMFrontSegDist13RMT", 0, 0, 5},
-    {ASPM_LM_ObjSegment::ASPMXXXXX, "ASPMXXXXX", 0, 0, 1},
-    {ASPM_LM_ObjSegment::ASPMFrontSegType14RMT, "ASPMFrontSegType14RMT", 0, 0, 2},
-    {ASPM_LM_ObjSegment::ASPMFrontSegDist14RMT, "ASPMFrontSegDist14RMT", 0, 0, 5},
-    {ASPM_LM_ObjSegment::ASPMXXXXX, "ASPMXXXXX", 0, 0, 1},
-    {ASPM_LM_ObjSegment::ASPMFrontSegType15RMT, "ASPMFrontSegType15RMT", 0, 0, 2},
-    {ASPM_LM_ObjSegment::ASPMFrontSegDist15RMT, "ASPMFrontSegDist15RMT", 0, 0, 5},
-    // 31
-    {ASPM_LM_ObjSegment::ASPMXXXXX, "ASPMXXXXX", 0, 0, 1},
-    {ASPM_LM_ObjSegment::ASPMFrontSegType16RMT, "ASPMFrontSegType16RMT", 0, 0, 2},
-    {ASPM_LM_ObjSegment::ASPMFrontSegDist16RMT, "ASPMFrontSegDist16RMT", 0, 0, 5},
-    {ASPM_LM_ObjSegment::ASPMXXXXX, "ASPMXXXXX", 0, 0, 1},
-    {ASPM_LM_ObjSegment::ASPMRearSegType1RMT, "ASPMRearSegType1RMT", 0, 0, 2},
-    {ASPM_LM_ObjSegment::ASPMRearSegDist1RMT, "ASPMRearSegDist1RMT", 0, 0, 5},
-    {ASPM_LM_ObjSegment::ASPMXXXXX, "ASPMXXXXX", 0, 0, 1},
-    {ASPM_LM_ObjSegment::ASPMRearSegType2RMT, "ASPMRearSegType2RMT", 0, 0, 2},
-    {ASPM_LM_ObjSegment::ASPMRearSegDist2RMT, "ASPMRearSegDist2RMT", 0, 0, 5},
-    {ASPM_LM_ObjSegment::ASPMXXXXX, "ASPMXXXXX", 0, 0, 1},
-    {ASPM_LM_ObjSegment::ASPMRearSegType3RMT, "ASPMRearSegType3RMT", 0, 0, 2},
-    {ASPM_LM_ObjSegment::ASPMRearSegDist3RMT, "ASPMRearSegDist3RMT", 0, 0, 5},
-    {ASPM_LM_ObjSegment::ASPMXXXXX, "ASPMXXXXX", 0, 0, 1},
-    {ASPM_LM_ObjSegment::ASPMRearSegType4RMT, "ASPMRearSegType4RMT", 0, 0, 2},
-    {ASPM_LM_ObjSegment::ASPMRearSegDist4RMT, "ASPMRearSegDist4RMT", 0, 0, 5},
-    // 41
-    {ASPM_LM_ObjSegment::ASPMXXXXX, "ASPMXXXXX", 0, 0, 1},
-    {ASPM_LM_ObjSegment::ASPMRearSegType5RMT, "ASPMRearSegType5RMT", 0, 0, 2},
-    {ASPM_LM_ObjSegment::ASPMRearSegDist5RMT, "ASPMRearSegDist5RMT", 0, 0, 5},
-    {ASPM_LM_ObjSegment::ASPMXXXXX, "ASPMXXXXX", 0, 0, 1},
-    {ASPM_LM_ObjSegment::ASPMRearSegType6RMT, "ASPMRearSegType6RMT", 0, 0, 2},
-    {ASPM_LM_ObjSegment::ASPMRearSegDist6RMT, "ASPMRearSegDist6RMT", 0, 0, 5},
-    {ASPM_LM_ObjSegment::ASPMXXXXX, "ASPMXXXXX", 0, 0, 1},
-    {ASPM_LM_ObjSegment::ASPMRearSegType7RMT, "ASPMRearSegType7RMT", 0, 0, 2},
-    {ASPM_LM_ObjSegment::ASPMRearSegDist7RMT, "ASPMRearSegDist7RMT", 0, 0, 5},
-    {ASPM_LM_ObjSegment::ASPMXXXXX, "ASPMXXXXX", 0, 0, 1},
-    {ASPM_LM_ObjSegment::ASPMRearSegType8RMT, "ASPMRearSegType8RMT", 0, 0, 2},
-    {ASPM_LM_ObjSegment::ASPMRearSegDist8RMT, "ASPMRearSegDist8RMT", 0, 0, 5},
-    {ASPM_LM_ObjSegment::ASPMXXXXX, "ASPMXXXXX", 0, 0, 1},
-    {ASPM_LM_ObjSegment::ASPMRearSegType9RMT, "ASPMRearSegType9RMT", 0, 0, 2},
-    {ASPM_LM_ObjSegment::ASPMRearSegDist9RMT, "ASPMRearSegDist9RMT", 0, 0, 5},
-    // 51
-    {ASPM_LM_ObjSegment::ASPMXXXXX, "ASPMXXXXX", 0, 0, 1},
-    {ASPM_LM_ObjSegment::ASPMRearSegType10RMT, "ASPMRearSegType10RMT", 0, 0, 2},
-    {ASPM_LM_ObjSegment::ASPMRearSegDist10RMT, "ASPMRearSegDist10RMT", 0, 0, 5},
-    {ASPM_LM_ObjSegment::ASPMXXXXX, "ASPMXXXXX", 0, 0, 1},
-    {ASPM_LM_ObjSegment::ASPMRearSegType11RMT, "ASPMRearSegType11RMT", 0, 0, 2},
-    {ASPM_LM_ObjSegment::ASPMRearSegDist11RMT, "ASPMRearSegDist11RMT", 0, 0, 5},
-    {ASPM_LM_ObjSegment::ASPMXXXXX, "ASPMXXXXX", 0, 0, 1},
-    {ASPM_LM_ObjSegment::ASPMRearSegType12RMT, "ASPMRearSegType12RMT", 0, 0, 2},
-    {ASPM_LM_ObjSegment::ASPMRearSegDist12RMT, "ASPMRearSegDist12RMT", 0, 0, 5},
-    {ASPM_LM_ObjSegment::ASPMXXXXX, "ASPMXXXXX", 0, 0, 1},
-    {ASPM_LM_ObjSegment::ASPMRearSegType13RMT, "ASPMRearSegType13RMT", 0, 0, 2},
-    {ASPM_LM_ObjSegment::ASPMRearSegDist13RMT, "ASPMRearSegDist13RMT", 0, 0, 5},
-    {ASPM_LM_ObjSegment::ASPMXXXXX, "ASPMXXXXX", 0, 0, 1},
-    {ASPM_LM_ObjSegment::ASPMRearSegType14RMT, "ASPMRearSegType14RMT", 0, 0, 2},
-    {ASPM_LM_ObjSegment::ASPMRearSegDist14RMT, "ASPMRearSegDist14RMT", 0, 0, 5},
-    // 61
-    {ASPM_LM_ObjSegment::ASPMXXXXX, "ASPMXXXXX", 0, 0, 1},
-    {ASPM_LM_ObjSegment::ASPMRearSegType15RMT, "ASPMRearSegType15RMT", 0, 0, 2},
-    {ASPM_LM_ObjSegment::ASPMRearSegDist15RMT, "ASPMRearSegDist15RMT", 0, 0, 5},
-    {ASPM_LM_ObjSegment::ASPMXXXXX, "ASPMXXXXX", 0, 0, 1},
-    {ASPM_LM_ObjSegment::ASPMRearSegType16RMT, "ASPMRearSegType16RMT", 0, 0, 2},
-    {ASPM_LM_ObjSegment::ASPMRearSegDist16RMT, "ASPMRearSegDist16RMT", 0, 0, 5},
-
-    {ASPM_LM_ObjSegment::MAXSignal, "MAXSignal", 0, 0, 0}
+    ASPM_LM_OBJSEGMENT_SIGNALS( PDU_TABLE_SIGNAL )
+    {ASPM_LM_ObjSegment::MAXSignal, "MAXSignal", 0, 0, 0},
 };
 
 /*!
  * List of all signals sent in the payload of the ASPM_RemoteTarget PDU
  */
 lm_signal_t ASPM_remotetarget_t[] = {
-    {ASPM_RemoteTarget::TCMRemoteTarget, "TCMRemoteTarget", 0, 0, 64},
-    {ASPM_RemoteTarget::MAXSignal, "MAXSignal", 0, 0, 0}
+    ASPM_REMOTETARGET_SIGNALS( PDU_TABLE_SIGNAL )
+    {ASPM_RemoteTarget::MAXSignal, "MAXSignal", 0, 0, 0},
 };
 
 /*!
  * List of all signals sent in the payload of the ASPM_LM_Session PDU
  */
 lm_signal_t ASPM_lm_session_t[] = {
-    {ASPM_LM_Session::LMEncrptSessionCntASPM_1, "LMEncrptSessionCntASPM_1", 0, 0, 64},
-    {ASPM_LM_Session::LMEncrptSessionCntASPM_2, "LMEncrptSessionCntASPM_2", 0, 0, 64},
-    {ASPM_LM_Session::LMEncryptSessionIDASPM_1, "LMEncryptSessionIDASPM_1", 0, 0, 64},
-    {ASPM_LM_Session::LMEncryptSessionIDASPM_2, "LMEncryptSessionIDASPM_2", 0, 0, 64},
-    {ASPM_LM_Session::LMTruncMACASPM, "LMTruncMACASPM", 0, 0, 64},
-    {ASPM_LM_Session::LMTruncSessionCntASPM, "LMTruncSessionCntASPM", 0, 0, 8},
-    {ASPM_LM_Session::LMSessionControlASPM, "LMSessionControlASPM", 0, 0, 3},
-    {ASPM_LM_Session::LMSessionControlASPMExt, "LMSessionControlASPMExt", 0, 0, 5},
-    {ASPM_LM_Session::MAXSignal, "MAXSignal", 0, 0, 0}
+    ASPM_LM_SESSION_SIGNALS( PDU_TABLE_SIGNAL )
+    {ASPM_LM_Session::MAXSignal, "MAXSignal", 0, 0, 0},
 };
 
 /*!
  * List of all signals sent in the payload of the ASPM_LM_Trunc PDU
  */
 lm_signal_t ASPM_lm_trunc_t[] = {
-    {ASPM_LM_Trunc::LMTruncEnPsPrasRotASPM_1, "LMTruncEnPsPrasRotASPM_1", 0, 0, 64},
-    {ASPM_LM_Trunc::LMTruncEnPsPrasRotASPM_2, "LMTruncEnPsPrasRotASPM_2", 0, 0, 64},
-    {ASPM_LM_Trunc::MAXSignal, "MAXSignal", 0, 0, 0}
+    ASPM_LM_TRUNC_SIGNALS( PDU_TABLE_SIGNAL )
+    {ASPM_LM_Trunc::MAXSignal, "MAXSignal", 0, 0, 0},
 };
 
 // Constructor initializes all member variables.
@@ -419,16 +205,52 @@ SignalHandler::SignalHandler( )
         rangingRequestRate_( DCM::FobRangeRequestRate::None ),
         InControlRemotePIN_( DCM::PIN_NOT_SET ),
         pinStoredInVDC_( DCM::PIN_NOT_SET ),
-        maneuverButtonPressTime_( (struct timeval){0} ),
         pinEntryLockoutTime_( (struct timeval){0} ),
         pinIncorrectCount_( 0 ),
         pinLockoutLimit_( 0 ),
-        socketHandler_( ),
+        transportType_( AspTransportType::Udp ),
+        aspPort_( UDP_PORT ),
+        transport_( ),
+        aspReceiveTime_( 0 ),
+        aspDecodeTime_( 0 ),
+        maneuverStatusChangeTime_( 0 ),
+        arrivalToDecode_( ),
+        decodeToSend_( ),
         running_( true ),
+        changedSignals_( 0 ),
+        stateVersion_( 1 ),
+        lastAspPacket_( ),
+        dmhInput_( DmhInput{ 0000, 0000, 0000, TCM::ManeuverEnableInput::NoScrnInput, 0000 } ),
+        dmhInputVersion_( 0 ),
+        aspSnapshot_( ),
+        commands_( ),
+        commandOverflow_( false ),
+        latestConnectionApproval_( ),
+        latestDeviceControlMode_( ),
+        latestManeuverButtonPress_( ),
+        latestSelection_( ),
+        commandSignals_( ),
+        buttonPressSentTime_( 0 ),
         engine_off_( false ),
         doors_locked_( false )
 {
 
+    // The encoder starts from the same command signals as the members.
+    commandSignals_.ConnectionApproval = ConnectionApproval;
+    commandSignals_.DeviceControlMode = DeviceControlMode;
+    commandSignals_.ManeuverButtonPress = ManeuverButtonPress;
+    commandSignals_.selection = ManeuverSelection{
+            ManeuverTypeSelect,
+            ManeuverDirectionSelect,
+            ManeuverGearSelect,
+            ManeuverSideSelect,
+            ExploreModeSelect,
+            NudgeSelect };
+    latestConnectionApproval_ = commandSignals_.ConnectionApproval;
+    latestDeviceControlMode_ = commandSignals_.DeviceControlMode;
+    latestManeuverButtonPress_ = commandSignals_.ManeuverButtonPress;
+    latestSelection_.store( commandSignals_.selection );
+
     // Prepopulate structs
     threatDistanceData.ASPMFrontSegDist1RMT = 19;
     threatDistanceData.ASPMFrontSegDist2RMT = 19;
@@ -529,15 +351,26 @@ SignalHandler::SignalHandler( )
         vt_ASPM_lm_session.push_back(std::make_shared <LMSignalInfo>(ASPM_lm_session_t[i]));
     for (int i = 0; (ASPM_LM_Trunc::ID) ASPM_lm_trunc_t[i].index < ASPM_LM_Trunc::MAXSignal ; ++i)
         vt_ASPM_lm_trunc.push_back(std::make_shared <LMSignalInfo>(ASPM_lm_trunc_t[i]));
+
+    aspSnapshot_.store( captureAspSnapshot_( ) );
 }
 
 void SignalHandler::stop( ) {
     running_ = false;
-    socketHandler_.disconnectClient( false );
-    socketHandler_.disconnectServer( );
-    signalLoopHandler_.join( );
-    rangingLoopHandler_.join( );
-    buttonPressLoopHandler_.join( );
+    // Cut every loop's sleep short; closing the transport unblocks a
+    // pending receive.
+    wakeup_.notify( );
+    if( transport_ )
+    {
+        transport_->close( );
+    }
+    // Nothing to join when driven by initiateTicks( ).
+    if( signalLoopHandler_.joinable( ) )
+    {
+        signalLoopHandler_.join( );
+        rangingLoopHandler_.join( );
+    }
+    printLatencyReport( );
 }
 
 SignalHandler::~SignalHandler( ) {}
@@ -547,21 +380,177 @@ std::mutex& SignalHandler::getMutex( )
     return mtx;
 }
 
+void SignalHandler::setTransport( const AspTransportType& type )
+{
+    transportType_ = type;
+}
+
+AspTransportType SignalHandler::getTransportType( ) const
+{
+    return transportType_;
+}
+
+void SignalHandler::setAspPort( const uint16_t& port )
+{
+    aspPort_ = port;
+}
+
+uint16_t SignalHandler::getAspPort( ) const
+{
+    return aspPort_;
+}
+
+int SignalHandler::getEventSocket( )
+{
+    return transport_ ? transport_->getEventSocket( ) : -1;
+}
+
+uint64_t SignalHandler::getSupersededPacketCount( )
+{
+    return transport_ ? transport_->getSupersededCount( ) : 0;
+}
+
+uint64_t SignalHandler::getAspReceiveTime( )
+{
+    return aspReceiveTime_;
+}
+
+uint64_t SignalHandler::getAspDecodeTime( )
+{
+    return aspDecodeTime_;
+}
+
+void SignalHandler::setStateCallback( const std::function< void( ) >& callback )
+{
+    stateCallback_ = callback;
+}
+
+SignalBus& SignalHandler::getSignalBus( )
+{
+    return signalBus_;
+}
+
+uint64_t SignalHandler::getStateVersion( ) const
+{
+    return stateVersion_;
+}
+
+void SignalHandler::markStateChanged( )
+{
+    ++stateVersion_;
+}
+
+AspSnapshot SignalHandler::getAspSnapshot( ) const
+{
+    return aspSnapshot_.load( );
+}
+
+void SignalHandler::publishAspSnapshot( )
+{
+    AspSnapshot previous( aspSnapshot_.load( ) );
+    AspSnapshot snapshot( captureAspSnapshot_( ) );
+    aspSnapshot_.store( snapshot );
+
+    // The DCM signals keep no earlier copy, so they always count as changed.
+    SignalMask changed(
+            signalBit( StatusSignal::AcknowledgeRemotePIN ) |
+            signalBit( StatusSignal::ErrorMsg ) );
+    auto compare = [ &changed ]( const bool& differs, const StatusSignal& id )
+    {
+        if( differs )
+        {
+            changed |= signalBit( id );
+        }
+    };
+    compare( snapshot.ManeuverStatus != previous.ManeuverStatus, StatusSignal::ManeuverStatus );
+    compare( snapshot.NoFeatureAvailableMsg != previous.NoFeatureAvailableMsg, StatusSignal::NoFeatureAvailableMsg );
+    compare( snapshot.CancelMsg != previous.CancelMsg, StatusSignal::CancelMsg );
+    compare( snapshot.PauseMsg1 != previous.PauseMsg1, StatusSignal::PauseMsg1 );
+    compare( snapshot.PauseMsg2 != previous.PauseMsg2, StatusSignal::PauseMsg2 );
+    compare( snapshot.InfoMsg != previous.InfoMsg, StatusSignal::InfoMsg );
+    compare( snapshot.InstructMsg != previous.InstructMsg, StatusSignal::InstructMsg );
+    compare( snapshot.MobileChallengeSend != previous.MobileChallengeSend, StatusSignal::MobileChallengeSend );
+
+    signalBus_.publish( changed );
+}
+
+AspSnapshot SignalHandler::captureAspSnapshot_( ) const
+{
+    AspSnapshot snapshot;
+
+    snapshot.InfoMsg = InfoMsg;
+    snapshot.ActiveAutonomousFeature = ActiveAutonomousFeature;
+    snapshot.ActiveParkingType = ActiveParkingType;
+    snapshot.ActiveParkingMode = ActiveParkingMode;
+    snapshot.ManeuverStatus = ManeuverStatus;
+    snapshot.NoFeatureAvailableMsg = NoFeatureAvailableMsg;
+    snapshot.CancelMsg = CancelMsg;
+    snapshot.PauseMsg1 = PauseMsg1;
+    snapshot.PauseMsg2 = PauseMsg2;
+    snapshot.InstructMsg = InstructMsg;
+    snapshot.ExploreModeAvailability = ExploreModeAvailability;
+    snapshot.RemoteDriveAvailability = RemoteDriveAvailability;
+    snapshot.ManeuverSideAvailability = ManeuverSideAvailability;
+    snapshot.DirectionChangeAvailability = DirectionChangeAvailability;
+    snapshot.ActiveManeuverSide = ActiveManeuverSide;
+    snapshot.ActiveManeuverOrientation = ActiveManeuverOrientation;
+    snapshot.ParkTypeChangeAvailability = ParkTypeChangeAvailability;
+    snapshot.ManeuverDirectionAvailability = ManeuverDirectionAvailability;
+    snapshot.ManeuverAlignmentAvailability = ManeuverAlignmentAvailability;
+    snapshot.ConfirmAvailability = ConfirmAvailability;
+    snapshot.ResumeAvailability = ResumeAvailability;
+    snapshot.ReturnToStartAvailability = ReturnToStartAvailability;
+    snapshot.LongitudinalAdjustAvailability = LongitudinalAdjustAvailability;
+    snapshot.LongitudinalAdjustLength = LongitudinalAdjustLength;
+    snapshot.ManeuverProgressBar = ManeuverProgressBar;
+    snapshot.MobileChallengeSend = MobileChallengeSend;
+
+    // The segment structs are laid out front 1-16, then rear 1-16.
+    static_assert( sizeof( threatDistanceData ) == 2 * ASP_THREAT_SEGMENT_COUNT, "unexpected threat layout" );
+    static_assert( sizeof( threatTypeData ) == 2 * ASP_THREAT_SEGMENT_COUNT, "unexpected threat layout" );
+    const uint8_t* distances( &threatDistanceData.ASPMFrontSegDist1RMT );
+    const uint8_t* types( &threatTypeData.ASPMFrontSegType1RMT );
+    memcpy( snapshot.ASPMFrontSegDistRMT, distances, ASP_THREAT_SEGMENT_COUNT );
+    memcpy( snapshot.ASPMRearSegDistRMT, distances + ASP_THREAT_SEGMENT_COUNT, ASP_THREAT_SEGMENT_COUNT );
+    memcpy( snapshot.ASPMFrontSegTypeRMT, types, ASP_THREAT_SEGMENT_COUNT );
+    memcpy( snapshot.ASPMRearSegTypeRMT, types + ASP_THREAT_SEGMENT_COUNT, ASP_THREAT_SEGMENT_COUNT );
+
+    return snapshot;
+}
+
+void SignalHandler::recordManeuverStatusSent( )
+{
+    decodeToSend_.record( maneuverStatusChangeTime_.exchange( 0 ), LatencyHistogram::now( ) );
+}
+
+LatencyHistogram& SignalHandler::getArrivalToDecodeLatency( )
+{
+    return arrivalToDecode_;
+}
+
+LatencyHistogram& SignalHandler::getDecodeToSendLatency( )
+{
+    return decodeToSend_;
+}
+
+void SignalHandler::printLatencyReport( )
+{
+    arrivalToDecode_.print( "ASP arrival to decode" );
+    decodeToSend_.print( "ManeuverStatus decode to send" );
+}
+
 
 void SignalHandler::initiateEventLoops( )
 {
 
-    // Generate a new UDP socket
-    socketHandler_.connectServer(
-            (int32_t)SOCK_DGRAM,
-            (uint64_t)UDP_ADDR,
-            (uint16_t)UDP_PORT,
-            true );
+    // Open the TCM end of the selected link
+    transport_ = AspTransport::create( transportType_ );
+    transport_->setPort( aspPort_ );
+    transport_->open( true );
 
     // Kick off threads
     signalLoopHandler_ = std::thread( &SignalHandler::updateSignalEventLoop_, this );       // 30ms loop
     rangingLoopHandler_ = std::thread( &SignalHandler::rangingRequestEventLoop_, this );    // dmh-related
-    buttonPressLoopHandler_ = std::thread( &SignalHandler::buttonPressEventLoop_, this );   // maneuver button press rmt - 240ms countdown
 
     // ** FOR LG ** change below to whatever proprietary process needed
     // Set the PIN from value stored in VDC memory after socketHandler connects.
@@ -570,6 +559,84 @@ void SignalHandler::initiateEventLoops( )
 }
 
 
+void SignalHandler::initiateTicks( )
+{
+
+    transport_ = AspTransport::create( transportType_ );
+    transport_->setPort( aspPort_ );
+    transport_->open( true );
+
+    // ** FOR LG ** as in initiateEventLoops( )
+    getPinFromVDC_( );
+
+}
+
+
+void SignalHandler::sendSignals( )
+{
+
+    if( ConnectionApproval == TCM::ConnectionApproval::NoDevice || !transport_ )
+    {
+        return;
+    }
+
+    uint8_t bufferToASP[ UDP_BUF_MAX ];
+    bzero( bufferToASP, UDP_BUF_MAX );
+
+    std::lock_guard<std::mutex> lock( getMutex( ) );
+
+    uint16_t outBufSize = encodeTCMSignalData(bufferToASP);
+    transport_->send( bufferToASP, outBufSize );
+
+    return;
+
+}
+
+
+ssize_t SignalHandler::receiveSignals( )
+{
+
+    if( !transport_ )
+    {
+        return -1;
+    }
+
+    uint8_t bufferToTCM[ UDP_BUF_MAX ];
+    bzero( bufferToTCM, UDP_BUF_MAX );
+
+    std::lock_guard<std::mutex> lock( getMutex( ) );
+
+    ssize_t bytes_received = transport_->pollLatest(
+            bufferToTCM,
+            sizeof(bufferToTCM),
+            ASPM_TOTAL_PACKET_SIZE );
+
+    if( bytes_received < 0 && ( errno == EAGAIN || errno == EWOULDBLOCK ) )
+    {
+        return -1;
+    }
+
+    handleASPMPacket_( bufferToTCM, bytes_received );
+
+    return bytes_received;
+
+}
+
+
+void SignalHandler::updateTimers( )
+{
+
+    if( ConnectionApproval == TCM::ConnectionApproval::AllowedDevice &&
+        (uint32_t)rangingRequestRate_ != 0 )
+    {
+        updateRanging_( );
+    }
+
+    return;
+
+}
+
+
 MANOUEVRE SignalHandler::parseManeuverString( const std::string& maneuver )
 {
     if( maneuver == "OutLftFwd" || maneuver == "OLF" || maneuver == "POLF" )
@@ -642,6 +709,14 @@ MANOUEVRE SignalHandler::parseManeuverString( const std::string& maneuver )
 
 void SignalHandler::setInputManeuverSignals( const MANOUEVRE& maneuver )
 {
+    ManeuverSelection selection{
+            ManeuverTypeSelect,
+            ManeuverDirectionSelect,
+            ManeuverGearSelect,
+            ManeuverSideSelect,
+            ExploreModeSelect,
+            NudgeSelect };
+
     // set shared signals
     switch( maneuver )
     {
@@ -656,28 +731,28 @@ void SignalHandler::setInputManeuverSignals( const MANOUEVRE& maneuver )
         case MANOUEVRE::PILR:
         case MANOUEVRE::PIRR:
         {
-            ExploreModeSelect = TCM::ExploreModeSelect::NotPressed;
-            NudgeSelect = TCM::NudgeSelect::NudgeNotPressed;
+            selection.ExploreModeSelect = TCM::ExploreModeSelect::NotPressed;
+            selection.NudgeSelect = TCM::NudgeSelect::NudgeNotPressed;
             break;
         }
         case MANOUEVRE::NF:
         case MANOUEVRE::NR:
         {
-            ExploreModeSelect = TCM::ExploreModeSelect::NotPressed;
-            NudgeSelect = TCM::NudgeSelect::NudgePressed;
-            ManeuverTypeSelect = TCM::ManeuverTypeSelect::None;
-            ManeuverDirectionSelect = TCM::ManeuverDirectionSelect::None;
-            ManeuverSideSelect = TCM::ManeuverSideSelect::Center;
+            selection.ExploreModeSelect = TCM::ExploreModeSelect::NotPressed;
+            selection.NudgeSelect = TCM::NudgeSelect::NudgePressed;
+            selection.ManeuverTypeSelect = TCM::ManeuverTypeSelect::None;
+            selection.ManeuverDirectionSelect = TCM::ManeuverDirectionSelect::None;
+            selection.ManeuverSideSelect = TCM::ManeuverSideSelect::Center;
             break;
         }
         case MANOUEVRE::SF:
         case MANOUEVRE::SR:
         {
-            ExploreModeSelect = TCM::ExploreModeSelect::Pressed;
-            NudgeSelect = TCM::NudgeSelect::NudgeNotPressed;
-            ManeuverTypeSelect = TCM::ManeuverTypeSelect::None;
-            ManeuverDirectionSelect = TCM::ManeuverDirectionSelect::None;
-            ManeuverSideSelect = TCM::ManeuverSideSelect::Center;
+            selection.ExploreModeSelect = TCM::ExploreModeSelect::Pressed;
+            selection.NudgeSelect = TCM::NudgeSelect::NudgeNotPressed;
+            selection.ManeuverTypeSelect = TCM::ManeuverTypeSelect::None;
+            selection.ManeuverDirectionSelect = TCM::ManeuverDirectionSelect::None;
+            selection.ManeuverSideSelect = TCM::ManeuverSideSelect::Center;
             break;
         }
         case MANOUEVRE::RTS:
@@ -694,95 +769,95 @@ void SignalHandler::setInputManeuverSignals( const MANOUEVRE& maneuver )
     {
         case MANOUEVRE::POLF:
         {
-            ManeuverTypeSelect = TCM::ManeuverTypeSelect::Perpendicular;
-            ManeuverDirectionSelect = TCM::ManeuverDirectionSelect::NoseFirst;
-            ManeuverGearSelect = TCM::ManeuverGearSelect::Forward;
-            ManeuverSideSelect = TCM::ManeuverSideSelect::Left;
-            return;
+            selection.ManeuverTypeSelect = TCM::ManeuverTypeSelect::Perpendicular;
+            selection.ManeuverDirectionSelect = TCM::ManeuverDirectionSelect::NoseFirst;
+            selection.ManeuverGearSelect = TCM::ManeuverGearSelect::Forward;
+            selection.ManeuverSideSelect = TCM::ManeuverSideSelect::Left;
+            break;
         }
         case MANOUEVRE::PORF:
         {
-            ManeuverTypeSelect = TCM::ManeuverTypeSelect::Perpendicular;
-            ManeuverDirectionSelect = TCM::ManeuverDirectionSelect::NoseFirst;
-            ManeuverGearSelect = TCM::ManeuverGearSelect::Forward;
-            ManeuverSideSelect = TCM::ManeuverSideSelect::Right;
-            return;
+            selection.ManeuverTypeSelect = TCM::ManeuverTypeSelect::Perpendicular;
+            selection.ManeuverDirectionSelect = TCM::ManeuverDirectionSelect::NoseFirst;
+            selection.ManeuverGearSelect = TCM::ManeuverGearSelect::Forward;
+            selection.ManeuverSideSelect = TCM::ManeuverSideSelect::Right;
+            break;
         }
         case MANOUEVRE::POLR:
         {
-            ManeuverTypeSelect = TCM::ManeuverTypeSelect::Perpendicular;
-            ManeuverDirectionSelect = TCM::ManeuverDirectionSelect::RearFirst;
-            ManeuverGearSelect = TCM::ManeuverGearSelect::Reverse;
-            ManeuverSideSelect = TCM::ManeuverSideSelect::Left;
-            return;
+            selection.ManeuverTypeSelect = TCM::ManeuverTypeSelect::Perpendicular;
+            selection.ManeuverDirectionSelect = TCM::ManeuverDirectionSelect::RearFirst;
+            selection.ManeuverGearSelect = TCM::ManeuverGearSelect::Reverse;
+            selection.ManeuverSideSelect = TCM::ManeuverSideSelect::Left;
+            break;
         }
         case MANOUEVRE::PORR:
         {
-            ManeuverTypeSelect = TCM::ManeuverTypeSelect::Perpendicular;
-            ManeuverDirectionSelect = TCM::ManeuverDirectionSelect::RearFirst;
-            ManeuverGearSelect = TCM::ManeuverGearSelect::Reverse;
-            ManeuverSideSelect = TCM::ManeuverSideSelect::Right;
-            return;
+            selection.ManeuverTypeSelect = TCM::ManeuverTypeSelect::Perpendicular;
+            selection.ManeuverDirectionSelect = TCM::ManeuverDirectionSelect::RearFirst;
+            selection.ManeuverGearSelect = TCM::ManeuverGearSelect::Reverse;
+            selection.ManeuverSideSelect = TCM::ManeuverSideSelect::Right;
+            break;
         }
         case MANOUEVRE::POLP:
         {
-            ManeuverTypeSelect = TCM::ManeuverTypeSelect::Parallel;
-            ManeuverDirectionSelect = TCM::ManeuverDirectionSelect::None;
-            ManeuverGearSelect = TCM::ManeuverGearSelect::Forward;
-            ManeuverSideSelect = TCM::ManeuverSideSelect::Left;
-            return;
+            selection.ManeuverTypeSelect = TCM::ManeuverTypeSelect::Parallel;
+            selection.ManeuverDirectionSelect = TCM::ManeuverDirectionSelect::None;
+            selection.ManeuverGearSelect = TCM::ManeuverGearSelect::Forward;
+            selection.ManeuverSideSelect = TCM::ManeuverSideSelect::Left;
+            break;
         }
         case MANOUEVRE::PORP:
         {
-            ManeuverTypeSelect = TCM::ManeuverTypeSelect::Parallel;
-            ManeuverDirectionSelect = TCM::ManeuverDirectionSelect::None;
-            ManeuverGearSelect = TCM::ManeuverGearSelect::Forward;
-            ManeuverSideSelect = TCM::ManeuverSideSelect::Right;
-            return;
+            selection.ManeuverTypeSelect = TCM::ManeuverTypeSelect::Parallel;
+            selection.ManeuverDirectionSelect = TCM::ManeuverDirectionSelect::None;
+            selection.ManeuverGearSelect = TCM::ManeuverGearSelect::Forward;
+            selection.ManeuverSideSelect = TCM::ManeuverSideSelect::Right;
+            break;
         }
         case MANOUEVRE::PILF:
         {
-            ManeuverTypeSelect = TCM::ManeuverTypeSelect::Perpendicular;
-            ManeuverDirectionSelect = TCM::ManeuverDirectionSelect::NoseFirst;
-            ManeuverGearSelect = TCM::ManeuverGearSelect::Forward;
-            ManeuverSideSelect = TCM::ManeuverSideSelect::Left;
-            return;
+            selection.ManeuverTypeSelect = TCM::ManeuverTypeSelect::Perpendicular;
+            selection.ManeuverDirectionSelect = TCM::ManeuverDirectionSelect::NoseFirst;
+            selection.ManeuverGearSelect = TCM::ManeuverGearSelect::Forward;
+            selection.ManeuverSideSelect = TCM::ManeuverSideSelect::Left;
+            break;
         }
         case MANOUEVRE::PIRF:
         {
-            ManeuverTypeSelect = TCM::ManeuverTypeSelect::Perpendicular;
-            ManeuverDirectionSelect = TCM::ManeuverDirectionSelect::NoseFirst;
-            ManeuverGearSelect = TCM::ManeuverGearSelect::Forward;
-            ManeuverSideSelect = TCM::ManeuverSideSelect::Right;
-            return;
+            selection.ManeuverTypeSelect = TCM::ManeuverTypeSelect::Perpendicular;
+            selection.ManeuverDirectionSelect = TCM::ManeuverDirectionSelect::NoseFirst;
+            selection.ManeuverGearSelect = TCM::ManeuverGearSelect::Forward;
+            selection.ManeuverSideSelect = TCM::ManeuverSideSelect::Right;
+            break;
         }
         case MANOUEVRE::PILR:
         {
-            ManeuverTypeSelect = TCM::ManeuverTypeSelect::Perpendicular;
-            ManeuverDirectionSelect = TCM::ManeuverDirectionSelect::RearFirst;
-            ManeuverGearSelect = TCM::ManeuverGearSelect::Reverse;
-            ManeuverSideSelect = TCM::ManeuverSideSelect::Left;
-            return;
+            selection.ManeuverTypeSelect = TCM::ManeuverTypeSelect::Perpendicular;
+            selection.ManeuverDirectionSelect = TCM::ManeuverDirectionSelect::RearFirst;
+            selection.ManeuverGearSelect = TCM::ManeuverGearSelect::Reverse;
+            selection.ManeuverSideSelect = TCM::ManeuverSideSelect::Left;
+            break;
         }
         case MANOUEVRE::PIRR:
         {
-            ManeuverTypeSelect = TCM::ManeuverTypeSelect::Perpendicular;
-            ManeuverDirectionSelect = TCM::ManeuverDirectionSelect::RearFirst;
-            ManeuverGearSelect = TCM::ManeuverGearSelect::Reverse;
-            ManeuverSideSelect = TCM::ManeuverSideSelect::Right;
-            return;
+            selection.ManeuverTypeSelect = TCM::ManeuverTypeSelect::Perpendicular;
+            selection.ManeuverDirectionSelect = TCM::ManeuverDirectionSelect::RearFirst;
+            selection.ManeuverGearSelect = TCM::ManeuverGearSelect::Reverse;
+            selection.ManeuverSideSelect = TCM::ManeuverSideSelect::Right;
+            break;
         }
         case MANOUEVRE::NF:
         case MANOUEVRE::SF:
         {
-            ManeuverGearSelect = TCM::ManeuverGearSelect::Forward;
-            return;
+            selection.ManeuverGearSelect = TCM::ManeuverGearSelect::Forward;
+            break;
         }
         case MANOUEVRE::NR:
         case MANOUEVRE::SR:
         {
-            ManeuverGearSelect = TCM::ManeuverGearSelect::Reverse;
-            return;
+            selection.ManeuverGearSelect = TCM::ManeuverGearSelect::Reverse;
+            break;
         }
         case MANOUEVRE::RTS:
         case MANOUEVRE::NADA:
@@ -793,6 +868,27 @@ void SignalHandler::setInputManeuverSignals( const MANOUEVRE& maneuver )
         }
     }
 
+    setManeuverSelection( selection );
+
+}
+
+
+void SignalHandler::setManeuverSelection( const ManeuverSelection& selection )
+{
+
+    ManeuverTypeSelect = selection.ManeuverTypeSelect;
+    ManeuverDirectionSelect = selection.ManeuverDirectionSelect;
+    ManeuverGearSelect = selection.ManeuverGearSelect;
+    ManeuverSideSelect = selection.ManeuverSideSelect;
+    ExploreModeSelect = selection.ExploreModeSelect;
+    NudgeSelect = selection.NudgeSelect;
+
+    TcmCommand command;
+    command.type = TcmCommand::Type::ManeuverSelection;
+    command.value = 0;
+    command.selection = selection;
+    queueCommand_( command );
+
 }
 
 
@@ -803,6 +899,11 @@ void SignalHandler::setDeviceControlMode( const TCM::DeviceControlMode& mode )
     // should likewise be updated.
     DeviceControlMode = mode;
 
+    TcmCommand command;
+    command.type = TcmCommand::Type::DeviceControlMode;
+    command.value = (uint8_t)mode;
+    queueCommand_( command );
+
 }
 
 
@@ -811,10 +912,14 @@ void SignalHandler::setManeuverButtonPress( const TCM::ManeuverButtonPress& mode
 
     // **For LG** any time a member variable is updated, the corresponding ASP
     // should likewise be updated.
+    // The press goes back to 'None' on the wire after 240ms; see
+    // applyCommands_( ).
     ManeuverButtonPress = mode;
 
-    // Threading: after 240ms, this value should reset to 'None'
-    gettimeofday( &maneuverButtonPressTime_, NULL );
+    TcmCommand command;
+    command.type = TcmCommand::Type::ManeuverButtonPress;
+    command.value = (uint8_t)mode;
+    queueCommand_( command );
 
 }
 
@@ -823,28 +928,63 @@ void SignalHandler::setManeuverEnableInput(
         const uint16_t& xCoord,
         const uint16_t& yCoord,
         const int64_t& gesturePercent,
-        const bool& validGesture )
+        const bool& validGesture,
+        const TCM::AppCalcCheck& crc )
 {
 
     // **For LG** any time a member variable is updated, the corresponding ASP
     // should likewise be updated.
-    AppSliderPosX = xCoord;
-    AppSliderPosY = yCoord;
-    AppAccelerationZ = gesturePercent;
+    DmhInput input;
+    input.AppSliderPosX = xCoord;
+    input.AppSliderPosY = yCoord;
+    input.AppAccelerationZ = gesturePercent;
+    input.AppCalcCheck = crc;
 
     if( validGesture == true )
     {
-        ManeuverEnableInput = TCM::ManeuverEnableInput::ValidScrnInput;
+        input.ManeuverEnableInput = TCM::ManeuverEnableInput::ValidScrnInput;
     }
     else
     {
-        ManeuverEnableInput = TCM::ManeuverEnableInput::NoScrnInput;
+        input.ManeuverEnableInput = TCM::ManeuverEnableInput::NoScrnInput;
     }
 
+    setDmhInput( input );
+
+}
+
+
+void SignalHandler::setDmhInput( const DmhInput& input )
+{
+    dmhInput_.store( input );
+}
+
+
+DmhInput SignalHandler::getDmhInput( ) const
+{
+    return dmhInput_.load( );
 }
 
 
 void SignalHandler::setInControlRemotePin( const std::string& pin )
+{
+
+    DCM::AcknowledgeRemotePIN previous( AcknowledgeRemotePIN );
+
+    checkRemotePin_( pin );
+
+    // After the check, so a response built at the new version shows its result.
+    markStateChanged( );
+
+    if( AcknowledgeRemotePIN != previous )
+    {
+        signalBus_.publish( signalBit( StatusSignal::AcknowledgeRemotePIN ) );
+    }
+
+}
+
+
+void SignalHandler::checkRemotePin_( const std::string& pin )
 {
     // **For LG** any time a member variable is updated, the corresponding DCM
     // process should likewise be executed and appropriate signals updated.
@@ -973,6 +1113,11 @@ void SignalHandler::setConnectionApproval( const TCM::ConnectionApproval& mode )
     // compatible device, which does not hold true for production app.
     ConnectionApproval = mode;
     // std::cout << "ConnectionApproval: " << (int)ConnectionApproval << std::endl;
+
+    TcmCommand command;
+    command.type = TcmCommand::Type::ConnectionApproval;
+    command.value = (uint8_t)mode;
+    queueCommand_( command );
 }
 
 
@@ -986,6 +1131,7 @@ void SignalHandler::setCabinCommands( bool engine_off, bool doors_locked )
 {
     engine_off_ = engine_off;
     doors_locked_ = doors_locked;
+    markStateChanged( );
 }
 
 bool SignalHandler::getEngineOff( ) const
@@ -1000,11 +1146,17 @@ bool SignalHandler::getDoorsLocked( ) const
 
 std::string SignalHandler::getManeuverFromASP( )
 {
-    if( ActiveParkingType == ASP::ActiveParkingType::PushPull )
+    return getManeuverFromASP( captureAspSnapshot_( ) );
+}
+
+
+std::string SignalHandler::getManeuverFromASP( const AspSnapshot& snapshot )
+{
+    if( snapshot.ActiveParkingType == ASP::ActiveParkingType::PushPull )
     {
 
         // Check parallel, perpendicular rear or front
-        switch( ActiveManeuverOrientation )
+        switch( snapshot.ActiveManeuverOrientation )
         {
 
             // int value of 0 --> ** UNKNOWN **
@@ -1030,17 +1182,17 @@ std::string SignalHandler::getManeuverFromASP( )
             default:                                    break;
         }
     }
-    else if( ActiveParkingType == ASP::ActiveParkingType::Remote )
+    else if( snapshot.ActiveParkingType == ASP::ActiveParkingType::Remote )
     {
-        switch( ActiveParkingMode )
+        switch( snapshot.ActiveParkingMode )
         {
             case ASP::ActiveParkingMode::ParkIn:
             {
-                switch ( ActiveManeuverOrientation )
+                switch ( snapshot.ActiveManeuverOrientation )
                 {
                     case ASP::ActiveManeuverOrientation::PerpendicularFront:
                     {
-                        switch ( ActiveManeuverSide )
+                        switch ( snapshot.ActiveManeuverSide )
                         {
                             case ASP::ActiveManeuverSide::Left:
                             {
@@ -1056,7 +1208,7 @@ std::string SignalHandler::getManeuverFromASP( )
                     }
                     case ASP::ActiveManeuverOrientation::PerpendicularRear:
                     {
-                        switch ( ActiveManeuverSide )
+                        switch ( snapshot.ActiveManeuverSide )
                         {
                             case ASP::ActiveManeuverSide::Left:
                             {
@@ -1076,11 +1228,11 @@ std::string SignalHandler::getManeuverFromASP( )
             }
             case ASP::ActiveParkingMode::ParkOut:
             {
-                switch ( ActiveManeuverOrientation )
+                switch ( snapshot.ActiveManeuverOrientation )
                 {
                     case ASP::ActiveManeuverOrientation::Parallel:
                     {
-                        switch ( ActiveManeuverSide )
+                        switch ( snapshot.ActiveManeuverSide )
                         {
                             case ASP::ActiveManeuverSide::Left:
                             {
@@ -1096,7 +1248,7 @@ std::string SignalHandler::getManeuverFromASP( )
                     }
                     case ASP::ActiveManeuverOrientation::PerpendicularFront:
                     {
-                        switch ( ActiveManeuverSide )
+                        switch ( snapshot.ActiveManeuverSide )
                         {
                             case ASP::ActiveManeuverSide::Left:
                             {
@@ -1112,7 +1264,7 @@ std::string SignalHandler::getManeuverFromASP( )
                     }
                     case ASP::ActiveManeuverOrientation::PerpendicularRear:
                     {
-                        switch ( ActiveManeuverSide )
+                        switch ( snapshot.ActiveManeuverSide )
                         {
                             case ASP::ActiveManeuverSide::Left:
                             {
@@ -1133,9 +1285,9 @@ std::string SignalHandler::getManeuverFromASP( )
             default: break;
         }
     }
-    else if (ActiveParkingType == ASP::ActiveParkingType::LongitudinalAssist)
+    else if (snapshot.ActiveParkingType == ASP::ActiveParkingType::LongitudinalAssist)
     {
-        switch ( ActiveManeuverOrientation )
+        switch ( snapshot.ActiveManeuverOrientation )
         {
             case ASP::ActiveManeuverOrientation::PerpendicularFront:
             {
@@ -1313,17 +1465,7 @@ void SignalHandler::rangingRequestEventLoop_( )
         while(  ConnectionApproval == TCM::ConnectionApproval::AllowedDevice &&
                 (uint32_t)rangingRequestRate_ != 0 && running_.load( ) )
         {
-            // update rangingRequestRate_ to DeadmanRate if maneuver is underway
-            if(     ManeuverStatus == ASP::ManeuverStatus::Confirming ||
-                    ManeuverStatus == ASP::ManeuverStatus::Maneuvering )
-            {
-                setFobRangeRequestRate( DCM::FobRangeRequestRate::DeadmanRate );
-                hasVehicleMoved = true;
-            }
-            else
-            {
-                setFobRangeRequestRate( DCM::FobRangeRequestRate::DefaultRate );
-            }
+            updateRanging_( );
 
             // // Leave below for ranging debugging.
             // float showRate( (unsigned int)rangingRequestRate_ );
@@ -1336,17 +1478,13 @@ void SignalHandler::rangingRequestEventLoop_( )
             // std::cout << std::fixed << std::setprecision( 2 ) << showRate;
             // std::cout << " seconds." << std::endl;
 
-            /*
-            *   ** FOR LG ** Insert request to check Key Fob Range here
-            */
-
-            usleep( (uint32_t)rangingRequestRate_ );
+            wakeup_.waitFor( (uint32_t)rangingRequestRate_ );
 
         }
 
         // To prevent memory leakage, if the FobRangeRequestRate is currently
         // None (0), put the loop to sleep at the highest frequency.
-        usleep( (uint32_t)DCM::FobRangeRequestRate::DeadmanRate );
+        wakeup_.waitFor( (uint32_t)DCM::FobRangeRequestRate::DeadmanRate );
 
     }
 
@@ -1354,36 +1492,148 @@ void SignalHandler::rangingRequestEventLoop_( )
 }
 
 
-void SignalHandler::buttonPressEventLoop_( )
+void SignalHandler::updateRanging_( )
 {
 
-    while( running_.load( ) )
+    // update rangingRequestRate_ to DeadmanRate if maneuver is underway
+    if(     ManeuverStatus == ASP::ManeuverStatus::Confirming ||
+            ManeuverStatus == ASP::ManeuverStatus::Maneuvering )
     {
-        usleep( ASP_REFRESH_RATE );
+        setFobRangeRequestRate( DCM::FobRangeRequestRate::DeadmanRate );
 
-        if( ManeuverButtonPress == TCM::ManeuverButtonPress::None )
+        if( hasVehicleMoved == false )
         {
-            // do nothing, we only need to check when not "None"
-            continue;
+            hasVehicleMoved = true;
+            markStateChanged( );
         }
+    }
+    else
+    {
+        setFobRangeRequestRate( DCM::FobRangeRequestRate::DefaultRate );
+    }
+
+    /*
+    *   ** FOR LG ** Insert request to check Key Fob Range here
+    */
+
+    return;
 
-        if( isTimevalZero( maneuverButtonPressTime_ ) )
+}
+
+
+void SignalHandler::queueCommand_( const TcmCommand& command )
+{
+
+    // Recorded first, so an overflow seen by the encoder covers this command.
+    switch( command.type )
+    {
+        case TcmCommand::Type::ConnectionApproval:
         {
-            // if not initialized, reset the button press time
-            gettimeofday( &maneuverButtonPressTime_, NULL );
-            continue;
+            latestConnectionApproval_ = (TCM::ConnectionApproval)command.value;
+            break;
+        }
+        case TcmCommand::Type::DeviceControlMode:
+        {
+            latestDeviceControlMode_ = (TCM::DeviceControlMode)command.value;
+            break;
+        }
+        case TcmCommand::Type::ManeuverButtonPress:
+        {
+            latestManeuverButtonPress_ = (TCM::ManeuverButtonPress)command.value;
+            break;
+        }
+        case TcmCommand::Type::ManeuverSelection:
+        {
+            latestSelection_.store( command.selection );
+            break;
+        }
+    }
+
+    if( commands_.push( command ) == false )
+    {
+        commandOverflow_ = true;
+    }
+
+}
+
+
+void SignalHandler::applyCommands_( )
+{
+
+    uint64_t now( LatencyHistogram::now( ) );
+
+    if(     commandSignals_.ManeuverButtonPress != TCM::ManeuverButtonPress::None
+            && now - buttonPressSentTime_ >= (uint64_t)BUTTON_TIMEOUT_RATE * 1000 )
+    {
+        commandSignals_.ManeuverButtonPress = TCM::ManeuverButtonPress::None;
+    }
+
+    // One bit per TcmCommand::Type set during this pass.
+    uint32_t applied( 0 );
+
+    for( const TcmCommand* command( commands_.front( ) );
+         command != nullptr;
+         command = commands_.front( ) )
+    {
+        uint32_t signal( 1u << (uint32_t)command->type );
+
+        if( ( applied & signal ) != 0 )
+        {
+            break;
+        }
+        applied |= signal;
+
+        switch( command->type )
+        {
+            case TcmCommand::Type::ConnectionApproval:
+            {
+                commandSignals_.ConnectionApproval = (TCM::ConnectionApproval)command->value;
+                break;
+            }
+            case TcmCommand::Type::DeviceControlMode:
+            {
+                commandSignals_.DeviceControlMode = (TCM::DeviceControlMode)command->value;
+                break;
+            }
+            case TcmCommand::Type::ManeuverButtonPress:
+            {
+                commandSignals_.ManeuverButtonPress = (TCM::ManeuverButtonPress)command->value;
+                buttonPressSentTime_ = now;
+                break;
+            }
+            case TcmCommand::Type::ManeuverSelection:
+            {
+                commandSignals_.selection = command->selection;
+                break;
+            }
         }
 
-        if( checkTimeout( maneuverButtonPressTime_, BUTTON_TIMEOUT_RATE ) )
+        commands_.pop( );
+    }
+
+    // Lost commands leave order unknown; drop the older ones still queued, so
+    // they cannot replace the resync later, and catch up with the latest
+    // values.  queueCommand_( ) records those before pushing, so any command
+    // dropped here is already covered.
+    if( commandOverflow_.exchange( false ) )
+    {
+        std::cout << "---" << std::endl;
+        std::cout << "TCM command queue overflowed; resending current signals." << std::endl;
+
+        while( commands_.front( ) != nullptr )
         {
-            // if timeout, reset button to none and clear time holder.
-            ManeuverButtonPress = TCM::ManeuverButtonPress::None;
-            maneuverButtonPressTime_ = (struct timeval){0};
+            commands_.pop( );
         }
 
+        commandSignals_.ConnectionApproval = latestConnectionApproval_;
+        commandSignals_.DeviceControlMode = latestDeviceControlMode_;
+        commandSignals_.ManeuverButtonPress = latestManeuverButtonPress_;
+        latestSelection_.load( commandSignals_.selection );
+        buttonPressSentTime_ = now;
     }
 
     return;
+
 }
 
 
@@ -1411,9 +1661,15 @@ void SignalHandler::updateSignalEventLoop_( )
             // convert from integer to bit
             uint16_t outBufSize = encodeTCMSignalData(bufferToASP);
 
-            int sentLen = (int)socketHandler_.sendUDP(
+            // Send and await the reply in one step; a single syscall for UDP
+            // when built with USE_IO_URING.  Replies that queued up during a
+            // stall are skipped in favour of the newest one.
+            ssize_t bytes_received = transport_->exchange(
                     bufferToASP,
-                    outBufSize );
+                    outBufSize,
+                    bufferToTCM,
+                    sizeof(bufferToTCM),
+                    ASPM_TOTAL_PACKET_SIZE );
 
             // // leave per commonly-used state debugging statements.
             // std::cout << "---" << std::endl << "Message sent.\t";
@@ -1422,26 +1678,14 @@ void SignalHandler::updateSignalEventLoop_( )
             // std::cout << std::endl;
 
             // Print sent message
-            // printf( "** %i-Bytes of UDP data sent **\n", sentLen );
-            // for( int k = 0; k < sentLen; ) {
+            // printf( "** %i-Bytes of UDP data sent **\n", outBufSize );
+            // for( int k = 0; k < outBufSize; ) {
             //     printf( "%02X ", bufferToASP[k] );
             //     if(++k%20==0) printf("\n");
             // }
             // printf( "\n\n" );
 
-            ssize_t bytes_received = socketHandler_.receiveUDP(
-                    bufferToTCM,
-                    sizeof(bufferToTCM) );
-
-            if (bytes_received == ASPM_TOTAL_PACKET_SIZE) {
-                decodeASPMSignalData(bufferToTCM);
-            }
-            else if (bytes_received == 0) {
-                std::cout << "Socket disconnected" << std::endl;
-            }
-            else {
-                std::cout << "ERROR: received malformed UDP packet of length " << bytes_received << std::endl;
-            }
+            handleASPMPacket_( bufferToTCM, bytes_received );
 
             // leave per commonly-used state debugging statements.
             // std::cout << "---" << std::endl << "ManeuverStatus: " << (int)ManeuverStatus;
@@ -1452,17 +1696,57 @@ void SignalHandler::updateSignalEventLoop_( )
         }
             // reset the DMH input so that it can timeout on the ASP side.
             // ManeuverEnableInput = TCM::ManeuverEnableInput::NoScrnInput;
-            usleep( ASP_REFRESH_RATE );
+            wakeup_.waitFor( ASP_REFRESH_RATE );
         }
 
         // To prevent memory leakage, go to sleep
-        usleep( ASP_REFRESH_RATE );
+        wakeup_.waitFor( ASP_REFRESH_RATE );
 
     }
 
     return;
 }
 
+void SignalHandler::handleASPMPacket_( uint8_t* buffer, const ssize_t& bytes )
+{
+    if (bytes == ASPM_TOTAL_PACKET_SIZE) {
+        ASP::ManeuverStatus previousStatus = ManeuverStatus;
+        decodeASPMSignalData(buffer);
+
+        // Age of the ASP state once decoded, from its kernel arrival.
+        uint64_t decoded = LatencyHistogram::now( );
+        aspReceiveTime_ = transport_->getLastReceiveTime( );
+        aspDecodeTime_ = decoded;
+        arrivalToDecode_.record( aspReceiveTime_, decoded );
+
+        if (ManeuverStatus != previousStatus) {
+            maneuverStatusChangeTime_ = decoded;
+        }
+
+        // Repeats of the last packet leave cached responses valid.
+        if (memcmp(lastAspPacket_, buffer, ASPM_TOTAL_PACKET_SIZE) != 0) {
+            memcpy(lastAspPacket_, buffer, ASPM_TOTAL_PACKET_SIZE);
+            markStateChanged( );
+        }
+
+        // Once per packet, after the bookkeeping above, so subscribers see it.
+        if (changedSignals_ != 0) {
+            signalBus_.publish( changedSignals_ );
+            changedSignals_ = 0;
+        }
+
+        if (stateCallback_) {
+            stateCallback_( );
+        }
+    }
+    else if (bytes == 0) {
+        std::cout << "Socket disconnected" << std::endl;
+    }
+    else {
+        std::cout << "ERROR: received malformed UDP packet of length " << bytes << std::endl;
+    }
+}
+
 uint64_t SignalHandler::getTCMSignal( uint8_t header_id, const uint16_t& sigid )
 {
     // // leave for LG debugging.
@@ -1476,23 +1760,23 @@ uint64_t SignalHandler::getTCMSignal( uint8_t header_id, const uint16_t& sigid )
             case TCM_LM::AppCalcCheck:           return (uint64_t)AppCalcCheck;  //length:16bits
             case TCM_LM::LMDviceAliveCntRMT:        return 0x0;  //length:4bits
             case TCM_LM::ManeuverEnableInput:       return (uint64_t)ManeuverEnableInput; //length:2bits
-            case TCM_LM::ManeuverGearSelect:       return (uint64_t)ManeuverGearSelect; //length:2bits
-            case TCM_LM::NudgeSelect:            return (uint64_t)NudgeSelect;  //length:2bits
+            case TCM_LM::ManeuverGearSelect:       return (uint64_t)commandSignals_.selection.ManeuverGearSelect; //length:2bits
+            case TCM_LM::NudgeSelect:            return (uint64_t)commandSignals_.selection.NudgeSelect;  //length:2bits
             case TCM_LM::RCDOvrrdReqRMT:            return 0x0;  //length:2bits
             case TCM_LM::AppSliderPosY:            return (uint64_t)AppSliderPosY; //length:12bits
             case TCM_LM::AppSliderPosX:            return (uint64_t)AppSliderPosX; //length:11bits
             case TCM_LM::RCDSpeedChngReqRMT:        return 0x00;   //length:6bits
             case TCM_LM::RCDSteWhlChngReqRMT:       return 0x000;  //length:10bits
             //11===============================
-            case TCM_LM::ConnectionApproval:         return (uint64_t)ConnectionApproval;  //length:2bits
-            case TCM_LM::ManeuverButtonPress:      return (uint64_t)ManeuverButtonPress;
-            case TCM_LM::DeviceControlMode:        return (uint64_t)DeviceControlMode;
-            case TCM_LM::ManeuverTypeSelect:     return (uint64_t)ManeuverTypeSelect;
-            case TCM_LM::ManeuverDirectionSelect:       return (uint64_t)ManeuverDirectionSelect;
-            case TCM_LM::ExploreModeSelect:     return (uint64_t)ExploreModeSelect;
+            case TCM_LM::ConnectionApproval:         return (uint64_t)commandSignals_.ConnectionApproval;  //length:2bits
+            case TCM_LM::ManeuverButtonPress:      return (uint64_t)commandSignals_.ManeuverButtonPress;
+            case TCM_LM::DeviceControlMode:        return (uint64_t)commandSignals_.DeviceControlMode;
+            case TCM_LM::ManeuverTypeSelect:     return (uint64_t)commandSignals_.selection.ManeuverTypeSelect;
+            case TCM_LM::ManeuverDirectionSelect:       return (uint64_t)commandSignals_.selection.ManeuverDirectionSelect;
+            case TCM_LM::ExploreModeSelect:     return (uint64_t)commandSignals_.selection.ExploreModeSelect;
             case TCM_LM::RemoteDeviceBatteryLevel:       return (uint64_t)RemoteDeviceBatteryLevel;   //length:7bits
             case TCM_LM::PairedWKeyId:              return 0x00;  //length:8bits
-            case TCM_LM::ManeuverSideSelect:          return (uint64_t)ManeuverSideSelect;
+            case TCM_LM::ManeuverSideSelect:          return (uint64_t)commandSignals_.selection.ManeuverSideSelect;
             case TCM_LM::LMDviceRngeDistRMT:        return 0x00;  //length:10bits
             //21 ============================
             case TCM_LM::TTTTTTTTTT:                return 0x0;  //length:4bits, garbage value
@@ -1625,7 +1909,7 @@ void SignalHandler::setASPSignal(uint8_t header_id, const int16_t& sigid, uint64
             case ASPM_LM::ParkTypeChangeAvailability:    ParkTypeChangeAvailability = (ASP::ParkTypeChangeAvailability)value;      return;
             case ASPM_LM::ExploreModeAvailability:    ExploreModeAvailability = (ASP::ExploreModeAvailability)value;      return;
             case ASPM_LM::ActiveManeuverSide:                ActiveManeuverSide = (ASP::ActiveManeuverSide)value;                              return;
-            case ASPM_LM::ManeuverStatus:              ManeuverStatus = (ASP::ManeuverStatus)value;                          return;
+            case ASPM_LM::ManeuverStatus:              updateSignal_( ManeuverStatus, (ASP::ManeuverStatus)value, StatusSignal::ManeuverStatus ); return;
             case ASPM_LM::RemoteDriveOverrideState:         return;
             case ASPM_LM::ActiveParkingType:         ActiveParkingType = (ASP::ActiveParkingType)value;                return;
             case ASPM_LM::ResumeAvailability:          ResumeAvailability = (ASP::ResumeAvailability)value;
@@ -1634,7 +1918,7 @@ void SignalHandler::setASPSignal(uint8_t header_id, const int16_t& sigid, uint64
             case ASPM_LM::KeyFobRange:         return;
             case ASPM_LM::LMDviceAliveCntAckRMT:    return;
             //21===============================
-            case ASPM_LM::NoFeatureAvailableMsg:     NoFeatureAvailableMsg = (ASP::NoFeatureAvailableMsg)value;        return;
+            case ASPM_LM::NoFeatureAvailableMsg:     updateSignal_( NoFeatureAvailableMsg, (ASP::NoFeatureAvailableMsg)value, StatusSignal::NoFeatureAvailableMsg ); return;
             case ASPM_LM::LMFrwdCollSnsType1RMT:    return;
             case ASPM_LM::LMFrwdCollSnsType2RMT:    return;
             case ASPM_LM::LMFrwdCollSnsType3RMT:    return;
@@ -1643,16 +1927,16 @@ void SignalHandler::setASPSignal(uint8_t header_id, const int16_t& sigid, uint64
             case ASPM_LM::LMFrwdCollSnsZone2RMT:    return;
             case ASPM_LM::LMFrwdCollSnsZone3RMT:    return;
             case ASPM_LM::LMFrwdCollSnsZone4RMT:    return;
-            case ASPM_LM::InfoMsg:            InfoMsg = (ASP::InfoMsg)value;                      return;
+            case ASPM_LM::InfoMsg:            updateSignal_( InfoMsg, (ASP::InfoMsg)value, StatusSignal::InfoMsg ); return;
             //31===============================
-            case ASPM_LM::InstructMsg:        InstructMsg = (ASP::InstructMsg)value;              return;
+            case ASPM_LM::InstructMsg:        updateSignal_( InstructMsg, (ASP::InstructMsg)value, StatusSignal::InstructMsg ); return;
             case ASPM_LM::LateralControlInfo:        return;
             case ASPM_LM::LongitudinalAdjustLength:    LongitudinalAdjustLength = (ASP::LongitudinalAdjustLength)value;                         return;
             case ASPM_LM::LongitudinalControlInfo:       return;
             case ASPM_LM::ManeuverAlignmentAvailability:       ManeuverAlignmentAvailability = (ASP::ManeuverAlignmentAvailability)value;            return;
             case ASPM_LM::RemoteDriveAvailability:         RemoteDriveAvailability = (ASP::RemoteDriveAvailability)value;                return;
-            case ASPM_LM::PauseMsg2:          PauseMsg2 = (ASP::PauseMsg2)value;                  return;
-            case ASPM_LM::PauseMsg1:           PauseMsg1 = (ASP::PauseMsg1)value;                    return;
+            case ASPM_LM::PauseMsg2:          updateSignal_( PauseMsg2, (ASP::PauseMsg2)value, StatusSignal::PauseMsg2 ); return;
+            case ASPM_LM::PauseMsg1:           updateSignal_( PauseMsg1, (ASP::PauseMsg1)value, StatusSignal::PauseMsg1 ); return;
             case ASPM_LM::LMRearCollSnsType1RMT:    return;
             //41===============================
             case ASPM_LM::LMRearCollSnsType2RMT:    return;
@@ -1663,12 +1947,12 @@ void SignalHandler::setASPSignal(uint8_t header_id, const int16_t& sigid, uint64
             case ASPM_LM::LMRearCollSnsZone3RMT:    return;
             case ASPM_LM::LMRearCollSnsZone4RMT:    return;
             case ASPM_LM::LMRemoteFeatrReadyRMT:    return;
-            case ASPM_LM::CancelMsg:          CancelMsg = (ASP::CancelMsg)value;                  return;
+            case ASPM_LM::CancelMsg:          updateSignal_( CancelMsg, (ASP::CancelMsg)value, StatusSignal::CancelMsg ); return;
             case ASPM_LM::LMVehMaxRmteVLimRMT:      return;
             case ASPM_LM::ManueverPopupDisplay:           return;
             //51===============================
             case ASPM_LM::ManeuverProgressBar:   ManeuverProgressBar = (ASP::ManeuverProgressBar)value;    return;
-            case ASPM_LM::MobileChallengeSend:    MobileChallengeSend = (ASP::MobileChallengeSend)value;      return;
+            case ASPM_LM::MobileChallengeSend:    updateSignal_( MobileChallengeSend, (ASP::MobileChallengeSend)value, StatusSignal::MobileChallengeSend ); return;
             case ASPM_LM::LMRemoteResponseASPM:     return;
             default:
                 printf("receive unknown signal:%d", sigid);
@@ -1785,119 +2069,223 @@ void SignalHandler::setASPSignal(uint8_t header_id, const int16_t& sigid, uint64
     }
 }
 
-uint16_t SignalHandler::encodeTCMSignalData(uint8_t* buffer)
+namespace
 {
-    int8_t ii, jj, kk = 0;
-    uint16_t size_total = 0;
-    uint8_t* curr_packet = buffer;
-    uint8_t length = 0;
-    uint8_t length_new = 0;
-    uint8_t currValue = 0;
-    int8_t loop = 0;
-    int8_t startBit = 0;
-    int8_t remainBits = 0;
 
-    int pdu_header[NUMBER_OF_TCM_PDU] = {HRD_ID_OF_TCM_LM, HRD_ID_OF_TCM_LM_Session, HRD_ID_OF_TCM_RemoteControl, HRD_ID_OF_TCM_TransportKey,
-        HRD_ID_OF_TCM_LM_App, HRD_ID_OF_TCM_LM_KeyID, HRD_ID_OF_TCM_LM_KeyAlpha, HRD_ID_OF_TCM_LM_KeyBeta,  HRD_ID_OF_TCM_LM_KeyGamma };
+/*!
+ * Writes one TCM PDU, header and payload, and returns the view after it.
+ */
+template< typename CODEC, uint32_t HEADER_ID >
+PduView putPdu( PduView pdu, const uint64_t* values )
+{
+    static_assert( CODEC::BYTES == pduPayloadLength( tcmPduType( HEADER_ID ) ), "codec does not match PDU header" );
 
-    memset(buffer, 0x00, UDP_BUF_MAX);
+    if( pdu.putHeader( HEADER_ID, CODEC::BYTES ) )
+    {
+        CODEC::encode( values, pdu.getPayload( ) );
+    }
 
-    for (kk = 0; kk<NUMBER_OF_TCM_PDU ; ++kk) {
-        uint16_t index = 0;
+    return pdu.next( );
+}
 
-        //printf("=> curr_packet addr : %p ", curr_packet);
-        std::shared_ptr<SomePacket> packet = std::make_shared<SomePacket>(reinterpret_cast<char*>(curr_packet), UdpPacketType::SendTCMPacket);
-        packet->putHeaderID(pdu_header[kk]);
+/*!
+ * Writes the header of a TCM PDU whose signals are all zero; the payload is
+ * left as it is in the cleared buffer.
+ */
+template< typename CODEC, uint32_t HEADER_ID >
+PduView putZeroPdu( PduView pdu )
+{
+    static_assert( CODEC::BYTES == pduPayloadLength( tcmPduType( HEADER_ID ) ), "codec does not match PDU header" );
 
-        char* data = (char *)packet->getPayloadStartAddress();
-        std::vector<std::shared_ptr<LMSignalInfo>>& vt_signal = get_TCM_vector(pdu_header[kk]);
+    pdu.putHeader( HEADER_ID, CODEC::BYTES );
 
-        for (ii=0; ii < vt_signal.size(); ii++)
-        {
-            length = vt_signal.at(ii)->getBitLength();
-            loop = (length-1)/8 ;
+    return pdu.next( );
+}
 
-            for (jj = loop; jj >= 0; jj--)
-            {
-                unsigned long int x = 0xff; // 0xFF was int value in original code, this is not allowed to shift as int's max bit. So 0xFF should be defined as 8bytes(64bits)
-                //currValue = ((m_RCDSignal->getSigValue(signalPack[ii])) & (0xFF << (8 * jj))) >> (8 * jj); //ORIGIN
-                currValue = ( (getTCMSignal(packet->getHeaderID(), vt_signal.at(ii)->getIndex()) ) & (x << (8 * jj))) >> (8 * jj); //SANGGIL
-                if (length > 8) {
-                    length_new = length - (8 * jj);
-                    length -= length_new;
-                } else {
-                    length_new = length;
-                    currValue = (currValue & ((1 << length_new)-1));
-                }
-                remainBits = 8 - startBit;
-
-                if (length_new <= remainBits) {
-                    data[index] |= currValue << (remainBits - length_new);
-                    startBit = (startBit + length_new) % 8;
-                    if (startBit == 0) index++;
-                } else {
-                    startBit = length_new - remainBits;
-                    data[index] |= currValue >> startBit;
-                    data[++index] |= currValue << (8 - startBit);
-                }
-                //LOGI("data[%d]: %02X", index
-            }
-        }
+}
 
-        uint16_t move_len = sizeof(pdu_header_t) + packet->getPayloadLength();
+uint16_t SignalHandler::encodeTCMSignalData(uint8_t* buffer)
+{
+    memset(buffer, 0x00, UDP_BUF_MAX);
 
-        size_total += move_len;
-        curr_packet += move_len;
+    // Take the newest DMH sample whole; the members keep it for getTCMSignal().
+    if (dmhInput_.getVersion() != dmhInputVersion_) {
+        DmhInput input;
+        dmhInputVersion_ = dmhInput_.load(input);
+        AppSliderPosX = input.AppSliderPosX;
+        AppSliderPosY = input.AppSliderPosY;
+        AppAccelerationZ = input.AppAccelerationZ;
+        ManeuverEnableInput = input.ManeuverEnableInput;
+        AppCalcCheck = input.AppCalcCheck;
     }
 
-    //LOGE("==========================================(size_total: %d)", size_total);
-    return size_total;
+    applyCommands_();
+
+    // Same values as getTCMSignal(); signals left at zero are not implemented.
+    uint64_t lm[TCM_LM::MAXSignal] = { 0 };
+    lm[TCM_LM::AppCalcCheck] = (uint64_t)AppCalcCheck;
+    lm[TCM_LM::ManeuverEnableInput] = (uint64_t)ManeuverEnableInput;
+    lm[TCM_LM::ManeuverGearSelect] = (uint64_t)commandSignals_.selection.ManeuverGearSelect;
+    lm[TCM_LM::NudgeSelect] = (uint64_t)commandSignals_.selection.NudgeSelect;
+    lm[TCM_LM::AppSliderPosY] = (uint64_t)AppSliderPosY;
+    lm[TCM_LM::AppSliderPosX] = (uint64_t)AppSliderPosX;
+    lm[TCM_LM::ConnectionApproval] = (uint64_t)commandSignals_.ConnectionApproval;
+    lm[TCM_LM::ManeuverButtonPress] = (uint64_t)commandSignals_.ManeuverButtonPress;
+    lm[TCM_LM::DeviceControlMode] = (uint64_t)commandSignals_.DeviceControlMode;
+    lm[TCM_LM::ManeuverTypeSelect] = (uint64_t)commandSignals_.selection.ManeuverTypeSelect;
+    lm[TCM_LM::ManeuverDirectionSelect] = (uint64_t)commandSignals_.selection.ManeuverDirectionSelect;
+    lm[TCM_LM::ExploreModeSelect] = (uint64_t)commandSignals_.selection.ExploreModeSelect;
+    lm[TCM_LM::RemoteDeviceBatteryLevel] = (uint64_t)RemoteDeviceBatteryLevel;
+    lm[TCM_LM::ManeuverSideSelect] = (uint64_t)commandSignals_.selection.ManeuverSideSelect;
+    lm[TCM_LM::MobileChallengeReply] = (uint64_t)MobileChallengeReply;
+
+    uint64_t app[TCM_LM_App::MAXSignal] = { 0 };
+    app[TCM_LM_App::AppAccelerationZ] = (uint64_t)AppAccelerationZ;
+
+    PduView pdu(buffer, UDP_BUF_MAX);
+    pdu = putPdu<TcmLmCodec, HRD_ID_OF_TCM_LM>(pdu, lm);
+    pdu = putZeroPdu<TcmLmSessionCodec, HRD_ID_OF_TCM_LM_Session>(pdu);
+    pdu = putZeroPdu<TcmRemoteControlCodec, HRD_ID_OF_TCM_RemoteControl>(pdu);
+    pdu = putZeroPdu<TcmTransportKeyCodec, HRD_ID_OF_TCM_TransportKey>(pdu);
+    pdu = putPdu<TcmLmAppCodec, HRD_ID_OF_TCM_LM_App>(pdu, app);
+    pdu = putZeroPdu<TcmLmKeyIdCodec, HRD_ID_OF_TCM_LM_KeyID>(pdu);
+    pdu = putZeroPdu<TcmLmKeyAlphaCodec, HRD_ID_OF_TCM_LM_KeyAlpha>(pdu);
+    pdu = putZeroPdu<TcmLmKeyBetaCodec, HRD_ID_OF_TCM_LM_KeyBeta>(pdu);
+    pdu = putZeroPdu<TcmLmKeyGammaCodec, HRD_ID_OF_TCM_LM_KeyGamma>(pdu);
+
+    return (uint16_t)(UDP_BUF_MAX - pdu.getAvailable());
 }
 
 void SignalHandler::decodeASPMSignalData(uint8_t* buffer)
 {
-    int8_t ii = 0, jj = 0;
-    uint8_t length = 0;
-    uint8_t bits_read = 0, bits_to_read = 0;
-    uint8_t lmask = 0, rmask = 0, value_byte = 0;
-    uint8_t bits_remaining = 0;
-    uint64_t value = 0;
-    uint8_t* curr_packet = buffer;
-    uint16_t index = 0;
-
-    for (ii = 0; ii < NUMBER_OF_ASPM_PDU; ++ii) {
-        std::shared_ptr<SomePacket> packet = std::make_shared<SomePacket>(reinterpret_cast<char*>(curr_packet), UdpPacketType::ReadASPMPacket);
-        char* data = (char *)packet->getPayloadStartAddress();
-        index = 0;
-        std::vector<std::shared_ptr<LMSignalInfo>>& vt_signal = get_ASP_vector(packet->getHeaderID());
-
-        for (jj=0; jj < vt_signal.size(); ++jj) {
-            length = vt_signal.at(jj)->getBitLength();
-            bits_read = value = 0;
-            while(bits_read < length) {
-                if (bits_remaining) {
-                    lmask = (uint8_t)0xFF >> (8 - bits_remaining);
-                    bits_to_read = std::min((uint8_t)(length - bits_read), bits_remaining);
-                    rmask = (uint8_t)0xFF << (bits_remaining - bits_to_read);
-                    bits_remaining -= bits_to_read;
-                    value_byte = (data[index] & lmask & rmask) >> bits_remaining;
-                }
-                else {
-                    bits_to_read = std::min((uint8_t)(length - bits_read), (uint8_t)8);
-                    rmask = (uint8_t)0xFF << (8 - bits_to_read);
-                    bits_remaining = 8 - bits_to_read;
-                    value_byte = (data[index] & rmask) >> bits_remaining;
-                }
-                bits_read += bits_to_read;
-                value |= (uint64_t)value_byte << (length - bits_read);
-                if (!bits_remaining) {
-                    ++index;
-                }
-            }
-            setASPSignal(packet->getHeaderID(), vt_signal[jj]->getIndex(), value);
+    uint64_t lm[ASPM_LM::MAXSignal];
+    uint64_t objSegment[ASPM_LM_ObjSegment::MAXSignal];
+    PduView pdu(buffer, ASPM_TOTAL_PACKET_SIZE);
+
+    for (int ii = 0; ii < NUMBER_OF_ASPM_PDU && pdu.isValid(); ++ii, pdu = pdu.next()) {
+        PDU_TYPE::ID type = aspmPduType(pdu.getHeaderID());
+
+        // A PDU whose header gives the wrong length is skipped whole.
+        if (pdu.getPayloadLength() != pduPayloadLength(type)) {
+            continue;
+        }
+
+        switch (type) {
+            case PDU_TYPE::PDU_ASPM_LM:
+                AspmLmCodec::decode(pdu.getPayload(), lm);
+                applyAspmLm_(lm);
+                break;
+            case PDU_TYPE::PDU_ASPM_LM_ObjSegment:
+                AspmLmObjSegmentCodec::decode(pdu.getPayload(), objSegment);
+                applyAspmObjSegment_(objSegment);
+                break;
+            default:
+                // RemoteTarget, LM_Session and LM_Trunc carry nothing the TCM uses.
+                break;
         }
-        curr_packet += sizeof(pdu_header_t) + packet->getPayloadLength();
     }
+
+    // The changes go to the bus once handleASPMPacket_( ) is done with them.
+    aspSnapshot_.store( captureAspSnapshot_( ) );
+}
+
+void SignalHandler::applyAspmLm_( const uint64_t* values )
+{
+    // Signals setASPSignal() ignores are skipped here too.
+    ActiveAutonomousFeature = (ASP::ActiveAutonomousFeature)values[ASPM_LM::ActiveAutonomousFeature];
+    ConfirmAvailability = (ASP::ConfirmAvailability)values[ASPM_LM::ConfirmAvailability];
+    LongitudinalAdjustAvailability = (ASP::LongitudinalAdjustAvailability)values[ASPM_LM::LongitudinalAdjustAvailability];
+    ManeuverDirectionAvailability = (ASP::ManeuverDirectionAvailability)values[ASPM_LM::ManeuverDirectionAvailability];
+    ManeuverSideAvailability = (ASP::ManeuverSideAvailability)values[ASPM_LM::ManeuverSideAvailability];
+    ActiveManeuverOrientation = (ASP::ActiveManeuverOrientation)values[ASPM_LM::ActiveManeuverOrientation];
+    ActiveParkingMode = (ASP::ActiveParkingMode)values[ASPM_LM::ActiveParkingMode];
+    DirectionChangeAvailability = (ASP::DirectionChangeAvailability)values[ASPM_LM::DirectionChangeAvailability];
+    ParkTypeChangeAvailability = (ASP::ParkTypeChangeAvailability)values[ASPM_LM::ParkTypeChangeAvailability];
+    ExploreModeAvailability = (ASP::ExploreModeAvailability)values[ASPM_LM::ExploreModeAvailability];
+    ActiveManeuverSide = (ASP::ActiveManeuverSide)values[ASPM_LM::ActiveManeuverSide];
+    updateSignal_( ManeuverStatus, (ASP::ManeuverStatus)values[ASPM_LM::ManeuverStatus], StatusSignal::ManeuverStatus );
+    ActiveParkingType = (ASP::ActiveParkingType)values[ASPM_LM::ActiveParkingType];
+    ResumeAvailability = (ASP::ResumeAvailability)values[ASPM_LM::ResumeAvailability];
+    ReturnToStartAvailability = (ASP::ReturnToStartAvailability)values[ASPM_LM::ReturnToStartAvailability];
+    updateSignal_( NoFeatureAvailableMsg, (ASP::NoFeatureAvailableMsg)values[ASPM_LM::NoFeatureAvailableMsg], StatusSignal::NoFeatureAvailableMsg );
+    updateSignal_( InfoMsg, (ASP::InfoMsg)values[ASPM_LM::InfoMsg], StatusSignal::InfoMsg );
+    updateSignal_( InstructMsg, (ASP::InstructMsg)values[ASPM_LM::InstructMsg], StatusSignal::InstructMsg );
+    LongitudinalAdjustLength = (ASP::LongitudinalAdjustLength)values[ASPM_LM::LongitudinalAdjustLength];
+    ManeuverAlignmentAvailability = (ASP::ManeuverAlignmentAvailability)values[ASPM_LM::ManeuverAlignmentAvailability];
+    RemoteDriveAvailability = (ASP::RemoteDriveAvailability)values[ASPM_LM::RemoteDriveAvailability];
+    updateSignal_( PauseMsg2, (ASP::PauseMsg2)values[ASPM_LM::PauseMsg2], StatusSignal::PauseMsg2 );
+    updateSignal_( PauseMsg1, (ASP::PauseMsg1)values[ASPM_LM::PauseMsg1], StatusSignal::PauseMsg1 );
+    updateSignal_( CancelMsg, (ASP::CancelMsg)values[ASPM_LM::CancelMsg], StatusSignal::CancelMsg );
+    ManeuverProgressBar = (ASP::ManeuverProgressBar)values[ASPM_LM::ManeuverProgressBar];
+    updateSignal_( MobileChallengeSend, (ASP::MobileChallengeSend)values[ASPM_LM::MobileChallengeSend], StatusSignal::MobileChallengeSend );
+}
+
+void SignalHandler::applyAspmObjSegment_( const uint64_t* values )
+{
+    threatTypeData.ASPMFrontSegType1RMT = (uint8_t)values[ASPM_LM_ObjSegment::ASPMFrontSegType1RMT];
+    threatDistanceData.ASPMFrontSegDist1RMT = (uint8_t)values[ASPM_LM_ObjSegment::ASPMFrontSegDist1RMT];
+    threatTypeData.ASPMFrontSegType2RMT = (uint8_t)values[ASPM_LM_ObjSegment::ASPMFrontSegType2RMT];
+    threatDistanceData.ASPMFrontSegDist2RMT = (uint8_t)values[ASPM_LM_ObjSegment::ASPMFrontSegDist2RMT];
+    threatTypeData.ASPMFrontSegType3RMT = (uint8_t)values[ASPM_LM_ObjSegment::ASPMFrontSegType3RMT];
+    threatDistanceData.ASPMFrontSegDist3RMT = (uint8_t)values[ASPM_LM_ObjSegment::ASPMFrontSegDist3RMT];
+    threatTypeData.ASPMFrontSegType4RMT = (uint8_t)values[ASPM_LM_ObjSegment::ASPMFrontSegType4RMT];
+    threatDistanceData.ASPMFrontSegDist4RMT = (uint8_t)values[ASPM_LM_ObjSegment::ASPMFrontSegDist4RMT];
+    threatTypeData.ASPMFrontSegType5RMT = (uint8_t)values[ASPM_LM_ObjSegment::ASPMFrontSegType5RMT];
+    threatDistanceData.ASPMFrontSegDist5RMT = (uint8_t)values[ASPM_LM_ObjSegment::ASPMFrontSegDist5RMT];
+    threatTypeData.ASPMFrontSegType6RMT = (uint8_t)values[ASPM_LM_ObjSegment::ASPMFrontSegType6RMT];
+    threatDistanceData.ASPMFrontSegDist6RMT = (uint8_t)values[ASPM_LM_ObjSegment::ASPMFrontSegDist6RMT];
+    threatTypeData.ASPMFrontSegType7RMT = (uint8_t)values[ASPM_LM_ObjSegment::ASPMFrontSegType7RMT];
+    threatDistanceData.ASPMFrontSegDist7RMT = (uint8_t)values[ASPM_LM_ObjSegment::ASPMFrontSegDist7RMT];
+    threatTypeData.ASPMFrontSegType8RMT = (uint8_t)values[ASPM_LM_ObjSegment::ASPMFrontSegType8RMT];
+    threatDistanceData.ASPMFrontSegDist8RMT = (uint8_t)values[ASPM_LM_ObjSegment::ASPMFrontSegDist8RMT];
+    threatTypeData.ASPMFrontSegType9RMT = (uint8_t)values[ASPM_LM_ObjSegment::ASPMFrontSegType9RMT];
+    threatDistanceData.ASPMFrontSegDist9RMT = (uint8_t)values[ASPM_LM_ObjSegment::ASPMFrontSegDist9RMT];
+    threatTypeData.ASPMFrontSegType10RMT = (uint8_t)values[ASPM_LM_ObjSegment::ASPMFrontSegType10RMT];
+    threatDistanceData.ASPMFrontSegDist10RMT = (uint8_t)values[ASPM_LM_ObjSegment::ASPMFrontSegDist10RMT];
+    threatTypeData.ASPMFrontSegType11RMT = (uint8_t)values[ASPM_LM_ObjSegment::ASPMFrontSegType11RMT];
+    threatDistanceData.ASPMFrontSegDist11RMT = (uint8_t)values[ASPM_LM_ObjSegment::ASPMFrontSegDist11RMT];
+    threatTypeData.ASPMFrontSegType12RMT = (uint8_t)values[ASPM_LM_ObjSegment::ASPMFrontSegType12RMT];
+    threatDistanceData.ASPMFrontSegDist12RMT = (uint8_t)values[ASPM_LM_ObjSegment::ASPMFrontSegDist12RMT];
+    threatTypeData.ASPMFrontSegType13RMT = (uint8_t)values[ASPM_LM_ObjSegment::ASPMFrontSegType13RMT];
+    threatDistanceData.ASPMFrontSegDist13RMT = (uint8_t)values[ASPM_LM_ObjSegment::ASPMFrontSegDist13RMT];
+    threatTypeData.ASPMFrontSegType14RMT = (uint8_t)values[ASPM_LM_ObjSegment::ASPMFrontSegType14RMT];
+    threatDistanceData.ASPMFrontSegDist14RMT = (uint8_t)values[ASPM_LM_ObjSegment::ASPMFrontSegDist14RMT];
+    threatTypeData.ASPMFrontSegType15RMT = (uint8_t)values[ASPM_LM_ObjSegment::ASPMFrontSegType15RMT];
+    threatDistanceData.ASPMFrontSegDist15RMT = (uint8_t)values[ASPM_LM_ObjSegment::ASPMFrontSegDist15RMT];
+    threatTypeData.ASPMFrontSegType16RMT = (uint8_t)values[ASPM_LM_ObjSegment::ASPMFrontSegType16RMT];
+    threatDistanceData.ASPMFrontSegDist16RMT = (uint8_t)values[ASPM_LM_ObjSegment::ASPMFrontSegDist16RMT];
+    threatTypeData.ASPMRearSegType1RMT = (uint8_t)values[ASPM_LM_ObjSegment::ASPMRearSegType1RMT];
+    threatDistanceData.ASPMRearSegDist1RMT = (uint8_t)values[ASPM_LM_ObjSegment::ASPMRearSegDist1RMT];
+    threatTypeData.ASPMRearSegType2RMT = (uint8_t)values[ASPM_LM_ObjSegment::ASPMRearSegType2RMT];
+    threatDistanceData.ASPMRearSegDist2RMT = (uint8_t)values[ASPM_LM_ObjSegment::ASPMRearSegDist2RMT];
+    threatTypeData.ASPMRearSegType3RMT = (uint8_t)values[ASPM_LM_ObjSegment::ASPMRearSegType3RMT];
+    threatDistanceData.ASPMRearSegDist3RMT = (uint8_t)values[ASPM_LM_ObjSegment::ASPMRearSegDist3RMT];
+    threatTypeData.ASPMRearSegType4RMT = (uint8_t)values[ASPM_LM_ObjSegment::ASPMRearSegType4RMT];
+    threatDistanceData.ASPMRearSegDist4RMT = (uint8_t)values[ASPM_LM_ObjSegment::ASPMRearSegDist4RMT];
+    threatTypeData.ASPMRearSegType5RMT = (uint8_t)values[ASPM_LM_ObjSegment::ASPMRearSegType5RMT];
+    threatDistanceData.ASPMRearSegDist5RMT = (uint8_t)values[ASPM_LM_ObjSegment::ASPMRearSegDist5RMT];
+    threatTypeData.ASPMRearSegType6RMT = (uint8_t)values[ASPM_LM_ObjSegment::ASPMRearSegType6RMT];
+    threatDistanceData.ASPMRearSegDist6RMT = (uint8_t)values[ASPM_LM_ObjSegment::ASPMRearSegDist6RMT];
+    threatTypeData.ASPMRearSegType7RMT = (uint8_t)values[ASPM_LM_ObjSegment::ASPMRearSegType7RMT];
+    threatDistanceData.ASPMRearSegDist7RMT = (uint8_t)values[ASPM_LM_ObjSegment::ASPMRearSegDist7RMT];
+    threatTypeData.ASPMRearSegType8RMT = (uint8_t)values[ASPM_LM_ObjSegment::ASPMRearSegType8RMT];
+    threatDistanceData.ASPMRearSegDist8RMT = (uint8_t)values[ASPM_LM_ObjSegment::ASPMRearSegDist8RMT];
+    threatTypeData.ASPMRearSegType9RMT = (uint8_t)values[ASPM_LM_ObjSegment::ASPMRearSegType9RMT];
+    threatDistanceData.ASPMRearSegDist9RMT = (uint8_t)values[ASPM_LM_ObjSegment::ASPMRearSegDist9RMT];
+    threatTypeData.ASPMRearSegType10RMT = (uint8_t)values[ASPM_LM_ObjSegment::ASPMRearSegType10RMT];
+    threatDistanceData.ASPMRearSegDist10RMT = (uint8_t)values[ASPM_LM_ObjSegment::ASPMRearSegDist10RMT];
+    threatTypeData.ASPMRearSegType11RMT = (uint8_t)values[ASPM_LM_ObjSegment::ASPMRearSegType11RMT];
+    threatDistanceData.ASPMRearSegDist11RMT = (uint8_t)values[ASPM_LM_ObjSegment::ASPMRearSegDist11RMT];
+    threatTypeData.ASPMRearSegType12RMT = (uint8_t)values[ASPM_LM_ObjSegment::ASPMRearSegType12RMT];
+    threatDistanceData.ASPMRearSegDist12RMT = (uint8_t)values[ASPM_LM_ObjSegment::ASPMRearSegDist12RMT];
+    threatTypeData.ASPMRearSegType13RMT = (uint8_t)values[ASPM_LM_ObjSegment::ASPMRearSegType13RMT];
+    threatDistanceData.ASPMRearSegDist13RMT = (uint8_t)values[ASPM_LM_ObjSegment::ASPMRearSegDist13RMT];
+    threatTypeData.ASPMRearSegType14RMT = (uint8_t)values[ASPM_LM_ObjSegment::ASPMRearSegType14RMT];
+    threatDistanceData.ASPMRearSegDist14RMT = (uint8_t)values[ASPM_LM_ObjSegment::ASPMRearSegDist14RMT];
+    threatTypeData.ASPMRearSegType15RMT = (uint8_t)values[ASPM_LM_ObjSegment::ASPMRearSegType15RMT];
+    threatDistanceData.ASPMRearSegDist15RMT = (uint8_t)values[ASPM_LM_ObjSegment::ASPMRearSegDist15RMT];
+    threatTypeData.ASPMRearSegType16RMT = (uint8_t)values[ASPM_LM_ObjSegment::ASPMRearSegType16RMT];
+    threatDistanceData.ASPMRearSegDist16RMT = (uint8_t)values[ASPM_LM_ObjSegment::ASPMRearSegDist16RMT];
 }
 
 std::vector<std::shared_ptr<LMSignalInfo>>& SignalHandler::get_TCM_vector (int header_id)
@@ -30,21 +30,52 @@
 #include "sockethandler.hpp"
 
 
+namespace
+{
+
+// Connection whose frame is being dispatched on this thread, and the handler
+// that owns it; lets sendTCP( ) route replies back to the requesting client.
+thread_local const SocketHandler* dispatchOwner = nullptr;
+thread_local int dispatchConnection = -1;
+
+// Monotonic clock in ms, for liveness bookkeeping.
+uint64_t monotonicMs( )
+{
+    struct timespec now;
+    clock_gettime( CLOCK_MONOTONIC, &now );
+
+    return (uint64_t)now.tv_sec * 1000 + now.tv_nsec / 1000000;
+}
+
+}
+
+
 // Constructor initializes all member variables.
 SocketHandler::SocketHandler( )
         :
-        serverSocket_( ),
-        clientSocket_( ),
+        isClientConnected( false ),
+        serverSocket_( -1 ),
+        epollSocket_( -1 ),
+        wakeSocket_( -1 ),
+        timerSocket_( -1 ),
+        connections_( ),
+        maxFrameSize_( TCP_MAX_FRAME_SIZE ),
+        coalesce_( true ),
+        backpressurePolicy_( BackpressurePolicy::Disconnect ),
+        queueDepth_( TCP_TX_QUEUE_DEPTH ),
+        supersededFrames_( 0 ),
+        droppedFrames_( 0 ),
+        supersededPackets_( 0 ),
+        udpBatch_( ),
+        lastReceiveTimestamp_( 0 ),
         serverAddress_( ),
-        clientAddress_( ),
         sin_size_( sizeof( struct sockaddr_in ) ),
         curTime_( time( NULL ) ),
-        isClientConnected( false )
+        uringEnabled_( false )
 {
 
-    // Clear server and client address information
+    // Clear server address information
     bzero( (char *) &serverAddress_, sizeof( serverAddress_ ) );
-    bzero( (char *) &clientAddress_, sizeof( clientAddress_ ) );
 
 }
 
@@ -77,6 +108,13 @@ void SocketHandler::connectServer(
         printf( "setsockopt fail. SOL_SOCKET, SO_REUSEADDR port: %d", port );
     }
 
+    // Software receive stamps tell how old a datagram is once it is decoded.
+    if( type == SOCK_DGRAM
+        && setsockopt( serverSocket_, SOL_SOCKET, SO_TIMESTAMPNS, &opt, sizeof(opt) ) != 0 )
+    {
+        perror( "setsockopt fail. SOL_SOCKET, SO_TIMESTAMPNS" );
+    }
+
     // for the signalHandler, exit without calling ::bind
     if( isTCM == true )
     {
@@ -84,6 +122,25 @@ void SocketHandler::connectServer(
         std::cout << inet_ntoa( serverAddress_.sin_addr ) << ":";
         std::cout << ntohs( serverAddress_.sin_port ) << std::endl;
 
+#if defined( USE_IO_URING )
+        // Fixed-buffer reads and writes need a connected socket.
+        if( type == SOCK_DGRAM
+            && connect( serverSocket_,
+                        (struct sockaddr*)&serverAddress_,
+                        sizeof( serverAddress_ ) ) == 0
+            && uring_.init( URING_QUEUE_DEPTH ) == true )
+        {
+            struct iovec buffers[ 2 ];
+            for( int i = 0; i < 2; ++i )
+            {
+                buffers[ i ].iov_base = uringBuffers_[ i ];
+                buffers[ i ].iov_len = UDP_URING_BUF_SIZE;
+            }
+
+            uringEnabled_ = uring_.registerBuffers( buffers, 2 );
+        }
+#endif
+
         return;
     }
 
@@ -97,7 +154,7 @@ void SocketHandler::connectServer(
         std::cout << "socket bind failed" << std::endl;
     }
 
-    if( type == SOCK_DGRAM && port == UDP_PORT )
+    if( type == SOCK_DGRAM )
     {
 
         std::cout << "---" << std::endl << "ASPM awaiting TCM connection on: ";
@@ -107,6 +164,65 @@ void SocketHandler::connectServer(
         return;
     }
 
+    // Clients are accepted from pollEvents( ), so never block in accept( ).
+    setNonBlocking_( serverSocket_ );
+
+    epollSocket_ = epoll_create1( EPOLL_CLOEXEC );
+    if( epollSocket_ < 0 )
+    {
+        perror( "ERROR creating epoll instance." );
+
+        return;
+    }
+
+    struct epoll_event event;
+    bzero( (char *) &event, sizeof( event ) );
+    event.events = EPOLLIN | EPOLLET;
+    event.data.fd = serverSocket_;
+
+    if( epoll_ctl( epollSocket_, EPOLL_CTL_ADD, serverSocket_, &event ) != 0 )
+    {
+        perror( "ERROR registering server socket with epoll." );
+    }
+
+    // Lets other threads wake the writer after queueing a frame.
+    wakeSocket_ = eventfd( 0, EFD_NONBLOCK | EFD_CLOEXEC );
+    event.events = EPOLLIN | EPOLLET;
+    event.data.fd = wakeSocket_;
+
+    if( wakeSocket_ < 0
+        || epoll_ctl( epollSocket_, EPOLL_CTL_ADD, wakeSocket_, &event ) != 0 )
+    {
+        perror( "ERROR registering wake eventfd with epoll." );
+    }
+
+    // Periodic tick for closing dead or silent clients.
+    timerSocket_ = timerfd_create( CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC );
+
+    struct itimerspec period;
+    bzero( (char *) &period, sizeof( period ) );
+    period.it_interval.tv_nsec = TCP_LIVENESS_PERIOD * 1000000L;
+    period.it_value = period.it_interval;
+
+    event.events = EPOLLIN | EPOLLET;
+    event.data.fd = timerSocket_;
+
+    if( timerSocket_ < 0
+        || timerfd_settime( timerSocket_, 0, &period, NULL ) != 0
+        || epoll_ctl( epollSocket_, EPOLL_CTL_ADD, timerSocket_, &event ) != 0 )
+    {
+        perror( "ERROR registering liveness timer with epoll." );
+    }
+
+#if defined( USE_IO_URING )
+    // Queued frames for every client are then written with one submission.
+    if( uring_.init( URING_QUEUE_DEPTH ) == true )
+    {
+        uringSends_.resize( URING_QUEUE_DEPTH );
+        uringEnabled_ = true;
+    }
+#endif
+
     // With server connected, now listen for a new client to connect.
     listenForNewClient_( );
 
@@ -116,82 +232,389 @@ void SocketHandler::connectServer(
 }
 
 
-void SocketHandler::connectClient( )
+void SocketHandler::setMessageCallback( const MessageCallback& callback )
 {
+    onMessage_ = callback;
+}
 
-    // Clear client address information
-    bzero( (char *) &clientAddress_, sizeof( clientAddress_ ) );
 
-    // Connect client and server sockets
-    clientSocket_ = accept(
-            serverSocket_,
-            (struct sockaddr*)&clientAddress_,
-            &sin_size_ );
+void SocketHandler::setMaxFrameSize( const uint32_t& maxFrameSize )
+{
+    maxFrameSize_ = maxFrameSize;
+}
+
 
-    std::cout << "---" << std::endl << "Mobile device connected." << std::endl;
-    std::cout << "Mobile Address: " << inet_ntoa( clientAddress_.sin_addr );
-    std::cout << ":" << ntohs( clientAddress_.sin_port ) << std::endl;
+void SocketHandler::setCoalescing( const bool& coalesce )
+{
+    coalesce_ = coalesce;
+}
 
-    // Set bool value to true for reference in other classes.
-    isClientConnected = true;
 
+void SocketHandler::setBackpressurePolicy(
+        const BackpressurePolicy& policy,
+        const size_t& depth )
+{
+    std::lock_guard<std::mutex> lock( connectionMtx_ );
+
+    backpressurePolicy_ = policy;
+    queueDepth_ = ( depth > 0 ) ? depth : 1;
+}
 
-    return;
 
+uint64_t SocketHandler::getSupersededFrameCount( )
+{
+    return supersededFrames_;
 }
 
 
-void SocketHandler::receiveTCP(
-        ssize_t& val,
-        std::string& receivedMsg,
-        uint32_t& headerLen,
-        uint32_t& msgLen )
+uint64_t SocketHandler::getDroppedFrameCount( )
 {
+    return droppedFrames_;
+}
 
-    std::cout << "---" << std::endl << "TCM awaiting JSON input." << std::endl;
-    std::cout << "Server Address: " << inet_ntoa( serverAddress_.sin_addr );
-    std::cout << ":" << ntohs( serverAddress_.sin_port ) << std::endl;
-    std::cout << "Mobile Address: " << inet_ntoa( clientAddress_.sin_addr );
-    std::cout << ":" << ntohs( clientAddress_.sin_port ) << std::endl;
-    std::cout << "---" << std::endl;
 
-    headerLen = 0;
-    msgLen = 0;
+uint64_t SocketHandler::getSupersededPacketCount( )
+{
+    return supersededPackets_;
+}
+
+
+uint64_t SocketHandler::getLastReceiveTimestamp( )
+{
+    return lastReceiveTimestamp_;
+}
+
+
+int SocketHandler::getEventSocket( ) const
+{
+    return epollSocket_;
+}
+
 
-    // Read in message from client
-    ssize_t header_len_bytes = read( clientSocket_, (void*)(&headerLen), sizeof(std::uint32_t));
-    ssize_t msg_len_bytes = read( clientSocket_, (void*)(&msgLen), sizeof(std::uint32_t));
-    if( header_len_bytes < 0 || msg_len_bytes < 0 )
+int SocketHandler::getServerSocket( ) const
+{
+    return serverSocket_;
+}
+
+
+void SocketHandler::setConnectCallback( const ConnectionCallback& callback )
+{
+    onConnect_ = callback;
+}
+
+
+void SocketHandler::setDisconnectCallback( const ConnectionCallback& callback )
+{
+    onDisconnect_ = callback;
+}
+
+
+int SocketHandler::pollEvents( const int& timeoutMs )
+{
+
+    if( epollSocket_ < 0 )
+    {
+        return -1;
+    }
+
+    struct epoll_event events[ TCP_MAX_EVENTS ];
+
+    int ready = epoll_wait( epollSocket_, events, TCP_MAX_EVENTS, timeoutMs );
+
+    if( ready < 0 )
     {
-        std::cout << "read error" << std::endl;
-        perror( "ERROR reading from socket." );
+        if( errno == EINTR )
+        {
+            return 0;
+        }
 
-        val = -1;
+        perror( "ERROR waiting on epoll." );
+
+        return -1;
     }
-    else if ( header_len_bytes == 0 ) {
-        std::cout << "TCP connection closed" << std::endl;
-        disconnectClient();
-        return;
+
+    for( int i = 0; i < ready; ++i )
+    {
+
+        int socket = events[ i ].data.fd;
+
+        if( socket == serverSocket_ )
+        {
+            acceptClients_( );
+
+            continue;
+        }
+
+        if( socket == timerSocket_ )
+        {
+            uint64_t expirations;
+            if( read( timerSocket_, &expirations, sizeof( expirations ) ) > 0 )
+            {
+                checkLiveness_( );
+            }
+
+            continue;
+        }
+
+        if( socket == wakeSocket_ )
+        {
+            // Queued frames are written by flushPending_( ) below.
+            eventfd_t count;
+            eventfd_read( wakeSocket_, &count );
+
+            continue;
+        }
+
+        // Only this thread inserts or erases connections, so the entry stays
+        // valid without holding connectionMtx_; the fields other threads
+        // write are atomic or taken under the lock.
+        auto it = connections_.find( socket );
+
+        if( it == connections_.end( ) )
+        {
+            continue;
+        }
+
+        if( events[ i ].events & EPOLLOUT )
+        {
+            std::lock_guard<std::mutex> lock( connectionMtx_ );
+            it->second.txBlocked = false;
+        }
+
+        if( ( events[ i ].events & ( EPOLLIN | EPOLLRDHUP | EPOLLHUP | EPOLLERR ) )
+            && it->second.closing == false )
+        {
+            receiveTCP_( it->second );
+        }
+
+    }
+
+    // Write out everything queued during this iteration or by other threads.
+    flushPending_( );
+
+    // Close connections flagged while reading or by other threads.
+    std::vector<int> closing;
+    for( auto& it : connections_ )
+    {
+        if( it.second.closing == true )
+        {
+            closing.push_back( it.first );
+        }
+    }
+
+    for( auto& connection : closing )
+    {
+        closeClient_( connection );
+    }
+
+
+    return ready;
+
+}
+
+
+void SocketHandler::acceptClients_( )
+{
+
+    while( true )
+    {
+
+        struct sockaddr_in clientAddress;
+        socklen_t addressSize = sizeof( clientAddress );
+        bzero( (char *) &clientAddress, sizeof( clientAddress ) );
+
+        int clientSocket = accept4(
+                serverSocket_,
+                (struct sockaddr*)&clientAddress,
+                &addressSize,
+                SOCK_NONBLOCK | SOCK_CLOEXEC );
+
+        if( clientSocket < 0 )
+        {
+            if( errno == EINTR )
+            {
+                continue;
+            }
+            if( errno != EAGAIN && errno != EWOULDBLOCK )
+            {
+                perror( "ERROR accepting client." );
+            }
+
+            return;
+        }
+
+        struct epoll_event event;
+        bzero( (char *) &event, sizeof( event ) );
+        event.events = EPOLLIN | EPOLLOUT | EPOLLRDHUP | EPOLLET;
+        event.data.fd = clientSocket;
+
+        if( epoll_ctl( epollSocket_, EPOLL_CTL_ADD, clientSocket, &event ) != 0 )
+        {
+            perror( "ERROR registering client socket with epoll." );
+            close( clientSocket );
+
+            continue;
+        }
+
+        setKeepAlive_( clientSocket );
+
+        // Frames are always written whole, so Nagle would only add latency.
+        int opt = 1;
+        if( setsockopt( clientSocket, IPPROTO_TCP, TCP_NODELAY, &opt, sizeof( opt ) ) != 0 )
+        {
+            perror( "setsockopt fail. IPPROTO_TCP, TCP_NODELAY" );
+        }
+
+        std::cout << "---" << std::endl << "Mobile device connected." << std::endl;
+        std::cout << "Mobile Address: " << inet_ntoa( clientAddress.sin_addr );
+        std::cout << ":" << ntohs( clientAddress.sin_port ) << std::endl;
+
+        {
+            std::lock_guard<std::mutex> lock( connectionMtx_ );
+
+            Connection& connection = connections_[ clientSocket ];
+            connection.socket = clientSocket;
+            connection.address = clientAddress;
+            connection.rxBuffer.reset( TCP_FRAME_PREFIX_SIZE + maxFrameSize_ );
+            connection.txQueue.clear( );
+            connection.txOffset = 0;
+            connection.txBlocked = false;
+            connection.corked = false;
+            connection.lastReceived = monotonicMs( );
+            connection.livenessTimeout = 0;
+            connection.closing = false;
+
+            // Set bool value to true for reference in other classes.
+            isClientConnected = true;
+        }
+
+        if( onConnect_ )
+        {
+            onConnect_( clientSocket );
+        }
+
+    }
+
+}
+
+
+void SocketHandler::receiveTCP_( Connection& connection )
+{
+
+    // Edge-triggered: read until the socket would block, dispatching frames
+    // whenever the buffer fills so a burst larger than it is still drained.
+    while( connection.closing == false )
+    {
+
+        char* tail = connection.rxBuffer.writePtr( );
+        size_t space = connection.rxBuffer.writable( );
+
+        ssize_t received = recv( connection.socket, tail, space, 0 );
+
+        if( received > 0 )
+        {
+            connection.rxBuffer.commit( received );
+            connection.lastReceived = monotonicMs( );
+
+            if( dispatchFrames_( connection ) == false )
+            {
+                connection.closing = true;
+            }
+
+            continue;
+        }
+        if( received == 0 )
+        {
+            std::cout << "TCP connection closed" << std::endl;
+            connection.closing = true;
+
+            break;
+        }
+        if( errno == EINTR )
+        {
+            continue;
+        }
+        if( errno != EAGAIN && errno != EWOULDBLOCK )
+        {
+            std::cout << "read error" << std::endl;
+            perror( "ERROR reading from socket." );
+            connection.closing = true;
+        }
+
+        break;
+
     }
-    else
+
+
+    return;
+
+}
+
+
+bool SocketHandler::dispatchFrames_( Connection& connection )
+{
+
+    RingBuffer& rx( connection.rxBuffer );
+
+    // Dispatch every complete [headerLen][bodyLen][header][body] frame.
+    while( rx.readable( ) >= TCP_FRAME_PREFIX_SIZE )
     {
-        headerLen = ntohl(headerLen);
-        msgLen = ntohl(msgLen);
-        uint32_t totalMsgLen( headerLen + msgLen );
+
+        std::uint32_t headerLen;
+        std::uint32_t msgLen;
+
+        memcpy( &headerLen, rx.readPtr( ), sizeof( headerLen ) );
+        memcpy( &msgLen, rx.readPtr( ) + sizeof( headerLen ), sizeof( msgLen ) );
+
+        headerLen = ntohl( headerLen );
+        msgLen = ntohl( msgLen );
+
+        uint64_t totalMsgLen( (uint64_t)headerLen + msgLen );
+
+        if( totalMsgLen > maxFrameSize_ )
+        {
+            std::cout << "---" << std::endl << "Frame of " << totalMsgLen;
+            std::cout << " bytes exceeds limit of " << maxFrameSize_;
+            std::cout << "; dropping client." << std::endl;
+
+            return false;
+        }
+
+        if( rx.readable( ) - TCP_FRAME_PREFIX_SIZE < totalMsgLen )
+        {
+            break;
+        }
 
         // Print time at receipt of new message
         curTime_ = time( NULL );
         std::cout << "Data received at: " << ctime( &curTime_ );
 
-        receivedMsg.clear( );
-        receivedMsg.resize( totalMsgLen );
+        if( onMessage_ )
+        {
+            dispatchOwner = this;
+            dispatchConnection = connection.socket;
+
+            onMessage_(
+                    connection.socket,
+                    rx.readPtr( ) + TCP_FRAME_PREFIX_SIZE,
+                    headerLen,
+                    msgLen );
+
+            dispatchOwner = nullptr;
+            dispatchConnection = -1;
+        }
+
+        rx.consume( TCP_FRAME_PREFIX_SIZE + totalMsgLen );
 
-        ssize_t bytes_read = 0;
-        while (bytes_read < totalMsgLen) {
-            val = (ssize_t)read( clientSocket_, (void*)(receivedMsg.data() + bytes_read), (totalMsgLen - bytes_read) );
-            bytes_read += val;
+        if( connection.closing == true )
+        {
+            break;
         }
+
     }
+
+    return true;
+
 }
 
 
@@ -215,112 +638,1074 @@ ssize_t SocketHandler::receiveUDP( void* buffer, const uint16_t& bufSize )
 }
 
 
-void SocketHandler::sendTCP(
-        const std::string& msgHeader,
-        const std::string& msgBody )
+ssize_t SocketHandler::receiveLatestUDP(
+        void* buffer,
+        const uint16_t& bufSize,
+        const uint16_t& validSize )
 {
-    // leave per commonly-used state debugging statements.
-    // std::cout << "headerLen = " << (int)msgHeader.length() << std::endl;
-    std::cout << "rawHeader: " << msgHeader << std::endl;
-    // std::cout << "bodyLen = " << (int)msgBody.length() << std::endl;
-    std::cout << "rawBody: " << msgBody << std::endl;
 
-    std::uint32_t headerSize = htonl(msgHeader.length());
-    std::uint32_t bodySize = htonl(msgBody.length());
+    // Block for the first datagram; the rest of the batch is whatever else
+    // is already queued.
+    return drainUDP_( buffer, bufSize, validSize, MSG_WAITFORONE, -1 );
 
-    // Send reply back to client
-    if( write( clientSocket_, &headerSize, sizeof( headerSize ) ) < 0
-        || write( clientSocket_, &bodySize, sizeof( bodySize ) ) < 0 )
+}
 
-    {
-        perror( "ERROR writing to socket." );
-    }
-    else
-    {
-        write( clientSocket_, msgHeader.c_str( ), msgHeader.size( ) );
-        write( clientSocket_, msgBody.c_str( ), msgBody.size( ) );
-    }
 
-    return;
+ssize_t SocketHandler::pollLatestUDP(
+        void* buffer,
+        const uint16_t& bufSize,
+        const uint16_t& validSize )
+{
+
+    // An empty socket leaves errno at EAGAIN from recvmmsg( ).
+    return drainUDP_( buffer, bufSize, validSize, MSG_DONTWAIT, -1 );
 
 }
 
 
-int32_t SocketHandler::sendUDP( const void* buffer, const uint16_t& bufSize )
+ssize_t SocketHandler::drainUDP_(
+        void* buffer,
+        const uint16_t& bufSize,
+        const uint16_t& validSize,
+        const int& flags,
+        const ssize_t& current )
 {
 
-    // std::cout << "---" << std::endl << "Sending UDP message on: ";
-    // std::cout << inet_ntoa( serverAddress_.sin_addr ) << ":";
-    // std::cout << ntohs( serverAddress_.sin_port ) << std::endl;
-    // std::cout << "---" << std::endl;
+    if( udpBatch_.empty( ) )
+    {
+        udpBatch_.resize( UDP_BATCH_MAX * UDP_BATCH_BUF_SIZE );
+    }
 
+    struct mmsghdr msgs[ UDP_BATCH_MAX ];
+    struct iovec iov[ UDP_BATCH_MAX ];
+    struct sockaddr_in peers[ UDP_BATCH_MAX ];
+    uint8_t control[ UDP_BATCH_MAX ][ CMSG_SPACE( sizeof( struct timespec ) ) ];
 
-    return sendto(
-            serverSocket_,
-            ((uint8_t*)buffer),
-            bufSize,
-            0,
-            (const struct sockaddr*)&serverAddress_,
-            sin_size_ );
-}
+    ssize_t result = current;
+    bool haveValid = ( current >= 0 && ( validSize == 0 || current == validSize ) );
+    int batchFlags = flags;
 
+    while( true )
+    {
 
-void SocketHandler::disconnectClient( bool listenForNew )
-{
-    close( clientSocket_ );
+        bzero( (char *) msgs, sizeof( msgs ) );
+        for( int i = 0; i < UDP_BATCH_MAX; ++i )
+        {
+            iov[ i ].iov_base = &udpBatch_[ i * UDP_BATCH_BUF_SIZE ];
+            iov[ i ].iov_len = UDP_BATCH_BUF_SIZE;
+            msgs[ i ].msg_hdr.msg_iov = &iov[ i ];
+            msgs[ i ].msg_hdr.msg_iovlen = 1;
+            msgs[ i ].msg_hdr.msg_name = &peers[ i ];
+            msgs[ i ].msg_hdr.msg_namelen = sizeof( peers[ i ] );
+            msgs[ i ].msg_hdr.msg_control = control[ i ];
+            msgs[ i ].msg_hdr.msg_controllen = sizeof( control[ i ] );
+        }
 
-    // Set bool value to false for reference in other classes.
-    isClientConnected = false;
+        int count = recvmmsg( serverSocket_, msgs, UDP_BATCH_MAX, batchFlags, NULL );
 
-    // With server connected, now listen for a new client to connect.
-    if (listenForNew) {
-        listenForNewClient_( );
-    }
+        if( count < 0 )
+        {
+            if( errno == EINTR )
+            {
+                continue;
+            }
+            if( errno == EAGAIN || errno == EWOULDBLOCK )
+            {
+                break;
+            }
 
+            return ( result >= 0 ) ? result : -1;
+        }
 
-    return;
+        // Newest valid datagram in this batch, else the newest of any kind
+        // while nothing valid has been seen.
+        int chosen = -1;
+        for( int i = 0; i < count; ++i )
+        {
+            bool valid = ( validSize == 0 || msgs[ i ].msg_len == validSize );
+
+            if( valid == true )
+            {
+                if( haveValid == true )
+                {
+                    ++supersededPackets_;
+                }
+                haveValid = true;
+                chosen = i;
+            }
+            else if( haveValid == false )
+            {
+                chosen = i;
+            }
+        }
 
-}
+        if( chosen >= 0 )
+        {
+            size_t length = msgs[ chosen ].msg_len;
+            if( length > bufSize )
+            {
+                length = bufSize;
+            }
 
+            memcpy( buffer, iov[ chosen ].iov_base, length );
+            result = (ssize_t)length;
 
-void SocketHandler::disconnectServer( )
-{
-    shutdown(clientSocket_, SHUT_RDWR);
-    close( clientSocket_ );
-    shutdown(serverSocket_, SHUT_RDWR);
-    close( serverSocket_ );
+            // Replies go to whoever sent the datagram kept, as with recvfrom( ).
+            if( msgs[ chosen ].msg_hdr.msg_namelen == sizeof( serverAddress_ ) )
+            {
+                serverAddress_ = peers[ chosen ];
+            }
+
+            lastReceiveTimestamp_ = readTimestamp_( &msgs[ chosen ].msg_hdr );
+        }
+
+        // A short batch means the socket is empty.
+        if( count < UDP_BATCH_MAX )
+        {
+            break;
+        }
+
+        batchFlags = MSG_DONTWAIT;
+
+    }
 
-    return;
+
+    return result;
 
 }
 
 
-int SocketHandler::checkClientConnection( )
+uint64_t SocketHandler::readTimestamp_( struct msghdr* msg )
 {
 
-    int error;
-    socklen_t errorSize = sizeof( error );
+    for( struct cmsghdr* cmsg = CMSG_FIRSTHDR( msg );
+         cmsg != NULL;
+         cmsg = CMSG_NXTHDR( msg, cmsg ) )
+    {
+        if( cmsg->cmsg_level == SOL_SOCKET && cmsg->cmsg_type == SCM_TIMESTAMPNS )
+        {
+            struct timespec arrival;
+            memcpy( &arrival, CMSG_DATA( cmsg ), sizeof( arrival ) );
 
-    // If client socket has disconnected, return value of "-1" will be returned.
-    return getsockopt(clientSocket_, SOL_SOCKET, SO_ERROR, &error, &errorSize);
+            return (uint64_t)arrival.tv_sec * 1000000000ull + arrival.tv_nsec;
+        }
+    }
+
+    return 0;
 
 }
 
 
-void SocketHandler::listenForNewClient_( )
+void SocketHandler::sendTCP(
+        const std::string& msgHeader,
+        const std::string& msgBody,
+        const std::string& supersedeKey )
 {
 
-    // wait for a client
-    /* listen (this socket, request queue length) */
-    listen( serverSocket_, 5 );
+    // A reply produced while dispatching a frame goes back to its sender.
+    if( dispatchOwner == this && dispatchConnection >= 0 )
+    {
+        sendTCP( dispatchConnection, msgHeader, msgBody, supersedeKey );
 
-    // Use this to repopulate server address information if it was cleared.
-    getsockname( serverSocket_, (struct sockaddr*)&serverAddress_, &sin_size_ );
+        return;
+    }
 
-    std::cout << "---" << std::endl << "TCM awaiting mobile connection." << std::endl;
-    std::cout << "Listening on: " << inet_ntoa( serverAddress_.sin_addr );
-    std::cout << ":" << ntohs( serverAddress_.sin_port ) << std::endl;
+    std::vector<int> targets;
+    {
+        std::lock_guard<std::mutex> lock( connectionMtx_ );
+        for( auto& it : connections_ )
+        {
+            targets.push_back( it.first );
+        }
+    }
 
+    for( auto& target : targets )
+    {
+        sendTCP( target, msgHeader, msgBody, supersedeKey );
+    }
+
+    return;
+
+}
+
+
+void SocketHandler::sendTCP(
+        const int& connection,
+        const std::string& msgHeader,
+        const std::string& msgBody,
+        const std::string& supersedeKey )
+{
+    // leave per commonly-used state debugging statements.
+    // std::cout << "headerLen = " << (int)msgHeader.length() << std::endl;
+    // std::cout << "rawHeader: " << msgHeader << std::endl;
+    // std::cout << "bodyLen = " << (int)msgBody.length() << std::endl;
+    // std::cout << "rawBody: " << msgBody << std::endl;
+
+    std::uint32_t lengths[ 2 ];
+    lengths[ 0 ] = htonl( msgHeader.length( ) );
+    lengths[ 1 ] = htonl( msgBody.length( ) );
+
+    OutboundFrame frame;
+    frame.bytes.reserve( sizeof( lengths ) + msgHeader.size( ) + msgBody.size( ) );
+    frame.bytes.append( (const char*)lengths, sizeof( lengths ) );
+    frame.bytes.append( msgHeader );
+    frame.bytes.append( msgBody );
+    frame.key = supersedeKey;
+
+    {
+        std::lock_guard<std::mutex> lock( connectionMtx_ );
+
+        auto it = connections_.find( connection );
+        if( it == connections_.end( ) || it->second.closing == true )
+        {
+            return;
+        }
+
+        enqueueFrame_( it->second, frame );
+    }
+
+    // The pollEvents( ) thread flushes at the end of its iteration anyway.
+    if( dispatchOwner != this )
+    {
+        wake_( );
+    }
+
+    return;
+
+}
+
+
+void SocketHandler::enqueueFrame_( Connection& connection, const OutboundFrame& frame )
+{
+
+    std::deque<OutboundFrame>& queue( connection.txQueue );
+
+    // A partially written front frame must be finished, never replaced.
+    auto firstUnsent = queue.begin( );
+    if( connection.txOffset > 0 && firstUnsent != queue.end( ) )
+    {
+        ++firstUnsent;
+    }
+
+    if( !frame.key.empty( ) )
+    {
+        for( auto it = firstUnsent; it != queue.end( ); ++it )
+        {
+            if( it->key == frame.key )
+            {
+                queue.erase( it );
+                ++supersededFrames_;
+
+                break;
+            }
+        }
+    }
+
+    if( queue.size( ) >= queueDepth_ )
+    {
+
+        ++droppedFrames_;
+
+        switch( backpressurePolicy_ )
+        {
+            case BackpressurePolicy::DropOldest:
+            {
+                if( firstUnsent != queue.end( ) )
+                {
+                    queue.erase( firstUnsent );
+
+                    break;
+                }
+
+                return;
+            }
+            case BackpressurePolicy::DropNewest:
+            {
+                return;
+            }
+            case BackpressurePolicy::Disconnect:
+            default:
+            {
+                std::cout << "---" << std::endl << "Outbound queue full; ";
+                std::cout << "dropping stalled client." << std::endl;
+
+                connection.closing = true;
+                shutdown( connection.socket, SHUT_RDWR );
+
+                return;
+            }
+        }
+
+    }
+
+    queue.push_back( frame );
+
+    return;
+
+}
+
+
+void SocketHandler::flushPending_( )
+{
+
+    std::lock_guard<std::mutex> lock( connectionMtx_ );
+
+#if defined( USE_IO_URING )
+    if( uringEnabled_ == true )
+    {
+        flushPendingUring_( );
+
+        return;
+    }
+#endif
+
+    for( auto& it : connections_ )
+    {
+
+        Connection& connection( it.second );
+
+        if( connection.txQueue.empty( )
+            || connection.txBlocked == true
+            || connection.closing == true )
+        {
+            continue;
+        }
+
+        if( flushConnection_( connection ) == false )
+        {
+            perror( "ERROR writing to socket." );
+
+            // A partial frame cannot be recovered; drop the client.
+            connection.closing = true;
+            shutdown( connection.socket, SHUT_RDWR );
+        }
+
+    }
+
+    return;
+
+}
+
+
+bool SocketHandler::flushConnection_( Connection& connection )
+{
+
+    struct iovec iov[ TCP_TX_BATCH_MAX ];
+
+    struct msghdr msg;
+    bzero( (char *) &msg, sizeof( msg ) );
+    msg.msg_iov = iov;
+
+    while( !connection.txQueue.empty( ) && connection.txBlocked == false )
+    {
+
+        msg.msg_iovlen = gatherFrames_( connection, iov );
+
+        ssize_t sent = sendmsg( connection.socket, &msg, MSG_NOSIGNAL | MSG_DONTWAIT );
+
+        if( completeSend_( connection, sent, errno ) == false )
+        {
+            return false;
+        }
+
+    }
+
+    return true;
+
+}
+
+
+size_t SocketHandler::gatherFrames_( const Connection& connection, struct iovec* iov )
+{
+
+    const std::deque<OutboundFrame>& queue( connection.txQueue );
+
+    // One frame per syscall unless coalescing.
+    size_t batch = ( coalesce_ == true ) ? TCP_TX_BATCH_MAX : 1;
+    size_t count = 0;
+
+    for( auto it = queue.begin( ); it != queue.end( ) && count < batch; ++it, ++count )
+    {
+        size_t offset = ( count == 0 ) ? connection.txOffset : 0;
+        iov[ count ].iov_base = (void*)( it->bytes.data( ) + offset );
+        iov[ count ].iov_len = it->bytes.size( ) - offset;
+    }
+
+    return count;
+
+}
+
+
+bool SocketHandler::completeSend_(
+        Connection& connection,
+        const ssize_t& sent,
+        const int& error )
+{
+
+    std::deque<OutboundFrame>& queue( connection.txQueue );
+
+    if( sent < 0 )
+    {
+        if( error == EINTR )
+        {
+            return true;
+        }
+        if( error != EAGAIN && error != EWOULDBLOCK )
+        {
+            return false;
+        }
+
+        // Socket buffer is full; resume on EPOLLOUT.  Hold back the tail
+        // of a partially written frame (TCP_NODELAY is set) until the
+        // rest of it can be queued.
+        connection.txBlocked = true;
+
+        if( connection.txOffset > 0 && connection.corked == false )
+        {
+            int opt = 1;
+            setsockopt( connection.socket, IPPROTO_TCP, TCP_CORK, &opt, sizeof( opt ) );
+            connection.corked = true;
+        }
+
+        return true;
+    }
+
+    // Retire every frame written in full.
+    size_t written = (size_t)sent;
+    while( written > 0 && !queue.empty( ) )
+    {
+        size_t remaining = queue.front( ).bytes.size( ) - connection.txOffset;
+
+        if( written < remaining )
+        {
+            connection.txOffset += written;
+            written = 0;
+
+            break;
+        }
+
+        written -= remaining;
+        connection.txOffset = 0;
+        queue.pop_front( );
+    }
+
+    // Uncorking pushes out anything still held back.
+    if( queue.empty( ) && connection.corked == true )
+    {
+        int opt = 0;
+        setsockopt( connection.socket, IPPROTO_TCP, TCP_CORK, &opt, sizeof( opt ) );
+        connection.corked = false;
+    }
+
+    return true;
+
+}
+
+
+#if defined( USE_IO_URING )
+void SocketHandler::flushPendingUring_( )
+{
+
+    bool pending = true;
+
+    while( pending == true )
+    {
+
+        pending = false;
+        size_t count = 0;
+
+        // One sendmsg per connection, all submitted with a single syscall.
+        for( auto& it : connections_ )
+        {
+
+            Connection& connection( it.second );
+
+            if( connection.txQueue.empty( )
+                || connection.txBlocked == true
+                || connection.closing == true )
+            {
+                continue;
+            }
+
+            if( count == uringSends_.size( ) )
+            {
+                pending = true;
+
+                break;
+            }
+
+            UringSend& send( uringSends_[ count ] );
+            send.connection = &connection;
+            bzero( (char *) &send.msg, sizeof( send.msg ) );
+            send.msg.msg_iov = send.iov;
+            send.msg.msg_iovlen = gatherFrames_( connection, send.iov );
+
+            uring_.prepareSendMsg(
+                    connection.socket,
+                    &send.msg,
+                    MSG_NOSIGNAL | MSG_DONTWAIT,
+                    count );
+            ++count;
+
+        }
+
+        if( count == 0 )
+        {
+            break;
+        }
+
+        if( uring_.submit( count ) < 0 )
+        {
+            perror( "ERROR submitting to io_uring." );
+
+            break;
+        }
+
+        uint64_t index;
+        int32_t result;
+
+        while( uring_.popCompletion( index, result ) == true )
+        {
+
+            if( index >= count )
+            {
+                continue;
+            }
+
+            Connection& connection( *uringSends_[ index ].connection );
+
+            if( completeSend_( connection, ( result < 0 ) ? -1 : result, -result ) == false )
+            {
+                errno = -result;
+                perror( "ERROR writing to socket." );
+
+                // A partial frame cannot be recovered; drop the client.
+                connection.closing = true;
+                shutdown( connection.socket, SHUT_RDWR );
+            }
+            else if( !connection.txQueue.empty( ) && connection.txBlocked == false )
+            {
+                pending = true;
+            }
+
+        }
+
+    }
+
+    return;
+
+}
+#endif
+
+
+void SocketHandler::wake( )
+{
+    wake_( );
+}
+
+
+void SocketHandler::wake_( )
+{
+
+    if( wakeSocket_ >= 0 )
+    {
+        eventfd_write( wakeSocket_, 1 );
+    }
+
+    return;
+
+}
+
+
+ssize_t SocketHandler::exchangeUDP(
+        const void* bufferOut,
+        const uint16_t& sizeOut,
+        void* bufferIn,
+        const uint16_t& sizeIn,
+        const uint16_t& validSize )
+{
+
+#if defined( USE_IO_URING )
+    if( uringEnabled_ == true )
+    {
+
+        if( sizeOut > UDP_URING_BUF_SIZE )
+        {
+            errno = EMSGSIZE;
+
+            return -1;
+        }
+
+        uint32_t sizeReply = ( sizeIn < UDP_URING_BUF_SIZE ) ? sizeIn : UDP_URING_BUF_SIZE;
+        memcpy( uringBuffers_[ 0 ], bufferOut, sizeOut );
+
+        // recvmsg rather than a fixed read, so the arrival stamp comes back.
+        struct iovec reply;
+        reply.iov_base = uringBuffers_[ 1 ];
+        reply.iov_len = sizeReply;
+        uint8_t control[ CMSG_SPACE( sizeof( struct timespec ) ) ];
+        struct msghdr msg;
+        bzero( (char *) &msg, sizeof( msg ) );
+        msg.msg_iov = &reply;
+        msg.msg_iovlen = 1;
+        msg.msg_control = control;
+        msg.msg_controllen = sizeof( control );
+
+        // The read is linked, so it is only issued once the write is done.
+        uring_.prepareWriteFixed( serverSocket_, uringBuffers_[ 0 ], sizeOut, 0, 0, true );
+        uring_.prepareRecvMsg( serverSocket_, &msg, 0, 1 );
+
+        if( uring_.submit( 2 ) < 0 )
+        {
+            return -1;
+        }
+
+        int32_t results[ 2 ] = { -ECANCELED, -ECANCELED };
+        uint64_t index;
+        int32_t result;
+
+        while( uring_.popCompletion( index, result ) == true )
+        {
+            if( index < 2 )
+            {
+                results[ index ] = result;
+            }
+        }
+
+        for( auto& it : results )
+        {
+            if( it < 0 )
+            {
+                errno = -it;
+
+                return -1;
+            }
+        }
+
+        memcpy( bufferIn, uringBuffers_[ 1 ], results[ 1 ] );
+
+        lastReceiveTimestamp_ = readTimestamp_( &msg );
+
+        // Anything that queued up behind the reply is newer.
+        return drainUDP_( bufferIn, sizeIn, validSize, MSG_DONTWAIT, results[ 1 ] );
+
+    }
+#endif
+
+    if( sendUDP( bufferOut, sizeOut ) < 0 )
+    {
+        return -1;
+    }
+
+    return receiveLatestUDP( bufferIn, sizeIn, validSize );
+
+}
+
+
+void SocketHandler::setUringEnabled( const bool& enable )
+{
+
+#if defined( USE_IO_URING )
+    std::lock_guard<std::mutex> lock( connectionMtx_ );
+    uringEnabled_ = ( enable == true && uring_.isReady( ) == true );
+#else
+    (void)enable;
+#endif
+
+    return;
+
+}
+
+
+bool SocketHandler::isUringEnabled( ) const
+{
+
+    return uringEnabled_;
+
+}
+
+
+int32_t SocketHandler::sendUDP( const void* buffer, const uint16_t& bufSize )
+{
+
+    // std::cout << "---" << std::endl << "Sending UDP message on: ";
+    // std::cout << inet_ntoa( serverAddress_.sin_addr ) << ":";
+    // std::cout << ntohs( serverAddress_.sin_port ) << std::endl;
+    // std::cout << "---" << std::endl;
+
+
+    return sendto(
+            serverSocket_,
+            ((uint8_t*)buffer),
+            bufSize,
+            0,
+            (const struct sockaddr*)&serverAddress_,
+            sin_size_ );
+}
+
+
+int SocketHandler::sendBatchUDP(
+        const struct iovec* packets,
+        const unsigned& count,
+        const struct sockaddr_in* peers )
+{
+
+    struct mmsghdr msgs[ UDP_BATCH_MAX ];
+    unsigned batch = ( count < UDP_BATCH_MAX ) ? count : UDP_BATCH_MAX;
+
+    bzero( (char *) msgs, sizeof( msgs ) );
+    for( unsigned i = 0; i < batch; ++i )
+    {
+        msgs[ i ].msg_hdr.msg_iov = (struct iovec*)&packets[ i ];
+        msgs[ i ].msg_hdr.msg_iovlen = 1;
+        msgs[ i ].msg_hdr.msg_name = (void*)( ( peers != NULL ) ? &peers[ i ] : &serverAddress_ );
+        msgs[ i ].msg_hdr.msg_namelen = sin_size_;
+    }
+
+    return sendmmsg( serverSocket_, msgs, batch, 0 );
+
+}
+
+
+void SocketHandler::disconnectClient( bool listenForNew )
+{
+
+    std::lock_guard<std::mutex> lock( connectionMtx_ );
+
+    // Shutting a socket down wakes pollEvents( ), which then closes it.
+    for( auto& it : connections_ )
+    {
+        it.second.closing = true;
+        shutdown( it.first, SHUT_RDWR );
+    }
+
+    // Stop accepting new clients as well.
+    if( listenForNew == false && epollSocket_ >= 0 && serverSocket_ >= 0 )
+    {
+        shutdown( serverSocket_, SHUT_RDWR );
+    }
+
+
+    return;
+
+}
+
+
+void SocketHandler::disconnectClient( const int& connection )
+{
+
+    std::lock_guard<std::mutex> lock( connectionMtx_ );
+
+    auto it = connections_.find( connection );
+    if( it != connections_.end( ) )
+    {
+        it->second.closing = true;
+        shutdown( connection, SHUT_RDWR );
+    }
+
+    return;
+
+}
+
+
+void SocketHandler::closeClient_( const int& connection )
+{
+
+    {
+        std::lock_guard<std::mutex> lock( connectionMtx_ );
+
+        if( connections_.erase( connection ) == 0 )
+        {
+            return;
+        }
+
+        epoll_ctl( epollSocket_, EPOLL_CTL_DEL, connection, NULL );
+        close( connection );
+
+        // Set bool value to false for reference in other classes.
+        isClientConnected = !connections_.empty( );
+    }
+
+    std::cout << "---" << std::endl << "Mobile device disconnected." << std::endl;
+
+    if( onDisconnect_ )
+    {
+        onDisconnect_( connection );
+    }
+
+    return;
+
+}
+
+
+size_t SocketHandler::getClientCount( )
+{
+
+    std::lock_guard<std::mutex> lock( connectionMtx_ );
+
+    return connections_.size( );
+
+}
+
+
+std::vector<int> SocketHandler::getConnections( )
+{
+
+    std::vector<int> connections;
+
+    std::lock_guard<std::mutex> lock( connectionMtx_ );
+
+    for( auto& it : connections_ )
+    {
+        connections.push_back( it.first );
+    }
+
+    return connections;
+
+}
+
+
+int SocketHandler::getDispatchConnection( ) const
+{
+
+    return ( dispatchOwner == this ) ? dispatchConnection : -1;
+
+}
+
+
+void SocketHandler::dispatchAs( const int& connection, const std::function< void( ) >& send )
+{
+
+    const SocketHandler* owner( dispatchOwner );
+    int ownerConnection( dispatchConnection );
+
+    dispatchOwner = this;
+    dispatchConnection = connection;
+
+    send( );
+
+    dispatchOwner = owner;
+    dispatchConnection = ownerConnection;
+
+    // Outside pollEvents( ) nothing else flushes the frames just queued.
+    if( owner != this )
+    {
+        flushPending_( );
+    }
+
+    return;
+
+}
+
+
+void SocketHandler::disconnectServer( )
+{
+
+    {
+        std::lock_guard<std::mutex> lock( connectionMtx_ );
+
+        for( auto& it : connections_ )
+        {
+            shutdown( it.first, SHUT_RDWR );
+            close( it.first );
+        }
+
+        connections_.clear( );
+        isClientConnected = false;
+    }
+
+    if( serverSocket_ >= 0 )
+    {
+        shutdown(serverSocket_, SHUT_RDWR);
+        close( serverSocket_ );
+        serverSocket_ = -1;
+    }
+
+    if( wakeSocket_ >= 0 )
+    {
+        close( wakeSocket_ );
+        wakeSocket_ = -1;
+    }
+
+    if( timerSocket_ >= 0 )
+    {
+        close( timerSocket_ );
+        timerSocket_ = -1;
+    }
+
+    // The io_uring instance is kept until destruction; another thread may
+    // still be waiting on it, and the shutdown above completes that wait.
+
+    if( epollSocket_ >= 0 )
+    {
+        close( epollSocket_ );
+        epollSocket_ = -1;
+    }
+
+    return;
+
+}
+
+
+int SocketHandler::checkClientConnection( )
+{
+
+    // checkLiveness_( ) closes sockets with SO_ERROR set, so an open
+    // connection is a healthy one and no socket needs asking here.
+    std::lock_guard<std::mutex> lock( connectionMtx_ );
+
+    for( auto& it : connections_ )
+    {
+        if( it.second.closing == false )
+        {
+            return 0;
+        }
+    }
+
+    // If no client is connected, return value of "-1" will be returned.
+    return -1;
+
+}
+
+
+int SocketHandler::checkClientConnection( const int& connection )
+{
+
+    int error = 0;
+    socklen_t errorSize = sizeof( error );
+
+    if( getsockopt( connection, SOL_SOCKET, SO_ERROR, &error, &errorSize ) != 0 )
+    {
+        return -1;
+    }
+
+    // SO_ERROR holds e.g. ETIMEDOUT once keepalive or TCP_USER_TIMEOUT expire.
+    return error;
+
+}
+
+
+void SocketHandler::setLivenessTimeout(
+        const int& connection,
+        const uint32_t& timeoutMs )
+{
+
+    std::lock_guard<std::mutex> lock( connectionMtx_ );
+
+    auto it = connections_.find( connection );
+    if( it != connections_.end( ) )
+    {
+        it->second.livenessTimeout = timeoutMs;
+    }
+
+    return;
+
+}
+
+
+void SocketHandler::checkLiveness_( )
+{
+
+    uint64_t now = monotonicMs( );
+
+    std::lock_guard<std::mutex> lock( connectionMtx_ );
+
+    for( auto& it : connections_ )
+    {
+
+        Connection& connection( it.second );
+
+        if( connection.closing == true )
+        {
+            continue;
+        }
+
+        int error = 0;
+        socklen_t errorSize = sizeof( error );
+        getsockopt( connection.socket, SOL_SOCKET, SO_ERROR, &error, &errorSize );
+
+        if( error != 0 )
+        {
+            std::cout << "---" << std::endl << "Mobile device link lost: ";
+            std::cout << strerror( error ) << std::endl;
+
+            connection.closing = true;
+        }
+        else if( connection.livenessTimeout > 0
+                 && now - connection.lastReceived > connection.livenessTimeout )
+        {
+            std::cout << "---" << std::endl << "Mobile device heartbeat lapsed after ";
+            std::cout << now - connection.lastReceived << " ms." << std::endl;
+
+            connection.closing = true;
+            shutdown( connection.socket, SHUT_RDWR );
+        }
+
+    }
+
+    return;
+
+}
+
+
+void SocketHandler::listenForNewClient_( )
+{
+
+    // wait for a client
+    /* listen (this socket, request queue length) */
+    listen( serverSocket_, SOMAXCONN );
+
+    // Use this to repopulate server address information if it was cleared.
+    getsockname( serverSocket_, (struct sockaddr*)&serverAddress_, &sin_size_ );
+
+    std::cout << "---" << std::endl << "TCM awaiting mobile connection." << std::endl;
+    std::cout << "Listening on: " << inet_ntoa( serverAddress_.sin_addr );
+    std::cout << ":" << ntohs( serverAddress_.sin_port ) << std::endl;
+
+
+    return;
+
+}
+
+
+void SocketHandler::setKeepAlive_( const int& socket )
+{
+
+    int enable = 1;
+    int idle = TCP_KEEPALIVE_IDLE;
+    int interval = TCP_KEEPALIVE_INTERVAL;
+    int count = TCP_KEEPALIVE_COUNT;
+    unsigned int userTimeout = TCP_USER_TIMEOUT_MS;
+
+    if( setsockopt( socket, SOL_SOCKET, SO_KEEPALIVE, &enable, sizeof( enable ) ) != 0
+        || setsockopt( socket, IPPROTO_TCP, TCP_KEEPIDLE, &idle, sizeof( idle ) ) != 0
+        || setsockopt( socket, IPPROTO_TCP, TCP_KEEPINTVL, &interval, sizeof( interval ) ) != 0
+        || setsockopt( socket, IPPROTO_TCP, TCP_KEEPCNT, &count, sizeof( count ) ) != 0 )
+    {
+        perror( "setsockopt fail. SO_KEEPALIVE" );
+    }
+
+    // Bounds how long written data may stay unacknowledged before reset.
+    if( setsockopt( socket, IPPROTO_TCP, TCP_USER_TIMEOUT,
+                    &userTimeout, sizeof( userTimeout ) ) != 0 )
+    {
+        perror( "setsockopt fail. IPPROTO_TCP, TCP_USER_TIMEOUT" );
+    }
+
+    return;
+
+}
+
+
+void SocketHandler::setNonBlocking_( const int& socket )
+{
+
+    int flags = fcntl( socket, F_GETFL, 0 );
+
+    if( flags < 0 || fcntl( socket, F_SETFL, flags | O_NONBLOCK ) < 0 )
+    {
+        perror( "ERROR setting socket non-blocking." );
+    }
 
     return;
 
@@ -161,194 +161,3 @@ TemplateHandler::TemplateHandler( )
         {"lock_status", 99}
     };
 }
-
-const char * rawTextManeuverStatus = "\
-NotActive \
-Scanning \
-Selecting \
-Confirming \
-Manoeuvring \
-Interrupted \
-Finishing \
-Ended \
-RCStartStop \
-Holding \
-Cancelled \
-RESERVED4 \
-RESERVED3 \
-RESERVED2 \
-RESERVED1 \
-RESERVED \
-";
-
-const char * rawTextNoFeatureAvailableMsg = "\
-None \
-NotAvailableSystemFault \
-NotAvailableSensorBlocked \
-NotAvailableVehicleNotStarted \
-NotAvailableTiltTooStrong \
-NotAvailableTrailerConnected \
-NotAvailableRideHeight \
-NotAvailableSpeedToohigh \
-NotAvailableATPC \
-NotAvailableTowAssistOn \
-NotAvailableWadeAssistOn \
-NotAvailableACCOn \
-NotAvailableTJPOn \
-NotAvailableVehicleOnMotorway \
-Reserved2 \
-Reserved1 \
-";
-
-const char * rawTextCancelMsg = "\
-None \
-CancelledFromLossOfTraction \
-CancelledMaxNumMovesReached \
-CancelledPausedForTooLong \
-CancelledInternalSystemFailure \
-CancelledTrailerConnected \
-ManoeuvreCancelledDriverRequest \
-ManoeuvreCancelledVehicleDrivenOn \
-CancelledSpeedTooHigh \
-CancelledVehicleInMotorway \
-Reserved6 \
-Reserved5 \
-Reserved4 \
-Reserved3 \
-Reserved2 \
-Reserved1 \
-";
-
-const char * rawTextPauseMsg1 = "\
-None \
-PausedDriverReq \
-PausedSteeringIntervention \
-PausedManualGearChange \
-PausedDriverBraked \
-PausedParkBrake \
-PausedAcceleratorPressed \
-PausedEngineStalled \
-PausedDoorOpen \
-PausedBootOpen \
-PausedBonnetOpen \
-PausedObstacleDetected \
-PauseRideHeightChanged \
-PausedSensorPerformance \
-RemoteCommunicationLost \
-PausedPowerLow \
-";
-
-const char * rawTextPauseMsg2 = "\
-None \
-ActivityKeyInVehicle \
-ActivityKeyOutsideLegalDistance \
-ActivityKeyDistanceIndeterminate \
-ActivityKeyMissing \
-MaximumDistanceReached \
-MaximumDurationForOperationReached \
-ApplicationCRCFailure \
-ChallengeResponseMismatch \
-DMHInvalid \
-TemporarySystemFailure \
-";
-
-const char * rawTextLMInfoRMT = "\
-None \
-SearchingForSpaces \
-SlowDownSearchForSpaces \
-SlowDownViewSpaces \
-DriveForwardSpaceSearch \
-MoveSuspensionToNormalHeight \
-SpaceTooSmall \
-NarrowSpaceAvailableThroughRemoteOnly \
-SpaceOccupied \
-CantManeuverIntoSpace \
-BringVehicleToRestAndApplyBrake \
-ConfirmAndReleaseBrakeToStart \
-ReleaseBrakeToStart \
-MoveIndicatorToChangeSelectionSide \
-NoAvailableParkOut \
-NotEnoughSpaceToParkOut \
-SelectParkOutManeuver \
-RemoteDeviceConnectedAndReady \
-RemoteDeviceBatteryTooLow \
-RemoteManeuverReady \
-DriverMustBeOutsideOfVehicle \
-PowerReservesLow \
-MindOtherRoadUsersDisclaimer \
-EngageReverseToStartManeuver \
-ApproachingLegalDistanceLimit \
-ApproachingMaximumDistance \
-ApproachingMaximumDistanceForOperation \
-";
-
-const char * rawTextInstructMsg = "\
-None \
-BringVehicleToRest \
-ReleaseBrakesToStart \
-SelectR \
-SelectD \
-SelectFirstGear \
-DeselctRtoDisplaySpaces \
-DriveForward \
-ContinueForward \
-DriveBackward \
-ContinueBackward \
-Stop \
-EngageParkBrake \
-MonitorManouevreInProgress \
-RemoteManouevreInProgress \
-VehicleStopping \
-VehicleStopped \
-SystemOperationRestrictedCapabilityReached \
-SystemOperationRestrictedOccupantMovement \
-PressAcceleratorToResume \
-PauseManuouevre \
-PowerReservesLow \
-MindOtherRoadUsersDisclaimer \
-EngageReverseToStartManeuver \
-ApproachingLegalDistanceLimit \
-ApproachingMaximumDistance \
-ApproachingMaximumDistanceForOperation \
-";
-
-const char * rawAcknowledgeRemotePIN = "\
-None \
-IncorrectPIN \
-IncorrectPIN3xLock60s \
-IncorrectPIN3xLock300s \
-IncorrectPIN3xLock3600s \
-IncorrectPIN3xLockIndefinite \
-ExpiredPIN \
-NotSetInDCM \
-CorrectPIN \
-";
-
-const char * rawErrorMsg = "\
-None \
-ElectricChargerConnected \
-StolenVehicleTrackingAlert \
-RemoteStartMaxAttemptsReached \
-VehicleCrashDetected \
-LowFuelWarning \
-ErrorFromCCM \
-MultipleKeyFobsDetected \
-LowBatteryWarning \
-RemoteSessionExpirationWarning \
-Reserved9 \
-Reserved8 \
-Reserved7 \
-Reserved6 \
-Reserved5 \
-Reserved4 \
-Reserved3 \
-Reserved2 \
-Reserved1 \
-Reserved0 \
-WiFiAdvertisingTimeoutIn30sec \
-WiFiAdvertisingTimeoutIn1min \
-WiFiAdvertisingTimeoutIn2min \
-WiFiAdvertisingTimeoutIn3min \
-WiFiAdvertisingTimeoutIn4min \
-WiFiAdvertisingTimeoutIn5min \
-";
@@ -0,0 +1,379 @@
+/*! \license
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * \copyright 2021 Dan Fernández
+ *
+ * \file Class definition for \p UringQueue.
+ *
+ * \author fdaniel, trice2
+ */
+
+#include "uringqueue.hpp"
+
+#include <stdio.h>
+#include <errno.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+
+
+UringQueue::UringQueue( )
+        :
+        ringSocket_( -1 ),
+        sqRing_( MAP_FAILED ),
+        cqRing_( MAP_FAILED ),
+        sqEntries_( NULL ),
+        sqRingSize_( 0 ),
+        cqRingSize_( 0 ),
+        sqEntriesSize_( 0 ),
+        sqHead_( NULL ),
+        sqTail_( NULL ),
+        sqMask_( NULL ),
+        sqEntryCount_( NULL ),
+        sqArray_( NULL ),
+        cqHead_( NULL ),
+        cqTail_( NULL ),
+        cqMask_( NULL ),
+        cqEntries_( NULL ),
+        sqLocalTail_( 0 )
+{
+
+}
+
+
+UringQueue::~UringQueue( )
+{
+
+    release( );
+
+}
+
+
+bool UringQueue::init( const unsigned& entries )
+{
+
+    release( );
+
+    struct io_uring_params params;
+    bzero( (char *) &params, sizeof( params ) );
+
+    ringSocket_ = (int)syscall( __NR_io_uring_setup, entries, &params );
+    if( ringSocket_ < 0 )
+    {
+        perror( "ERROR creating io_uring instance." );
+
+        return false;
+    }
+
+    sqRingSize_ = params.sq_off.array + params.sq_entries * sizeof( unsigned );
+    cqRingSize_ = params.cq_off.cqes + params.cq_entries * sizeof( struct io_uring_cqe );
+
+    // Newer kernels share one mapping between both rings.
+    bool singleMap = ( params.features & IORING_FEAT_SINGLE_MMAP ) != 0;
+    if( singleMap == true )
+    {
+        if( cqRingSize_ > sqRingSize_ )
+        {
+            sqRingSize_ = cqRingSize_;
+        }
+        cqRingSize_ = sqRingSize_;
+    }
+
+    sqRing_ = mmap( NULL, sqRingSize_, PROT_READ | PROT_WRITE,
+                    MAP_SHARED | MAP_POPULATE, ringSocket_, IORING_OFF_SQ_RING );
+    cqRing_ = ( singleMap == true )
+              ? sqRing_
+              : mmap( NULL, cqRingSize_, PROT_READ | PROT_WRITE,
+                      MAP_SHARED | MAP_POPULATE, ringSocket_, IORING_OFF_CQ_RING );
+
+    sqEntriesSize_ = params.sq_entries * sizeof( struct io_uring_sqe );
+    void* sqEntries = mmap( NULL, sqEntriesSize_, PROT_READ | PROT_WRITE,
+                            MAP_SHARED | MAP_POPULATE, ringSocket_, IORING_OFF_SQES );
+
+    if( sqRing_ == MAP_FAILED || cqRing_ == MAP_FAILED || sqEntries == MAP_FAILED )
+    {
+        perror( "ERROR mapping io_uring rings." );
+
+        if( sqEntries != MAP_FAILED )
+        {
+            munmap( sqEntries, sqEntriesSize_ );
+        }
+        release( );
+
+        return false;
+    }
+
+    sqEntries_ = (struct io_uring_sqe*)sqEntries;
+
+    char* sq = (char*)sqRing_;
+    sqHead_ = (unsigned*)( sq + params.sq_off.head );
+    sqTail_ = (unsigned*)( sq + params.sq_off.tail );
+    sqMask_ = (unsigned*)( sq + params.sq_off.ring_mask );
+    sqEntryCount_ = (unsigned*)( sq + params.sq_off.ring_entries );
+    sqArray_ = (unsigned*)( sq + params.sq_off.array );
+
+    char* cq = (char*)cqRing_;
+    cqHead_ = (unsigned*)( cq + params.cq_off.head );
+    cqTail_ = (unsigned*)( cq + params.cq_off.tail );
+    cqMask_ = (unsigned*)( cq + params.cq_off.ring_mask );
+    cqEntries_ = (struct io_uring_cqe*)( cq + params.cq_off.cqes );
+
+    sqLocalTail_ = *sqTail_;
+
+
+    return true;
+
+}
+
+
+bool UringQueue::isReady( ) const
+{
+
+    return ringSocket_ >= 0;
+
+}
+
+
+bool UringQueue::registerBuffers( const struct iovec* buffers, const unsigned& count )
+{
+
+    if( syscall( __NR_io_uring_register, ringSocket_,
+                 IORING_REGISTER_BUFFERS, buffers, count ) != 0 )
+    {
+        perror( "ERROR registering io_uring buffers." );
+
+        return false;
+    }
+
+    return true;
+
+}
+
+
+bool UringQueue::prepareSendMsg(
+        const int& socket,
+        const struct msghdr* msg,
+        const int& flags,
+        const uint64_t& userData )
+{
+
+    struct io_uring_sqe* entry = nextEntry_( );
+    if( entry == NULL )
+    {
+        return false;
+    }
+
+    entry->opcode = IORING_OP_SENDMSG;
+    entry->fd = socket;
+    entry->addr = (uint64_t)(uintptr_t)msg;
+    entry->len = 1;
+    entry->msg_flags = (uint32_t)flags;
+    entry->user_data = userData;
+
+    return true;
+
+}
+
+
+bool UringQueue::prepareRecvMsg(
+        const int& socket,
+        struct msghdr* msg,
+        const int& flags,
+        const uint64_t& userData )
+{
+
+    struct io_uring_sqe* entry = nextEntry_( );
+    if( entry == NULL )
+    {
+        return false;
+    }
+
+    entry->opcode = IORING_OP_RECVMSG;
+    entry->fd = socket;
+    entry->addr = (uint64_t)(uintptr_t)msg;
+    entry->len = 1;
+    entry->msg_flags = (uint32_t)flags;
+    entry->user_data = userData;
+
+    return true;
+
+}
+
+
+bool UringQueue::prepareWriteFixed(
+        const int& socket,
+        const void* buffer,
+        const uint32_t& len,
+        const uint16_t& bufIndex,
+        const uint64_t& userData,
+        const bool& link )
+{
+
+    struct io_uring_sqe* entry = nextEntry_( );
+    if( entry == NULL )
+    {
+        return false;
+    }
+
+    entry->opcode = IORING_OP_WRITE_FIXED;
+    entry->fd = socket;
+    entry->addr = (uint64_t)(uintptr_t)buffer;
+    entry->len = len;
+    entry->buf_index = bufIndex;
+    entry->user_data = userData;
+
+    if( link == true )
+    {
+        entry->flags |= IOSQE_IO_LINK;
+    }
+
+    return true;
+
+}
+
+
+bool UringQueue::prepareReadFixed(
+        const int& socket,
+        void* buffer,
+        const uint32_t& len,
+        const uint16_t& bufIndex,
+        const uint64_t& userData )
+{
+
+    struct io_uring_sqe* entry = nextEntry_( );
+    if( entry == NULL )
+    {
+        return false;
+    }
+
+    entry->opcode = IORING_OP_READ_FIXED;
+    entry->fd = socket;
+    entry->addr = (uint64_t)(uintptr_t)buffer;
+    entry->len = len;
+    entry->buf_index = bufIndex;
+    entry->user_data = userData;
+
+    return true;
+
+}
+
+
+int UringQueue::submit( const unsigned& waitFor )
+{
+
+    // Publish the prepared entries; the kernel reads them after this store.
+    __atomic_store_n( sqTail_, sqLocalTail_, __ATOMIC_RELEASE );
+
+    unsigned flags = ( waitFor > 0 ) ? IORING_ENTER_GETEVENTS : 0;
+    int submitted;
+
+    do
+    {
+        unsigned pending = sqLocalTail_ - __atomic_load_n( sqHead_, __ATOMIC_ACQUIRE );
+
+        submitted = (int)syscall( __NR_io_uring_enter, ringSocket_,
+                                  pending, waitFor, flags, NULL, 0 );
+    }
+    while( submitted < 0 && errno == EINTR );
+
+
+    return submitted;
+
+}
+
+
+bool UringQueue::popCompletion( uint64_t& userData, int32_t& result )
+{
+
+    unsigned head = *cqHead_;
+
+    if( head == __atomic_load_n( cqTail_, __ATOMIC_ACQUIRE ) )
+    {
+        return false;
+    }
+
+    struct io_uring_cqe& completion( cqEntries_[ head & *cqMask_ ] );
+    userData = completion.user_data;
+    result = completion.res;
+
+    __atomic_store_n( cqHead_, head + 1, __ATOMIC_RELEASE );
+
+
+    return true;
+
+}
+
+
+void UringQueue::release( )
+{
+
+    if( sqEntries_ != NULL )
+    {
+        munmap( sqEntries_, sqEntriesSize_ );
+        sqEntries_ = NULL;
+    }
+
+    if( cqRing_ != MAP_FAILED && cqRing_ != sqRing_ )
+    {
+        munmap( cqRing_, cqRingSize_ );
+    }
+    cqRing_ = MAP_FAILED;
+
+    if( sqRing_ != MAP_FAILED )
+    {
+        munmap( sqRing_, sqRingSize_ );
+        sqRing_ = MAP_FAILED;
+    }
+
+    if( ringSocket_ >= 0 )
+    {
+        close( ringSocket_ );
+        ringSocket_ = -1;
+    }
+
+    return;
+
+}
+
+
+struct io_uring_sqe* UringQueue::nextEntry_( )
+{
+
+    unsigned head = __atomic_load_n( sqHead_, __ATOMIC_ACQUIRE );
+
+    if( sqLocalTail_ - head >= *sqEntryCount_ )
+    {
+        return NULL;
+    }
+
+    unsigned index = sqLocalTail_ & *sqMask_;
+    struct io_uring_sqe* entry = &sqEntries_[ index ];
+    bzero( (char *) entry, sizeof( *entry ) );
+
+    sqArray_[ index ] = index;
+    ++sqLocalTail_;
+
+
+    return entry;
+
+}
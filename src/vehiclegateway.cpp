@@ -0,0 +1,541 @@
+/*! \license
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * \copyright 2021 Dan Fernández
+ *
+ * \file Class definitions for \p VehicleGateway class.
+ *
+ * \author fdaniel, trice2
+ */
+
+#include "vehiclegateway.hpp"
+
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/timerfd.h>
+
+using json = nlohmann::json;
+
+// epoll tag of the wake eventfd; vehicle i uses 2i (mobile) and 2i+1 (ASP).
+static const uint64_t GATEWAY_WAKE_TAG = UINT64_MAX;
+
+
+VehicleGateway::VehicleGateway( )
+        :
+        vehicles_( ),
+        epollSocket_( -1 ),
+        aspEpollSocket_( -1 ),
+        wakeSocket_( -1 ),
+        timerSocket_( -1 ),
+        startTime_( 0 ),
+        overruns_( 0 ),
+        running_( false ),
+        ioLoopHandler_( ),
+        aspLoopHandler_( ),
+        timerLoopHandler_( )
+{
+}
+
+
+VehicleGateway::~VehicleGateway( )
+{
+    stop( );
+}
+
+
+bool VehicleGateway::readPort_(
+        const json& object,
+        const std::string& key,
+        const uint32_t& fallback,
+        uint16_t& port )
+{
+
+    uint32_t value = fallback;
+
+    if( object.contains( key ) )
+    {
+        if( object[ key ].is_number_unsigned( ) == false )
+        {
+            return false;
+        }
+
+        value = object[ key ].get<uint32_t>( );
+    }
+
+    if( value == 0 || value > 65535 )
+    {
+        return false;
+    }
+
+    port = (uint16_t)value;
+
+    return true;
+
+}
+
+
+bool VehicleGateway::parseConfig(
+        const std::string& config,
+        std::vector<VehicleConfig>& vehicles )
+{
+
+    json root = json::parse( config, nullptr, false );
+
+    if( root.is_discarded( ) || root.is_object( ) == false )
+    {
+        std::cout << "---" << std::endl << "ERROR: gateway config is not a JSON object." << std::endl;
+
+        return false;
+    }
+
+    AspTransportType transport = AspTransportType::Udp;
+    if( root.contains( "transport" ) && root[ "transport" ].is_string( ) )
+    {
+        transport = AspTransport::parseType( root[ "transport" ].get<std::string>( ) );
+    }
+
+    std::vector<VehicleConfig> found;
+
+    if( root.contains( "vehicles" ) && root[ "vehicles" ].is_array( ) )
+    {
+
+        for( auto& it : root[ "vehicles" ] )
+        {
+
+            VehicleConfig vehicle;
+            uint32_t index = (uint32_t)found.size( );
+
+            vehicle.name = "vehicle-" + std::to_string( index );
+            vehicle.transport = transport;
+
+            if( it.is_object( ) == false
+                || readPort_( it, "tcp_port", GATEWAY_TCP_PORT_BASE + index, vehicle.tcpPort ) == false
+                || readPort_( it, "asp_port", GATEWAY_ASP_PORT_BASE + index, vehicle.aspPort ) == false )
+            {
+                std::cout << "---" << std::endl << "ERROR: gateway vehicle " << index;
+                std::cout << " has an invalid port." << std::endl;
+
+                return false;
+            }
+
+            if( it.contains( "name" ) && it[ "name" ].is_string( ) )
+            {
+                vehicle.name = it[ "name" ].get<std::string>( );
+            }
+            if( it.contains( "transport" ) && it[ "transport" ].is_string( ) )
+            {
+                vehicle.transport = AspTransport::parseType( it[ "transport" ].get<std::string>( ) );
+            }
+
+            found.push_back( vehicle );
+
+        }
+
+    }
+    else if( root.contains( "count" ) && root[ "count" ].is_number_unsigned( ) )
+    {
+
+        uint32_t count = root[ "count" ].get<uint32_t>( );
+        uint16_t tcpBase;
+        uint16_t aspBase;
+
+        if( readPort_( root, "tcp_port_base", GATEWAY_TCP_PORT_BASE, tcpBase ) == false
+            || readPort_( root, "asp_port_base", GATEWAY_ASP_PORT_BASE, aspBase ) == false
+            || (uint32_t)tcpBase + count > 65536
+            || (uint32_t)aspBase + count > 65536 )
+        {
+            std::cout << "---" << std::endl << "ERROR: gateway port range is invalid." << std::endl;
+
+            return false;
+        }
+
+        for( uint32_t i = 0; i < count; ++i )
+        {
+            VehicleConfig vehicle;
+            vehicle.name = "vehicle-" + std::to_string( i );
+            vehicle.tcpPort = (uint16_t)( tcpBase + i );
+            vehicle.aspPort = (uint16_t)( aspBase + i );
+            vehicle.transport = transport;
+
+            found.push_back( vehicle );
+        }
+
+    }
+
+    if( found.empty( ) )
+    {
+        std::cout << "---" << std::endl << "ERROR: gateway config lists no vehicle." << std::endl;
+
+        return false;
+    }
+
+    vehicles.insert( vehicles.end( ), found.begin( ), found.end( ) );
+
+
+    return true;
+
+}
+
+
+bool VehicleGateway::loadConfig( const std::string& path )
+{
+
+    std::ifstream file( path );
+
+    if( file.is_open( ) == false )
+    {
+        std::cout << "---" << std::endl << "ERROR: cannot open gateway config " << path << std::endl;
+
+        return false;
+    }
+
+    std::stringstream contents;
+    contents << file.rdbuf( );
+
+    std::vector<VehicleConfig> vehicles;
+
+    if( parseConfig( contents.str( ), vehicles ) == false )
+    {
+        return false;
+    }
+
+    for( auto& it : vehicles )
+    {
+        addVehicle( it );
+    }
+
+
+    return true;
+
+}
+
+
+void VehicleGateway::addVehicle( const VehicleConfig& config )
+{
+
+    std::unique_ptr<Vehicle> vehicle( new Vehicle( ) );
+
+    vehicle->config = config;
+    vehicle->TCM = std::make_shared<SignalHandler>( );
+    vehicle->TCM->setTransport( config.transport );
+    vehicle->TCM->setAspPort( config.aspPort );
+
+    vehicles_.push_back( std::move( vehicle ) );
+
+    return;
+
+}
+
+
+size_t VehicleGateway::getVehicleCount( ) const
+{
+    return vehicles_.size( );
+}
+
+
+std::shared_ptr<SignalHandler> VehicleGateway::getSignalHandler( const size_t& index )
+{
+
+    if( index >= vehicles_.size( ) )
+    {
+        return std::shared_ptr<SignalHandler>( );
+    }
+
+    return vehicles_[ index ]->TCM;
+
+}
+
+
+bool VehicleGateway::start( )
+{
+
+    if( running_ == true )
+    {
+        return true;
+    }
+
+    epollSocket_ = epoll_create1( EPOLL_CLOEXEC );
+    aspEpollSocket_ = epoll_create1( EPOLL_CLOEXEC );
+    wakeSocket_ = eventfd( 0, EFD_NONBLOCK | EFD_CLOEXEC );
+    timerSocket_ = timerfd_create( CLOCK_MONOTONIC, TFD_CLOEXEC );
+
+    struct epoll_event event;
+    bzero( (char *) &event, sizeof( event ) );
+    event.events = EPOLLIN;
+    event.data.u64 = GATEWAY_WAKE_TAG;
+
+    struct itimerspec period;
+    bzero( (char *) &period, sizeof( period ) );
+    period.it_interval.tv_nsec = ASP_REFRESH_RATE * 1000L;
+    period.it_value.tv_nsec = ASP_REFRESH_RATE * 1000L;
+
+    if( epollSocket_ < 0 || aspEpollSocket_ < 0 || wakeSocket_ < 0 || timerSocket_ < 0
+        || epoll_ctl( epollSocket_, EPOLL_CTL_ADD, wakeSocket_, &event ) != 0
+        || epoll_ctl( aspEpollSocket_, EPOLL_CTL_ADD, wakeSocket_, &event ) != 0
+        || timerfd_settime( timerSocket_, 0, &period, NULL ) != 0 )
+    {
+        perror( "ERROR creating gateway event sockets." );
+
+        return false;
+    }
+
+    for( size_t i = 0; i < vehicles_.size( ); ++i )
+    {
+
+        Vehicle& vehicle = *vehicles_[ i ];
+
+        // No threads of its own; this gateway drives it.
+        vehicle.handler.reset( new RemoteDeviceHandler( vehicle.TCM, false ) );
+        vehicle.handler->bindServer( vehicle.config.tcpPort );
+
+        event.data.u64 = 2 * i;
+        if( epoll_ctl( epollSocket_, EPOLL_CTL_ADD, vehicle.handler->getEventSocket( ), &event ) != 0 )
+        {
+            std::cout << "---" << std::endl << "ERROR: " << vehicle.config.name;
+            std::cout << " not listening on port " << vehicle.config.tcpPort << std::endl;
+        }
+
+        // Links without a descriptor are polled by the timer thread.
+        int aspSocket = vehicle.TCM->getEventSocket( );
+        event.data.u64 = 2 * i + 1;
+        if( aspSocket >= 0 )
+        {
+            epoll_ctl( aspEpollSocket_, EPOLL_CTL_ADD, aspSocket, &event );
+        }
+
+    }
+
+    std::cout << "---" << std::endl << "Gateway serving " << vehicles_.size( );
+    std::cout << " vehicles" << std::endl;
+
+    startTime_ = LatencyHistogram::now( );
+    overruns_ = 0;
+    running_ = true;
+
+    ioLoopHandler_ = std::thread( &VehicleGateway::ioEventLoop_, this, epollSocket_ );
+    aspLoopHandler_ = std::thread( &VehicleGateway::ioEventLoop_, this, aspEpollSocket_ );
+    timerLoopHandler_ = std::thread( &VehicleGateway::timerEventLoop_, this );
+
+
+    return true;
+
+}
+
+
+void VehicleGateway::spin( )
+{
+
+    if( start( ) == false )
+    {
+        return;
+    }
+
+    uint64_t lastReport = LatencyHistogram::now( );
+
+    while( running_ )
+    {
+        usleep( ASP_REFRESH_RATE );
+
+        if( LatencyHistogram::now( ) - lastReport > GATEWAY_REPORT_PERIOD * 1000000000ull )
+        {
+            printReport( );
+            lastReport = LatencyHistogram::now( );
+        }
+    }
+
+    return;
+
+}
+
+
+void VehicleGateway::stop( )
+{
+
+    if( running_.exchange( false ) == true )
+    {
+        eventfd_write( wakeSocket_, 1 );
+
+        ioLoopHandler_.join( );
+        aspLoopHandler_.join( );
+        timerLoopHandler_.join( );
+    }
+
+    for( auto& it : vehicles_ )
+    {
+        if( it->handler )
+        {
+            it->handler->stop( );
+            it->handler->closeServer( );
+            it->handler.reset( );
+        }
+    }
+
+    for( int* socket : { &epollSocket_, &aspEpollSocket_, &wakeSocket_, &timerSocket_ } )
+    {
+        if( *socket >= 0 )
+        {
+            close( *socket );
+            *socket = -1;
+        }
+    }
+
+    return;
+
+}
+
+
+uint64_t VehicleGateway::getOverrunCount( ) const
+{
+    return overruns_;
+}
+
+
+void VehicleGateway::printReport( const bool& perVehicle )
+{
+
+    double elapsed = ( LatencyHistogram::now( ) - startTime_ ) / 1e9;
+    LatencyHistogram total;
+    uint64_t worst = 0;
+    std::string worstName;
+
+    for( auto& it : vehicles_ )
+    {
+
+        LatencyHistogram& latency = it->TCM->getArrivalToDecodeLatency( );
+        total.merge( latency );
+
+        if( latency.getPercentile( 99 ) >= worst )
+        {
+            worst = latency.getPercentile( 99 );
+            worstName = it->config.name;
+        }
+
+        if( perVehicle == true )
+        {
+            latency.print( it->config.name + " ASP arrival to decode" );
+            it->TCM->getDecodeToSendLatency( ).print( it->config.name + " ManeuverStatus decode to send" );
+        }
+
+    }
+
+    std::cout << "---" << std::endl << "Gateway: " << vehicles_.size( ) << " vehicles, ";
+    std::cout << (uint64_t)( elapsed > 0 ? total.getCount( ) / elapsed : 0 );
+    std::cout << " ASP packets/s, " << overruns_ << " timer overruns" << std::endl;
+    total.print( "All vehicles ASP arrival to decode" );
+    std::cout << "Slowest vehicle: " << worstName << "\tp99 < " << worst << " us" << std::endl;
+
+    return;
+
+}
+
+
+void VehicleGateway::ioEventLoop_( const int& epollSocket )
+{
+
+    struct epoll_event events[ GATEWAY_MAX_EVENTS ];
+
+    while( running_ )
+    {
+
+        int ready = epoll_wait( epollSocket, events, GATEWAY_MAX_EVENTS, -1 );
+
+        if( ready < 0 )
+        {
+            if( errno == EINTR )
+            {
+                continue;
+            }
+
+            perror( "ERROR waiting on gateway epoll." );
+
+            break;
+        }
+
+        for( int i = 0; i < ready; ++i )
+        {
+
+            uint64_t tag = events[ i ].data.u64;
+
+            // Left set, so both I/O threads see it.
+            if( tag == GATEWAY_WAKE_TAG )
+            {
+                continue;
+            }
+
+            Vehicle& vehicle = *vehicles_[ tag / 2 ];
+
+            if( tag % 2 == 1 )
+            {
+                vehicle.TCM->receiveSignals( );
+            }
+            else
+            {
+                vehicle.handler->pollEvents( 0 );
+            }
+
+        }
+
+    }
+
+    return;
+
+}
+
+
+void VehicleGateway::timerEventLoop_( )
+{
+
+    while( running_ )
+    {
+
+        uint64_t expirations;
+        if( read( timerSocket_, &expirations, sizeof( expirations ) ) <= 0 )
+        {
+            continue;
+        }
+
+        if( expirations > 1 )
+        {
+            overruns_ += expirations - 1;
+        }
+
+        for( auto& it : vehicles_ )
+        {
+
+            it->TCM->updateTimers( );
+            it->handler->updateStatus( );
+
+            // Replies on links without a descriptor are picked up a cycle late.
+            if( it->TCM->getEventSocket( ) < 0 )
+            {
+                it->TCM->receiveSignals( );
+            }
+
+            it->TCM->sendSignals( );
+
+        }
+
+    }
+
+    return;
+
+}
@@ -15,7 +15,8 @@ protected:
         std::this_thread::sleep_for(std::chrono::milliseconds(10));
         // simulate RD authentication
         sh_->AcknowledgeRemotePIN = DCM::AcknowledgeRemotePIN::CorrectPIN;
-        sh_->ConnectionApproval = TCM::ConnectionApproval::AllowedDevice;
+        sh_->publishAspSnapshot();
+        sh_->setConnectionApproval(TCM::ConnectionApproval::AllowedDevice);
         client_->receive(); // clear vehicle_status for CorrectPIN
     }
     virtual void TearDown() {
@@ -67,6 +68,7 @@ protected:
 // then "ready" field in vehicle_init should be true
 TEST_F(ASPSignalTest, ActiveAutonomousFeatureMobileInitReady) {
     sh_->ActiveAutonomousFeature = ASP::ActiveAutonomousFeature::Parking;
+    sh_->publishAspSnapshot();
     sendMobileInit();
     struct TCPMessage reply = client_->receive();
     json reply_header = json::parse(reply.header);
@@ -79,6 +81,7 @@ TEST_F(ASPSignalTest, ActiveAutonomousFeatureMobileInitReady) {
 // then "ready" field in vehicle_init should be false
 TEST_F(ASPSignalTest, ActiveAutonomousFeatureMobileInitNotReady) {
     sh_->ActiveAutonomousFeature = ASP::ActiveAutonomousFeature::NoFeatureActive;
+    sh_->publishAspSnapshot();
     sendMobileInit();
     struct TCPMessage reply = client_->receive();
     json reply_header = json::parse(reply.header);
@@ -91,6 +94,7 @@ TEST_F(ASPSignalTest, ActiveAutonomousFeatureMobileInitNotReady) {
 // then vehicle_status should be sent with corresponding "status_code" and "status_text"
 TEST_F(ASPSignalTest, CancelMsg) {
     sh_->CancelMsg = ASP::CancelMsg::CancelledFromLossOfTraction;
+    sh_->publishAspSnapshot();
     struct TCPMessage reply = client_->receive();
     json reply_header = json::parse(reply.header);
     EXPECT_EQ(reply_header["group"], (std::string)RD::VEHICLE_STATUS);
@@ -98,6 +102,7 @@ TEST_F(ASPSignalTest, CancelMsg) {
     EXPECT_EQ(reply_body[ "status_2xx" ]["status_code"], 201);
     EXPECT_EQ(reply_body[ "status_2xx" ]["status_text"], "CancelledFromLossOfTraction");
     sh_->CancelMsg = ASP::CancelMsg::CancelledSpeedTooHigh;
+    sh_->publishAspSnapshot();
     struct TCPMessage reply2 = client_->receive();
     json reply2_header = json::parse(reply2.header);
     EXPECT_EQ(reply_header["group"], (std::string)RD::VEHICLE_STATUS);
@@ -113,6 +118,7 @@ TEST_F(ASPSignalTest, ConfirmAvailabilityManeuverInitConfirmed) {
     sh_->ActiveManeuverOrientation = ASP::ActiveManeuverOrientation::PerpendicularFront;
     sh_->ConfirmAvailability = ASP::ConfirmAvailability::OfferEnabled;
     sh_->ManeuverStatus = ASP::ManeuverStatus::Confirming;
+    sh_->publishAspSnapshot();
     sendManeuverInit("StrFwd");
     struct TCPMessage reply = client_->receive(true);
     json reply_header = json::parse(reply.header);
@@ -128,6 +134,7 @@ TEST_F(ASPSignalTest, ConfirmAvailabilityManeuverInitUnconfirmed) {
     sh_->ActiveManeuverOrientation = ASP::ActiveManeuverOrientation::PerpendicularRear;
     sh_->ConfirmAvailability = ASP::ConfirmAvailability::OfferDisabled;
     sh_->ManeuverStatus = ASP::ManeuverStatus::Confirming;
+    sh_->publishAspSnapshot();
     sendManeuverInit("StrRvs");
     struct TCPMessage reply = client_->receive(true);
     json reply_header = json::parse(reply.header);
@@ -140,6 +147,7 @@ TEST_F(ASPSignalTest, ConfirmAvailabilityManeuverInitUnconfirmed) {
 // then vehicle_status should be sent with corresponding "status_code" and "status_text"
 TEST_F(ASPSignalTest, NoFeatureAvailableMsg) {
     sh_->NoFeatureAvailableMsg = ASP::NoFeatureAvailableMsg::NotAvailableACCOn;
+    sh_->publishAspSnapshot();
     struct TCPMessage reply = client_->receive();
     json reply_header = json::parse(reply.header);
     EXPECT_EQ(reply_header["group"], (std::string)RD::VEHICLE_STATUS);
@@ -147,6 +155,7 @@ TEST_F(ASPSignalTest, NoFeatureAvailableMsg) {
     EXPECT_EQ(reply_body[ "status_1xx" ]["status_code"], 111);
     EXPECT_EQ(reply_body[ "status_1xx" ]["status_text"], "NotAvailableACCOn");
     sh_->NoFeatureAvailableMsg = ASP::NoFeatureAvailableMsg::NotAvailableSpeedToohigh;
+    sh_->publishAspSnapshot();
     struct TCPMessage reply2 = client_->receive();
     json reply2_header = json::parse(reply2.header);
     EXPECT_EQ(reply_header["group"], (std::string)RD::VEHICLE_STATUS);
@@ -159,6 +168,7 @@ TEST_F(ASPSignalTest, NoFeatureAvailableMsg) {
 // then vehicle_status should be sent with corresponding "status_code" and "status_text"
 TEST_F(ASPSignalTest, InfoMsg) {
     sh_->InfoMsg = ASP::InfoMsg::ApproachingMaximumDistance;
+    sh_->publishAspSnapshot();
     struct TCPMessage reply = client_->receive();
     json reply_header = json::parse(reply.header);
     EXPECT_EQ(reply_header["group"], (std::string)RD::VEHICLE_STATUS);
@@ -166,6 +176,7 @@ TEST_F(ASPSignalTest, InfoMsg) {
     EXPECT_EQ(reply_body[ "status_5xx" ]["status_code"], 525);
     EXPECT_EQ(reply_body[ "status_5xx" ]["status_text"], "ApproachingMaximumDistance");
     sh_->InfoMsg = ASP::InfoMsg::ConfirmAndReleaseBrakeToStart;
+    sh_->publishAspSnapshot();
     struct TCPMessage reply2 = client_->receive();
     json reply2_header = json::parse(reply2.header);
     EXPECT_EQ(reply_header["group"], (std::string)RD::VEHICLE_STATUS);
@@ -178,6 +189,7 @@ TEST_F(ASPSignalTest, InfoMsg) {
 // then vehicle_status should be sent with corresponding "status_code" and "status_text"
 TEST_F(ASPSignalTest, InstructMsg) {
     sh_->InstructMsg = ASP::InstructMsg::ContinueForward;
+    sh_->publishAspSnapshot();
     struct TCPMessage reply = client_->receive();
     json reply_header = json::parse(reply.header);
     EXPECT_EQ(reply_header["group"], (std::string)RD::VEHICLE_STATUS);
@@ -185,6 +197,7 @@ TEST_F(ASPSignalTest, InstructMsg) {
     EXPECT_EQ(reply_body[ "status_6xx" ]["status_code"], 608);
     EXPECT_EQ(reply_body[ "status_6xx" ]["status_text"], "ContinueForward");
     sh_->InstructMsg = ASP::InstructMsg::EngageParkBrake;
+    sh_->publishAspSnapshot();
     struct TCPMessage reply2 = client_->receive();
     json reply2_header = json::parse(reply2.header);
     EXPECT_EQ(reply_header["group"], (std::string)RD::VEHICLE_STATUS);
@@ -199,6 +212,7 @@ TEST_F(ASPSignalTest, ActiveParkingTypePushPull) {
     sh_->ActiveParkingType = ASP::ActiveParkingType::PushPull;
     sh_->ActiveManeuverOrientation = ASP::ActiveManeuverOrientation::PerpendicularFront;
     sh_->ConfirmAvailability = ASP::ConfirmAvailability::OfferEnabled;
+    sh_->publishAspSnapshot();
     sendManeuverInit("StrFwd");
     struct TCPMessage reply = client_->receive();
     json reply_header = json::parse(reply.header);
@@ -214,6 +228,7 @@ TEST_F(ASPSignalTest, ActiveParkingTypeInvalid) {
     sh_->ActiveParkingType = ASP::ActiveParkingType::None;
     sh_->ActiveManeuverOrientation = ASP::ActiveManeuverOrientation::PerpendicularFront;
     sh_->ConfirmAvailability = ASP::ConfirmAvailability::OfferEnabled;
+    sh_->publishAspSnapshot();
     sendManeuverInit("StrRvs");
     struct TCPMessage reply = client_->receive();
     json reply_header = json::parse(reply.header);
@@ -226,6 +241,7 @@ TEST_F(ASPSignalTest, ActiveParkingTypeInvalid) {
 // then vehicle_status should be sent with corresponding "status_code" and "status_text"
 TEST_F(ASPSignalTest, PauseMsg2) {
     sh_->PauseMsg2 = ASP::PauseMsg2::ActivityKeyMissing;
+    sh_->publishAspSnapshot();
     struct TCPMessage reply = client_->receive();
     json reply_header = json::parse(reply.header);
     EXPECT_EQ(reply_header["group"], (std::string)RD::VEHICLE_STATUS);
@@ -233,6 +249,7 @@ TEST_F(ASPSignalTest, PauseMsg2) {
     EXPECT_EQ(reply_body[ "status_4xx" ]["status_code"], 404);
     EXPECT_EQ(reply_body[ "status_4xx" ]["status_text"], "ActivityKeyMissing");
     sh_->PauseMsg2 = ASP::PauseMsg2::MaximumDistanceReached;
+    sh_->publishAspSnapshot();
     struct TCPMessage reply2 = client_->receive();
     json reply2_header = json::parse(reply2.header);
     EXPECT_EQ(reply_header["group"], (std::string)RD::VEHICLE_STATUS);
@@ -245,6 +262,7 @@ TEST_F(ASPSignalTest, PauseMsg2) {
 // then vehicle_status should be sent with corresponding "status_code" and "status_text"
 TEST_F(ASPSignalTest, PauseMsg1) {
     sh_->PauseMsg1 = ASP::PauseMsg1::PausedBootOpen;
+    sh_->publishAspSnapshot();
     struct TCPMessage reply = client_->receive();
     json reply_header = json::parse(reply.header);
     EXPECT_EQ(reply_header["group"], (std::string)RD::VEHICLE_STATUS);
@@ -252,6 +270,7 @@ TEST_F(ASPSignalTest, PauseMsg1) {
     EXPECT_EQ(reply_body[ "status_3xx" ]["status_code"], 309);
     EXPECT_EQ(reply_body[ "status_3xx" ]["status_text"], "PausedBootOpen");
     sh_->PauseMsg1 = ASP::PauseMsg1::PausedPowerLow;
+    sh_->publishAspSnapshot();
     struct TCPMessage reply2 = client_->receive();
     json reply2_header = json::parse(reply2.header);
     EXPECT_EQ(reply_header["group"], (std::string)RD::VEHICLE_STATUS);
@@ -264,6 +283,7 @@ TEST_F(ASPSignalTest, PauseMsg1) {
 // then mobile_challenge should be sent
 TEST_F(ASPSignalTest, MobileChallengeSend) {
     sh_->MobileChallengeSend = 0x1234567890abcdef;
+    sh_->publishAspSnapshot();
     std::ostringstream challengeVal;
     challengeVal << sh_->MobileChallengeSend;
     struct TCPMessage reply = client_->receive();
@@ -278,6 +298,7 @@ TEST_F(ASPSignalTest, MobileChallengeSend) {
 TEST_F(ASPSignalTest, ManeuverStatus) {
     sh_->ConfirmAvailability = ASP::ConfirmAvailability::OfferEnabled;
     sh_->ManeuverStatus = ASP::ManeuverStatus::Maneuvering;
+    sh_->publishAspSnapshot();
     struct TCPMessage reply = client_->receive();
     json reply_header = json::parse(reply.header);
     EXPECT_EQ(reply_header["group"], (std::string)RD::MANEUVER_STATUS);
@@ -285,6 +306,7 @@ TEST_F(ASPSignalTest, ManeuverStatus) {
     EXPECT_EQ(reply_body["progress"], 0);
     EXPECT_EQ(reply_body["status"], 904);
     sh_->ManeuverStatus = ASP::ManeuverStatus::Scanning;
+    sh_->publishAspSnapshot();
     struct TCPMessage reply2 = client_->receive();
     json reply2_header = json::parse(reply2.header);
     EXPECT_EQ(reply_header["group"], (std::string)RD::MANEUVER_STATUS);
@@ -298,9 +320,11 @@ TEST_F(ASPSignalTest, ManeuverStatus) {
 TEST_F(ASPSignalTest, ManeuverStatusScanningToSelecting) {
     sh_->ConfirmAvailability = ASP::ConfirmAvailability::OfferEnabled;
     sh_->ManeuverStatus = ASP::ManeuverStatus::Scanning;
+    sh_->publishAspSnapshot();
     sendGetThreatData();
     sendListManeuvers();
     sh_->ManeuverStatus = ASP::ManeuverStatus::Selecting;
+    sh_->publishAspSnapshot();
 
     // expecting three replies - available_maneuvers, threat_data, and
     // maneuver_status; these can arrive in any order
@@ -339,8 +363,10 @@ TEST_F(ASPSignalTest, ManeuverStatusSelectingToConfirming) {
     sh_->ActiveManeuverOrientation = ASP::ActiveManeuverOrientation::PerpendicularFront;
     sh_->ConfirmAvailability = ASP::ConfirmAvailability::OfferEnabled;
     sh_->ManeuverStatus = ASP::ManeuverStatus::Selecting;
+    sh_->publishAspSnapshot();
     sendManeuverInit("StrFwd");
     sh_->ManeuverStatus = ASP::ManeuverStatus::Confirming;
+    sh_->publishAspSnapshot();
     struct TCPMessage reply = client_->receive(true);
     json reply_header = json::parse(reply.header);
     EXPECT_EQ(reply_header["group"], (std::string)RD::MANEUVER_STATUS);
@@ -350,8 +376,10 @@ TEST_F(ASPSignalTest, ManeuverStatusSelectingToConfirming) {
 // then maneuver_status should be sent
 TEST_F(ASPSignalTest, ManeuverStatusManeuveringToCancelled) {
     sh_->ManeuverStatus = ASP::ManeuverStatus::Maneuvering;
+    sh_->publishAspSnapshot();
     sendCancelManeuver();
     sh_->ManeuverStatus = ASP::ManeuverStatus::Cancelled;
+    sh_->publishAspSnapshot();
     struct TCPMessage reply = client_->receive(true);
     json reply_header = json::parse(reply.header);
     EXPECT_EQ(reply_header["group"], (std::string)RD::MANEUVER_STATUS);
@@ -361,6 +389,7 @@ TEST_F(ASPSignalTest, ManeuverStatusManeuveringToCancelled) {
 // then maneuver_status should be sent
 TEST_F(ASPSignalTest, ManeuverStatusFinishing) {
     sh_->ManeuverStatus = ASP::ManeuverStatus::Finishing;
+    sh_->publishAspSnapshot();
     struct TCPMessage reply = client_->receive(true);
     json reply_header = json::parse(reply.header);
     EXPECT_EQ(reply_header["group"], (std::string)RD::MANEUVER_STATUS);
@@ -370,6 +399,7 @@ TEST_F(ASPSignalTest, ManeuverStatusFinishing) {
 // then vehicle_status should be sent
 TEST_F(ASPSignalTest, ManeuverStatusEnded) {
     sh_->ManeuverStatus = ASP::ManeuverStatus::Ended;
+    sh_->publishAspSnapshot();
     struct TCPMessage reply = client_->receive();
     json reply_header = json::parse(reply.header);
     EXPECT_EQ(reply_header["group"], (std::string)RD::VEHICLE_STATUS);
@@ -379,6 +409,7 @@ TEST_F(ASPSignalTest, ManeuverStatusEnded) {
 // then "active_maneuver" field in vehicle_init should be false
 TEST_F(ASPSignalTest, ManeuverStatusVehicleInit) {
     sh_->ManeuverStatus = ASP::ManeuverStatus::NotActive;
+    sh_->publishAspSnapshot();
     sendMobileInit();
     struct TCPMessage reply = client_->receive(true);
     json reply_header = json::parse(reply.header);
@@ -391,6 +422,7 @@ TEST_F(ASPSignalTest, ManeuverStatusVehicleInit) {
 // then "active_maneuver" field in vehicle_init should be true
 TEST_F(ASPSignalTest, ManeuverStatusVehicleInitManeuverInProgress) {
     sh_->ManeuverStatus = ASP::ManeuverStatus::Maneuvering;
+    sh_->publishAspSnapshot();
     sendMobileInit();
 
     // expecting two statuses - vehicle_init and maneuver_status
@@ -432,6 +464,7 @@ TEST_F(ASPSignalTest, ManeuverStatusManeuverStatusManeuvering) {
     sh_->ActiveManeuverOrientation = ASP::ActiveManeuverOrientation::PerpendicularRear;
     sh_->ManeuverStatus = ASP::ManeuverStatus::Maneuvering;
     sh_->ConfirmAvailability = ASP::ConfirmAvailability::OfferEnabled;
+    sh_->publishAspSnapshot();
     sendManeuverInit("StrRvs");
     struct TCPMessage reply = client_->receive(true);
     json reply_header = json::parse(reply.header);
@@ -447,6 +480,7 @@ TEST_F(ASPSignalTest, ManeuverStatusManeuverStatusCancelled) {
     sh_->ActiveManeuverOrientation = ASP::ActiveManeuverOrientation::PerpendicularFront;
     sh_->ManeuverStatus = ASP::ManeuverStatus::Cancelled;
     sh_->ConfirmAvailability = ASP::ConfirmAvailability::OfferEnabled;
+    sh_->publishAspSnapshot();
     sendManeuverInit("StrFwd");
     struct TCPMessage reply = client_->receive(true);
     json reply_header = json::parse(reply.header);
@@ -461,6 +495,7 @@ TEST_F(ASPSignalTest, ManeuverProgressBar) {
     sh_->ActiveManeuverOrientation = ASP::ActiveManeuverOrientation::PerpendicularRear;
     sh_->ManeuverProgressBar = 77;
     sh_->ConfirmAvailability = ASP::ConfirmAvailability::OfferEnabled;
+    sh_->publishAspSnapshot();
     sendManeuverInit("StrRvs");
     struct TCPMessage reply = client_->receive(true);
     json reply_header = json::parse(reply.header);
@@ -488,7 +523,9 @@ TEST_F(ASPSignalTest, AvailableManeuversAllBranches) {
         sh_->ActiveParkingMode = (ASP::ActiveParkingMode)ActiveParkingMode;
         sh_->ActiveManeuverOrientation = (ASP::ActiveManeuverOrientation)ActiveManeuverOrientation;
         sh_->ManeuverSideAvailability = (ASP::ManeuverSideAvailability)ManeuverSideAvailability;
+        sh_->publishAspSnapshot();
         sh_->hasVehicleMoved = true;
+        sh_->markStateChanged(); // written directly, not decoded
         sendListManeuvers();
         struct TCPMessage reply = client_->receive();
         json reply_header = json::parse(reply.header);
@@ -655,6 +692,7 @@ TEST_F(ASPSignalTest, ThreatDataAllSignals) {
     sh_->threatDistanceData.ASPMFrontSegDist14RMT = ++i;
     sh_->threatDistanceData.ASPMFrontSegDist15RMT = ++i;
     sh_->threatDistanceData.ASPMFrontSegDist16RMT = ++i;
+    sh_->publishAspSnapshot();
     i = 20;
     sh_->threatDistanceData.ASPMRearSegDist1RMT = --i;
     sh_->threatDistanceData.ASPMRearSegDist2RMT = --i;
@@ -672,6 +710,7 @@ TEST_F(ASPSignalTest, ThreatDataAllSignals) {
     sh_->threatDistanceData.ASPMRearSegDist14RMT = --i;
     sh_->threatDistanceData.ASPMRearSegDist15RMT = --i;
     sh_->threatDistanceData.ASPMRearSegDist16RMT = --i;
+    sh_->publishAspSnapshot();
 
     sh_->threatTypeData.ASPMFrontSegType1RMT = 0;
     sh_->threatTypeData.ASPMFrontSegType2RMT = 1;
@@ -689,6 +728,7 @@ TEST_F(ASPSignalTest, ThreatDataAllSignals) {
     sh_->threatTypeData.ASPMFrontSegType14RMT = 1;
     sh_->threatTypeData.ASPMFrontSegType15RMT = 0;
     sh_->threatTypeData.ASPMFrontSegType16RMT = 1;
+    sh_->publishAspSnapshot();
 
     sh_->threatTypeData.ASPMRearSegType1RMT = 1;
     sh_->threatTypeData.ASPMRearSegType2RMT = 0;
@@ -706,6 +746,7 @@ TEST_F(ASPSignalTest, ThreatDataAllSignals) {
     sh_->threatTypeData.ASPMRearSegType14RMT = 0;
     sh_->threatTypeData.ASPMRearSegType15RMT = 1;
     sh_->threatTypeData.ASPMRearSegType16RMT = 0;
+    sh_->publishAspSnapshot();
 
     sendGetThreatData();
 
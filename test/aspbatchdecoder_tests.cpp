@@ -0,0 +1,107 @@
+#include <gtest/gtest.h>
+
+#include "aspbatchdecoder.hpp"
+#include "pdusignals.hpp"
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+namespace {
+const uint32_t pduIds[] = {HRD_ID_OF_ASPM_LM, HRD_ID_OF_ASPM_LM_ObjSegment, HRD_ID_OF_ASPM_RemoteTarget,
+                           HRD_ID_OF_ASPM_LM_Session, HRD_ID_OF_ASPM_LM_Trunc};
+
+// random payloads behind valid headers, with the PDUs in a random order
+std::vector<uint8_t> randomPackets(size_t n, std::mt19937& random) {
+    std::vector<uint8_t> packets(n * ASPM_TOTAL_PACKET_SIZE);
+    for (size_t i = 0; i < n; ++i) {
+        std::vector<uint32_t> order(std::begin(pduIds), std::end(pduIds));
+        std::shuffle(order.begin(), order.end(), random);
+        PduView pdu(&packets[i * ASPM_TOTAL_PACKET_SIZE], ASPM_TOTAL_PACKET_SIZE);
+        for (uint32_t id : order) {
+            uint32_t length = pduPayloadLength(aspmPduType(id));
+            pdu.putHeader(id, length);
+            for (uint32_t b = 0; b < length; ++b) {
+                pdu.getPayload()[b] = (uint8_t)random();
+            }
+            pdu = pdu.next();
+        }
+    }
+    return packets;
+}
+
+void expectSame(const AspSnapshot& actual, const AspSnapshot& expected, size_t packet) {
+#define EXPECT_SAME_FIELD(NAME) EXPECT_EQ((uint64_t)actual.NAME, (uint64_t)expected.NAME) << #NAME << " packet " << packet;
+    ASP_SNAPSHOT_LM_FIELDS(EXPECT_SAME_FIELD)
+#undef EXPECT_SAME_FIELD
+    for (size_t i = 0; i < ASP_THREAT_SEGMENT_COUNT; ++i) {
+        EXPECT_EQ(actual.ASPMFrontSegDistRMT[i], expected.ASPMFrontSegDistRMT[i]) << "packet " << packet;
+        EXPECT_EQ(actual.ASPMRearSegDistRMT[i], expected.ASPMRearSegDistRMT[i]) << "packet " << packet;
+        EXPECT_EQ(actual.ASPMFrontSegTypeRMT[i], expected.ASPMFrontSegTypeRMT[i]) << "packet " << packet;
+        EXPECT_EQ(actual.ASPMRearSegTypeRMT[i], expected.ASPMRearSegTypeRMT[i]) << "packet " << packet;
+    }
+}
+}
+
+// every packet decodes to what the live decoder would publish for it
+TEST(AspBatchDecoderTest, MatchesSignalHandler) {
+    std::mt19937 random(25);
+    const size_t n = 200;
+    std::vector<uint8_t> packets = randomPackets(n, random);
+
+    std::vector<AspSnapshot> batch(n);
+    AspBatchDecoder::decodeBatch(packets.data(), n, batch.data());
+
+    SignalHandler sh;
+    for (size_t i = 0; i < n; ++i) {
+        sh.decodeASPMSignalData(&packets[i * ASPM_TOTAL_PACKET_SIZE]);
+        expectSame(batch[i], sh.getAspSnapshot(), i);
+    }
+}
+
+// a batch split across threads decodes the same as on one thread
+TEST(AspBatchDecoderTest, ThreadsMatchOneThread) {
+    std::mt19937 random(4);
+    const size_t n = 4 * ASP_BATCH_THREAD_PACKETS + 3;
+    std::vector<uint8_t> packets = randomPackets(n, random);
+
+    std::vector<AspSnapshot> single(n);
+    std::vector<AspSnapshot> threaded(n);
+    AspBatchDecoder::decodeBatch(packets.data(), n, single.data(), 1);
+    AspBatchDecoder::decodeBatch(packets.data(), n, threaded.data(), 4);
+
+    for (size_t i = 0; i < n; ++i) {
+        expectSame(threaded[i], single[i], i);
+        if (HasFailure()) {
+            break;
+        }
+    }
+}
+
+// nothing carries over: a PDU with the wrong length leaves the defaults
+TEST(AspBatchDecoderTest, BadPduLeavesDefaults) {
+    std::mt19937 random(7);
+    std::vector<uint8_t> packets = randomPackets(2, random);
+    AspSnapshot defaults[2];
+    AspBatchDecoder::decodeBatch(packets.data(), 2, defaults);
+
+    // break every length field of the second packet, last byte of each header
+    std::vector<uint8_t*> lengths;
+    PduView pdu(&packets[ASPM_TOTAL_PACKET_SIZE], ASPM_TOTAL_PACKET_SIZE);
+    for (int i = 0; i < NUMBER_OF_ASPM_PDU; ++i, pdu = pdu.next()) {
+        lengths.push_back(pdu.getPayload() - 1);
+    }
+    for (uint8_t* length : lengths) {
+        *length ^= 0x80;
+    }
+
+    AspSnapshot out[2];
+    AspBatchDecoder::decodeBatch(packets.data(), 2, out);
+    expectSame(out[0], defaults[0], 0);
+    EXPECT_EQ(out[1].ManeuverStatus, ASP::ManeuverStatus::NotActive);
+    EXPECT_EQ(out[1].MobileChallengeSend, 0u);
+    for (size_t i = 0; i < ASP_THREAT_SEGMENT_COUNT; ++i) {
+        EXPECT_EQ(out[1].ASPMFrontSegDistRMT[i], ASP_THREAT_DISTANCE_NONE);
+        EXPECT_EQ(out[1].ASPMRearSegTypeRMT[i], 0);
+    }
+}
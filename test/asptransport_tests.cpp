@@ -0,0 +1,116 @@
+#include <gtest/gtest.h>
+#include <thread>
+#include <cstring>
+
+#include "asptransport.hpp"
+
+// TCM and ASP ends of one transport type, opened in the test process
+class AspTransportTest: public ::testing::TestWithParam<AspTransportType> {
+protected:
+    virtual void SetUp() {
+        asp_ = AspTransport::create(GetParam());
+        tcm_ = AspTransport::create(GetParam());
+        ASSERT_TRUE(asp_->open(false));
+        ASSERT_TRUE(tcm_->open(true));
+    }
+    virtual void TearDown() {
+        tcm_->close();
+        asp_->close();
+    }
+    std::unique_ptr<AspTransport> asp_;
+    std::unique_ptr<AspTransport> tcm_;
+};
+
+// each TCM packet is answered by the ASP, as in the 30 ms cycle
+TEST_P(AspTransportTest, ExchangeRoundTrip) {
+    std::thread echo([this]() {
+        uint8_t packet[64];
+        for (int i = 0; i < 3; ++i) {
+            ssize_t received = asp_->receive(packet, sizeof(packet));
+            ASSERT_GT(received, 0);
+            packet[0] += 1;
+            asp_->send(packet, received);
+        }
+    });
+    for (uint8_t i = 0; i < 3; ++i) {
+        uint8_t out[4] = {i, 0xAB, 0xCD, 0xEF};
+        uint8_t in[64] = {0};
+        ASSERT_EQ(tcm_->exchange(out, sizeof(out), in, sizeof(in)), (ssize_t)sizeof(out));
+        EXPECT_EQ(in[0], i + 1);
+        EXPECT_EQ(in[3], 0xEF);
+    }
+    echo.join();
+}
+
+// close() releases a receive() blocked on another thread
+TEST_P(AspTransportTest, CloseUnblocksReceive) {
+    std::thread reader([this]() {
+        uint8_t packet[64];
+        EXPECT_LE(asp_->receive(packet, sizeof(packet)), 0);
+    });
+    usleep(50000);
+    asp_->close();
+    reader.join();
+}
+
+INSTANTIATE_TEST_CASE_P(CoLocated, AspTransportTest,
+        ::testing::Values(AspTransportType::UnixDgram, AspTransportType::SharedMemory));
+
+// the shared memory link keeps only the newest packet
+TEST(SharedMemoryTransportTest, NewestPacketWins) {
+    SharedMemoryTransport asp, tcm;
+    ASSERT_TRUE(asp.open(false));
+    ASSERT_TRUE(tcm.open(true));
+    for (uint8_t i = 1; i <= 5; ++i) {
+        tcm.send(&i, 1);
+    }
+    uint8_t packet = 0;
+    EXPECT_EQ(asp.receive(&packet, 1), 1);
+    EXPECT_EQ(packet, 5);
+}
+
+// a reader racing one writer only ever sees whole packets, in order
+TEST(SharedMemoryTransportTest, ConcurrentReaderSeesNoTornPackets) {
+    SharedMemoryTransport asp, tcm;
+    ASSERT_TRUE(asp.open(false));
+    ASSERT_TRUE(tcm.open(true));
+    const uint32_t packets = 200000;
+
+    // counter, filler of a varying length, then a checksum over both
+    auto checksum = [](const uint8_t* packet, size_t size) {
+        uint32_t sum = 2166136261u;
+        for (size_t i = 0; i < size; ++i) {
+            sum = (sum ^ packet[i]) * 16777619u;
+        }
+        return sum;
+    };
+
+    std::thread writer([&]() {
+        uint8_t packet[ASP_SHM_SLOT_SIZE];
+        for (uint32_t n = 1; n <= packets; ++n) {
+            size_t size = sizeof(n) + n % (ASP_SHM_SLOT_SIZE - 2 * sizeof(n)) + sizeof(uint32_t);
+            memcpy(packet, &n, sizeof(n));
+            memset(packet + sizeof(n), (uint8_t)n, size - 2 * sizeof(n));
+            uint32_t sum = checksum(packet, size - sizeof(sum));
+            memcpy(packet + size - sizeof(sum), &sum, sizeof(sum));
+            tcm.send(packet, size);
+        }
+    });
+
+    uint8_t packet[ASP_SHM_SLOT_SIZE];
+    uint32_t last = 0;
+    uint32_t received = 0;
+    while (last < packets) {
+        ssize_t size = asp.receive(packet, sizeof(packet));
+        ASSERT_GE(size, (ssize_t)(2 * sizeof(uint32_t)));
+        uint32_t n, sum;
+        memcpy(&n, packet, sizeof(n));
+        memcpy(&sum, packet + size - sizeof(sum), sizeof(sum));
+        ASSERT_EQ(sum, checksum(packet, size - sizeof(sum))) << "torn packet after " << last;
+        ASSERT_GT(n, last);
+        last = n;
+        ++received;
+    }
+    writer.join();
+    EXPECT_EQ(received + asp.getSupersededCount(), packets);
+}
@@ -0,0 +1,38 @@
+#include <gtest/gtest.h>
+
+#include "bodycodec.hpp"
+#include "templatehandler.hpp"
+
+using json = nlohmann::json;
+
+// every encoding returns the body it was given
+TEST(BodyCodecTest, RoundTrip) {
+    TemplateHandler templates;
+    json body = templates.getRawThreatDataTemplate();
+    for (BodyEncoding encoding : {BodyEncoding::Json, BodyEncoding::Cbor, BodyEncoding::MsgPack}) {
+        std::string encoded = BodyCodec::encode(body, encoding);
+        json decoded;
+        EXPECT_TRUE(BodyCodec::decode(encoded.data(), encoded.size(), encoding, decoded));
+        EXPECT_EQ(decoded, body);
+    }
+    EXPECT_LT(BodyCodec::encode(body, BodyEncoding::Cbor).size(),
+              BodyCodec::encode(body, BodyEncoding::Json).size());
+}
+
+// malformed bodies and unknown names are reported, not thrown
+TEST(BodyCodecTest, RejectsInvalid) {
+    json decoded;
+    std::string text = "{\"pin\": ";
+    EXPECT_FALSE(BodyCodec::decode(text.data(), text.size(), BodyEncoding::Json, decoded));
+    std::string truncated = BodyCodec::encode(json({{"pin", "1234"}}), BodyEncoding::Cbor);
+    truncated.pop_back();
+    EXPECT_FALSE(BodyCodec::decode(truncated.data(), truncated.size(), BodyEncoding::Cbor, decoded));
+    EXPECT_FALSE(BodyCodec::decode(truncated.data(), truncated.size(), BodyEncoding::MsgPack, decoded));
+
+    BodyEncoding encoding = BodyEncoding::Cbor;
+    EXPECT_FALSE(BodyCodec::parseEncoding("xml", encoding));
+    EXPECT_EQ(encoding, BodyEncoding::Cbor);
+    EXPECT_TRUE(BodyCodec::parseEncoding("msgpack", encoding));
+    EXPECT_EQ(encoding, BodyEncoding::MsgPack);
+    EXPECT_STREQ(BodyCodec::getEncodingName(encoding), "msgpack");
+}
@@ -0,0 +1,74 @@
+#include <gtest/gtest.h>
+
+#include "commandqueue.hpp"
+
+#include <thread>
+#include <vector>
+
+namespace {
+struct Command {
+    uint8_t producer;
+    uint32_t index;
+};
+}
+
+// commands come out in the order they were pushed, and a full queue refuses more
+TEST(CommandQueueTest, OrderAndCapacity) {
+    CommandQueue<Command, 4> queue;
+    EXPECT_EQ(queue.front(), nullptr);
+
+    for (uint32_t i = 0; i < 4; ++i) {
+        EXPECT_TRUE(queue.push({0, i}));
+    }
+    EXPECT_FALSE(queue.push({0, 4}));
+
+    for (uint32_t i = 0; i < 4; ++i) {
+        ASSERT_NE(queue.front(), nullptr);
+        EXPECT_EQ(queue.front()->index, i);
+        queue.pop();
+    }
+    EXPECT_EQ(queue.front(), nullptr);
+
+    // slots are reused once popped
+    EXPECT_TRUE(queue.push({0, 5}));
+    ASSERT_NE(queue.front(), nullptr);
+    EXPECT_EQ(queue.front()->index, 5u);
+}
+
+// with several producers racing the consumer, each producer's commands stay in order
+TEST(CommandQueueTest, PreservesOrderPerProducer) {
+    CommandQueue<Command, 64> queue;
+    const uint8_t producers = 3;
+    const uint32_t commands = 50000;
+
+    std::vector<std::thread> threads;
+    for (uint8_t p = 0; p < producers; ++p) {
+        threads.emplace_back([&queue, p, commands] {
+            for (uint32_t i = 0; i < commands; ++i) {
+                while (!queue.push({p, i})) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+
+    uint32_t next[producers] = {0, 0, 0};
+    uint32_t received = 0;
+    int outOfOrder = 0;
+    while (received < producers * commands) {
+        const Command* command = queue.front();
+        if (command == nullptr) {
+            std::this_thread::yield();
+            continue;
+        }
+        outOfOrder += command->index != next[command->producer];
+        next[command->producer] = command->index + 1;
+        queue.pop();
+        ++received;
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    EXPECT_EQ(outOfOrder, 0);
+    EXPECT_EQ(queue.front(), nullptr);
+}
@@ -0,0 +1,47 @@
+#include <gtest/gtest.h>
+
+#include "dmhframe.hpp"
+
+#include <string>
+
+// every field survives a round trip, big-endian on the wire
+TEST(DmhFrameTest, RoundTrip) {
+    DmhSample sample = {true, 100, 0x1234, 0xFFFF, 0xBEEF};
+    char raw[DMH_FRAME_SIZE];
+    DmhFrame::encode(sample, raw);
+    EXPECT_EQ(std::string(raw, DMH_FRAME_SIZE),
+            std::string("\x01\x01\x64\x00\x12\x34\xFF\xFF\xBE\xEF", DMH_FRAME_SIZE));
+
+    DmhSample decoded = {};
+    ASSERT_TRUE(DmhFrame::decode(raw, DMH_FRAME_SIZE, decoded));
+    EXPECT_TRUE(decoded.gesture);
+    EXPECT_EQ(decoded.percent, 100);
+    EXPECT_EQ(decoded.x, 0x1234);
+    EXPECT_EQ(decoded.y, 0xFFFF);
+    EXPECT_EQ(decoded.crc, 0xBEEF);
+
+    sample.gesture = false;
+    DmhFrame::encode(sample, raw);
+    ASSERT_TRUE(DmhFrame::decode(raw, DMH_FRAME_SIZE, decoded));
+    EXPECT_FALSE(decoded.gesture);
+}
+
+// wrong size, frame type, flags or reserved byte leave the sample untouched
+TEST(DmhFrameTest, RejectsMalformed) {
+    DmhSample sample = {true, 1, 2, 3, 4};
+    char raw[DMH_FRAME_SIZE + 1] = {};
+    DmhFrame::encode(sample, raw);
+    DmhSample decoded = {false, 9, 9, 9, 9};
+    EXPECT_FALSE(DmhFrame::decode(raw, DMH_FRAME_SIZE - 1, decoded));
+    EXPECT_FALSE(DmhFrame::decode(raw, DMH_FRAME_SIZE + 1, decoded));
+    raw[0] = 0x02;
+    EXPECT_FALSE(DmhFrame::decode(raw, DMH_FRAME_SIZE, decoded));
+    raw[0] = DMH_FRAME_TYPE;
+    raw[1] = 0x03;
+    EXPECT_FALSE(DmhFrame::decode(raw, DMH_FRAME_SIZE, decoded));
+    raw[1] = DMH_FLAG_ENABLE_MOTION;
+    raw[3] = 0x01;
+    EXPECT_FALSE(DmhFrame::decode(raw, DMH_FRAME_SIZE, decoded));
+    EXPECT_EQ(decoded.percent, 9);
+    EXPECT_EQ(decoded.x, 9);
+}
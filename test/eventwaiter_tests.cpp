@@ -0,0 +1,43 @@
+#include <gtest/gtest.h>
+
+#include "eventwaiter.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <pthread.h>
+#include <signal.h>
+
+namespace {
+void ignoreSignal(int) {}
+}
+
+// signals arriving faster than the period do not restart the wait
+TEST(EventWaiterTest, SignalsDoNotExtendTheWait) {
+    struct sigaction action = {};
+    struct sigaction previous;
+    action.sa_handler = ignoreSignal;
+    sigaction(SIGUSR1, &action, &previous); // no SA_RESTART, so ppoll() sees EINTR
+
+    EventWaiter waiter;
+    pthread_t self = pthread_self();
+    std::atomic<bool> done(false);
+    std::thread signaller([&]() {
+        // keep interrupting for well past the 20 ms period, up to 2 s
+        for (int i = 0; i < 1000 && !done; ++i) {
+            pthread_kill(self, SIGUSR1);
+            std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        }
+    });
+
+    auto start = std::chrono::steady_clock::now();
+    EXPECT_TRUE(waiter.waitFor(20000));
+    double elapsedMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    done = true;
+    signaller.join();
+    sigaction(SIGUSR1, &previous, NULL);
+
+    // an oversleeping wait would run until the signals stop
+    EXPECT_GE(elapsedMs, 19.0);
+    EXPECT_LT(elapsedMs, 1000.0);
+}
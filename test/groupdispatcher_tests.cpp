@@ -0,0 +1,61 @@
+#include <gtest/gtest.h>
+
+#include <string.h>
+
+#include "groupdispatcher.hpp"
+
+namespace {
+const FieldSpec PIN_FIELDS[] = {{"pin", FieldType::String, true}};
+const RequestSchema PIN_SCHEMA = makeSchema(PIN_FIELDS);
+
+bool dispatch(const GroupDispatcher& dispatcher, const std::string& group, const RequestBody& body) {
+    return dispatcher.dispatch(group.data(), group.size(), body);
+}
+}
+
+// each registered group reaches its own handler with the message body
+TEST(GroupDispatcherTest, DispatchesByGroup) {
+    GroupDispatcher dispatcher;
+    std::string called;
+    EXPECT_TRUE(dispatcher.add(RD::SEND_PIN, [&called](const RequestBody& body) { called = body.getString("pin"); },
+                               PIN_SCHEMA));
+    EXPECT_TRUE(dispatcher.add(RD::HEARTBEAT, [&called](const RequestBody&) { called = "heartbeat"; }));
+
+    EXPECT_EQ(dispatcher.getSchema(RD::SEND_PIN, strlen(RD::SEND_PIN)), &PIN_SCHEMA);
+    EXPECT_EQ(dispatcher.getSchema(RD::HEARTBEAT, strlen(RD::HEARTBEAT)), &GroupDispatcher::NO_FIELDS);
+
+    RequestBody body(PIN_SCHEMA);
+    std::string raw("{\"pin\": \"1234\"}");
+    ASSERT_EQ(RequestParser::parse(raw.data(), raw.size(), body), ParseStatus::Ok);
+    EXPECT_TRUE(dispatch(dispatcher, RD::SEND_PIN, body));
+    EXPECT_EQ(called, "1234");
+    EXPECT_TRUE(dispatch(dispatcher, RD::HEARTBEAT, body));
+    EXPECT_EQ(called, "heartbeat");
+}
+
+// unknown and unregistered groups are rejected without calling anything
+TEST(GroupDispatcherTest, RejectsUnknownGroups) {
+    GroupDispatcher dispatcher;
+    bool called = false;
+    dispatcher.add(RD::HEARTBEAT, [&called](const RequestBody&) { called = true; });
+
+    RequestBody body(GroupDispatcher::NO_FIELDS);
+    EXPECT_FALSE(dispatch(dispatcher, "not_a_group", body));
+    EXPECT_FALSE(dispatch(dispatcher, RD::SEND_PIN, body));
+    EXPECT_FALSE(dispatch(dispatcher, std::string(RD::HEARTBEAT) + '\0' + "x", body));
+    EXPECT_FALSE(dispatch(dispatcher, std::string(RD::HEARTBEAT).substr(0, 5), body));
+    EXPECT_EQ(dispatcher.getSchema("not_a_group", 11), nullptr);
+    EXPECT_FALSE(called);
+
+    // a name sharing a slot with a registered group cannot displace it
+    std::string clash;
+    for (int i = 0; clash.empty(); ++i) {
+        std::string name = "group_" + std::to_string(i);
+        if (GroupDispatcher::slot(name.c_str()) == GroupDispatcher::slot(RD::HEARTBEAT)) {
+            clash = name;
+        }
+    }
+    EXPECT_FALSE(dispatcher.add(clash.c_str(), [](const RequestBody&) {}));
+    EXPECT_TRUE(dispatch(dispatcher, RD::HEARTBEAT, body));
+    EXPECT_TRUE(called);
+}
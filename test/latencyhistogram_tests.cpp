@@ -0,0 +1,32 @@
+#include <gtest/gtest.h>
+
+#include "latencyhistogram.hpp"
+
+// samples land in power-of-two microsecond buckets
+TEST(LatencyHistogramTest, BucketsAndPercentiles) {
+    LatencyHistogram histogram;
+    uint64_t start = LatencyHistogram::now();
+    for (int i = 0; i < 99; ++i) {
+        histogram.record(start, start + 3000);          // 3 us, bucket [2, 4)
+    }
+    histogram.record(start, start + 5000000);           // 5 ms
+    EXPECT_EQ(histogram.getCount(), 100u);
+    EXPECT_EQ(histogram.getBucket(2), 99u);
+    EXPECT_EQ(histogram.getPercentile(50), 4u);
+    EXPECT_EQ(histogram.getPercentile(99), 4u);
+    EXPECT_EQ(histogram.getPercentile(100), 8192u);
+    EXPECT_EQ(histogram.getMax(), 5000u);
+}
+
+// unknown or reversed intervals are not counted
+TEST(LatencyHistogramTest, RejectsInvalidIntervals) {
+    LatencyHistogram histogram;
+    histogram.record(0, LatencyHistogram::now());
+    histogram.record(2000, 1000);
+    EXPECT_EQ(histogram.getCount(), 0u);
+    histogram.record(1000, 1000);
+    EXPECT_EQ(histogram.getBucket(0), 1u);
+    histogram.reset();
+    EXPECT_EQ(histogram.getCount(), 0u);
+    EXPECT_EQ(histogram.getPercentile(50), 0u);
+}
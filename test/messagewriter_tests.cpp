@@ -0,0 +1,100 @@
+#include <gtest/gtest.h>
+
+#include "messagewriter.hpp"
+#include "templatehandler.hpp"
+
+using json = nlohmann::json;
+
+// each writer emits exactly what dumping the filled-in template emits
+TEST(MessageWriterTest, MatchesTemplateDump) {
+    TemplateHandler templates;
+    std::string out;
+
+    json header = templates.getRawHeaderTemplate();
+    header["group"] = "vehicle_status";
+    MessageWriter::writeHeader("vehicle_status", out);
+    EXPECT_EQ(out, header.dump());
+
+    const char* keys[VEHICLE_STATUS_COUNT] = {"status_1xx", "status_2xx", "status_3xx",
+            "status_4xx", "status_5xx", "status_6xx", "status_7xx", "status_8xx", "status_9xx"};
+    StatusEntry status[VEHICLE_STATUS_COUNT];
+    json vehicleStatus = templates.getRawVehicleStatusTemplate();
+    for (int i = 0; i < VEHICLE_STATUS_COUNT; i++) {
+        status[i].code = (i + 1) * 100 + i;
+        status[i].text = MessageWriter::getStatusText((VehicleStatusPrefix)((i + 1) * 100), i);
+        vehicleStatus[keys[i]]["status_code"] = status[i].code;
+        vehicleStatus[keys[i]]["status_text"] = status[i].text;
+    }
+    out.clear();
+    MessageWriter::writeVehicleStatus(status, out);
+    EXPECT_EQ(out, vehicleStatus.dump());
+
+    json maneuverStatus = templates.getRawManeuverStatusTemplate();
+    maneuverStatus["maneuver"] = "OutLftFwd";
+    maneuverStatus["progress"] = 42;
+    maneuverStatus["status"] = 905;
+    out.clear();
+    MessageWriter::writeManeuverStatus("OutLftFwd", 42, 905, out);
+    EXPECT_EQ(out, maneuverStatus.dump());
+
+    for (int i = 0; i < 4; i++) {
+        json cabinStatus = templates.getRawCabinStatusTemplate();
+        cabinStatus["power_status"] = (i & 1) != 0;
+        cabinStatus["lock_status"] = (i & 2) != 0;
+        out.clear();
+        MessageWriter::writeCabinStatus((i & 1) != 0, (i & 2) != 0, out);
+        EXPECT_EQ(out, cabinStatus.dump());
+    }
+
+    for (int pattern : {0x0000, 0x7FFF, 0x1234, 0x4C21}) {
+        bool offered[AVAILABLE_MANEUVER_COUNT];
+        json availableManeuvers = templates.getRawAvailableManeuversTemplate();
+        for (int i = 0; i < AVAILABLE_MANEUVER_COUNT; i++) {
+            offered[i] = ((pattern >> i) & 1) != 0;
+            availableManeuvers["maneuvers"][AVAILABLE_MANEUVER_NAMES[i]] = offered[i];
+        }
+        availableManeuvers["default"] = "NdgRvs";
+        availableManeuvers["continue_exploring"] = (pattern & 1) != 0;
+        out.clear();
+        MessageWriter::writeAvailableManeuvers("NdgRvs", (pattern & 1) != 0, offered, out);
+        EXPECT_EQ(out, availableManeuvers.dump());
+    }
+
+    uint8_t threats[THREAT_SEGMENT_COUNT];
+    json threatData = templates.getRawThreatDataTemplate();
+    for (int i = 0; i < THREAT_SEGMENT_COUNT; i++) {
+        threats[i] = (uint8_t)(i * 8);
+        threatData["threats"][i] = threats[i];
+    }
+    out.clear();
+    MessageWriter::writeThreatData(threats, out);
+    EXPECT_EQ(out, threatData.dump());
+}
+
+// strings and integers are formatted as the DOM formats them
+TEST(MessageWriterTest, FormatsLikeDump) {
+    TemplateHandler templates;
+    std::string odd("quote\" back\\ tab\t nl\n bell\x07 \xc3\xa9");
+
+    json maneuverStatus = templates.getRawManeuverStatusTemplate();
+    maneuverStatus["maneuver"] = odd;
+    maneuverStatus["progress"] = -2147483647 - 1;
+    maneuverStatus["status"] = 0;
+
+    std::string out;
+    MessageWriter::writeManeuverStatus(odd, -2147483647 - 1, 0, out);
+    EXPECT_EQ(out, maneuverStatus.dump());
+}
+
+// signal values map to their text, and unknown values do not overrun a table
+TEST(MessageWriterTest, StatusText) {
+    EXPECT_STREQ(MessageWriter::getStatusText(VehicleStatusPrefix::ManeuverStatus,
+            (int)ASP::ManeuverStatus::Maneuvering), "Manoeuvring");
+    EXPECT_STREQ(MessageWriter::getStatusText(VehicleStatusPrefix::AcknowledgeRemotePIN,
+            (int)DCM::AcknowledgeRemotePIN::CorrectPIN), "CorrectPIN");
+    EXPECT_STREQ(MessageWriter::getStatusText(VehicleStatusPrefix::PauseMsg2,
+            (int)ASP::PauseMsg2::TemporarySystemFailure), "TemporarySystemFailure");
+    EXPECT_STREQ(MessageWriter::getStatusText(VehicleStatusPrefix::InfoMsg,
+            (int)ASP::InfoMsg::InvalidSig), "InvalidSig");
+    EXPECT_STREQ(MessageWriter::getStatusText(VehicleStatusPrefix::PauseMsg2, 11), "InvalidSig");
+}
@@ -15,6 +15,7 @@ protected:
         asp_ = std::make_shared<StubASP>();
         sh_ = std::make_shared<SignalHandler>();
         sh_->ActiveAutonomousFeature = ASP::ActiveAutonomousFeature::Parking; // test RPA state only
+        sh_->publishAspSnapshot();
         server_ = std::make_shared<RemoteDeviceHandler>(sh_);
         thr = std::thread([this] { server_->spin(); });
         std::this_thread::sleep_for(std::chrono::milliseconds(10));
@@ -395,9 +396,96 @@ TEST_F(MobileCommsTest, GetAPIVersion) {
     EXPECT_EQ(reply_body["api_version"], API_DOC_VERSION);
 }
 
+// the vehicle answers each heartbeat with a heartbeat
+TEST_F(MobileCommsTest, Heartbeat) {
+    TCPMessage msg;
+    msg.header = constructHeader(RD::HEARTBEAT).dump();
+    client_->send(msg);
+    struct TCPMessage reply = client_->receive(true);
+    EXPECT_EQ(json::parse(reply.header)["group"], (std::string)RD::HEARTBEAT);
+}
+
+// a second device can connect and be served while the first stays connected
+TEST_F(MobileCommsTest, MultipleClients) {
+    MobileClient second;
+    TCPMessage msg;
+    msg.header = constructHeader(RD::GET_API_VERSION).dump();
+    second.send(msg);
+    struct TCPMessage reply = second.receive(true);
+    EXPECT_EQ(json::parse(reply.header)["group"], (std::string)RD::VEHICLE_API_VERSION);
+    client_->send(msg);
+    reply = client_->receive(true);
+    EXPECT_EQ(json::parse(reply.header)["group"], (std::string)RD::VEHICLE_API_VERSION);
+    second.disconnect();
+}
+
+// a device may switch to CBOR or MessagePack bodies; others keep JSON
+TEST_F(MobileCommsTest, BinaryBodyEncoding) {
+    TCPMessage msg;
+    msg.header = constructHeader(RD::SET_BODY_ENCODING).dump();
+    msg.body = json({{"encoding", "cbor"}}).dump();
+    client_->send(msg);
+    struct TCPMessage reply = client_->receive(true);
+    json reply_header = json::parse(reply.header);
+    EXPECT_EQ(reply_header["group"], (std::string)RD::BODY_ENCODING);
+    EXPECT_EQ(reply_header["encoding"], "cbor");
+    EXPECT_EQ(json::from_cbor(reply.body)["encoding"], "cbor");
+
+    // bodies are CBOR both ways from now on
+    json body = templates_.getRawSendPINTemplate();
+    body["pin"] = picosha2::hash256_hex_string( std::string( DCM::POC_PIN ) );
+    std::vector<uint8_t> cbor = json::to_cbor(body);
+    msg.header = constructHeader(RD::SEND_PIN).dump();
+    msg.body = std::string(cbor.begin(), cbor.end());
+    client_->send(msg);
+    reply = client_->receive();
+    reply_header = json::parse(reply.header);
+    EXPECT_EQ(reply_header["group"], (std::string)RD::VEHICLE_STATUS);
+    EXPECT_EQ(reply_header["encoding"], "cbor");
+    EXPECT_EQ(json::from_cbor(reply.body)["status_7xx"]["status_code"], 708);
+
+    MobileClient second;
+    msg.header = constructHeader(RD::GET_API_VERSION).dump();
+    msg.body = "";
+    second.send(msg);
+    reply = second.receive(true);
+    EXPECT_FALSE(json::parse(reply.header).contains("encoding"));
+    EXPECT_EQ(json::parse(reply.body)["api_version"], API_DOC_VERSION);
+
+    msg.header = constructHeader(RD::SET_BODY_ENCODING).dump();
+    msg.body = json({{"encoding", "msgpack"}}).dump();
+    second.send(msg);
+    reply = second.receive(true);
+    EXPECT_EQ(json::parse(reply.header)["encoding"], "msgpack");
+    EXPECT_EQ(json::from_msgpack(reply.body)["encoding"], "msgpack");
+    second.disconnect();
+
+    // unknown encodings are refused
+    std::vector<uint8_t> request = json::to_cbor(json({{"encoding", "xml"}}));
+    msg.body = std::string(request.begin(), request.end());
+    client_->send(msg);
+    reply = client_->receive(true);
+    EXPECT_EQ(json::from_cbor(reply.body)["encoding"], "cbor");
+}
+
+// frames may arrive several to a segment or split across segments
+TEST_F(MobileCommsTest, BurstAndPartialFrames) {
+    TCPMessage msg;
+    msg.header = constructHeader(RD::GET_API_VERSION).dump();
+    std::string frame = MobileClient::frame(msg);
+    client_->sendRaw(frame + frame + frame.substr(0, 5));
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    client_->sendRaw(frame.substr(5));
+    for (int i = 0; i < 3; ++i) {
+        struct TCPMessage reply = client_->receive(true);
+        EXPECT_EQ(json::parse(reply.header)["group"], (std::string)RD::VEHICLE_API_VERSION);
+    }
+}
+
 TEST_F( MobileCommsTest, NoPinInVDC )
 {
     sh_->AcknowledgeRemotePIN = DCM::AcknowledgeRemotePIN::NotSetInDCM;
+    sh_->publishAspSnapshot( );
     std::this_thread::sleep_for( std::chrono::milliseconds( 30 ) );
 
     // send get_api_version to trigger a 707 response
@@ -484,10 +572,14 @@ TEST_F( MobileCommsTest, SendIncorrectPin )
     body["pin"] = picosha2::hash256_hex_string( std::string( DCM::POC_PIN ) );
     msg.body = body.dump();
     client_->send(msg);
+    reply = client_->receive( );
+    reply_body = json::parse( reply.body );
+    EXPECT_EQ( reply_body[ "status_7xx" ][ "status_code" ], 702 );
     EXPECT_EQ( sh_->AcknowledgeRemotePIN, DCM::AcknowledgeRemotePIN::IncorrectPIN3xLock60s );
 
     // check other timeouts as well.
     sh_->AcknowledgeRemotePIN = DCM::AcknowledgeRemotePIN::IncorrectPIN3xLock300s;
+    sh_->publishAspSnapshot( );
     std::this_thread::sleep_for( std::chrono::milliseconds( 30 ) );
     reply = client_->receive( );
     reply_header = json::parse( reply.header );
@@ -496,6 +588,7 @@ TEST_F( MobileCommsTest, SendIncorrectPin )
     EXPECT_EQ( reply_body[ "status_7xx" ][ "status_code" ], 703 );
 
     sh_->AcknowledgeRemotePIN = DCM::AcknowledgeRemotePIN::IncorrectPIN3xLock3600s;
+    sh_->publishAspSnapshot( );
     std::this_thread::sleep_for( std::chrono::milliseconds( 30 ) );
     reply = client_->receive( );
     reply_header = json::parse( reply.header );
@@ -504,6 +597,7 @@ TEST_F( MobileCommsTest, SendIncorrectPin )
     EXPECT_EQ( reply_body[ "status_7xx" ][ "status_code" ], 704 );
 
     sh_->AcknowledgeRemotePIN = DCM::AcknowledgeRemotePIN::IncorrectPIN3xLockIndefinite;
+    sh_->publishAspSnapshot( );
     std::this_thread::sleep_for( std::chrono::milliseconds( 30 ) );
     reply = client_->receive( );
     reply_header = json::parse( reply.header );
@@ -662,6 +756,21 @@ TEST_F( MobileCommsTest, StatusEnded )
     EXPECT_EQ( reply_body[ "status_9xx" ][ "status_code" ], 907 );
 }
 
+// ASP packets are timed from kernel arrival to decode, and status changes
+// from decode to the JSON push
+TEST_F( MobileCommsTest, ManeuverStatusLatency )
+{
+    asp_->ManeuverStatus = ASP::ManeuverStatus::Interrupted;
+    asp_->sync();
+    struct TCPMessage reply = client_->receive();
+    json reply_header = json::parse(reply.header);
+    EXPECT_EQ( reply_header[ "group" ], (std::string)RD::MANEUVER_STATUS );
+    EXPECT_GT( sh_->getArrivalToDecodeLatency().getCount(), 0u );
+    EXPECT_EQ( sh_->getDecodeToSendLatency().getCount(), 1u );
+    EXPECT_GT( sh_->getAspReceiveTime(), 0u );
+    EXPECT_LE( sh_->getAspReceiveTime(), sh_->getAspDecodeTime() );
+}
+
 TEST_F(MobileCommsTest, ListManeuversPushPull) {
     sendCorrectMobileInit();
     json available_maneuvers = sendListManeuversPushPull( );
@@ -702,6 +811,32 @@ TEST_F(MobileCommsTest, GetThreatData) {
     sendGetThreatData( );
 }
 
+// a reply waiting on the ASP does not hold up the rest of the connection
+TEST_F(MobileCommsTest, DeferredThreatData) {
+    sendCorrectMobileInit();
+    asp_->ManeuverStatus = ASP::ManeuverStatus::Scanning;
+    asp_->sync();
+    struct TCPMessage reply = client_->receive(true);
+    EXPECT_EQ(json::parse(reply.header)["group"], (std::string)RD::MANEUVER_STATUS);
+
+    TCPMessage msg;
+    msg.header = constructHeader(RD::GET_THREAT_DATA).dump();
+    client_->send(msg);
+    msg.header = constructHeader(RD::HEARTBEAT).dump();
+    client_->send(msg);
+    reply = client_->receive(true);
+    EXPECT_EQ(json::parse(reply.header)["group"], (std::string)RD::HEARTBEAT);
+
+    // threat data follows once scanning is over
+    asp_->ManeuverStatus = ASP::ManeuverStatus::Selecting;
+    asp_->sync();
+    reply = client_->receive(true);
+    if (json::parse(reply.header)["group"] == RD::MANEUVER_STATUS) {
+        reply = client_->receive(true);
+    }
+    EXPECT_EQ(json::parse(reply.header)["group"], (std::string)RD::THREAT_DATA);
+}
+
 TEST_F(MobileCommsTest, ManeuverInitSF) {
     std::string testManeuver = "StrFwd";
     sendCorrectMobileInit();
@@ -786,6 +921,7 @@ TEST_F(MobileCommsTest, ManeuverInitDuringManeuver) {
 TEST_F(MobileCommsTest, DeadmansHandle)
 {
     sh_->ManeuverStatus = ASP::ManeuverStatus::Selecting;
+    sh_->publishAspSnapshot( );
     TCPMessage msg;
     msg.header = constructHeader( RD::DEADMANS_HANDLE ).dump( );
     json body = templates_.getRawDeadmansHandleTemplate( );
@@ -798,7 +934,7 @@ TEST_F(MobileCommsTest, DeadmansHandle)
     client_->send( msg );
 
     std::this_thread::sleep_for( std::chrono::milliseconds( 30 ) );
-    EXPECT_EQ( sh_->ManeuverEnableInput, TCM::ManeuverEnableInput::ValidScrnInput );
+    EXPECT_EQ( sh_->getDmhInput( ).ManeuverEnableInput, TCM::ManeuverEnableInput::ValidScrnInput );
     EXPECT_EQ( sh_->ManeuverButtonPress, TCM::ManeuverButtonPress::ConfirmationSelected );
 
     asp_->sync( );
@@ -814,6 +950,7 @@ TEST_F( MobileCommsTest, DeadmansHandleAlt )
 {
     sh_->ManeuverStatus = ASP::ManeuverStatus::Interrupted;
     sh_->ResumeAvailability = ASP::ResumeAvailability::OfferEnabled;
+    sh_->publishAspSnapshot( );
 
     TCPMessage msg;
     msg.header = constructHeader( RD::DEADMANS_HANDLE ).dump( );
@@ -827,7 +964,7 @@ TEST_F( MobileCommsTest, DeadmansHandleAlt )
     client_->send( msg );
 
     std::this_thread::sleep_for( std::chrono::milliseconds( 30 ) );
-    EXPECT_EQ( sh_->ManeuverEnableInput, TCM::ManeuverEnableInput::NoScrnInput );
+    EXPECT_EQ( sh_->getDmhInput( ).ManeuverEnableInput, TCM::ManeuverEnableInput::NoScrnInput );
     EXPECT_EQ( sh_->ManeuverButtonPress, TCM::ManeuverButtonPress::ResumeSelected );
 
     asp_->sync( );
@@ -839,6 +976,106 @@ TEST_F( MobileCommsTest, DeadmansHandleAlt )
     EXPECT_EQ( asp_->ManeuverButtonPress, TCM::ManeuverButtonPress::ResumeSelected );
 }
 
+// binary DMH frames are ignored until negotiated, then drive the same signals
+TEST_F( MobileCommsTest, BinaryDeadmansHandle )
+{
+    DmhSample sample = { true, 20, 30, 40, 50 };
+    TCPMessage frame;
+    frame.body.resize( DMH_FRAME_SIZE );
+    DmhFrame::encode( sample, &frame.body[ 0 ] );
+    client_->sendRaw( MobileClient::frame( frame ) );
+
+    TCPMessage msg;
+    msg.header = constructHeader( RD::SET_BODY_ENCODING ).dump( );
+    msg.body = json( { { "binary_dmh", true } } ).dump( );
+    client_->send( msg );
+    struct TCPMessage reply = client_->receive( true );
+    EXPECT_EQ( json::parse( reply.header )[ "group" ], (std::string)RD::BODY_ENCODING );
+    EXPECT_EQ( json::parse( reply.body )[ "encoding" ], "json" );
+    EXPECT_EQ( json::parse( reply.body )[ "binary_dmh" ], true );
+    EXPECT_EQ( sh_->getDmhInput( ).ManeuverEnableInput, TCM::ManeuverEnableInput::NoScrnInput );
+
+    sh_->ManeuverStatus = ASP::ManeuverStatus::Selecting;
+    sh_->publishAspSnapshot( );
+    client_->sendRaw( MobileClient::frame( frame ) );
+    std::this_thread::sleep_for( std::chrono::milliseconds( 30 ) );
+    EXPECT_EQ( sh_->getDmhInput( ).ManeuverEnableInput, TCM::ManeuverEnableInput::ValidScrnInput );
+    EXPECT_EQ( sh_->ManeuverButtonPress, TCM::ManeuverButtonPress::ConfirmationSelected );
+
+    // a frame of the wrong size is rejected, not misread
+    sample.percent = 99;
+    DmhFrame::encode( sample, &frame.body[ 0 ] );
+    frame.body += '\0';
+    client_->sendRaw( MobileClient::frame( frame ) );
+    std::this_thread::sleep_for( std::chrono::milliseconds( 30 ) );
+
+    asp_->sync( );
+    EXPECT_EQ( asp_->AppAccelerationZ, 20 );
+    EXPECT_EQ( asp_->AppSliderPosX, 30 );
+    EXPECT_EQ( asp_->AppSliderPosY, 40 );
+    EXPECT_EQ( asp_->AppCalcCheck, 50 );
+    EXPECT_EQ( asp_->ManeuverEnableInput, TCM::ManeuverEnableInput::ValidScrnInput );
+}
+
+// a deadmans_handle frame, JSON or binary, goes from the socket to
+// SignalHandler without touching the heap
+TEST( MobileFrameAllocationTest, DeadmansHandleFramesDoNotAllocate )
+{
+    const uint16_t port = 8073;
+    auto sh = std::make_shared<SignalHandler>();
+    sh->ManeuverStatus = ASP::ManeuverStatus::Selecting;
+    sh->publishAspSnapshot( );
+    RemoteDeviceHandler server( sh, false );
+    server.bindServer( port );
+    MobileClient client( "localhost", port );
+    server.pollEvents( 100 ); // accept
+
+    TCPMessage msg;
+    msg.header = constructHeader( RD::SET_BODY_ENCODING ).dump( );
+    msg.body = json( { { "binary_dmh", true } } ).dump( );
+    client.send( msg );
+    server.pollEvents( 100 );
+    client.receive( true );
+
+    TemplateHandler templates;
+    msg.header = constructHeader( RD::DEADMANS_HANDLE ).dump( );
+    json body = templates.getRawDeadmansHandleTemplate( );
+    body[ "enable_vehicle_motion" ] = true;
+    body[ "dmh_gesture_progress" ] = 20;
+    body[ "dmh_horizontal_touch" ] = 30;
+    body[ "dmh_vertical_touch" ] = 40;
+    body[ "crc_value" ] = 50;
+    msg.body = body.dump( );
+    const std::string jsonFrame( MobileClient::frame( msg ) );
+
+    DmhSample sample = { true, 21, 31, 41, 51 };
+    TCPMessage binary;
+    binary.body.resize( DMH_FRAME_SIZE );
+    DmhFrame::encode( sample, &binary.body[ 0 ] );
+    const std::string binaryFrame( MobileClient::frame( binary ) );
+
+    // let any first-use buffers be allocated before counting
+    for( int i = 0; i < 4; ++i )
+    {
+        client.sendRaw( i % 2 ? binaryFrame : jsonFrame );
+        server.pollEvents( 100 );
+    }
+
+    size_t before = getThreadAllocations( );
+    for( int i = 0; i < 100; ++i )
+    {
+        client.sendRaw( jsonFrame );
+        server.pollEvents( 100 );
+        EXPECT_EQ( sh->getDmhInput( ).AppCalcCheck, 50 );
+        client.sendRaw( binaryFrame );
+        server.pollEvents( 100 );
+        EXPECT_EQ( sh->getDmhInput( ).AppCalcCheck, 51 );
+    }
+    EXPECT_EQ( getThreadAllocations( ), before );
+
+    client.disconnect( );
+    server.closeServer( );
+}
 
 TEST_F( MobileCommsTest, ManeuverComplete )
 {
@@ -1016,6 +1253,33 @@ TEST_F(MobileCommsTest, CabinCommands) {
     EXPECT_TRUE(reply2_body["lock_status"]);
 }
 
+// repeated status queries are served from the cache until the state changes
+TEST_F(MobileCommsTest, CachedCabinStatus) {
+    TCPMessage msg;
+    msg.header = constructHeader(RD::GET_CABIN_STATUS).dump();
+    client_->send(msg);
+    struct TCPMessage first = client_->receive(true);
+    uint64_t hits = server_->getResponseCache().getHits();
+    client_->send(msg);
+    struct TCPMessage second = client_->receive(true);
+    EXPECT_EQ(server_->getResponseCache().getHits(), hits + 1);
+    EXPECT_EQ(second.header, first.header);
+    EXPECT_EQ(second.body, first.body);
+    EXPECT_FALSE(json::parse(second.body)["power_status"]);
+
+    // cabin_commands changes the state, so its reply is built afresh
+    TCPMessage msg2;
+    msg2.header = constructHeader(RD::CABIN_COMMANDS).dump();
+    json body = templates_.getRawCabinCommandsTemplate();
+    body["engine_off"] = true;
+    body["doors_locked"] = false;
+    msg2.body = body.dump();
+    client_->send(msg2);
+    struct TCPMessage reply = client_->receive(true);
+    EXPECT_TRUE(json::parse(reply.body)["power_status"]);
+    EXPECT_GT(server_->getResponseCache().getHitRate(), 0.0);
+}
+
 TEST_F(MobileCommsTest, MobileChallenge) {
     asp_->MobileChallengeSend = 12345678;
     asp_->sync();
@@ -1075,7 +1339,7 @@ TEST_F( MobileCommsTest, HappyPath )
     EXPECT_EQ( asp_->AppCalcCheck, bodyDMH["crc_value"] );
     EXPECT_EQ( sh_->ManeuverStatus, ASP::ManeuverStatus::Maneuvering );
     EXPECT_EQ( sh_->InstructMsg, ASP::InstructMsg::RemoteManouevreInProgress );
-    EXPECT_EQ( sh_->ManeuverEnableInput, TCM::ManeuverEnableInput::ValidScrnInput );
+    EXPECT_EQ( sh_->getDmhInput( ).ManeuverEnableInput, TCM::ManeuverEnableInput::ValidScrnInput );
 
     // expecting one vehicle statuses - these can arrive in any order
     std::vector<TCPMessage> receivedStatuses;
@@ -1117,7 +1381,7 @@ TEST_F( MobileCommsTest, HappyPath )
     EXPECT_EQ( sh_->ManeuverStatus, ASP::ManeuverStatus::Interrupted );
     EXPECT_EQ( sh_->ResumeAvailability, ASP::ResumeAvailability::OfferEnabled );
     EXPECT_EQ( sh_->InstructMsg, ASP::InstructMsg::RemoteManouevreInProgress );
-    EXPECT_EQ( sh_->ManeuverEnableInput, TCM::ManeuverEnableInput::NoScrnInput );
+    EXPECT_EQ( sh_->getDmhInput( ).ManeuverEnableInput, TCM::ManeuverEnableInput::NoScrnInput );
     struct TCPMessage reply = client_->receive( );
     replyHeader = json::parse( reply.header );
     EXPECT_EQ( replyHeader[ "group" ], (std::string)RD::MANEUVER_STATUS );
@@ -1150,7 +1414,7 @@ TEST_F( MobileCommsTest, HappyPath )
     EXPECT_EQ( sh_->InfoMsg, ASP::InfoMsg::None );
     EXPECT_EQ( sh_->CancelMsg, ASP::CancelMsg::None );
     EXPECT_EQ( sh_->InstructMsg, ASP::InstructMsg::None );
-    EXPECT_EQ( sh_->ManeuverEnableInput, TCM::ManeuverEnableInput::ValidScrnInput );
+    EXPECT_EQ( sh_->getDmhInput( ).ManeuverEnableInput, TCM::ManeuverEnableInput::ValidScrnInput );
 
     // expecting one vehicle status, one maneuver status
     // - these can arrive in any order
@@ -1179,3 +1443,72 @@ TEST_F( MobileCommsTest, HappyPath )
         }
     }
 }
+
+// Stopping a server with an approved device must return, and a new server
+// must accept clients on the same port.  The timings are reported rather
+// than asserted, so loaded or sanitizer runs do not fail on them.
+TEST( ServerLifecycleTest, StopAndRestart )
+{
+    typedef std::chrono::steady_clock Clock;
+
+    StubASP asp;
+    TemplateHandler templates;
+    auto sh = std::make_shared<SignalHandler>();
+    auto server = std::make_shared<RemoteDeviceHandler>(sh);
+    std::thread thr([server] { server->spin(); });
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+
+    MobileClient client;
+    TCPMessage msg;
+    msg.header = constructHeader(RD::SEND_PIN).dump();
+    json body = templates.getRawSendPINTemplate();
+    body["pin"] = picosha2::hash256_hex_string( std::string( DCM::POC_PIN ) );
+    msg.body = body.dump();
+    client.send(msg);
+    client.receive();
+    // let every loop settle into its sleep
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+    Clock::time_point stopStart = Clock::now();
+    server->stop();
+    thr.join();
+    double stopMs = std::chrono::duration<double, std::milli>(
+            Clock::now() - stopStart ).count();
+    client.disconnect();
+    server.reset();
+    sh.reset();
+
+    Clock::time_point restartStart = Clock::now();
+    sh = std::make_shared<SignalHandler>();
+    server = std::make_shared<RemoteDeviceHandler>(sh);
+    thr = std::thread([server] { server->spin(); });
+
+    std::shared_ptr<MobileClient> reconnected;
+    while( !reconnected &&
+            Clock::now() - restartStart < std::chrono::seconds( 5 ) )
+    {
+        try
+        {
+            reconnected = std::make_shared<MobileClient>();
+        }
+        catch( const std::runtime_error& )
+        {
+            std::this_thread::sleep_for(std::chrono::microseconds(100));
+        }
+    }
+    double restartMs = std::chrono::duration<double, std::milli>(
+            Clock::now() - restartStart ).count();
+
+    std::cout << "stop: " << stopMs << " ms, restart to listening: "
+              << restartMs << " ms" << std::endl;
+
+    EXPECT_TRUE( reconnected != nullptr );
+
+    server->stop();
+    if( reconnected )
+    {
+        reconnected->disconnect();
+    }
+    thr.join();
+    asp.disconnect();
+}
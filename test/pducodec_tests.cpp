@@ -0,0 +1,107 @@
+#include <gtest/gtest.h>
+
+#include "pdusignals.hpp"
+
+#include <random>
+#include <vector>
+
+namespace {
+struct Layout {
+    int id;
+    unsigned bits;
+};
+
+#define LAYOUT_ENTRY(PDU, NAME, BITS) {PDU::NAME, BITS},
+
+const Layout tcmLm[] = {TCM_LM_SIGNALS(LAYOUT_ENTRY)};
+const Layout aspmLm[] = {ASPM_LM_SIGNALS(LAYOUT_ENTRY)};
+const Layout aspmObjSegment[] = {ASPM_LM_OBJSEGMENT_SIGNALS(LAYOUT_ENTRY)};
+
+// signal by signal, bit by bit, MSB first; what the old table-driven loops did
+void referenceEncode(const Layout* layout, size_t count, const uint64_t* values, uint8_t* payload) {
+    unsigned bit = 0;
+    for (size_t i = 0; i < count; ++i) {
+        for (unsigned b = layout[i].bits; b-- > 0; ++bit) {
+            if (layout[i].id >= 0 && ((values[layout[i].id] >> b) & 1)) {
+                payload[bit / 8] |= 0x80 >> (bit % 8);
+            }
+        }
+    }
+}
+
+uint64_t referenceDecode(const Layout& signal, unsigned offset, const uint8_t* payload) {
+    uint64_t value = 0;
+    for (unsigned b = 0; b < signal.bits; ++b, ++offset) {
+        value = (value << 1) | ((payload[offset / 8] >> (7 - offset % 8)) & 1);
+    }
+    return value;
+}
+
+// random values, some wider than their signal, must pack and unpack like the reference
+template <typename CODEC, size_t N>
+void checkAgainstReference(const Layout (&layout)[N], int maxSignal) {
+    std::mt19937_64 random(maxSignal);
+
+    for (int round = 0; round < 200; ++round) {
+        std::vector<uint64_t> values(maxSignal);
+        for (auto& value : values) {
+            value = random();
+        }
+
+        std::vector<uint8_t> expected(CODEC::BYTES, 0);
+        std::vector<uint8_t> payload(CODEC::BYTES, 0xA5);
+        referenceEncode(layout, N, values.data(), expected.data());
+        CODEC::encode(values.data(), payload.data());
+        ASSERT_EQ(payload, expected) << "round " << round;
+
+        std::vector<uint64_t> decoded(maxSignal, 0);
+        CODEC::decode(payload.data(), decoded.data());
+        unsigned offset = 0;
+        for (size_t i = 0; i < N; offset += layout[i++].bits) {
+            if (layout[i].id < 0) {
+                continue;
+            }
+            uint64_t mask = layout[i].bits == 64 ? ~0ull : (1ull << layout[i].bits) - 1;
+            EXPECT_EQ(decoded[layout[i].id], values[layout[i].id] & mask) << "signal " << layout[i].id;
+            EXPECT_EQ(decoded[layout[i].id], referenceDecode(layout[i], offset, payload.data()));
+        }
+    }
+}
+}
+
+TEST(PduCodecTest, TcmLmMatchesReference) {
+    checkAgainstReference<TcmLmCodec>(tcmLm, TCM_LM::MAXSignal);
+}
+
+TEST(PduCodecTest, AspmLmMatchesReference) {
+    checkAgainstReference<AspmLmCodec>(aspmLm, ASPM_LM::MAXSignal);
+}
+
+TEST(PduCodecTest, AspmObjSegmentMatchesReference) {
+    checkAgainstReference<AspmLmObjSegmentCodec>(aspmObjSegment, ASPM_LM_ObjSegment::MAXSignal);
+}
+
+// unused bits are written as zero and a value wider than its signal does not spill
+TEST(PduCodecTest, UnusedBitsAndMasking) {
+    typedef PduCodec<PduSignal<1, 3>, PduSignal<-1, 2>, PduSignal<2, 11>, PduEnd> Codec;
+    static_assert(Codec::BITS == 16 && Codec::BYTES == 2, "layout is two bytes");
+
+    uint64_t values[3] = {0, ~0ull, 0};
+    uint8_t payload[2];
+    Codec::encode(values, payload);
+    EXPECT_EQ(payload[0], 0xE0);
+    EXPECT_EQ(payload[1], 0x00);
+
+    values[1] = 0;
+    values[2] = ~0ull;
+    Codec::encode(values, payload);
+    EXPECT_EQ(payload[0], 0x07);
+    EXPECT_EQ(payload[1], 0xFF);
+
+    uint64_t decoded[3] = {7, 7, 7};
+    payload[0] = 0xFF;
+    Codec::decode(payload, decoded);
+    EXPECT_EQ(decoded[0], 7u);
+    EXPECT_EQ(decoded[1], 7u);
+    EXPECT_EQ(decoded[2], 0x7FFu);
+}
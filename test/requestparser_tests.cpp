@@ -0,0 +1,90 @@
+#include <gtest/gtest.h>
+
+#include "requestparser.hpp"
+#include "testutils.hpp"
+
+namespace {
+const FieldSpec DMH_FIELDS[] = {
+    {"enable_vehicle_motion", FieldType::Bool, true},
+    {"dmh_gesture_progress", FieldType::Number, true},
+    {"dmh_horizontal_touch", FieldType::Number, true},
+    {"dmh_vertical_touch", FieldType::Number, true},
+    {"crc_value", FieldType::Number, true}};
+const RequestSchema DMH_SCHEMA = makeSchema(DMH_FIELDS);
+
+const FieldSpec PIN_FIELDS[] = {
+    {"pin", FieldType::String, true},
+    {"note", FieldType::String, false}};
+const RequestSchema PIN_SCHEMA = makeSchema(PIN_FIELDS);
+
+ParseStatus parse(const std::string& raw, RequestBody& body) {
+    return RequestParser::parse(raw.data(), raw.size(), body);
+}
+}
+
+// schema fields are extracted in place; other fields are skipped
+TEST(RequestParserTest, ExtractsSchemaFields) {
+    RequestBody body(DMH_SCHEMA);
+    ASSERT_EQ(parse("{\"enable_vehicle_motion\": true, \"dmh_gesture_progress\": 100,"
+                    " \"extra\": {\"a\": [1, 2.5e3, null, \"x\\\"y\"]},"
+                    " \"dmh_horizontal_touch\": 1234.4321, \"dmh_vertical_touch\": -2.5,"
+                    " \"crc_value\": 56789}", body),
+              ParseStatus::Ok);
+    EXPECT_TRUE(body.getBool("enable_vehicle_motion"));
+    EXPECT_EQ(body.getNumber("dmh_gesture_progress"), 100);
+    EXPECT_DOUBLE_EQ(body.getNumber("dmh_horizontal_touch"), 1234.4321);
+    EXPECT_DOUBLE_EQ(body.getNumber("dmh_vertical_touch"), -2.5);
+    EXPECT_EQ(body.getNumber("crc_value"), 56789);
+    EXPECT_FALSE(body.has("extra"));
+
+    RequestBody pin(PIN_SCHEMA);
+    std::string raw("{\"pin\":\"1234\"}");
+    ASSERT_EQ(parse(raw, pin), ParseStatus::Ok);
+    EXPECT_TRUE(pin.get("pin").equals("1234"));
+    EXPECT_EQ(pin.get("pin").string, raw.data() + 8);
+    EXPECT_FALSE(pin.has("note"));
+    EXPECT_EQ(pin.getString("note"), "");
+}
+
+// bad input is reported by status, never thrown
+TEST(RequestParserTest, ReportsErrors) {
+    RequestBody body(PIN_SCHEMA);
+    EXPECT_EQ(parse("{\"pin\": 1234}", body), ParseStatus::TypeMismatch);
+    EXPECT_EQ(parse("{\"pin\": null}", body), ParseStatus::TypeMismatch);
+    EXPECT_EQ(parse("{\"note\": \"x\"}", body), ParseStatus::MissingField);
+    EXPECT_EQ(parse("", body), ParseStatus::MissingField);
+    EXPECT_EQ(parse("{\"pin\": \"1234\"", body), ParseStatus::Malformed);
+    EXPECT_EQ(parse("{\"pin\": \"1234\"} x", body), ParseStatus::Malformed);
+    EXPECT_EQ(parse("{\"pin\": 1234, }", body), ParseStatus::Malformed);
+    EXPECT_EQ(parse("{\"pin\": \"12\n34\"}", body), ParseStatus::Malformed);
+    EXPECT_EQ(parse("{\"pin\": \"1234\", \"n\": 01}", body), ParseStatus::Malformed);
+    EXPECT_EQ(parse("{\"pin\": \"1234\", \"n\": tru}", body), ParseStatus::Malformed);
+    EXPECT_EQ(parse("[\"pin\"]", body), ParseStatus::Malformed);
+    EXPECT_EQ(parse(std::string(100, '[') + std::string(100, ']'), body), ParseStatus::Malformed);
+    EXPECT_EQ(parse("{\"n\": " + std::string(100, '[') + std::string(100, ']') + "}", body),
+              ParseStatus::Unsupported);
+
+    // escaped strings are left to the DOM, which gives the same fields
+    std::string raw("{\"pin\": \"12\\u0033\\\"4\"}");
+    ASSERT_EQ(parse(raw, body), ParseStatus::Unsupported);
+    json dom = json::parse(raw);
+    ASSERT_EQ(RequestParser::parseDom(dom, body), ParseStatus::Ok);
+    EXPECT_EQ(body.getString("pin"), "123\"4");
+    EXPECT_EQ(RequestParser::parseDom(json::array(), body), ParseStatus::TypeMismatch);
+    EXPECT_EQ(RequestParser::parseDom(json{{"pin", false}}, body), ParseStatus::TypeMismatch);
+    EXPECT_EQ(RequestParser::parseDom(json(), body), ParseStatus::MissingField);
+}
+
+// a deadman's handle frame parses without touching the heap
+TEST(RequestParserTest, DeadmansHandleDoesNotAllocate) {
+    std::string raw("{\"crc_value\":56789,\"dmh_gesture_progress\":55,\"dmh_horizontal_touch\":1234.4321,"
+                    "\"dmh_vertical_touch\":2468.8642,\"enable_vehicle_motion\":true}");
+    RequestBody body(DMH_SCHEMA);
+
+    size_t before = getThreadAllocations();
+    for (int i = 0; i < 100; ++i) {
+        ASSERT_EQ(parse(raw, body), ParseStatus::Ok);
+    }
+    EXPECT_EQ(getThreadAllocations(), before);
+    EXPECT_EQ(body.getNumber("dmh_gesture_progress"), 55);
+}
@@ -0,0 +1,36 @@
+#include <gtest/gtest.h>
+
+#include "responsecache.hpp"
+
+// a response is served only at the state version it was built from
+TEST(ResponseCacheTest, HitsAtSameVersion) {
+    ResponseCache cache;
+    std::string header, body;
+    EXPECT_FALSE(cache.lookup("cabin_status", BodyEncoding::Json, 1, header, body));
+
+    cache.store("cabin_status", BodyEncoding::Json, 1, "{\"group\":\"cabin_status\"}", "{}");
+    EXPECT_TRUE(cache.lookup("cabin_status", BodyEncoding::Json, 1, header, body));
+    EXPECT_EQ(header, "{\"group\":\"cabin_status\"}");
+    EXPECT_EQ(body, "{}");
+
+    EXPECT_FALSE(cache.lookup("cabin_status", BodyEncoding::Cbor, 1, header, body));
+    EXPECT_FALSE(cache.lookup("cabin_status", BodyEncoding::Json, 2, header, body));
+    EXPECT_FALSE(cache.lookup("vehicle_status", BodyEncoding::Json, 1, header, body));
+
+    EXPECT_EQ(cache.getHits(), 1u);
+    EXPECT_EQ(cache.getMisses(), 4u);
+    EXPECT_DOUBLE_EQ(cache.getHitRate(), 0.2);
+}
+
+// older responses never replace newer ones, and unversioned ones are not kept
+TEST(ResponseCacheTest, KeepsNewestVersion) {
+    ResponseCache cache;
+    std::string header, body;
+    cache.store("vehicle_status", BodyEncoding::Json, 3, "h3", "b3");
+    cache.store("vehicle_status", BodyEncoding::Json, 2, "h2", "b2");
+    EXPECT_TRUE(cache.lookup("vehicle_status", BodyEncoding::Json, 3, header, body));
+    EXPECT_EQ(body, "b3");
+
+    cache.store("maneuver_status", BodyEncoding::Json, NO_STATE_VERSION, "h", "b");
+    EXPECT_FALSE(cache.lookup("maneuver_status", BodyEncoding::Json, NO_STATE_VERSION, header, body));
+}
@@ -0,0 +1,65 @@
+#include <gtest/gtest.h>
+
+#include "seqlock.hpp"
+
+#include <atomic>
+#include <thread>
+
+namespace {
+struct Sample {
+    uint16_t x;
+    uint16_t y;
+    int64_t percent;
+    uint8_t gesture;
+    uint16_t crc;
+};
+}
+
+// loads return the initial value, then each stored value, with its version
+TEST(SeqlockTest, StoreAndLoad) {
+    Seqlock<Sample> mailbox({1, 2, 3, 0, 4});
+    Sample sample = mailbox.load();
+    EXPECT_EQ(sample.x, 1);
+    EXPECT_EQ(sample.crc, 4);
+    EXPECT_EQ(mailbox.getVersion(), 0u);
+
+    mailbox.store({10, 20, -30, 1, 40});
+    EXPECT_EQ(mailbox.getVersion(), 1u);
+    EXPECT_EQ(mailbox.load(sample), 1u);
+    EXPECT_EQ(sample.x, 10);
+    EXPECT_EQ(sample.y, 20);
+    EXPECT_EQ(sample.percent, -30);
+    EXPECT_EQ(sample.gesture, 1);
+    EXPECT_EQ(sample.crc, 40);
+}
+
+// a reader racing a writer only ever sees whole samples, in order
+TEST(SeqlockTest, ReaderNeverSeesTornValue) {
+    Seqlock<Sample> mailbox({0, 0, 0, 0, 0});
+    std::atomic<bool> done(false);
+    const int stores = 200000;
+
+    std::thread writer([&] {
+        for (int i = 1; i <= stores; ++i) {
+            mailbox.store({(uint16_t)i, (uint16_t)~i, (int64_t)i * 3, (uint8_t)(i & 1), (uint16_t)(i * 7)});
+        }
+        done = true;
+    });
+
+    uint32_t lastVersion = 0;
+    int torn = 0;
+    while (!done) {
+        Sample sample;
+        uint32_t version = mailbox.load(sample);
+        torn += (sample.y != (uint16_t)~sample.x && version != 0)
+                || sample.percent % 3 != 0
+                || sample.gesture != (sample.percent / 3 & 1)
+                || sample.crc != (uint16_t)(sample.percent / 3 * 7)
+                || version < lastVersion;
+        lastVersion = version;
+    }
+    writer.join();
+    EXPECT_EQ(torn, 0);
+    EXPECT_EQ(mailbox.getVersion(), (uint32_t)stores);
+    EXPECT_EQ(mailbox.load().percent, stores * 3);
+}
@@ -0,0 +1,67 @@
+#include <gtest/gtest.h>
+
+#include "signalbus.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+// each subscriber sees only the changes of the signals it subscribed to
+TEST(SignalBusTest, DeliversBySignal) {
+    SignalBus bus;
+    auto maneuver = bus.subscribe(MANEUVER_STATUS_SIGNALS);
+    auto challenge = bus.subscribe(MOBILE_CHALLENGE_SIGNALS);
+
+    bus.publish(signalBit(StatusSignal::ManeuverStatus) | signalBit(StatusSignal::CancelMsg));
+
+    EXPECT_FALSE(maneuver->waitFor(1000000));
+    EXPECT_EQ(maneuver->takeChanges(), signalBit(StatusSignal::ManeuverStatus));
+    EXPECT_EQ(maneuver->takeChanges(), 0u);
+    EXPECT_TRUE(challenge->waitFor(1000));
+    EXPECT_EQ(challenge->takeChanges(), 0u);
+
+    bus.unsubscribe(maneuver);
+    bus.publish(signalBit(StatusSignal::ManeuverStatus));
+    EXPECT_TRUE(maneuver->waitFor(1000));
+}
+
+// a change published from another thread wakes the waiting subscriber at once
+TEST(SignalBusTest, WakesWaitingSubscriber) {
+    SignalBus bus;
+    auto status = bus.subscribe(VEHICLE_STATUS_SIGNALS);
+
+    auto start = std::chrono::steady_clock::now();
+    std::thread publisher([&bus] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        bus.publish(signalBit(StatusSignal::AcknowledgeRemotePIN));
+    });
+    EXPECT_FALSE(status->waitFor(2000000));
+    auto waited = std::chrono::steady_clock::now() - start;
+    publisher.join();
+
+    EXPECT_LT(std::chrono::duration_cast<std::chrono::milliseconds>(waited).count(), 1000);
+    EXPECT_EQ(status->takeChanges(), signalBit(StatusSignal::AcknowledgeRemotePIN));
+
+    // wake( ) ends a wait without reporting a change
+    status->wake();
+    EXPECT_FALSE(status->waitFor(2000000));
+    EXPECT_EQ(status->takeChanges(), 0u);
+}
+
+// wait( ) has no period; only a published change ends it
+TEST(SignalBusTest, WaitEndsOnlyOnChange) {
+    SignalBus bus;
+    auto status = bus.subscribe(VEHICLE_STATUS_SIGNALS);
+
+    std::atomic<bool> published(false);
+    std::thread publisher([&] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        published = true;
+        bus.publish(signalBit(StatusSignal::ErrorMsg));
+    });
+    status->wait();
+    EXPECT_TRUE(published);
+    publisher.join();
+
+    EXPECT_EQ(status->takeChanges(), signalBit(StatusSignal::ErrorMsg));
+}
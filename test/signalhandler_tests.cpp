@@ -1,7 +1,11 @@
 #include <gtest/gtest.h>
 #include <cstring>
+#include <atomic>
+#include <thread>
 
 #include "signalhandler.hpp"
+#include "pdusignals.hpp"
+#include "testutils.hpp"
 
 class SignalHandlerTest: public ::testing::Test {
 protected:
@@ -107,6 +111,58 @@ TEST_F(SignalHandlerTest, DecodeASPMSignalData) {
             EXPECT_EQ((int)sh_->getASPMRearSegTypexxRMT(i), 0x0);
         }
     }
+
+    // the decoded packet is published as one snapshot
+    AspSnapshot snapshot = sh_->getAspSnapshot();
+    EXPECT_EQ(snapshot.CancelMsg, sh_->CancelMsg);
+    EXPECT_EQ(snapshot.MobileChallengeSend, sh_->MobileChallengeSend);
+    EXPECT_EQ((int)snapshot.ManeuverProgressBar, 0x66);
+    EXPECT_EQ((int)snapshot.ASPMFrontSegDistRMT[0], 0x10);
+    EXPECT_EQ((int)snapshot.ASPMRearSegDistRMT[1], 0x04);
+}
+
+// a snapshot written by hand wakes only the subscribers of signals it changed
+TEST_F(SignalHandlerTest, PublishAspSnapshotPublishesChanges) {
+    auto maneuver = sh_->getSignalBus().subscribe(MANEUVER_STATUS_SIGNALS);
+    auto challenge = sh_->getSignalBus().subscribe(MOBILE_CHALLENGE_SIGNALS);
+
+    sh_->ManeuverStatus = ASP::ManeuverStatus::Selecting;
+    sh_->publishAspSnapshot();
+    EXPECT_EQ(maneuver->takeChanges(), signalBit(StatusSignal::ManeuverStatus));
+    EXPECT_EQ(challenge->takeChanges(), 0u);
+
+    sh_->publishAspSnapshot();
+    EXPECT_EQ(maneuver->takeChanges(), 0u);
+
+    sh_->getSignalBus().unsubscribe(maneuver);
+    sh_->getSignalBus().unsubscribe(challenge);
+}
+
+// readers racing the UDP thread never see signals from two packets
+TEST_F(SignalHandlerTest, AspSnapshotIsConsistent) {
+    std::atomic<bool> done(false);
+    std::thread udp([&] {
+        for (uint32_t i = 1; i <= 20000; ++i) {
+            sh_->ManeuverStatus = (ASP::ManeuverStatus)(i % 8);
+            sh_->CancelMsg = (ASP::CancelMsg)(i % 8);
+            sh_->ManeuverProgressBar = (ASP::ManeuverProgressBar)(i % 101);
+            sh_->MobileChallengeSend = i;
+            sh_->publishAspSnapshot();
+        }
+        done = true;
+    });
+
+    int mixed = 0;
+    while (!done) {
+        AspSnapshot snapshot = sh_->getAspSnapshot();
+        uint64_t i = snapshot.MobileChallengeSend;
+        mixed += i != 0 && ((int)snapshot.ManeuverStatus != (int)(i % 8)
+                || (int)snapshot.CancelMsg != (int)(i % 8)
+                || snapshot.ManeuverProgressBar != i % 101);
+    }
+    udp.join();
+    EXPECT_EQ(mixed, 0);
+    EXPECT_EQ(sh_->getAspSnapshot().MobileChallengeSend, 20000u);
 }
 
 TEST_F(SignalHandlerTest, EncodeTCMSignalData) {
@@ -116,18 +172,19 @@ TEST_F(SignalHandlerTest, EncodeTCMSignalData) {
     sh_->AppAccelerationZ = 0x1234567890abcdef; // 64 bits
     sh_->AppCalcCheck = 0x1234; // 16 bits
     sh_->ManeuverEnableInput = TCM::ManeuverEnableInput::ValidScrnInput; // 1, 2 bits
-    sh_->ManeuverGearSelect = TCM::ManeuverGearSelect::Reverse; // 2, 2 bits
-    sh_->NudgeSelect = TCM::NudgeSelect::NudgeNotAvailable; // 0, 2 bits
     sh_->AppSliderPosY = 0x987; // 12 bits
     sh_->AppSliderPosX = 0x120; // 11 bits
-    sh_->ConnectionApproval = TCM::ConnectionApproval::AllowedDevice; // 2, 2 bits
-    sh_->ManeuverButtonPress = TCM::ManeuverButtonPress::ContinueManouevre; // 7, 3 bits
-    sh_->DeviceControlMode = TCM::DeviceControlMode::RCParkIn; // 5, 4 bits
-    sh_->ManeuverTypeSelect = TCM::ManeuverTypeSelect::Parallel; // 1, 2 bits
-    sh_->ManeuverDirectionSelect = TCM::ManeuverDirectionSelect::None; // 0, 2 bits
-    sh_->ExploreModeSelect = TCM::ExploreModeSelect::Pressed; // 1, 1 bit
+    sh_->setConnectionApproval(TCM::ConnectionApproval::AllowedDevice); // 2, 2 bits
+    sh_->setManeuverButtonPress(TCM::ManeuverButtonPress::ContinueManouevre); // 7, 3 bits
+    sh_->setDeviceControlMode(TCM::DeviceControlMode::RCParkIn); // 5, 4 bits
+    sh_->setManeuverSelection({
+        TCM::ManeuverTypeSelect::Parallel, // 1, 2 bits
+        TCM::ManeuverDirectionSelect::None, // 0, 2 bits
+        TCM::ManeuverGearSelect::Reverse, // 2, 2 bits
+        TCM::ManeuverSideSelect::Right, // 2, 2 bits
+        TCM::ExploreModeSelect::Pressed, // 1, 1 bit
+        TCM::NudgeSelect::NudgeNotAvailable}); // 0, 2 bits
     sh_->RemoteDeviceBatteryLevel = 0x7F; // 7 bits
-    sh_->ManeuverSideSelect = TCM::ManeuverSideSelect::Right; // 2, 2 bits
     sh_->MobileChallengeReply = 0x1234567890abcdef; // 64 bits
 
     uint8_t buffer[UDP_BUF_MAX];
@@ -194,6 +251,130 @@ TEST_F(SignalHandlerTest, EncodeTCMSignalData) {
     EXPECT_TRUE(std::memcmp(buffer, expected, TCM_TOTAL_PACKET_SIZE) == 0);
 }
 
+// DMH samples published while packets are being encoded go out whole
+TEST_F(SignalHandlerTest, EncodeTakesWholeDmhSample) {
+    std::atomic<bool> done(false);
+    std::thread mobile([&] {
+        for (uint16_t i = 1; i <= 20000; ++i) {
+            sh_->setManeuverEnableInput(i & 0x7FF, i & 0xFFF, i, i & 1, i);
+        }
+        done = true;
+    });
+
+    uint8_t buffer[UDP_BUF_MAX];
+    int torn = 0;
+    while (!done) {
+        sh_->encodeTCMSignalData(buffer);
+        uint16_t crc = (buffer[8] << 8) | buffer[9];
+        uint16_t y = ((buffer[11] & 0x0F) << 8) | buffer[12];
+        bool valid = ((buffer[10] >> 2) & 0x3) == (int)TCM::ManeuverEnableInput::ValidScrnInput;
+        torn += sh_->AppCalcCheck != crc || sh_->AppSliderPosY != y
+                || y != (crc & 0xFFF) || sh_->AppSliderPosX != (crc & 0x7FF)
+                || sh_->AppAccelerationZ != crc || valid != (bool)(crc & 1);
+    }
+    mobile.join();
+    EXPECT_EQ(torn, 0);
+
+    sh_->encodeTCMSignalData(buffer);
+    EXPECT_EQ(sh_->AppCalcCheck, 20000);
+    EXPECT_EQ(sh_->getDmhInput().AppCalcCheck, 20000);
+}
+
+// each queued command goes out in its own frame, in the order it was set
+TEST_F(SignalHandlerTest, EncodeSendsEveryQueuedCommand) {
+    uint8_t buffer[UDP_BUF_MAX];
+    auto buttonPress = [&buffer] { return (TCM::ManeuverButtonPress)(buffer[16] & 0x7); };
+    auto controlMode = [&buffer] { return (TCM::DeviceControlMode)(buffer[17] >> 4); };
+
+    sh_->setDeviceControlMode(TCM::DeviceControlMode::RCParkIn);
+    sh_->setManeuverButtonPress(TCM::ManeuverButtonPress::ConfirmationSelected);
+    sh_->setManeuverButtonPress(TCM::ManeuverButtonPress::CancellationSelected);
+    sh_->setDeviceControlMode(TCM::DeviceControlMode::RCParkOut);
+    EXPECT_EQ(sh_->ManeuverButtonPress, TCM::ManeuverButtonPress::CancellationSelected);
+
+    sh_->encodeTCMSignalData(buffer);
+    EXPECT_EQ(controlMode(), TCM::DeviceControlMode::RCParkIn);
+    EXPECT_EQ(buttonPress(), TCM::ManeuverButtonPress::ConfirmationSelected);
+
+    sh_->encodeTCMSignalData(buffer);
+    EXPECT_EQ(controlMode(), TCM::DeviceControlMode::RCParkOut);
+    EXPECT_EQ(buttonPress(), TCM::ManeuverButtonPress::CancellationSelected);
+
+    sh_->encodeTCMSignalData(buffer);
+    EXPECT_EQ(controlMode(), TCM::DeviceControlMode::RCParkOut);
+    EXPECT_EQ(buttonPress(), TCM::ManeuverButtonPress::CancellationSelected);
+}
+
+// after the queue overflows, the encoder resyncs from the latest queued commands,
+// not from the signal members other threads write
+TEST_F(SignalHandlerTest, EncodeResyncsFromLatestCommandsAfterOverflow) {
+    uint8_t buffer[UDP_BUF_MAX];
+    auto controlMode = [&buffer] { return (TCM::DeviceControlMode)(buffer[17] >> 4); };
+
+    // fill the queue with one value, then overflow it with another
+    for (size_t i = 0; i < TCM_COMMAND_QUEUE_SIZE; ++i) {
+        sh_->setDeviceControlMode(TCM::DeviceControlMode::RCParkOut);
+    }
+    sh_->setDeviceControlMode(TCM::DeviceControlMode::RCParkIn);
+    sh_->DeviceControlMode = TCM::DeviceControlMode::RCParkOut;
+
+    for (size_t cycle = 0; cycle < TCM_COMMAND_QUEUE_SIZE + 8; ++cycle) {
+        sh_->encodeTCMSignalData(buffer);
+        ASSERT_EQ(controlMode(), TCM::DeviceControlMode::RCParkIn) << "cycle " << cycle;
+    }
+}
+
+// once warmed up, a send / receive cycle over the ASP link makes no heap allocations
+TEST_F(SignalHandlerTest, UdpCycleDoesNotAllocate) {
+    const uint16_t port = 8094;
+    sh_->setTransport(AspTransportType::UnixDgram);
+    sh_->setAspPort(port);
+    sh_->initiateTicks();
+    sh_->setConnectionApproval(TCM::ConnectionApproval::AllowedDevice);
+
+    std::unique_ptr<AspTransport> asp = AspTransport::create(AspTransportType::UnixDgram);
+    asp->setPort(port);
+    ASSERT_TRUE(asp->open(false));
+
+    // two ASP states, alternated so that every cycle decodes a change
+    uint8_t replies[2][ASPM_TOTAL_PACKET_SIZE] = {};
+    for (int r = 0; r < 2; ++r) {
+        uint64_t lm[ASPM_LM::MAXSignal] = {0};
+        lm[ASPM_LM::ManeuverStatus] = r ? 3 : 4;
+        lm[ASPM_LM::ManeuverProgressBar] = r ? 10 : 20;
+        PduView pdu(replies[r], sizeof(replies[r]));
+        for (uint32_t id : {HRD_ID_OF_ASPM_LM, HRD_ID_OF_ASPM_LM_ObjSegment, HRD_ID_OF_ASPM_RemoteTarget,
+                            HRD_ID_OF_ASPM_LM_Session, HRD_ID_OF_ASPM_LM_Trunc}) {
+            ASSERT_TRUE(pdu.putHeader(id, pduPayloadLength(aspmPduType(id))));
+            if (id == HRD_ID_OF_ASPM_LM) {
+                AspmLmCodec::encode(lm, pdu.getPayload());
+            }
+            pdu = pdu.next();
+        }
+        ASSERT_EQ(pdu.getAvailable(), 0u);
+    }
+
+    uint8_t packet[UDP_BUF_MAX];
+    auto cycle = [&](int i) {
+        sh_->sendSignals();
+        ASSERT_EQ(asp->receive(packet, sizeof(packet)), TCM_TOTAL_PACKET_SIZE);
+        asp->send(replies[i % 2], ASPM_TOTAL_PACKET_SIZE);
+        ASSERT_EQ(sh_->receiveSignals(), ASPM_TOTAL_PACKET_SIZE);
+    };
+
+    for (int i = 0; i < 4; ++i) {
+        cycle(i);
+    }
+    size_t before = getThreadAllocations();
+    for (int i = 0; i < 100; ++i) {
+        cycle(i);
+    }
+    EXPECT_EQ(getThreadAllocations(), before);
+    EXPECT_EQ((int)sh_->ManeuverProgressBar, 10);
+
+    asp->close();
+}
+
 TEST_F(SignalHandlerTest, GetManeuverFromASP) {
     std::string maneuver_str;
     for (int ActiveParkingType = 3; ActiveParkingType <= 5; ++ActiveParkingType) {
@@ -0,0 +1,107 @@
+#include <gtest/gtest.h>
+
+#include "sockethandler.hpp"
+#include "latencyhistogram.hpp"
+#include "testutils.hpp"
+
+// SocketHandler on its own port, driven from the test thread
+class SocketHandlerTest: public ::testing::Test {
+protected:
+    virtual void SetUp() {
+        server_.setConnectCallback([this](const int& connection) { connection_ = connection; });
+        server_.connectServer(SOCK_STREAM, (uint64_t)"127.0.0.1", port_);
+        client_ = std::make_shared<MobileClient>("localhost", port_);
+        server_.pollEvents(100); // accept
+        ASSERT_EQ(server_.getClientCount(), 1u);
+    }
+    virtual void TearDown() {
+        client_->disconnect();
+        server_.disconnectServer();
+    }
+    const uint16_t port_ = 8071;
+    SocketHandler server_;
+    int connection_ = -1;
+    std::shared_ptr<MobileClient> client_;
+};
+
+// status frames sent before the writer runs are latest-wins
+TEST_F(SocketHandlerTest, LatestWinsSupersedesUnsentFrames) {
+    for (int i = 0; i < 10; ++i) {
+        server_.sendTCP("{\"group\":\"vehicle_status\"}", std::to_string(i), "vehicle_status");
+    }
+    server_.sendTCP("{\"group\":\"vehicle_api_version\"}", "{}");
+    EXPECT_EQ(server_.getSupersededFrameCount(), 9u);
+    server_.pollEvents(100); // single writer flushes the queue
+    TCPMessage reply = client_->receive();
+    EXPECT_EQ(reply.body, "9");
+    reply = client_->receive();
+    EXPECT_EQ(reply.header, "{\"group\":\"vehicle_api_version\"}");
+}
+
+// a full queue applies the configured backpressure policy
+TEST_F(SocketHandlerTest, BackpressureDropsNewest) {
+    server_.setBackpressurePolicy(BackpressurePolicy::DropNewest, 2);
+    for (int i = 0; i < 5; ++i) {
+        server_.sendTCP("{}", std::to_string(i));
+    }
+    EXPECT_EQ(server_.getDroppedFrameCount(), 3u);
+    server_.pollEvents(100);
+    EXPECT_EQ(client_->receive().body, "0");
+    EXPECT_EQ(client_->receive().body, "1");
+}
+
+// a peer that opted in to heartbeats and goes quiet is closed by the timer
+TEST_F(SocketHandlerTest, LapsedHeartbeatClosesConnection) {
+    EXPECT_EQ(server_.checkClientConnection(connection_), 0);
+    EXPECT_EQ(server_.checkClientConnection(), 0);
+    server_.setLivenessTimeout(connection_, 100);
+    for (int i = 0; i < 10 && server_.getClientCount() > 0; ++i) {
+        server_.pollEvents(100);
+    }
+    EXPECT_EQ(server_.getClientCount(), 0u);
+    EXPECT_NE(server_.checkClientConnection(), 0);
+}
+
+// a connection flagged for closing no longer counts before the poll thread closes it
+TEST_F(SocketHandlerTest, ClosingConnectionIsNotConnected) {
+    server_.disconnectClient(connection_);
+    EXPECT_NE(server_.checkClientConnection(), 0);
+    server_.pollEvents(100);
+    EXPECT_EQ(server_.getClientCount(), 0u);
+}
+
+// a UDP backlog is drained in one call and only the newest valid datagram kept
+TEST(SocketHandlerUDPTest, ReceiveLatestSkipsBacklog) {
+    SocketHandler asp;
+    asp.connectServer(SOCK_DGRAM, (uint64_t)UDP_ADDR, UDP_PORT);
+    int tcm = socket(AF_INET, SOCK_DGRAM, 0);
+    struct sockaddr_in address;
+    bzero((char *)&address, sizeof(address));
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = inet_addr(UDP_ADDR);
+    address.sin_port = htons(UDP_PORT);
+    for (uint8_t i = 1; i <= 20; ++i) {
+        uint8_t packet[4] = {i, 0, 0, 0};
+        sendto(tcm, packet, sizeof(packet), 0, (struct sockaddr*)&address, sizeof(address));
+    }
+    sendto(tcm, "bad", 3, 0, (struct sockaddr*)&address, sizeof(address));
+    uint8_t packet[64] = {0};
+    EXPECT_EQ(asp.receiveLatestUDP(packet, sizeof(packet), 4), 4);
+    EXPECT_EQ(packet[0], 20);
+    EXPECT_EQ(asp.getSupersededPacketCount(), 19u);
+    EXPECT_GT(asp.getLastReceiveTimestamp(), 0u);
+    EXPECT_LE(asp.getLastReceiveTimestamp(), LatencyHistogram::now());
+
+    // replies go back to the sender, several per syscall
+    struct iovec replies[3];
+    for (int i = 0; i < 3; ++i) {
+        replies[i].iov_base = packet;
+        replies[i].iov_len = 4;
+    }
+    EXPECT_EQ(asp.sendBatchUDP(replies, 3), 3);
+    for (int i = 0; i < 3; ++i) {
+        EXPECT_EQ(recv(tcm, packet, sizeof(packet), 0), 4);
+    }
+    close(tcm);
+    asp.disconnectServer();
+}
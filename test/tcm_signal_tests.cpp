@@ -19,6 +19,7 @@ protected:
 
         // simulate RD authentication
         sh_->AcknowledgeRemotePIN = DCM::AcknowledgeRemotePIN::CorrectPIN;
+        sh_->publishAspSnapshot();
         sh_->ConnectionApproval = TCM::ConnectionApproval::AllowedDevice;
         client_->receive(); // clear vehicle_status for CorrectPIN
     }
@@ -101,6 +102,7 @@ TEST_F(TCMSignalTest, ConnectionApprovalTermsRejected) {
 // then ManeuverButtonPress should be set to ConfirmationSelected
 TEST_F(TCMSignalTest, ManeuverButtonPressConfirmation) {
     sh_->ManeuverStatus = ASP::ManeuverStatus::Selecting;
+    sh_->publishAspSnapshot();
     sh_->ManeuverButtonPress = TCM::ManeuverButtonPress::None;
     sendDeadmansHandle(true);
     std::this_thread::sleep_for(std::chrono::milliseconds(10));
@@ -111,6 +113,7 @@ TEST_F(TCMSignalTest, ManeuverButtonPressConfirmation) {
 // then ManeuverButtonPress should be set to ResumeSelected
 TEST_F(TCMSignalTest, ManeuverButtonPressResume) {
     sh_->ManeuverStatus = ASP::ManeuverStatus::Interrupted;
+    sh_->publishAspSnapshot();
     sh_->ManeuverButtonPress = TCM::ManeuverButtonPress::None;
     sendDeadmansHandle(true);
     std::this_thread::sleep_for(std::chrono::milliseconds(10));
@@ -124,6 +127,7 @@ TEST_F(TCMSignalTest, ManeuverButtonPressCancellation) {
     sendCancelManeuver();
     std::this_thread::sleep_for(std::chrono::milliseconds(10));
     sh_->ManeuverStatus = ASP::ManeuverStatus::Cancelled; // simulate ASP state change
+    sh_->publishAspSnapshot();
     client_->receive();
     EXPECT_EQ(sh_->ManeuverButtonPress, TCM::ManeuverButtonPress::CancellationSelected);
 }
@@ -140,31 +144,32 @@ TEST_F(TCMSignalTest, ManeuverButtonPressEndManouevre) {
 // if deadmans_handle is sent with "enable_vehicle_motion" set to true
 // then ManeuverEnableInput should be set to ValidScrnInput
 TEST_F(TCMSignalTest, ManeuverEnableInputValid) {
-    sh_->ManeuverEnableInput = TCM::ManeuverEnableInput::NoScrnInput;
+    sh_->setDmhInput({0, 0, 0, TCM::ManeuverEnableInput::NoScrnInput, 0});
     sendDeadmansHandle(true);
     std::this_thread::sleep_for(std::chrono::milliseconds(10));
-    EXPECT_EQ(sh_->ManeuverEnableInput, TCM::ManeuverEnableInput::ValidScrnInput);
+    EXPECT_EQ(sh_->getDmhInput().ManeuverEnableInput, TCM::ManeuverEnableInput::ValidScrnInput);
 }
 
 // if deadmans_handle is sent with "enable_vehicle_motion" set to false
 // then ManeuverEnableInput should not be set to NoScrnInput
 TEST_F(TCMSignalTest, ManeuverEnableInputInvalid) {
-    sh_->ManeuverEnableInput = TCM::ManeuverEnableInput::InvalidScrnInput;
+    sh_->setDmhInput({0, 0, 0, TCM::ManeuverEnableInput::InvalidScrnInput, 0});
     sendDeadmansHandle(false);
     std::this_thread::sleep_for(std::chrono::milliseconds(10));
-    EXPECT_EQ(sh_->ManeuverEnableInput, TCM::ManeuverEnableInput::NoScrnInput);
+    EXPECT_EQ(sh_->getDmhInput().ManeuverEnableInput, TCM::ManeuverEnableInput::NoScrnInput);
 }
 
 // if deadmans_handle is received
 // then coordinate signals should be set to "dmh_horizontal_touch" and "dmh_vertical_touch"
 TEST_F(TCMSignalTest, DMHCoordinates) {
-    EXPECT_EQ(sh_->AppSliderPosX, 0);
-    EXPECT_EQ(sh_->AppSliderPosY, 0);
+    EXPECT_EQ(sh_->getDmhInput().AppSliderPosX, 0);
+    EXPECT_EQ(sh_->getDmhInput().AppSliderPosY, 0);
     sendDeadmansHandle(true);
     std::this_thread::sleep_for(std::chrono::milliseconds(10));
-    EXPECT_EQ(sh_->AppAccelerationZ, 11);
-    EXPECT_EQ(sh_->AppSliderPosX, 20);
-    EXPECT_EQ(sh_->AppSliderPosY, 30);
+    DmhInput input = sh_->getDmhInput();
+    EXPECT_EQ(input.AppAccelerationZ, 11);
+    EXPECT_EQ(input.AppSliderPosX, 20);
+    EXPECT_EQ(input.AppSliderPosY, 30);
 }
 
 // TCM should start up with no maneuver selected
@@ -182,6 +187,7 @@ TEST_F(TCMSignalTest, ManeuverSelectStrFwd) {
     sh_->ActiveParkingType = ASP::ActiveParkingType::PushPull;
     sh_->ActiveManeuverOrientation = ASP::ActiveManeuverOrientation::PerpendicularFront;
     sh_->ConfirmAvailability = ASP::ConfirmAvailability::OfferEnabled;
+    sh_->publishAspSnapshot();
     sendManeuverInit("StrFwd");
     client_->receive();
     EXPECT_EQ(sh_->ExploreModeSelect, TCM::ExploreModeSelect::Pressed);
@@ -197,6 +203,7 @@ TEST_F(TCMSignalTest, ManeuverSelectStrRvs) {
     sh_->ActiveParkingType = ASP::ActiveParkingType::PushPull;
     sh_->ActiveManeuverOrientation = ASP::ActiveManeuverOrientation::PerpendicularRear;
     sh_->ConfirmAvailability = ASP::ConfirmAvailability::OfferEnabled;
+    sh_->publishAspSnapshot();
     sendManeuverInit("StrRvs");
     client_->receive();
     EXPECT_EQ(sh_->ExploreModeSelect, TCM::ExploreModeSelect::Pressed);
@@ -212,6 +219,7 @@ TEST_F(TCMSignalTest, ManeuverSelectNdgFwd) {
     sh_->ActiveParkingType = ASP::ActiveParkingType::LongitudinalAssist;
     sh_->ActiveManeuverOrientation = ASP::ActiveManeuverOrientation::PerpendicularFront;
     sh_->ConfirmAvailability = ASP::ConfirmAvailability::OfferEnabled;
+    sh_->publishAspSnapshot();
     sendManeuverInit("NdgFwd");
     client_->receive();
     EXPECT_EQ(sh_->NudgeSelect, TCM::NudgeSelect::NudgePressed);
@@ -227,6 +235,7 @@ TEST_F(TCMSignalTest, ManeuverSelectNdgRvs) {
     sh_->ActiveParkingType = ASP::ActiveParkingType::LongitudinalAssist;
     sh_->ActiveManeuverOrientation = ASP::ActiveManeuverOrientation::PerpendicularRear;
     sh_->ConfirmAvailability = ASP::ConfirmAvailability::OfferEnabled;
+    sh_->publishAspSnapshot();
     sendManeuverInit("NdgRvs");
     client_->receive();
     EXPECT_EQ(sh_->NudgeSelect, TCM::NudgeSelect::NudgePressed);
@@ -244,6 +253,7 @@ TEST_F(TCMSignalTest, ManeuverSelectInLftFwd) {
     sh_->ActiveManeuverOrientation = ASP::ActiveManeuverOrientation::PerpendicularFront;
     sh_->ActiveManeuverSide = ASP::ActiveManeuverSide::Left;
     sh_->ConfirmAvailability = ASP::ConfirmAvailability::OfferEnabled;
+    sh_->publishAspSnapshot();
     sendManeuverInit("InLftFwd");
     client_->receive();
     EXPECT_EQ(sh_->ManeuverTypeSelect, TCM::ManeuverTypeSelect::Perpendicular);
@@ -260,6 +270,7 @@ TEST_F(TCMSignalTest, ManeuverSelectInLftRvs) {
     sh_->ActiveManeuverOrientation = ASP::ActiveManeuverOrientation::PerpendicularRear;
     sh_->ActiveManeuverSide = ASP::ActiveManeuverSide::Left;
     sh_->ConfirmAvailability = ASP::ConfirmAvailability::OfferEnabled;
+    sh_->publishAspSnapshot();
     sendManeuverInit("InLftRvs");
     client_->receive();
     EXPECT_EQ(sh_->ManeuverTypeSelect, TCM::ManeuverTypeSelect::Perpendicular);
@@ -276,6 +287,7 @@ TEST_F(TCMSignalTest, ManeuverSelectInRgtFwd) {
     sh_->ActiveManeuverOrientation = ASP::ActiveManeuverOrientation::PerpendicularFront;
     sh_->ActiveManeuverSide = ASP::ActiveManeuverSide::Right;
     sh_->ConfirmAvailability = ASP::ConfirmAvailability::OfferEnabled;
+    sh_->publishAspSnapshot();
     sendManeuverInit("InRgtFwd");
     client_->receive();
     EXPECT_EQ(sh_->ManeuverTypeSelect, TCM::ManeuverTypeSelect::Perpendicular);
@@ -292,6 +304,7 @@ TEST_F(TCMSignalTest, ManeuverSelectInRgtRvs) {
     sh_->ActiveManeuverOrientation = ASP::ActiveManeuverOrientation::PerpendicularRear;
     sh_->ActiveManeuverSide = ASP::ActiveManeuverSide::Right;
     sh_->ConfirmAvailability = ASP::ConfirmAvailability::OfferEnabled;
+    sh_->publishAspSnapshot();
     sendManeuverInit("InRgtRvs");
     client_->receive();
     EXPECT_EQ(sh_->ManeuverTypeSelect, TCM::ManeuverTypeSelect::Perpendicular);
@@ -308,6 +321,7 @@ TEST_F(TCMSignalTest, ManeuverSelectOutLftFwd) {
     sh_->ActiveManeuverOrientation = ASP::ActiveManeuverOrientation::PerpendicularFront;
     sh_->ActiveManeuverSide = ASP::ActiveManeuverSide::Left;
     sh_->ConfirmAvailability = ASP::ConfirmAvailability::OfferEnabled;
+    sh_->publishAspSnapshot();
     sendManeuverInit("OutLftFwd");
     client_->receive();
     EXPECT_EQ(sh_->ManeuverTypeSelect, TCM::ManeuverTypeSelect::Perpendicular);
@@ -324,6 +338,7 @@ TEST_F(TCMSignalTest, ManeuverSelectOutLftRvs) {
     sh_->ActiveParkingMode = ASP::ActiveParkingMode::ParkOut;
     sh_->ActiveManeuverOrientation = ASP::ActiveManeuverOrientation::PerpendicularRear;
     sh_->ActiveManeuverSide = ASP::ActiveManeuverSide::Left;
+    sh_->publishAspSnapshot();
     sendManeuverInit("OutLftRvs");
     client_->receive();
     EXPECT_EQ(sh_->ManeuverTypeSelect, TCM::ManeuverTypeSelect::Perpendicular);
@@ -340,6 +355,7 @@ TEST_F(TCMSignalTest, ManeuverSelectOutRgtFwd) {
     sh_->ActiveParkingMode = ASP::ActiveParkingMode::ParkOut;
     sh_->ActiveManeuverOrientation = ASP::ActiveManeuverOrientation::PerpendicularFront;
     sh_->ActiveManeuverSide = ASP::ActiveManeuverSide::Right;
+    sh_->publishAspSnapshot();
     sendManeuverInit("OutRgtFwd");
     client_->receive();
     EXPECT_EQ(sh_->ManeuverTypeSelect, TCM::ManeuverTypeSelect::Perpendicular);
@@ -356,6 +372,7 @@ TEST_F(TCMSignalTest, ManeuverSelectOutRgtRvs) {
     sh_->ActiveManeuverOrientation = ASP::ActiveManeuverOrientation::PerpendicularRear;
     sh_->ActiveManeuverSide = ASP::ActiveManeuverSide::Right;
     sh_->ConfirmAvailability = ASP::ConfirmAvailability::OfferEnabled;
+    sh_->publishAspSnapshot();
     sendManeuverInit("OutRgtRvs");
     client_->receive();
     EXPECT_EQ(sh_->ManeuverTypeSelect, TCM::ManeuverTypeSelect::Perpendicular);
@@ -372,6 +389,7 @@ TEST_F(TCMSignalTest, ManeuverSelectOutLftPrl) {
     sh_->ActiveManeuverOrientation = ASP::ActiveManeuverOrientation::Parallel;
     sh_->ActiveManeuverSide = ASP::ActiveManeuverSide::Left;
     sh_->ConfirmAvailability = ASP::ConfirmAvailability::OfferEnabled;
+    sh_->publishAspSnapshot();
     sendManeuverInit("OutLftPrl");
     client_->receive();
     EXPECT_EQ(sh_->ManeuverTypeSelect, TCM::ManeuverTypeSelect::Parallel);
@@ -388,6 +406,7 @@ TEST_F(TCMSignalTest, ManeuverSelectOutRgtPrl) {
     sh_->ActiveParkingMode = ASP::ActiveParkingMode::ParkOut;
     sh_->ActiveManeuverOrientation = ASP::ActiveManeuverOrientation::Parallel;
     sh_->ActiveManeuverSide = ASP::ActiveManeuverSide::Right;
+    sh_->publishAspSnapshot();
     sendManeuverInit("OutRgtPrl");
     client_->receive();
     EXPECT_EQ(sh_->ManeuverTypeSelect, TCM::ManeuverTypeSelect::Parallel);
@@ -400,6 +419,7 @@ TEST_F(TCMSignalTest, ManeuverSelectOutRgtPrl) {
 // then corresponding TCM signals should be set accordingly
 TEST_F(TCMSignalTest, ManeuverSelectRtnToOgn) {
     sh_->ConfirmAvailability = ASP::ConfirmAvailability::OfferEnabled;
+    sh_->publishAspSnapshot();
     sendManeuverInit("RtnToOgn");
     client_->receive();
     EXPECT_EQ(sh_->ManeuverButtonPress, TCM::ManeuverButtonPress::ReturnToStart);
@@ -1,6 +1,35 @@
 #include "testutils.hpp"
 #include "templatehandler.hpp"
 
+#include <new>
+#include <stdlib.h>
+
+namespace {
+thread_local size_t threadAllocations = 0;
+}
+
+// Counted, so tests can check that a path does not allocate.
+void* operator new(size_t size) {
+    ++threadAllocations;
+    void* ptr = malloc(size ? size : 1);
+    if (ptr == nullptr) {
+        throw std::bad_alloc();
+    }
+    return ptr;
+}
+
+void operator delete(void* ptr) noexcept {
+    free(ptr);
+}
+
+void operator delete(void* ptr, size_t) noexcept {
+    free(ptr);
+}
+
+size_t getThreadAllocations() {
+    return threadAllocations;
+}
+
 json constructHeader(const std::string& group_name) {
     TemplateHandler templates;
     json header = templates.getRawHeaderTemplate();
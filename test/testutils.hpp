@@ -4,6 +4,7 @@
 #include <netinet/in.h>
 #include <arpa/inet.h>
 #include <netdb.h>
+#include <errno.h>
 
 #include "json.hpp"
 #include "aspm.hpp"
@@ -17,6 +18,9 @@ struct TCPMessage {
 
 json constructHeader(const std::string& group_name);
 
+// Number of heap allocations made so far by the calling thread
+size_t getThreadAllocations();
+
 // Represents the ASP socket connection for testing purposes
 class StubASP : public ASPM {
 public:
@@ -51,8 +55,10 @@ public:
         uint8_t bufferFromTCM[ UDP_BUF_MAX ];
         bzero( bufferToTCM, UDP_BUF_MAX );
         bzero( bufferFromTCM, UDP_BUF_MAX );
-        // clear initial send from TCM
-        recvfrom(sock, bufferFromTCM, sizeof(bufferFromTCM), 0,(struct sockaddr *)&serv_addr, &addr_len);
+        // clear initial send from TCM; io_uring completions for the calling
+        // thread can interrupt a timed receive, so retry on EINTR
+        while (recvfrom(sock, bufferFromTCM, sizeof(bufferFromTCM), 0,(struct sockaddr *)&serv_addr, &addr_len) < 0
+               && errno == EINTR) {}
         while (bytes_received <= 0) {
             uint16_t outBufSize = encodeASPMSignalData(bufferToTCM);
             ssize_t bytes_sent = sendto(
@@ -64,13 +70,15 @@ public:
                 addr_len );
             // If we receive a packet back, that means the TCM server received the packet we sent
             // timeout flag is set so that this call will only block for 1 second
-            bytes_received = recvfrom(
-                sock,
-                bufferFromTCM,
-                sizeof(bufferFromTCM),
-                0,
-                (struct sockaddr *)&serv_addr,
-                &addr_len );
+            do {
+                bytes_received = recvfrom(
+                    sock,
+                    bufferFromTCM,
+                    sizeof(bufferFromTCM),
+                    0,
+                    (struct sockaddr *)&serv_addr,
+                    &addr_len );
+            } while (bytes_received < 0 && errno == EINTR);
             decodeTCMSignalData(bufferFromTCM);
             if (bytes_received < 0) {
                 std::cout << "WARNING: UDP packet not received by server...retrying" << std::endl;
@@ -115,6 +123,16 @@ public:
             throw std::runtime_error("ERROR: failed to send header/body payloads");
         }
     }
+    // Writes pre-framed bytes as-is, e.g. several frames or part of one.
+    void sendRaw(const std::string& bytes) {
+        if (write(sock, bytes.data(), bytes.size()) < 0) {
+            throw std::runtime_error("ERROR: failed to send raw bytes");
+        }
+    }
+    static std::string frame(const TCPMessage& msg) {
+        uint32_t sizes[2] = { htonl(msg.header.length()), htonl(msg.body.length()) };
+        return std::string((const char*)sizes, sizeof(sizes)) + msg.header + msg.body;
+    }
     struct TCPMessage receive(bool ignore_vehicle_status = false) {
         struct TCPMessage msg;
         uint32_t headerSize;
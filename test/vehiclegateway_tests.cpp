@@ -0,0 +1,91 @@
+#include <gtest/gtest.h>
+
+#include "vehiclegateway.hpp"
+#include "testutils.hpp"
+
+// vehicles may be listed one by one
+TEST(VehicleGatewayConfigTest, ParseList) {
+    std::vector<VehicleConfig> vehicles;
+    ASSERT_TRUE(VehicleGateway::parseConfig(
+        "{\"transport\": \"unix\", \"vehicles\": ["
+        "{\"name\": \"bench-1\", \"tcp_port\": 9200, \"asp_port\": 9700},"
+        "{\"tcp_port\": 9201, \"asp_port\": 9701, \"transport\": \"udp\"}]}",
+        vehicles));
+    ASSERT_EQ(vehicles.size(), 2u);
+    EXPECT_EQ(vehicles[0].name, "bench-1");
+    EXPECT_EQ(vehicles[0].tcpPort, 9200);
+    EXPECT_EQ(vehicles[0].aspPort, 9700);
+    EXPECT_EQ(vehicles[0].transport, AspTransportType::UnixDgram);
+    EXPECT_EQ(vehicles[1].name, "vehicle-1");
+    EXPECT_EQ(vehicles[1].transport, AspTransportType::Udp);
+}
+
+// or generated from a count, with consecutive ports
+TEST(VehicleGatewayConfigTest, ParseCount) {
+    std::vector<VehicleConfig> vehicles;
+    ASSERT_TRUE(VehicleGateway::parseConfig(
+        "{\"count\": 300, \"tcp_port_base\": 20000, \"asp_port_base\": 30000}", vehicles));
+    ASSERT_EQ(vehicles.size(), 300u);
+    EXPECT_EQ(vehicles[299].tcpPort, 20299);
+    EXPECT_EQ(vehicles[299].aspPort, 30299);
+    EXPECT_EQ(vehicles[299].name, "vehicle-299");
+}
+
+// malformed configs are reported, not thrown
+TEST(VehicleGatewayConfigTest, RejectsInvalid) {
+    std::vector<VehicleConfig> vehicles;
+    EXPECT_FALSE(VehicleGateway::parseConfig("{\"count\": ", vehicles));
+    EXPECT_FALSE(VehicleGateway::parseConfig("{\"count\": 0}", vehicles));
+    EXPECT_FALSE(VehicleGateway::parseConfig("{\"count\": 10, \"tcp_port_base\": 65530}", vehicles));
+    EXPECT_FALSE(VehicleGateway::parseConfig("{\"vehicles\": [{\"tcp_port\": \"x\"}]}", vehicles));
+    EXPECT_TRUE(vehicles.empty());
+}
+
+// two vehicles on shared threads, each with its own ports and signal state
+class VehicleGatewayTest: public ::testing::Test {
+protected:
+    virtual void SetUp() {
+        for (int i = 0; i < 2; ++i) {
+            VehicleConfig config;
+            config.name = "vehicle-" + std::to_string(i);
+            config.tcpPort = 9100 + i;
+            config.aspPort = 9600 + i;
+            config.transport = AspTransportType::Udp;
+            gateway_.addVehicle(config);
+            gateway_.getSignalHandler(i)->ActiveAutonomousFeature = ASP::ActiveAutonomousFeature::Parking;
+            asp_[i] = std::make_shared<StubASP>("127.0.0.1", 9600 + i);
+        }
+        ASSERT_TRUE(gateway_.start());
+        for (int i = 0; i < 2; ++i) {
+            client_[i] = std::make_shared<MobileClient>("localhost", 9100 + i);
+        }
+    }
+    virtual void TearDown() {
+        gateway_.stop();
+        for (int i = 0; i < 2; ++i) {
+            asp_[i]->disconnect();
+        }
+    }
+    VehicleGateway gateway_;
+    std::shared_ptr<StubASP> asp_[2];
+    std::shared_ptr<MobileClient> client_[2];
+};
+
+TEST_F(VehicleGatewayTest, VehiclesAreIsolated) {
+    asp_[0]->ManeuverStatus = ASP::ManeuverStatus::Interrupted;
+    asp_[0]->sync();
+    struct TCPMessage reply = client_[0]->receive();
+    json reply_header = json::parse(reply.header);
+    EXPECT_EQ(reply_header["group"], (std::string)RD::MANEUVER_STATUS);
+    EXPECT_EQ(gateway_.getSignalHandler(0)->ManeuverStatus, ASP::ManeuverStatus::Interrupted);
+    EXPECT_NE(gateway_.getSignalHandler(1)->ManeuverStatus, ASP::ManeuverStatus::Interrupted);
+
+    // the other vehicle still answers its own phone
+    TCPMessage msg;
+    msg.header = constructHeader(RD::GET_API_VERSION).dump();
+    client_[1]->send(msg);
+    reply = client_[1]->receive();
+    reply_header = json::parse(reply.header);
+    EXPECT_EQ(reply_header["group"], (std::string)RD::VEHICLE_API_VERSION);
+    EXPECT_GT(gateway_.getSignalHandler(0)->getArrivalToDecodeLatency().getCount(), 0u);
+}
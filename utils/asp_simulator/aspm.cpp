@@ -34,7 +34,7 @@ ASPM::ASPM( SIMULATOR type, MANOUEVRE testManeuver )
         isProgressHandledExternally_( false ),
         scanStartTime_( (struct timeval){0} ),
         dmhStartTime_( (struct timeval){0} ),
-        socketHandler_( ),
+        transport_( ),
         initialized_( false ),
         running_( true ),
         challenge_idx_( 0 ),
@@ -59,7 +59,8 @@ ASPM::ASPM( SIMULATOR type, MANOUEVRE testManeuver )
 
 ASPM::~ASPM( )
 {
-    if (initialized_) {
+    if( signalLoopHandler_.joinable( ) )
+    {
         signalLoopHandler_.join( );
         progressBarLoopHandler_.join( );
     }
@@ -67,19 +68,24 @@ ASPM::~ASPM( )
 
 void ASPM::stop() {
     running_ = false;
-    socketHandler_.disconnectClient( false );
-    socketHandler_.disconnectServer( );
-    signalLoopHandler_.join( );
-    progressBarLoopHandler_.join( );
+    wakeup_.notify( );
+    if( transport_ )
+    {
+        transport_->close( );
+    }
+    if( signalLoopHandler_.joinable( ) )
+    {
+        signalLoopHandler_.join( );
+        progressBarLoopHandler_.join( );
+    }
 }
 
 void ASPM::initiateEventLoops( )
 {
-    // Generate a new UDP socket
-    socketHandler_.connectServer(
-            (int32_t)SOCK_DGRAM,
-            (uint64_t)UDP_ADDR,
-            (uint16_t)UDP_PORT );
+    // Open the ASP end of the selected link
+    transport_ = AspTransport::create( getTransportType( ) );
+    transport_->setPort( getAspPort( ) );
+    transport_->open( false );
     initialized_ = true;
     signalLoopHandler_ = std::thread( &ASPM::updateSignalEventLoop_, this );
     progressBarLoopHandler_ = std::thread( &ASPM::progressBarEventLoop_, this );
@@ -576,9 +582,8 @@ void ASPM::setManeuverButtonPress( const TCM::ManeuverButtonPress& mode )
     }
 
     // For cancellation, wait until the TCM confirms that mode has been set.
-    while( ManeuverButtonPress != mode )
+    while( ManeuverButtonPress != mode && wakeup_.waitFor( ASP_REFRESH_RATE ) )
     {
-        usleep( ASP_REFRESH_RATE );
     }
 
     // // leave per commonly-used state debugging statements.
@@ -635,9 +640,8 @@ void ASPM::setConnectionApproval( const TCM::ConnectionApproval& mode )
     }
 
     // Wait until the TCM confirms that ConnectionApproval has been set.
-    while( ConnectionApproval != mode )
+    while( ConnectionApproval != mode && wakeup_.waitFor( ASP_REFRESH_RATE ) )
     {
-        usleep( ASP_REFRESH_RATE );
     }
 
     return;
@@ -1099,9 +1103,8 @@ void ASPM::progressBarEventLoop_( )
             case ASP::ManeuverStatus::Interrupted:
             {
 
-                while( progress < 1.0 )
+                while( progress < 1.0 && wakeup_.waitFor( ASP_REFRESH_RATE ) )
                 {
-                    usleep( ASP_REFRESH_RATE );
 
                     if( progress == ManeuverProgressBar / 100 ) { continue; }
 
@@ -1129,7 +1132,7 @@ void ASPM::progressBarEventLoop_( )
             }
             default:
             {
-                usleep( ASP_REFRESH_RATE );
+                wakeup_.waitFor( ASP_REFRESH_RATE );
                 break;
             }
         }
@@ -1153,9 +1156,10 @@ void ASPM::updateSignalEventLoop_( )
         bzero( bufferToASP, UDP_BUF_MAX );
         bzero( bufferToTCM, UDP_BUF_MAX );
 
-        ssize_t bytes_received = socketHandler_.receiveUDP(
+        ssize_t bytes_received = transport_->receiveLatest(
                 bufferToASP,
-                sizeof(bufferToASP) );
+                sizeof(bufferToASP),
+                TCM_TOTAL_PACKET_SIZE );
     {
         // while updating signals, stop actions on concurrent threads.
         std::lock_guard<std::mutex> lock( getMutex( ) );
@@ -1182,7 +1186,7 @@ void ASPM::updateSignalEventLoop_( )
 
         uint16_t outBufSize = encodeASPMSignalData(bufferToTCM);
 
-        int sentLen = (int)socketHandler_.sendUDP(
+        int sentLen = (int)transport_->send(
                 bufferToTCM,
                 outBufSize );
 
@@ -1196,7 +1200,7 @@ void ASPM::updateSignalEventLoop_( )
     }
     }
 
-    socketHandler_.disconnectServer( );
+    transport_->close( );
 
     return;
 }
@@ -1842,10 +1846,10 @@ uint16_t ASPM::encodeASPMSignalData(uint8_t* buffer)
     for (kk = 0; kk<NUMBER_OF_ASPM_PDU ; ++kk) {
         uint16_t index = 0;
 
-        std::shared_ptr<SomePacket> packet = std::make_shared<SomePacket>(reinterpret_cast<char*>(curr_packet), UdpPacketType::SendASPMPacket);
-        packet->putHeaderID(pdu_header[kk]);
+        PduView packet(curr_packet, buffer + UDP_BUF_MAX - curr_packet);
+        packet.putHeader(pdu_header[kk], pduPayloadLength(aspmPduType(pdu_header[kk])));
 
-        char* data = (char *)packet->getPayloadStartAddress();
+        char* data = (char *)packet.getPayload();
         std::vector<std::shared_ptr<LMSignalInfo>>& vt_signal = get_ASP_vector(pdu_header[kk]);
 
         for (ii=0; ii < vt_signal.size(); ii++)
@@ -1856,7 +1860,7 @@ uint16_t ASPM::encodeASPMSignalData(uint8_t* buffer)
             for (jj = loop; jj >= 0; jj--)
             {
                 unsigned long int x = 0xff; // 0xFF was int value in original code, this is not allowed to shift as int's max bit. So 0xFF should be defined as 8bytes(64bits)
-                currValue = ( (getASPMSignal(packet->getHeaderID(), vt_signal.at(ii)->getIndex()) ) & (x << (8 * jj))) >> (8 * jj);
+                currValue = ( (getASPMSignal(pdu_header[kk], vt_signal.at(ii)->getIndex()) ) & (x << (8 * jj))) >> (8 * jj);
                 if (length > 8) {
                     length_new = length - (8 * jj);
                     length -= length_new;
@@ -1878,7 +1882,7 @@ uint16_t ASPM::encodeASPMSignalData(uint8_t* buffer)
             }
         }
 
-        uint16_t move_len = sizeof(pdu_header_t) + packet->getPayloadLength();
+        uint16_t move_len = sizeof(pdu_header_t) + packet.getPayloadLength();
         size_total += move_len;
         curr_packet += move_len;
     }
@@ -1898,10 +1902,13 @@ void ASPM::decodeTCMSignalData(uint8_t* buffer)
     uint16_t index = 0;
 
     for (ii = 0; ii < NUMBER_OF_TCM_PDU; ++ii) {
-        std::shared_ptr<SomePacket> packet = std::make_shared<SomePacket>(reinterpret_cast<char*>(curr_packet), UdpPacketType::ReadTCMPacket);
-        char* data = (char *)packet->getPayloadStartAddress();
+        PduView packet(curr_packet, buffer + TCM_TOTAL_PACKET_SIZE - curr_packet);
+        if (!packet.isValid()) {
+            break;
+        }
+        char* data = (char *)packet.getPayload();
         index = 0;
-        std::vector<std::shared_ptr<LMSignalInfo>>& vt_signal = get_TCM_vector(packet->getHeaderID());
+        std::vector<std::shared_ptr<LMSignalInfo>>& vt_signal = get_TCM_vector(packet.getHeaderID());
         for (jj=0; jj < vt_signal.size(); ++jj) {
             length = vt_signal.at(jj)->getBitLength();
             bits_read = value = 0;
@@ -1925,8 +1932,8 @@ void ASPM::decodeTCMSignalData(uint8_t* buffer)
                     ++index;
                 }
             }
-            setTCMSignal(packet->getHeaderID(), vt_signal[jj]->getIndex(), value);
+            setTCMSignal(packet.getHeaderID(), vt_signal[jj]->getIndex(), value);
         }
-        curr_packet += sizeof(pdu_header_t) + packet->getPayloadLength();
+        curr_packet += sizeof(pdu_header_t) + packet.getPayloadLength();
     }
 }
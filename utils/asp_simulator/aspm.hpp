@@ -281,9 +281,9 @@ public:
     timeval dmhStartTime_;
 
     /*!
-     * SocketHandler object for handling all socket communications.
+     * link to the TCM, opened by initiateEventLoops( ).
      */
-    SocketHandler socketHandler_;
+    std::unique_ptr<AspTransport> transport_;
 
     /*!
      * loopHandler for ASP simulator thread.
@@ -305,6 +305,12 @@ public:
      */
     std::atomic<bool> running_;
 
+    /*!
+     * sleep of the event loops and of setters awaiting TCM confirmation, cut
+     * short by stop( ).
+     */
+    EventWaiter wakeup_;
+
     /*!
      * stores challenges that haven't been responded to yet by index
      */
@@ -52,6 +52,19 @@ int main( int argc, char *argv[ ] )
 
     ASPM aspm( SIMULATOR::BENCH, inputTestManeuver );
 
+    // Optional second argument selects the TCM link: "udp", "unix" or "shm".
+    if( argc > 2 )
+    {
+        aspm.setTransport( AspTransport::parseType( (std::string)argv[2] ) );
+    }
+
+    // Optional third argument selects the channel, e.g. one vehicle of a
+    // gateway; UDP_PORT by default.
+    if( argc > 3 )
+    {
+        aspm.setAspPort( (uint16_t)atoi( argv[3] ) );
+    }
+
     aspm.initiateEventLoops( );
 
     std::cout << "Press Enter to Exit" << std::endl;
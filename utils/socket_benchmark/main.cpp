@@ -0,0 +1,1195 @@
+/*! \license
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * \copyright 2021 Dan Fernández
+ *
+ * \file Loopback benchmark comparing plain socket calls with the io_uring
+ * backend of \p SocketHandler, scaling of \p VehicleGateway, the cost of
+ * each \p BodyCodec encoding, JSON versus binary deadmans_handle latency, and
+ * the table-driven versus \p PduCodec UDP packet encode and decode, and
+ * \p AspBatchDecoder throughput.
+ *
+ * \author fdaniel
+ */
+
+#include "sockethandler.hpp"
+#include "asptransport.hpp"
+#include "vehiclegateway.hpp"
+#include "bodycodec.hpp"
+#include "templatehandler.hpp"
+#include "messagewriter.hpp"
+#include "remotedevicehandler.hpp"
+#include "dmhframe.hpp"
+#include "requestparser.hpp"
+#include "aspbatchdecoder.hpp"
+
+#include <thread>
+#include <functional>
+#include <chrono>
+#include <sys/time.h>
+#include <sys/resource.h>
+
+#if defined( __x86_64__ ) || defined( __i386__ )
+#include <x86intrin.h>
+#endif
+
+constexpr auto BENCH_UDP_PORT = 8074;
+constexpr auto BENCH_TCP_PORT = 8075;
+constexpr auto BENCH_DMH_PORT = 8076;
+constexpr auto BENCH_TCP_CLIENTS = 8;
+constexpr auto BENCH_TCP_FRAMES = 4;        // frames queued per client per round
+constexpr auto BENCH_UDP_PACKET = 96;       // bytes, about one PDU set
+constexpr auto BENCH_GATEWAY_TCP_PORT = 21000;
+constexpr auto BENCH_GATEWAY_ASP_PORT = 31000;
+constexpr auto BENCH_GATEWAY_SOCKETS = 8;   // descriptors per simulated vehicle
+
+
+/**
+ * Time spent and context switches taken by the calling thread.
+ */
+struct Sample
+{
+    std::chrono::steady_clock::time_point start;
+    long switches;
+
+    static long contextSwitches( )
+    {
+        struct rusage usage;
+        getrusage( RUSAGE_THREAD, &usage );
+
+        return usage.ru_nvcsw + usage.ru_nivcsw;
+    }
+
+    Sample( )
+            :
+            start( std::chrono::steady_clock::now( ) ),
+            switches( contextSwitches( ) )
+    {
+
+    }
+
+    void report( const std::string& name, const int& iterations ) const
+    {
+        double ns = std::chrono::duration<double, std::nano>(
+                std::chrono::steady_clock::now( ) - start ).count( );
+
+        fprintf( stderr, "  %-14s %10.0f ns/iter %8.3f ctx switches/iter\n",
+                name.c_str( ),
+                ns / iterations,
+                (double)( contextSwitches( ) - switches ) / iterations );
+    }
+};
+
+
+/**
+ * One send / receive cycle per iteration against a UDP echo peer, as done by
+ * the TCM every ASP_REFRESH_RATE.
+ */
+void benchmarkUDP( const int& cycles )
+{
+    int echoSocket = socket( AF_INET, SOCK_DGRAM, 0 );
+
+    struct sockaddr_in address;
+    bzero( (char *) &address, sizeof( address ) );
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = inet_addr( UDP_ADDR );
+    address.sin_port = htons( BENCH_UDP_PORT );
+
+    if( bind( echoSocket, (struct sockaddr*)&address, sizeof( address ) ) != 0 )
+    {
+        perror( "ERROR binding UDP echo socket." );
+
+        return;
+    }
+
+    // Echo peer standing in for the ASP; stops on an empty datagram.
+    std::thread echo( [ echoSocket ]( )
+    {
+        uint8_t packet[ UDP_URING_BUF_SIZE ];
+        struct sockaddr_in peer;
+        socklen_t peerSize = sizeof( peer );
+
+        while( true )
+        {
+            ssize_t received = recvfrom( echoSocket, packet, sizeof( packet ), 0,
+                                         (struct sockaddr*)&peer, &peerSize );
+            if( received <= 0 )
+            {
+                break;
+            }
+            sendto( echoSocket, packet, received, 0, (struct sockaddr*)&peer, peerSize );
+        }
+    } );
+
+    SocketHandler tcm;
+    tcm.connectServer( SOCK_DGRAM, (uint64_t)UDP_ADDR, BENCH_UDP_PORT, true );
+
+    uint8_t packetOut[ BENCH_UDP_PACKET ] = { 0 };
+    uint8_t packetIn[ UDP_URING_BUF_SIZE ];
+
+    std::cerr << "UDP send / receive cycle, " << cycles << " cycles:" << std::endl;
+
+    {
+        tcm.setUringEnabled( false );
+        Sample sample;
+        for( int i = 0; i < cycles; ++i )
+        {
+            tcm.sendUDP( packetOut, sizeof( packetOut ) );
+            tcm.receiveUDP( packetIn, sizeof( packetIn ) );
+        }
+        sample.report( "socket calls", cycles );
+    }
+
+    tcm.setUringEnabled( true );
+    if( tcm.isUringEnabled( ) == true )
+    {
+        Sample sample;
+        for( int i = 0; i < cycles; ++i )
+        {
+            tcm.exchangeUDP( packetOut, sizeof( packetOut ), packetIn, sizeof( packetIn ) );
+        }
+        sample.report( "io_uring", cycles );
+    }
+    else
+    {
+        std::cerr << "  io_uring       not available; build with -DUSE_IO_URING=ON" << std::endl;
+    }
+
+    tcm.sendUDP( packetOut, 0 );
+    echo.join( );
+    tcm.disconnectServer( );
+    close( echoSocket );
+
+    return;
+}
+
+
+/**
+ * The same cycle over each ASP transport, with the ASP end echoing; separates
+ * link cost from PDU encode / decode cost.
+ */
+void benchmarkTransports( const int& cycles )
+{
+    std::cerr << "ASP transport round trip, " << cycles << " cycles:" << std::endl;
+
+    const char* names[ ] = { "udp", "unix", "shm" };
+
+    for( auto& name : names )
+    {
+        std::unique_ptr<AspTransport> asp( AspTransport::create( AspTransport::parseType( name ) ) );
+        std::unique_ptr<AspTransport> tcm( AspTransport::create( AspTransport::parseType( name ) ) );
+
+        if( asp->open( false ) == false || tcm->open( true ) == false )
+        {
+            continue;
+        }
+
+        std::thread echo( [ &asp, &cycles ]( )
+        {
+            uint8_t packet[ UDP_URING_BUF_SIZE ];
+            for( int i = 0; i < cycles; ++i )
+            {
+                ssize_t received = asp->receive( packet, sizeof( packet ) );
+                if( received <= 0 )
+                {
+                    break;
+                }
+                asp->send( packet, received );
+            }
+        } );
+
+        uint8_t packetOut[ BENCH_UDP_PACKET ] = { 0 };
+        uint8_t packetIn[ UDP_URING_BUF_SIZE ];
+
+        Sample sample;
+        for( int i = 0; i < cycles; ++i )
+        {
+            tcm->exchange( packetOut, sizeof( packetOut ), packetIn, sizeof( packetIn ) );
+        }
+        sample.report( name, cycles );
+
+        echo.join( );
+        tcm->close( );
+        asp->close( );
+    }
+
+    return;
+}
+
+
+/**
+ * Frames queued for several clients, then written by one pollEvents( ) call
+ * per round.
+ */
+void benchmarkTCP( const int& rounds )
+{
+    SocketHandler server;
+    server.connectServer( SOCK_STREAM, (uint64_t)UDP_ADDR, BENCH_TCP_PORT );
+
+    std::string header( "{\"group\":\"vehicle_status\"}" );
+    std::string body( 160, ' ' );
+    size_t frameSize = TCP_FRAME_PREFIX_SIZE + header.size( ) + body.size( );
+
+    std::atomic<uint64_t> received( 0 );
+    std::vector<int> clients;
+    std::vector<std::thread> readers;
+
+    for( int i = 0; i < BENCH_TCP_CLIENTS; ++i )
+    {
+        int client = socket( AF_INET, SOCK_STREAM, 0 );
+
+        struct sockaddr_in address;
+        bzero( (char *) &address, sizeof( address ) );
+        address.sin_family = AF_INET;
+        address.sin_addr.s_addr = inet_addr( UDP_ADDR );
+        address.sin_port = htons( BENCH_TCP_PORT );
+
+        if( connect( client, (struct sockaddr*)&address, sizeof( address ) ) != 0 )
+        {
+            perror( "ERROR connecting benchmark client." );
+        }
+
+        clients.push_back( client );
+        readers.push_back( std::thread( [ client, &received ]( )
+        {
+            char buffer[ 65536 ];
+            ssize_t bytes;
+            while( ( bytes = recv( client, buffer, sizeof( buffer ), 0 ) ) > 0 )
+            {
+                received += bytes;
+            }
+        } ) );
+    }
+
+    while( server.getClientCount( ) < (size_t)BENCH_TCP_CLIENTS )
+    {
+        server.pollEvents( 10 );
+    }
+
+    std::cerr << "TCP flush of " << BENCH_TCP_FRAMES << " frames to ";
+    std::cerr << BENCH_TCP_CLIENTS << " clients, " << rounds << " rounds:" << std::endl;
+
+    for( int mode = 0; mode < 2; ++mode )
+    {
+        server.setUringEnabled( mode == 1 );
+        if( mode == 1 && server.isUringEnabled( ) == false )
+        {
+            std::cerr << "  io_uring       not available; build with -DUSE_IO_URING=ON" << std::endl;
+
+            break;
+        }
+
+        uint64_t expected = received + (uint64_t)rounds * BENCH_TCP_FRAMES
+                            * BENCH_TCP_CLIENTS * frameSize;
+
+        Sample sample;
+        for( int i = 0; i < rounds; ++i )
+        {
+            for( int frame = 0; frame < BENCH_TCP_FRAMES; ++frame )
+            {
+                server.sendTCP( header, body );
+            }
+            server.pollEvents( 0 );
+        }
+        while( received < expected )
+        {
+            server.pollEvents( 1 );
+        }
+        sample.report( ( mode == 1 ) ? "io_uring" : "socket calls", rounds );
+    }
+
+    for( auto& client : clients )
+    {
+        shutdown( client, SHUT_RDWR );
+    }
+    for( auto& reader : readers )
+    {
+        reader.join( );
+    }
+    for( auto& client : clients )
+    {
+        close( client );
+    }
+    server.disconnectServer( );
+
+    return;
+}
+
+
+/**
+ * Serve an increasing number of vehicles from one VehicleGateway, each with a
+ * connected phone and an ASP answering every TCM packet, and report ASP
+ * packets decoded per second and arrival-to-decode latency.
+ */
+void benchmarkGateway( const int& seconds )
+{
+    // Every vehicle needs several descriptors; take what the hard limit allows.
+    struct rlimit files;
+    getrlimit( RLIMIT_NOFILE, &files );
+    files.rlim_cur = files.rlim_max;
+    setrlimit( RLIMIT_NOFILE, &files );
+
+    std::cerr << "Gateway, " << seconds << " s per size:" << std::endl;
+
+    for( size_t vehicles : { 1, 10, 100, 300 } )
+    {
+        if( ( vehicles + 8 ) * BENCH_GATEWAY_SOCKETS > files.rlim_cur )
+        {
+            std::cerr << "  " << vehicles << " vehicles   skipped; too few descriptors" << std::endl;
+
+            continue;
+        }
+
+        VehicleGateway gateway;
+        std::vector<int> asps;
+        int aspEpoll = epoll_create1( EPOLL_CLOEXEC );
+        int aspWake = eventfd( 0, EFD_CLOEXEC );
+
+        struct epoll_event event;
+        event.events = EPOLLIN;
+        event.data.fd = aspWake;
+        epoll_ctl( aspEpoll, EPOLL_CTL_ADD, aspWake, &event );
+
+        for( size_t i = 0; i < vehicles; ++i )
+        {
+            VehicleConfig config;
+            config.name = "vehicle-" + std::to_string( i );
+            config.tcpPort = BENCH_GATEWAY_TCP_PORT + i;
+            config.aspPort = BENCH_GATEWAY_ASP_PORT + i;
+            config.transport = AspTransportType::Udp;
+            gateway.addVehicle( config );
+
+            struct sockaddr_in address;
+            bzero( (char *) &address, sizeof( address ) );
+            address.sin_family = AF_INET;
+            address.sin_addr.s_addr = inet_addr( UDP_ADDR );
+            address.sin_port = htons( config.aspPort );
+
+            int asp = socket( AF_INET, SOCK_DGRAM | SOCK_CLOEXEC, 0 );
+            bind( asp, (struct sockaddr*)&address, sizeof( address ) );
+            event.data.fd = asp;
+            epoll_ctl( aspEpoll, EPOLL_CTL_ADD, asp, &event );
+            asps.push_back( asp );
+        }
+
+        // One thread stands in for every ASP, answering each TCM packet.
+        std::thread responder( [ aspEpoll, aspWake ]( )
+        {
+            uint8_t packet[ UDP_URING_BUF_SIZE ];
+            uint8_t reply[ ASPM_TOTAL_PACKET_SIZE ] = { 0 };
+            struct epoll_event events[ 64 ];
+
+            while( true )
+            {
+                int ready = epoll_wait( aspEpoll, events, 64, -1 );
+                for( int i = 0; i < ready; ++i )
+                {
+                    if( events[ i ].data.fd == aspWake )
+                    {
+                        return;
+                    }
+
+                    struct sockaddr_in peer;
+                    socklen_t peerSize = sizeof( peer );
+                    if( recvfrom( events[ i ].data.fd, packet, sizeof( packet ), 0,
+                                  (struct sockaddr*)&peer, &peerSize ) > 0 )
+                    {
+                        sendto( events[ i ].data.fd, reply, sizeof( reply ), 0,
+                                (struct sockaddr*)&peer, peerSize );
+                    }
+                }
+            }
+        } );
+
+        gateway.start( );
+
+        // A connected phone makes each vehicle run its ASP cycle.
+        std::vector<int> phones;
+        for( size_t i = 0; i < vehicles; ++i )
+        {
+            struct sockaddr_in address;
+            bzero( (char *) &address, sizeof( address ) );
+            address.sin_family = AF_INET;
+            address.sin_addr.s_addr = inet_addr( UDP_ADDR );
+            address.sin_port = htons( BENCH_GATEWAY_TCP_PORT + i );
+
+            int phone = socket( AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0 );
+            connect( phone, (struct sockaddr*)&address, sizeof( address ) );
+            phones.push_back( phone );
+        }
+
+        uint64_t start = LatencyHistogram::now( );
+        std::this_thread::sleep_for( std::chrono::seconds( seconds ) );
+        double elapsed = ( LatencyHistogram::now( ) - start ) / 1e9;
+
+        LatencyHistogram total;
+        uint64_t worst = 0;
+        for( size_t i = 0; i < vehicles; ++i )
+        {
+            LatencyHistogram& latency = gateway.getSignalHandler( i )->getArrivalToDecodeLatency( );
+            total.merge( latency );
+            worst = std::max( worst, latency.getPercentile( 99 ) );
+        }
+
+        fprintf( stderr, "  %4zu vehicles %8.0f packets/s  p50 < %5llu us  p99 < %5llu us"
+                 "  worst vehicle p99 < %5llu us  %llu overruns\n",
+                 vehicles,
+                 total.getCount( ) / elapsed,
+                 (unsigned long long)total.getPercentile( 50 ),
+                 (unsigned long long)total.getPercentile( 99 ),
+                 (unsigned long long)worst,
+                 (unsigned long long)gateway.getOverrunCount( ) );
+
+        for( auto& phone : phones )
+        {
+            close( phone );
+        }
+        gateway.stop( );
+
+        eventfd_write( aspWake, 1 );
+        responder.join( );
+        for( auto& asp : asps )
+        {
+            close( asp );
+        }
+        close( aspWake );
+        close( aspEpoll );
+    }
+
+    return;
+}
+
+
+/**
+ * Serialize and parse the body of each message group in every encoding, and
+ * report its size and the time per round trip.
+ */
+void benchmarkBodyEncoding( const int& cycles )
+{
+    TemplateHandler templates;
+
+    const std::pair<std::string, nlohmann::json> groups[ ] = {
+        { std::string( RD::VEHICLE_STATUS ), templates.getRawVehicleStatusTemplate( ) },
+        { std::string( RD::MANEUVER_STATUS ), templates.getRawManeuverStatusTemplate( ) },
+        { std::string( RD::THREAT_DATA ), templates.getRawThreatDataTemplate( ) },
+        { std::string( RD::AVAILABLE_MANEUVERS ), templates.getRawAvailableManeuversTemplate( ) },
+        { std::string( RD::VEHICLE_INIT ), templates.getRawVehicleInitTemplate( ) },
+        { std::string( RD::CABIN_STATUS ), templates.getRawCabinStatusTemplate( ) },
+        { std::string( RD::DEADMANS_HANDLE ), templates.getRawDeadmansHandleTemplate( ) },
+        { std::string( RD::MANEUVER_INIT ), templates.getRawManeuverInitTemplate( ) } };
+
+    const BodyEncoding encodings[ ] = {
+        BodyEncoding::Json, BodyEncoding::Cbor, BodyEncoding::MsgPack };
+
+    std::cerr << "Body encoding, bytes and ns per encode + decode, "
+              << cycles / 10 << " cycles:" << std::endl;
+
+    for( auto& group : groups )
+    {
+        fprintf( stderr, "  %-20s", group.first.c_str( ) );
+
+        for( auto& encoding : encodings )
+        {
+            std::string encoded = BodyCodec::encode( group.second, encoding );
+            nlohmann::json decoded;
+
+            auto start = std::chrono::steady_clock::now( );
+            for( int i = 0; i < cycles / 10; ++i )
+            {
+                encoded = BodyCodec::encode( group.second, encoding );
+                BodyCodec::decode( encoded.data( ), encoded.size( ), encoding, decoded );
+            }
+            double ns = std::chrono::duration<double, std::nano>(
+                    std::chrono::steady_clock::now( ) - start ).count( );
+
+            fprintf( stderr, " %7s %5zu B %7.0f ns",
+                     BodyCodec::getEncodingName( encoding ),
+                     encoded.size( ),
+                     ns / ( cycles / 10 ) );
+        }
+
+        fprintf( stderr, "\n" );
+    }
+
+    return;
+}
+
+
+/**
+ * Time one serializer; the result is kept in \p out so it is not optimized
+ * away.
+ */
+double timeSerializer(
+        const int& cycles,
+        const std::function<void( std::string& )>& serialize,
+        std::string& out )
+{
+    auto start = std::chrono::steady_clock::now( );
+    for( int i = 0; i < cycles; ++i )
+    {
+        serialize( out );
+    }
+
+    return std::chrono::duration<double, std::nano>(
+            std::chrono::steady_clock::now( ) - start ).count( ) / cycles;
+}
+
+
+/**
+ * Serialize each fixed-schema outbound body through a filled-in template and
+ * through \p MessageWriter, and report the time per message of each.
+ */
+void benchmarkSerializers( const int& cycles )
+{
+    TemplateHandler templates;
+
+    StatusEntry status[ VEHICLE_STATUS_COUNT ];
+    for( int i = 0; i < VEHICLE_STATUS_COUNT; ++i )
+    {
+        VehicleStatusPrefix prefix( (VehicleStatusPrefix)( ( i + 1 ) * 100 ) );
+        status[ i ].code = (int)prefix + 1;
+        status[ i ].text = MessageWriter::getStatusText( prefix, 1 );
+    }
+
+    bool offered[ AVAILABLE_MANEUVER_COUNT ] = { false };
+    offered[ (int)AvailableManeuver::OutLftFwd ] = true;
+    offered[ (int)AvailableManeuver::NdgRvs ] = true;
+
+    uint8_t threats[ THREAT_SEGMENT_COUNT ];
+    for( int i = 0; i < THREAT_SEGMENT_COUNT; ++i )
+    {
+        threats[ i ] = (uint8_t)( i % 20 );
+    }
+
+    // The DOM side fills a template copy, as the handler used to.
+    const char* statusKeys[ VEHICLE_STATUS_COUNT ] = {
+        "status_1xx", "status_2xx", "status_3xx", "status_4xx", "status_5xx",
+        "status_6xx", "status_7xx", "status_8xx", "status_9xx" };
+
+    const std::pair<std::function<void( std::string& )>, std::function<void( std::string& )>> groups[ ] = {
+        { [ & ]( std::string& out )
+          {
+              nlohmann::json msgOut = templates.getRawVehicleStatusTemplate( );
+              for( int i = 0; i < VEHICLE_STATUS_COUNT; ++i )
+              {
+                  msgOut[ statusKeys[ i ] ][ "status_code" ] = status[ i ].code;
+                  msgOut[ statusKeys[ i ] ][ "status_text" ] = status[ i ].text;
+              }
+              out = msgOut.dump( );
+          },
+          [ & ]( std::string& out )
+          {
+              out.clear( );
+              MessageWriter::writeVehicleStatus( status, out );
+          } },
+        { [ & ]( std::string& out )
+          {
+              nlohmann::json msgOut = templates.getRawManeuverStatusTemplate( );
+              msgOut[ "maneuver" ] = "OutLftFwd";
+              msgOut[ "progress" ] = 42;
+              msgOut[ "status" ] = 904;
+              out = msgOut.dump( );
+          },
+          [ & ]( std::string& out )
+          {
+              out.clear( );
+              MessageWriter::writeManeuverStatus( "OutLftFwd", 42, 904, out );
+          } },
+        { [ & ]( std::string& out )
+          {
+              nlohmann::json msgOut = templates.getRawThreatDataTemplate( );
+              for( int i = 0; i < THREAT_SEGMENT_COUNT; ++i )
+              {
+                  msgOut[ "threats" ][ i ] = threats[ i ];
+              }
+              out = msgOut.dump( );
+          },
+          [ & ]( std::string& out )
+          {
+              out.clear( );
+              MessageWriter::writeThreatData( threats, out );
+          } },
+        { [ & ]( std::string& out )
+          {
+              nlohmann::json msgOut = templates.getRawAvailableManeuversTemplate( );
+              for( int i = 0; i < AVAILABLE_MANEUVER_COUNT; ++i )
+              {
+                  msgOut[ "maneuvers" ][ AVAILABLE_MANEUVER_NAMES[ i ] ] = offered[ i ];
+              }
+              msgOut[ "default" ] = "OutLftFwd";
+              msgOut[ "continue_exploring" ] = true;
+              out = msgOut.dump( );
+          },
+          [ & ]( std::string& out )
+          {
+              out.clear( );
+              MessageWriter::writeAvailableManeuvers( "OutLftFwd", true, offered, out );
+          } },
+        { [ & ]( std::string& out )
+          {
+              nlohmann::json msgOut = templates.getRawCabinStatusTemplate( );
+              msgOut[ "power_status" ] = true;
+              msgOut[ "lock_status" ] = false;
+              out = msgOut.dump( );
+          },
+          [ & ]( std::string& out )
+          {
+              out.clear( );
+              MessageWriter::writeCabinStatus( true, false, out );
+          } } };
+
+    const char* names[ ] = {
+        RD::VEHICLE_STATUS, RD::MANEUVER_STATUS, RD::THREAT_DATA,
+        RD::AVAILABLE_MANEUVERS, RD::CABIN_STATUS };
+
+    std::cerr << "Outbound serializers, ns per message, "
+              << cycles << " cycles:" << std::endl;
+
+    for( size_t i = 0; i < sizeof( names ) / sizeof( names[ 0 ] ); ++i )
+    {
+        std::string domOut;
+        std::string writerOut;
+
+        double domNs = timeSerializer( cycles, groups[ i ].first, domOut );
+        double writerNs = timeSerializer( cycles, groups[ i ].second, writerOut );
+
+        fprintf( stderr, "  %-20s  dom %7.0f ns  writer %5.0f ns  %5.1fx%s\n",
+                 names[ i ],
+                 domNs,
+                 writerNs,
+                 domNs / writerNs,
+                 ( domOut == writerOut ) ? "" : "  MISMATCH" );
+    }
+
+    return;
+}
+
+
+/**
+ * Write one frame, or several back to back, in a single call.
+ */
+void appendFrame( const std::string& header, const std::string& body, std::string& out )
+{
+    uint32_t sizes[ 2 ] = { htonl( header.size( ) ), htonl( body.size( ) ) };
+    out.append( (const char*)sizes, sizeof( sizes ) );
+    out += header;
+    out += body;
+}
+
+
+/**
+ * Read frames from \p phone until one of \p group arrives.
+ */
+bool awaitGroup( const int& phone, const std::string& group )
+{
+    std::string frame;
+    std::string wanted( "\"" + group + "\"" );
+
+    while( frame.find( wanted ) == std::string::npos )
+    {
+        uint32_t sizes[ 2 ];
+        if( recv( phone, sizes, sizeof( sizes ), MSG_WAITALL ) != (ssize_t)sizeof( sizes ) )
+        {
+            return false;
+        }
+
+        frame.resize( ntohl( sizes[ 0 ] ) + ntohl( sizes[ 1 ] ) );
+        if( frame.empty( ) == false
+            && recv( phone, &frame[ 0 ], frame.size( ), MSG_WAITALL ) != (ssize_t)frame.size( ) )
+        {
+            return false;
+        }
+        frame.resize( ntohl( sizes[ 0 ] ) );
+    }
+
+    return true;
+}
+
+
+/**
+ * Round trip of a deadmans_handle sample through \p RemoteDeviceHandler over
+ * loopback, sent as JSON and as a binary DMH frame.  Each sample is followed
+ * by a heartbeat in the same write; its reply marks the sample as applied.
+ */
+void benchmarkDeadmansHandle( const int& cycles )
+{
+    std::shared_ptr<SignalHandler> TCM( std::make_shared<SignalHandler>( ) );
+    RemoteDeviceHandler server( TCM, false );
+    server.bindServer( BENCH_DMH_PORT );
+
+    std::atomic<bool> serving( true );
+    std::thread loop( [ &server, &serving ]( )
+    {
+        while( serving )
+        {
+            server.pollEvents( 10 );
+        }
+    } );
+
+    int phone = socket( AF_INET, SOCK_STREAM, 0 );
+
+    struct sockaddr_in address;
+    bzero( (char *) &address, sizeof( address ) );
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = inet_addr( UDP_ADDR );
+    address.sin_port = htons( BENCH_DMH_PORT );
+
+    if( connect( phone, (struct sockaddr*)&address, sizeof( address ) ) != 0 )
+    {
+        perror( "ERROR connecting benchmark phone." );
+    }
+
+    int noDelay = 1;
+    setsockopt( phone, IPPROTO_TCP, TCP_NODELAY, &noDelay, sizeof( noDelay ) );
+
+    std::string request;
+    appendFrame( "{\"group\":\"set_body_encoding\"}", "{\"binary_dmh\":true}", request );
+    send( phone, request.data( ), request.size( ), 0 );
+    awaitGroup( phone, RD::BODY_ENCODING );
+
+    std::string heartbeat;
+    appendFrame( "{\"group\":\"heartbeat\"}", "", heartbeat );
+
+    std::string jsonBody(
+            "{\"enable_vehicle_motion\":true,\"dmh_gesture_progress\":50,"
+            "\"dmh_horizontal_touch\":320,\"dmh_vertical_touch\":480,\"crc_value\":4660}" );
+    std::string jsonRequest;
+    appendFrame( "{\"group\":\"deadmans_handle\"}", jsonBody, jsonRequest );
+    jsonRequest += heartbeat;
+
+    DmhSample dmh = { true, 50, 320, 480, 4660 };
+    std::string body( DMH_FRAME_SIZE, '\0' );
+    DmhFrame::encode( dmh, &body[ 0 ] );
+    std::string binaryRequest;
+    appendFrame( "", body, binaryRequest );
+    binaryRequest += heartbeat;
+
+    std::cerr << "Deadmans handle round trip, " << cycles / 10 << " cycles:" << std::endl;
+
+    const std::pair<const char*, const std::string*> modes[ ] = {
+        { "json", &jsonRequest }, { "binary", &binaryRequest } };
+
+    for( auto& mode : modes )
+    {
+        LatencyHistogram latency;
+
+        Sample sample;
+        for( int i = 0; i < cycles / 10; ++i )
+        {
+            uint64_t start = LatencyHistogram::now( );
+            send( phone, mode.second->data( ), mode.second->size( ), 0 );
+            if( awaitGroup( phone, RD::HEARTBEAT ) == false )
+            {
+                break;
+            }
+            latency.record( start, LatencyHistogram::now( ) );
+        }
+        sample.report( mode.first, cycles / 10 );
+
+        fprintf( stderr, "  %-14s %10zu B/sample  p50 < %5llu us  p99 < %5llu us\n",
+                 "",
+                 mode.second->size( ) - heartbeat.size( ),
+                 (unsigned long long)latency.getPercentile( 50 ),
+                 (unsigned long long)latency.getPercentile( 99 ) );
+    }
+
+    close( phone );
+    serving = false;
+    loop.join( );
+    server.closeServer( );
+
+    // Decode alone, without the socket and heartbeat around it.
+    static constexpr FieldSpec fields[ ] = {
+        { "enable_vehicle_motion", FieldType::Bool, true },
+        { "dmh_gesture_progress", FieldType::Number, true },
+        { "dmh_horizontal_touch", FieldType::Number, true },
+        { "dmh_vertical_touch", FieldType::Number, true },
+        { "crc_value", FieldType::Number, true } };
+    static constexpr RequestSchema schema = makeSchema( fields );
+
+    uint64_t checksum( 0 );
+
+    auto start = std::chrono::steady_clock::now( );
+    for( int i = 0; i < cycles; ++i )
+    {
+        RequestBody parsed( schema );
+        RequestParser::parse( jsonBody.data( ), jsonBody.size( ), parsed );
+        checksum += (uint64_t)parsed.getNumber( "crc_value" );
+    }
+    double jsonNs = std::chrono::duration<double, std::nano>(
+            std::chrono::steady_clock::now( ) - start ).count( ) / cycles;
+
+    start = std::chrono::steady_clock::now( );
+    for( int i = 0; i < cycles; ++i )
+    {
+        DmhFrame::decode( body.data( ), body.size( ), dmh );
+        checksum += dmh.crc;
+    }
+    double binaryNs = std::chrono::duration<double, std::nano>(
+            std::chrono::steady_clock::now( ) - start ).count( ) / cycles;
+
+    fprintf( stderr, "  decode only    json %7.1f ns  binary %5.1f ns  %6.1fx  (%llu)\n",
+             jsonNs, binaryNs, jsonNs / binaryNs, (unsigned long long)checksum );
+
+    return;
+}
+
+
+
+/**
+ * Cycle counter ticks where the CPU has one, nanoseconds elsewhere.
+ */
+#if defined( __x86_64__ ) || defined( __i386__ )
+constexpr auto TICK_UNIT = "cycles";
+
+inline uint64_t ticks( )
+{
+    return __rdtsc( );
+}
+#else
+constexpr auto TICK_UNIT = "ns";
+
+inline uint64_t ticks( )
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now( ).time_since_epoch( ) ).count( );
+}
+#endif
+
+
+/**
+ * The table-driven TCM encoder that \p PduCodec replaced: one getTCMSignal( )
+ * switch and one bit loop per signal.
+ */
+uint16_t tableEncode( SignalHandler& sh, uint8_t* buffer )
+{
+    int8_t jj, kk = 0;
+    size_t ii;
+    uint16_t size_total = 0;
+    uint8_t* curr_packet = buffer;
+    uint8_t length = 0;
+    uint8_t length_new = 0;
+    uint8_t currValue = 0;
+    int8_t loop = 0;
+    int8_t startBit = 0;
+    int8_t remainBits = 0;
+
+    int pdu_header[NUMBER_OF_TCM_PDU] = {HRD_ID_OF_TCM_LM, HRD_ID_OF_TCM_LM_Session, HRD_ID_OF_TCM_RemoteControl, HRD_ID_OF_TCM_TransportKey,
+        HRD_ID_OF_TCM_LM_App, HRD_ID_OF_TCM_LM_KeyID, HRD_ID_OF_TCM_LM_KeyAlpha, HRD_ID_OF_TCM_LM_KeyBeta,  HRD_ID_OF_TCM_LM_KeyGamma };
+
+    memset(buffer, 0x00, UDP_BUF_MAX);
+
+    for (kk = 0; kk<NUMBER_OF_TCM_PDU ; ++kk) {
+        uint16_t index = 0;
+
+        std::shared_ptr<SomePacket> packet = std::make_shared<SomePacket>(reinterpret_cast<char*>(curr_packet), UdpPacketType::SendTCMPacket);
+        packet->putHeaderID(pdu_header[kk]);
+
+        char* data = (char *)packet->getPayloadStartAddress();
+        std::vector<std::shared_ptr<LMSignalInfo>>& vt_signal = sh.get_TCM_vector(pdu_header[kk]);
+
+        for (ii=0; ii < vt_signal.size(); ii++)
+        {
+            length = vt_signal.at(ii)->getBitLength();
+            loop = (length-1)/8 ;
+
+            for (jj = loop; jj >= 0; jj--)
+            {
+                unsigned long int x = 0xff;
+                currValue = ( (sh.getTCMSignal(packet->getHeaderID(), vt_signal.at(ii)->getIndex()) ) & (x << (8 * jj))) >> (8 * jj);
+                if (length > 8) {
+                    length_new = length - (8 * jj);
+                    length -= length_new;
+                } else {
+                    length_new = length;
+                    currValue = (currValue & ((1 << length_new)-1));
+                }
+                remainBits = 8 - startBit;
+
+                if (length_new <= remainBits) {
+                    data[index] |= currValue << (remainBits - length_new);
+                    startBit = (startBit + length_new) % 8;
+                    if (startBit == 0) index++;
+                } else {
+                    startBit = length_new - remainBits;
+                    data[index] |= currValue >> startBit;
+                    data[++index] |= currValue << (8 - startBit);
+                }
+            }
+        }
+
+        uint16_t move_len = sizeof(pdu_header_t) + packet->getPayloadLength();
+
+        size_total += move_len;
+        curr_packet += move_len;
+    }
+
+    return size_total;
+}
+
+
+/**
+ * The table-driven ASPM decoder that \p PduCodec replaced: one bit loop and
+ * one setASPSignal( ) switch per signal.
+ */
+void tableDecode( SignalHandler& sh, uint8_t* buffer )
+{
+    int8_t ii = 0;
+    size_t jj = 0;
+    uint8_t length = 0;
+    uint8_t bits_read = 0, bits_to_read = 0;
+    uint8_t lmask = 0, rmask = 0, value_byte = 0;
+    uint8_t bits_remaining = 0;
+    uint64_t value = 0;
+    uint8_t* curr_packet = buffer;
+    uint16_t index = 0;
+
+    for (ii = 0; ii < NUMBER_OF_ASPM_PDU; ++ii) {
+        std::shared_ptr<SomePacket> packet = std::make_shared<SomePacket>(reinterpret_cast<char*>(curr_packet), UdpPacketType::ReadASPMPacket);
+        char* data = (char *)packet->getPayloadStartAddress();
+        index = 0;
+        std::vector<std::shared_ptr<LMSignalInfo>>& vt_signal = sh.get_ASP_vector(packet->getHeaderID());
+
+        for (jj=0; jj < vt_signal.size(); ++jj) {
+            length = vt_signal.at(jj)->getBitLength();
+            bits_read = value = 0;
+            while(bits_read < length) {
+                if (bits_remaining) {
+                    lmask = (uint8_t)0xFF >> (8 - bits_remaining);
+                    bits_to_read = std::min((uint8_t)(length - bits_read), bits_remaining);
+                    rmask = (uint8_t)0xFF << (bits_remaining - bits_to_read);
+                    bits_remaining -= bits_to_read;
+                    value_byte = (data[index] & lmask & rmask) >> bits_remaining;
+                }
+                else {
+                    bits_to_read = std::min((uint8_t)(length - bits_read), (uint8_t)8);
+                    rmask = (uint8_t)0xFF << (8 - bits_to_read);
+                    bits_remaining = 8 - bits_to_read;
+                    value_byte = (data[index] & rmask) >> bits_remaining;
+                }
+                bits_read += bits_to_read;
+                value |= (uint64_t)value_byte << (length - bits_read);
+                if (!bits_remaining) {
+                    ++index;
+                }
+            }
+            sh.setASPSignal(packet->getHeaderID(), vt_signal[jj]->getIndex(), value);
+        }
+        curr_packet += sizeof(pdu_header_t) + packet->getPayloadLength();
+    }
+
+    sh.publishAspSnapshot( );
+}
+
+
+/**
+ * Encode a TCM packet and decode an ASPM packet with the old table-driven
+ * loops and with the \p PduCodec layouts, and report the cost per packet.
+ */
+void benchmarkCodec( const int& cycles )
+{
+    SignalHandler table;
+    SignalHandler codec;
+
+    for( SignalHandler* sh : { &table, &codec } )
+    {
+        sh->AppSliderPosX = 1234;
+        sh->AppSliderPosY = 2345;
+        sh->AppCalcCheck = 0xBEEF;
+        sh->MobileChallengeReply = 0x0123456789ABCDEF;
+        sh->AppAccelerationZ = 50;
+    }
+
+    // An ASPM datagram with every PDU present and arbitrary signal values.
+    uint8_t aspm[ UDP_BUF_MAX ] = { 0 };
+    const uint32_t aspmPdus[ NUMBER_OF_ASPM_PDU ] = {
+        HRD_ID_OF_ASPM_LM, HRD_ID_OF_ASPM_RemoteTarget, HRD_ID_OF_ASPM_LM_Session,
+        HRD_ID_OF_ASPM_LM_ObjSegment, HRD_ID_OF_ASPM_LM_Trunc };
+    uint8_t* curr = aspm;
+    uint32_t seed = 12345;
+    for( uint32_t id : aspmPdus )
+    {
+        SomePacket packet( reinterpret_cast<char*>( curr ), UdpPacketType::SendASPMPacket );
+        packet.putHeaderID( id );
+        uint8_t* payload = reinterpret_cast<uint8_t*>( packet.getPayloadStartAddress( ) );
+        for( uint32_t i = 0; i < packet.getPayloadLength( ); ++i )
+        {
+            seed = seed * 1103515245 + 12345;
+            payload[ i ] = (uint8_t)( seed >> 16 );
+        }
+        curr = payload + packet.getPayloadLength( );
+    }
+
+    uint8_t tableOut[ UDP_BUF_MAX ];
+    uint8_t codecOut[ UDP_BUF_MAX ];
+
+    uint64_t start = ticks( );
+    for( int i = 0; i < cycles; ++i )
+    {
+        tableEncode( table, tableOut );
+    }
+    double tableEncodeTicks = (double)( ticks( ) - start ) / cycles;
+
+    start = ticks( );
+    for( int i = 0; i < cycles; ++i )
+    {
+        codec.encodeTCMSignalData( codecOut );
+    }
+    double codecEncodeTicks = (double)( ticks( ) - start ) / cycles;
+
+    start = ticks( );
+    for( int i = 0; i < cycles; ++i )
+    {
+        tableDecode( table, aspm );
+    }
+    double tableDecodeTicks = (double)( ticks( ) - start ) / cycles;
+
+    start = ticks( );
+    for( int i = 0; i < cycles; ++i )
+    {
+        codec.decodeASPMSignalData( aspm );
+    }
+    double codecDecodeTicks = (double)( ticks( ) - start ) / cycles;
+
+    bool encodeMatch = memcmp( tableOut, codecOut, TCM_TOTAL_PACKET_SIZE ) == 0;
+    bool decodeMatch = table.getManeuverFromASP( ) == codec.getManeuverFromASP( )
+            && table.InfoMsg == codec.InfoMsg
+            && table.MobileChallengeSend == codec.MobileChallengeSend
+            && memcmp( &table.threatDistanceData, &codec.threatDistanceData, sizeof( table.threatDistanceData ) ) == 0
+            && memcmp( &table.threatTypeData, &codec.threatTypeData, sizeof( table.threatTypeData ) ) == 0;
+
+    std::cerr << "PDU codec, " << TICK_UNIT << " per packet, " << cycles << " cycles:" << std::endl;
+
+    fprintf( stderr, "  %-14s table %8.0f  codec %6.0f  %6.1fx%s\n",
+             "encode TCM",
+             tableEncodeTicks,
+             codecEncodeTicks,
+             tableEncodeTicks / codecEncodeTicks,
+             encodeMatch ? "" : "  MISMATCH" );
+    fprintf( stderr, "  %-14s table %8.0f  codec %6.0f  %6.1fx%s\n",
+             "decode ASPM",
+             tableDecodeTicks,
+             codecDecodeTicks,
+             tableDecodeTicks / codecDecodeTicks,
+             decodeMatch ? "" : "  MISMATCH" );
+
+    return;
+}
+
+
+/**
+ * Decode a recording of ASPM packets into snapshots: one at a time through
+ * SignalHandler, then with AspBatchDecoder on one thread and on every core.
+ *
+ * @param packets  packets in the recording
+ */
+void benchmarkBatchDecode( const size_t& packets )
+{
+    std::vector<uint8_t> recording( packets * ASPM_TOTAL_PACKET_SIZE );
+    const uint32_t aspmPdus[ NUMBER_OF_ASPM_PDU ] = {
+        HRD_ID_OF_ASPM_LM, HRD_ID_OF_ASPM_RemoteTarget, HRD_ID_OF_ASPM_LM_Session,
+        HRD_ID_OF_ASPM_LM_ObjSegment, HRD_ID_OF_ASPM_LM_Trunc };
+    uint32_t seed = 12345;
+    for( size_t p = 0; p < packets; ++p )
+    {
+        PduView pdu( &recording[ p * ASPM_TOTAL_PACKET_SIZE ], ASPM_TOTAL_PACKET_SIZE );
+        for( uint32_t id : aspmPdus )
+        {
+            pdu.putHeader( id, pduPayloadLength( aspmPduType( id ) ) );
+            for( uint32_t i = 0; i < pdu.getPayloadLength( ); ++i )
+            {
+                seed = seed * 1103515245 + 12345;
+                pdu.getPayload( )[ i ] = (uint8_t)( seed >> 16 );
+            }
+            pdu = pdu.next( );
+        }
+    }
+
+    std::vector<AspSnapshot> live( packets );
+    std::vector<AspSnapshot> single( packets );
+    std::vector<AspSnapshot> threaded( packets );
+    SignalHandler sh;
+
+    auto rate = [ packets ]( std::chrono::steady_clock::time_point start )
+    {
+        std::chrono::duration<double> elapsed( std::chrono::steady_clock::now( ) - start );
+        return packets / elapsed.count( );
+    };
+
+    auto start = std::chrono::steady_clock::now( );
+    for( size_t p = 0; p < packets; ++p )
+    {
+        sh.decodeASPMSignalData( &recording[ p * ASPM_TOTAL_PACKET_SIZE ] );
+        live[ p ] = sh.getAspSnapshot( );
+    }
+    double liveRate = rate( start );
+
+    start = std::chrono::steady_clock::now( );
+    AspBatchDecoder::decodeBatch( recording.data( ), packets, single.data( ), 1 );
+    double singleRate = rate( start );
+
+    start = std::chrono::steady_clock::now( );
+    AspBatchDecoder::decodeBatch( recording.data( ), packets, threaded.data( ) );
+    double threadedRate = rate( start );
+
+    bool match = true;
+    for( size_t p = 0; p < packets && match; ++p )
+    {
+        match = SignalHandler::getManeuverFromASP( live[ p ] ) == SignalHandler::getManeuverFromASP( threaded[ p ] )
+                && live[ p ].InfoMsg == single[ p ].InfoMsg
+                && live[ p ].MobileChallengeSend == threaded[ p ].MobileChallengeSend
+                && memcmp( live[ p ].ASPMRearSegDistRMT, threaded[ p ].ASPMRearSegDistRMT, ASP_THREAT_SEGMENT_COUNT ) == 0
+                && memcmp( live[ p ].ASPMFrontSegTypeRMT, single[ p ].ASPMFrontSegTypeRMT, ASP_THREAT_SEGMENT_COUNT ) == 0;
+    }
+
+    std::cerr << "ASPM decode to snapshots, packets/s, " << packets << " packets:" << std::endl;
+
+    fprintf( stderr, "  %-22s %12.0f\n", "SignalHandler", liveRate );
+    fprintf( stderr, "  %-22s %12.0f  %6.1fx\n", "batch, 1 thread", singleRate, singleRate / liveRate );
+    fprintf( stderr, "  %-22s %12.0f  %6.1fx%s\n", "batch, every core", threadedRate, threadedRate / liveRate,
+             match ? "" : "  MISMATCH" );
+
+    return;
+}
+
+
+/**
+ * Usage: telematics-api-benchmark [iterations] > /dev/null
+ *
+ * Results go to stderr; stdout carries the usual socket logging.
+ */
+int main( int argc, char *argv[ ] )
+{
+    int iterations = ( argc > 1 ) ? atoi( argv[ 1 ] ) : 20000;
+
+    benchmarkUDP( iterations );
+    benchmarkTCP( iterations );
+    benchmarkTransports( iterations );
+    benchmarkGateway( 2 );
+    benchmarkBodyEncoding( iterations );
+    benchmarkSerializers( iterations );
+    benchmarkDeadmansHandle( iterations );
+    benchmarkCodec( iterations );
+    benchmarkBatchDecode( 16 * iterations );
+
+    return 0;
+}